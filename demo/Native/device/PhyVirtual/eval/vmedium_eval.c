@@ -0,0 +1,366 @@
+/**
+  * @file vmedium_eval.c
+  * @brief This file implement a throughput and collision measurement tool on
+  * the virtual medium
+  *
+  * @details N devices, randomly placed in a disc around a gateway, send a
+  * frame every period. The first transmission of each device is at a random
+  * time in the period (pure ALOHA). The gateway listen continuously on the
+  * same channel and modulation.
+  *
+  * With -a, the devices are aligned instead : they all transmit at the start
+  * of each period (as the periodic install after the day pass), with a random
+  * clock drift (-j). The transmit slot allocator of the device (see
+  * slot_internal) then spreads them over its window (-w, 0 to disable it).
+  *
+  * The tool report the offered load (G), the number of frames sent, received
+  * by the gateway, lost by collision and below the sensitivity, and the
+  * measured throughput (S) against the pure ALOHA one (G.exp(-2G)).
+  *
+  * Usage : vmedium_eval [-n devices] [-p period_s] [-d duration_s]
+  *                      [-l length] [-r radius_m] [-s seed]
+  *                      [-a] [-j drift_ms] [-w window_s]
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+
+#include "phy_virtual.h"
+#include "slot_internal.h"
+
+/*!
+ * @brief This struct defines the evaluation parameters
+ */
+struct eval_cfg_s
+{
+	uint32_t u32DevNb;    /*!< Number of devices */
+	uint32_t u32Period;   /*!< Transmission period (s) */
+	uint32_t u32Duration; /*!< Simulated duration (s) */
+	uint32_t u32Radius;   /*!< Radius of the disc where devices are placed (m) */
+	uint32_t u32Seed;     /*!< Seed of the random generators */
+	uint32_t u32Drift;    /*!< Clock drift, aligned mode only (ms) */
+	uint32_t u32Window;   /*!< Slot window, aligned mode only (s, 0 : no slot) */
+	uint8_t  u8Len;       /*!< Frame length */
+	uint8_t  bAligned;    /*!< Devices transmit at the start of the period */
+};
+
+static const vmedium_cfg_t _sMediumCfg_ = {
+	.fTxPowerMax = 14.0f,
+	.fSensitivity = -120.0f,
+	.fNoiseFloor = -130.0f,
+	.fPathLoss0 = 40.0f,
+	.fPathLossExp = 3.0f,
+	.fCaptureDb = 6.0f,
+	.u32BitErrPpm = 0,
+	.u32ByteErrPpm = 0,
+	.u32Seed = 0,
+};
+
+static uint32_t _u32GwRecv_;
+
+/*!
+ * @static
+ * @brief  Gateway event call-back, listen again after each frame
+ *
+ * @param [in] pCbParam Pointer on the gateway phy device
+ * @param [in] eEvt     Event (see phydev_evt_e)
+ *
+ * @return None
+ */
+static void _gw_evt_cb_(void *pCbParam, uint32_t eEvt)
+{
+	phydev_t *pPhydev = (phydev_t *)pCbParam;
+	if (eEvt == PHYDEV_EVT_RX_COMPLETE)
+	{
+		_u32GwRecv_++;
+		pPhydev->pIf->pfRx(pPhydev, PHY_CH120, PHY_WM2400);
+	}
+}
+
+/*!
+ * @static
+ * @brief  Setup the slot allocator of a device (aligned mode)
+ *
+ * @param [in] pSlot Pointer on the slot allocator context
+ * @param [in] pCfg  Pointer on the evaluation parameters
+ * @param [in] u32Id The device number (used as identification number)
+ *
+ * @return None
+ */
+static void _slot_setup_(struct slot_ctx_s *pSlot, const struct eval_cfg_s *pCfg, uint32_t u32Id)
+{
+	struct slot_cfg_s sSlotCfg;
+	// M-field, then A-field (identification number, version, type)
+	uint8_t aId[8] = { 0x4C, 0x25, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03 };
+
+	aId[2] = (uint8_t)(u32Id);
+	aId[3] = (uint8_t)(u32Id >> 8);
+	aId[4] = (uint8_t)(u32Id >> 16);
+	aId[5] = (uint8_t)(u32Id >> 24);
+
+	SlotInt_Init(pSlot);
+	sSlotCfg = pSlot->sCfg;
+	sSlotCfg.aWindowMs[SLOT_CLASS_INST] = pCfg->u32Window * 1000;
+	SlotInt_Config(pSlot, &sSlotCfg);
+	SlotInt_SetId(pSlot, aId, sizeof(aId), pCfg->u32Seed);
+}
+
+/*!
+ * @static
+ * @brief  Get the next transmission time of a device (aligned mode)
+ *
+ * @param [in] pSlot    Pointer on the slot allocator context
+ * @param [in] pCfg     Pointer on the evaluation parameters
+ * @param [in] u64Start Start of the period (us)
+ *
+ * @return The transmission time (us)
+ */
+static uint64_t _aligned_next_(struct slot_ctx_s *pSlot, const struct eval_cfg_s *pCfg, uint64_t u64Start)
+{
+	uint64_t u64Drift = (uint64_t)pCfg->u32Drift * 2000;
+	u64Drift = ( (uint64_t)rand() * u64Drift ) / ((uint64_t)RAND_MAX + 1);
+	return u64Start + (uint64_t)SlotInt_Offset(pSlot, SLOT_CLASS_INST) * 1000 + u64Drift;
+}
+
+/*!
+ * @static
+ * @brief  Parse a numerical argument
+ *
+ * @param [in]  pStr   The argument
+ * @param [in]  u32Max The greatest accepted value
+ * @param [out] pVal   Pointer on the value
+ *
+ * @retval 0 Success
+ * @retval 1 Not a number, or greater than u32Max
+ */
+static int _parse_num_(const char *pStr, uint32_t u32Max, uint32_t *pVal)
+{
+	char *pEnd;
+	unsigned long ulVal;
+
+	errno = 0;
+	ulVal = strtoul(pStr, &pEnd, 0);
+	if ( errno || (pEnd == pStr) || (*pEnd != '\0') || (strchr(pStr, '-') != NULL) || (ulVal > u32Max) )
+	{
+		return 1;
+	}
+	*pVal = (uint32_t)ulVal;
+	return 0;
+}
+
+/*!
+ * @static
+ * @brief  Parse the command line
+ *
+ * @param [in]  argc Number of arguments
+ * @param [in]  argv Arguments
+ * @param [out] pCfg Pointer on the evaluation parameters
+ *
+ * @retval 0 Success
+ * @retval 1 Invalid argument
+ */
+static int _parse_(int argc, char *argv[], struct eval_cfg_s *pCfg)
+{
+	int c;
+	int ret = 0;
+	uint32_t u32Len = pCfg->u8Len;
+	while ( (c = getopt(argc, argv, "n:p:d:l:r:s:aj:w:")) != -1 )
+	{
+		switch (c)
+		{
+			case 'n': ret |= _parse_num_(optarg, UINT32_MAX, &(pCfg->u32DevNb)); break;
+			case 'p': ret |= _parse_num_(optarg, UINT32_MAX, &(pCfg->u32Period)); break;
+			case 'd': ret |= _parse_num_(optarg, UINT32_MAX, &(pCfg->u32Duration)); break;
+			case 'l': ret |= _parse_num_(optarg, VPHY_BUF_SZ - 1, &u32Len); break;
+			case 'r': ret |= _parse_num_(optarg, UINT32_MAX, &(pCfg->u32Radius)); break;
+			case 's': ret |= _parse_num_(optarg, UINT32_MAX, &(pCfg->u32Seed)); break;
+			case 'a': pCfg->bAligned = 1; break;
+			case 'j': ret |= _parse_num_(optarg, UINT32_MAX, &(pCfg->u32Drift)); break;
+			case 'w': ret |= _parse_num_(optarg, UINT32_MAX, &(pCfg->u32Window)); break;
+			default: return 1;
+		}
+	}
+	if ( ret || (u32Len > UINT8_MAX) )
+	{
+		return 1;
+	}
+	pCfg->u8Len = (uint8_t)u32Len;
+	if ( !(pCfg->u32DevNb) || !(pCfg->u32Period) || !(pCfg->u32Duration) || !(pCfg->u8Len) )
+	{
+		return 1;
+	}
+	// the transmission must stay in its period
+	if ( pCfg->bAligned &&
+		 ( ( (uint64_t)pCfg->u32Window * 1000 + 2 * (uint64_t)pCfg->u32Drift ) >= (uint64_t)pCfg->u32Period * 1000 ) )
+	{
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	struct eval_cfg_s sCfg = {
+		.u32DevNb = 100,
+		.u32Period = 60,
+		.u32Duration = 3600,
+		.u32Radius = 1000,
+		.u32Seed = 1,
+		.u32Drift = 2000,
+		.u32Window = 0,
+		.u8Len = 40,
+		.bAligned = 0,
+	};
+	vmedium_t sMedium;
+	vmedium_cfg_t sMediumCfg;
+	vphy_dev_t **pHeap;
+	vphy_dev_t *pCtx;
+	phydev_t *pPhy;
+	struct slot_ctx_s *pSlot;
+	uint64_t *pNext;
+	uint8_t aFrm[VPHY_BUF_SZ];
+	uint64_t u64Period, u64End, u64T;
+	uint32_t i, u32Min, u32Sent, u32Busy, u32AirTime;
+	float fR, fA;
+	double dG, dS;
+
+	if ( _parse_(argc, argv, &sCfg) )
+	{
+		fprintf(stderr, "Usage : %s [-n devices] [-p period_s] [-d duration_s] [-l length] [-r radius_m] [-s seed] [-a] [-j drift_ms] [-w window_s]\n", argv[0]);
+		return 1;
+	}
+	srand(sCfg.u32Seed);
+	sMediumCfg = _sMediumCfg_;
+	sMediumCfg.u32Seed = sCfg.u32Seed;
+
+	// device 0 is the gateway
+	pHeap = calloc(sCfg.u32DevNb + 1, sizeof(vphy_dev_t*));
+	pCtx = calloc(sCfg.u32DevNb + 1, sizeof(vphy_dev_t));
+	pPhy = calloc(sCfg.u32DevNb + 1, sizeof(phydev_t));
+	pNext = calloc(sCfg.u32DevNb + 1, sizeof(uint64_t));
+	pSlot = calloc(sCfg.u32DevNb + 1, sizeof(struct slot_ctx_s));
+	if ( !pHeap || !pCtx || !pPhy || !pNext || !pSlot )
+	{
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	VMedium_Init(&sMedium, &sMediumCfg, pHeap, sCfg.u32DevNb + 1);
+
+	Phy_VPhy_setup(&pPhy[0], &pCtx[0], &sMedium, 0.0f, 0.0f);
+	pPhy[0].pIf->pfInit(&pPhy[0]);
+	pPhy[0].pfEvtCb = _gw_evt_cb_;
+	pPhy[0].pCbParam = &pPhy[0];
+	pPhy[0].pIf->pfRx(&pPhy[0], PHY_CH120, PHY_WM2400);
+
+	u64Period = (uint64_t)sCfg.u32Period * 1000000;
+	for (i = 1; i <= sCfg.u32DevNb; i++)
+	{
+		// uniform in the disc
+		fR = (float)sCfg.u32Radius * sqrtf( (float)rand() / (float)RAND_MAX );
+		fA = 6.2831853f * (float)rand() / (float)RAND_MAX;
+		Phy_VPhy_setup(&pPhy[i], &pCtx[i], &sMedium, fR * cosf(fA), fR * sinf(fA));
+		pPhy[i].pIf->pfInit(&pPhy[i]);
+		if (sCfg.bAligned)
+		{
+			_slot_setup_(&pSlot[i], &sCfg, i);
+			pNext[i] = _aligned_next_(&pSlot[i], &sCfg, 0);
+		}
+		else
+		{
+			pNext[i] = ( (uint64_t)rand() * u64Period ) / ((uint64_t)RAND_MAX + 1);
+		}
+	}
+	memset(aFrm, 0xA5, sizeof(aFrm));
+
+	u32Sent = 0;
+	u32Busy = 0;
+	u64End = (uint64_t)sCfg.u32Duration * 1000000;
+	while (1)
+	{
+		// next device to transmit
+		u32Min = 1;
+		for (i = 2; i <= sCfg.u32DevNb; i++)
+		{
+			if (pNext[i] < pNext[u32Min])
+			{
+				u32Min = i;
+			}
+		}
+		u64T = pNext[u32Min];
+		if (u64T >= u64End)
+		{
+			break;
+		}
+		VMedium_Run(&sMedium, u64T);
+		pPhy[u32Min].pIf->pfSetSend(&pPhy[u32Min], aFrm, sCfg.u8Len);
+		if ( pPhy[u32Min].pIf->pfTx(&pPhy[u32Min], PHY_CH120, PHY_WM2400) == PHY_STATUS_OK )
+		{
+			u32Sent++;
+		}
+		else
+		{
+			u32Busy++;
+		}
+		if (sCfg.bAligned)
+		{
+			pNext[u32Min] = _aligned_next_(&pSlot[u32Min], &sCfg, (u64T / u64Period + 1) * u64Period);
+		}
+		else
+		{
+			pNext[u32Min] += u64Period;
+		}
+	}
+	VMedium_Run(&sMedium, UINT64_MAX);
+
+	u32AirTime = VMedium_AirTime(PHY_WM2400, sCfg.u8Len, 0);
+	dG = (double)sCfg.u32DevNb * u32AirTime / (double)u64Period;
+	dS = (double)_u32GwRecv_ * u32AirTime / (double)u64End;
+
+	printf("devices          : %u\n", sCfg.u32DevNb);
+	if (sCfg.bAligned)
+	{
+		printf("drift (ms)       : +/-%u\n", sCfg.u32Drift);
+		printf("slot window (s)  : %u\n", sCfg.u32Window);
+	}
+	printf("airtime (us)     : %u\n", u32AirTime);
+	printf("offered load G   : %.4f\n", dG);
+	printf("sent             : %u\n", u32Sent);
+	printf("busy (not sent)  : %u\n", u32Busy);
+	printf("gw received      : %u\n", _u32GwRecv_);
+	printf("gw collisions    : %u\n", sMedium.sStats.u32RxCollisions);
+	printf("below sensitivity: %u\n", sMedium.sStats.u32RxBelowSens);
+	printf("success ratio    : %.4f\n", (u32Sent)?((double)_u32GwRecv_ / u32Sent):(0.0));
+	printf("throughput S     : %.4f (pure ALOHA : %.4f)\n", dS, dG * exp(-2.0 * dG));
+
+	free(pHeap);
+	free(pCtx);
+	free(pPhy);
+	free(pNext);
+	free(pSlot);
+	return 0;
+}
@@ -0,0 +1,191 @@
+/**
+  * @file phy_virtual.h
+  * @brief This file define the virtual radio medium and its phy device
+  *
+  * @details The virtual medium is a discrete event simulator, running in one
+  * host process, that connect any number of virtual phy devices. It model :
+  * - the channels (PHY_CH100 to PHY_CH150) and the modulations airtime
+  *   (WM2400, WM4800, WM6400),
+  * - a log-distance path-loss RSSI and a reception sensitivity,
+  * - the collisions (with capture effect),
+  * - a configurable bit and byte error injection.
+  *
+  * RSSI and noise given by the phy ioctl follow the phy_itf.h units : the
+  * RSSI is the L7 one (see PHY_RSSI_PER_DB, higher is stronger), the noise is
+  * the opposite of the dBm value (e.g. 110 for -110 dBm). The sync word
+  * detection time (PHY_CTL_GET_SYNC_TIME) is the simulated time.
+  *
+  * Events (RX_STARTED, RX_COMPLETE, TX_COMPLETE) are given to the upper layer
+  * at their simulated time, from VMedium_Run. The medium is not thread safe :
+  * VMedium_Run and the phy interface functions must be called from the same
+  * thread.
+  *
+  * As the phy_if_t ioctl argument is an uint32_t, the host build must be a
+  * 32 bits one. It is built (with the unit-tests and the vmedium_eval
+  * measurement tool) by the native environment, which compile with -m32 (see
+  * BUILD_PHYVIRTUAL and ENABLE_NATIVE_UNITTEST options).
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+/*!
+ * @addtogroup phy_virtual
+ * @ingroup device
+ * @{
+ */
+
+#ifndef _PHY_VIRTUAL_H_
+#define _PHY_VIRTUAL_H_
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "phy_itf.h"
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+#define VPHY_BUF_SZ 256
+
+/*!
+ * @}
+ * @endcond
+ */
+
+/*!
+ * @brief This enum defines the virtual phy device state.
+ */
+typedef enum
+{
+	VPHY_STATE_SLEEP = 0x00, /*!< Not initialized or sleeping */
+	VPHY_STATE_IDLE  = 0x01, /*!< Ready */
+	VPHY_STATE_TX    = 0x10, /*!< Transmitting */
+	VPHY_STATE_RX    = 0x20, /*!< Listening (or receiving) */
+} vphy_state_e;
+
+/*!
+ * @brief This enum defines the virtual phy device pending event.
+ */
+typedef enum
+{
+	VPHY_EVT_NONE    = 0x00, /*!< No pending event */
+	VPHY_EVT_TX_END  = 0x01, /*!< End of the transmitted frame */
+	VPHY_EVT_RX_SYNC = 0x02, /*!< Preamble and synchro of the locked frame received */
+} vphy_evt_e;
+
+/*!
+ * @brief This struct defines the virtual medium configuration
+ */
+typedef struct vmedium_cfg_s
+{
+	float fTxPowerMax;     /*!< TX power at PHY_PMAX_minus_0db (dBm) */
+	float fSensitivity;    /*!< Minimum RSSI to detect a frame (dBm) */
+	float fNoiseFloor;     /*!< Noise level on a free channel (dBm) */
+	float fPathLoss0;      /*!< Path loss at 1 meter (dB) */
+	float fPathLossExp;    /*!< Path loss exponent */
+	float fCaptureDb;      /*!< Minimum RSSI difference to survive a collision (dB) */
+	uint32_t u32BitErrPpm;  /*!< Bit error rate (per million bits) */
+	uint32_t u32ByteErrPpm; /*!< Byte error rate (per million bytes), the whole byte is replaced */
+	uint32_t u32Seed;       /*!< Seed of the error injection random generator */
+} vmedium_cfg_t;
+
+/*!
+ * @brief This struct defines the virtual medium statistics
+ */
+typedef struct vmedium_stats_s
+{
+	uint32_t u32TxFrames;         /*!< Number of transmitted frames */
+	uint32_t u32TxAborted;        /*!< Number of aborted transmissions */
+	uint32_t u32RxFrames;         /*!< Number of frames delivered to a receiver */
+	uint32_t u32RxErrFrames;      /*!< Number of delivered frames with injected errors */
+	uint32_t u32RxCollisions;     /*!< Number of frames lost by a receiver due to a collision */
+	uint32_t u32RxBelowSens;      /*!< Number of frames not detected by a listener (RSSI below sensitivity) */
+	uint64_t aAirTime[PHY_NB_CH]; /*!< Cumulated airtime per channel (us) */
+} vmedium_stats_t;
+
+/*!
+ * @brief The virtual phy device type
+ */
+typedef struct vphy_dev_s vphy_dev_t;
+
+/*!
+ * @brief This struct defines the virtual medium
+ */
+typedef struct vmedium_s
+{
+	vmedium_cfg_t sCfg;              /*!< Configuration */
+	vmedium_stats_t sStats;          /*!< Statistics */
+	uint64_t u64Now;                 /*!< Current simulated time (us) */
+	vphy_dev_t **pHeap;              /*!< Pending events (min-heap on time) */
+	uint32_t u32HeapNb;              /*!< Number of pending events */
+	uint32_t u32HeapMax;             /*!< Heap capacity (one per device) */
+	uint32_t u32DevNb;               /*!< Number of attached devices */
+	uint32_t u32Rand;                /*!< Random generator state */
+	vphy_dev_t *aListen[PHY_NB_CH];  /*!< Listening devices, per channel */
+	vphy_dev_t *aOnAir[PHY_NB_CH];   /*!< Transmitting devices, per channel */
+} vmedium_t;
+
+/*!
+ * @brief This struct defines the virtual phy device context
+ */
+struct vphy_dev_s
+{
+	vmedium_t *pMedium;     /*!< Medium the device is attached to */
+	phydev_t *pPhydev;      /*!< Phy device that use this context */
+	float fX;               /*!< X position (meter) */
+	float fY;               /*!< Y position (meter) */
+
+	uint64_t u64EvtTime;    /*!< Time of the pending event */
+	int32_t i32HeapIdx;     /*!< Index of the pending event in the heap (-1 if none) */
+	uint8_t eEvt;           /*!< Pending event (see vphy_evt_e) */
+	uint8_t eState;         /*!< Current state (see vphy_state_e) */
+	uint8_t bCorrupt;       /*!< The locked frame has been corrupted */
+	uint8_t u8TxLen;        /*!< Length of the frame to send */
+	uint8_t u8RxLen;        /*!< Length of the received frame */
+	float fRxRssi;          /*!< RSSI of the locked (or received) frame (dBm) */
+	float fTxPower;         /*!< TX power of the current transmission (dBm) */
+
+	vphy_dev_t *pNext;      /*!< Next device in the channel list (listen or on air) */
+	vphy_dev_t *pPrev;      /*!< Previous device in the channel list */
+	vphy_dev_t *pRxFrom;    /*!< Transmitting device the receiver is locked on */
+	vphy_dev_t *pRxNext;    /*!< Next receiver locked on the same transmission */
+	vphy_dev_t *pRxHead;    /*!< First receiver locked on this transmission */
+
+	uint8_t aTxBuf[VPHY_BUF_SZ]; /*!< Frame to send */
+	uint8_t aRxBuf[VPHY_BUF_SZ]; /*!< Received frame */
+};
+
+int32_t VMedium_Init(vmedium_t *pMedium, const vmedium_cfg_t *pCfg, vphy_dev_t **pHeap, uint32_t u32HeapMax);
+uint32_t VMedium_Run(vmedium_t *pMedium, uint64_t u64Until);
+uint64_t VMedium_NextEvt(vmedium_t *pMedium);
+uint32_t VMedium_AirTime(phy_mod_e eModulation, uint8_t u8Len, uint8_t bCrcOn);
+
+int32_t Phy_VPhy_setup(phydev_t *pPhydev, vphy_dev_t *pCtx, vmedium_t *pMedium, float fX, float fY);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _PHY_VIRTUAL_H_ */
+
+/*! @} */
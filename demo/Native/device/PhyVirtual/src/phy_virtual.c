@@ -0,0 +1,1107 @@
+/**
+  * @file phy_virtual.c
+  * @brief This file implement the virtual radio medium and its phy device
+  *
+  * @details
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+/*!
+ * @addtogroup phy_virtual
+ * @ingroup device
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+#include <math.h>
+
+#include "phy_virtual.h"
+#include "wize_utils.h"
+
+/*!
+ * @brief This convenient table hold the preamble plus synchro length (in bits)
+ */
+static const uint16_t _aSyncBits_[PHY_NB_MOD] = {
+	[PHY_WM2400] = PHY_WM2400_PREAMBLE_SIZE + PHY_WM2400_SYNC_WORD_SIZE,
+	[PHY_WM4800] = PHY_WM4800_PREAMBLE_SIZE + PHY_WM4800_SYNC_WORD_SIZE,
+	[PHY_WM6400] = PHY_WM6400_PREAMBLE_SIZE + PHY_WM6400_SYNC_WORD_SIZE,
+};
+
+/*!
+ * @brief This convenient table hold the bit rate (in bits per second)
+ */
+static const uint16_t _aBitRate_[PHY_NB_MOD] = {
+	[PHY_WM2400] = PHY_WM2400_BIT_RATE,
+	[PHY_WM4800] = PHY_WM4800_BIT_RATE,
+	[PHY_WM6400] = PHY_WM6400_BIT_RATE,
+};
+
+/*!
+ * @brief This convenient table hold the human error representation
+ */
+static const char * const _vphy_error_msgs_[] =
+{
+	[PHY_STATUS_OK]    = "VPhy ERR_NONE",
+	[PHY_STATUS_ERROR] = "VPhy FAILURE",
+	[PHY_STATUS_BUSY]  = "VPhy BUSY",
+};
+
+// Private function (mapped to interface)
+static int32_t _init(phydev_t *pPhydev);
+static int32_t _uninit(phydev_t *pPhydev);
+
+static int32_t _do_TX(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation);
+static int32_t _do_RX(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation);
+static int32_t _do_CCA(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation);
+
+static int32_t _set_send(phydev_t *pPhydev, uint8_t *pBuf, uint8_t u8Len);
+static int32_t _get_recv(phydev_t *pPhydev, uint8_t *pBuf, uint8_t *u8Len);
+
+static int32_t _ioctl(phydev_t *pPhydev, uint32_t eCtl, uint32_t args);
+
+/*!
+ * @brief This structure hold the Phy device interface
+ */
+static const phy_if_t _phy_if = {
+	.pfInit          = _init,
+	.pfUnInit        = _uninit,
+
+	.pfTx            = _do_TX,
+	.pfRx            = _do_RX,
+	.pfNoise         = _do_CCA,
+
+	.pfSetSend       = _set_send,
+	.pfGetRecv       = _get_recv,
+
+	.pfIoctl         = _ioctl
+};
+
+// Internal private function
+static void _heap_swap_(vmedium_t *pMedium, uint32_t i, uint32_t j);
+static void _heap_up_(vmedium_t *pMedium, uint32_t i);
+static void _heap_down_(vmedium_t *pMedium, uint32_t i);
+static void _evt_set_(vphy_dev_t *pDev, uint8_t eEvt, uint64_t u64Time);
+static void _evt_clr_(vphy_dev_t *pDev);
+
+static void _list_add_(vphy_dev_t **ppHead, vphy_dev_t *pDev);
+static void _list_del_(vphy_dev_t **ppHead, vphy_dev_t *pDev);
+
+static uint32_t _rand_(vmedium_t *pMedium);
+static float _rssi_(vphy_dev_t *pTx, vphy_dev_t *pRx);
+static uint8_t _dbm_to_noise_(float fDbm);
+static uint8_t _dbm_to_rssi_(float fDbm);
+
+static void _abort_(vphy_dev_t *pDev);
+static void _rx_on_new_tx_(vphy_dev_t *pRx, vphy_dev_t *pTx);
+static void _tx_end_(vphy_dev_t *pTx);
+static uint8_t _deliver_(vphy_dev_t *pRx, vphy_dev_t *pTx);
+static void _notify_(vphy_dev_t *pDev, uint32_t eEvt);
+
+/******************************************************************************/
+// Medium public function
+
+/*!
+ * @brief  This function initialize the virtual medium
+ *
+ * @param [in] pMedium    Pointer on the medium
+ * @param [in] pCfg       Pointer on the medium configuration
+ * @param [in] pHeap      Pointer on the pending events storage
+ * @param [in] u32HeapMax Pending events storage size (at least the number of
+ *                        devices to attach)
+ *
+ * @retval PHY_STATUS_OK (see @link phy_status_e::PHY_STATUS_OK @endlink)
+ * @retval PHY_STATUS_ERROR (see @link phy_status_e::PHY_STATUS_ERROR @endlink)
+ */
+int32_t VMedium_Init(vmedium_t *pMedium, const vmedium_cfg_t *pCfg, vphy_dev_t **pHeap, uint32_t u32HeapMax)
+{
+	int32_t i32Ret = PHY_STATUS_ERROR;
+	if (pMedium && pCfg && pHeap && u32HeapMax)
+	{
+		memset(pMedium, 0, sizeof(vmedium_t));
+		memcpy(&(pMedium->sCfg), pCfg, sizeof(vmedium_cfg_t));
+		pMedium->pHeap = pHeap;
+		pMedium->u32HeapMax = u32HeapMax;
+		// xorshift doesn't support a null state
+		pMedium->u32Rand = (pCfg->u32Seed)?(pCfg->u32Seed):(0x2545F491);
+		i32Ret = PHY_STATUS_OK;
+	}
+	return i32Ret;
+}
+
+/*!
+ * @brief  This function run the simulation until the given time
+ *
+ * @details Pending events are treated in time order, and notified to the
+ * upper layer (through the phy device call-back) at their simulated time.
+ * Call-backs may call the phy interface functions, events they create are
+ * treated in the same run if they occur before the given time.
+ *
+ * @param [in] pMedium  Pointer on the medium
+ * @param [in] u64Until Time until which to run (us). The current time is set to
+ *                      this value if it is not UINT64_MAX.
+ *
+ * @return The number of treated events
+ */
+uint32_t VMedium_Run(vmedium_t *pMedium, uint64_t u64Until)
+{
+	uint32_t u32Nb = 0;
+	vphy_dev_t *pDev;
+	uint8_t eEvt;
+
+	while ( pMedium->u32HeapNb && (pMedium->pHeap[0]->u64EvtTime <= u64Until) )
+	{
+		pDev = pMedium->pHeap[0];
+		pMedium->u64Now = pDev->u64EvtTime;
+		eEvt = pDev->eEvt;
+		_evt_clr_(pDev);
+		u32Nb++;
+
+		switch (eEvt)
+		{
+			case VPHY_EVT_TX_END:
+				_tx_end_(pDev);
+				break;
+			case VPHY_EVT_RX_SYNC:
+				// Time stamp with the simulated time
+				pDev->pPhydev->sSyncTime.u32Sec = (uint32_t)(pMedium->u64Now / 1000000);
+				pDev->pPhydev->sSyncTime.u32USec = (uint32_t)(pMedium->u64Now % 1000000);
+				if (pDev->pPhydev->bPreSyncOn)
+				{
+					_notify_(pDev, PHYDEV_EVT_RX_STARTED);
+				}
+				break;
+			default:
+				break;
+		}
+	}
+	if ( (u64Until != UINT64_MAX) && (u64Until > pMedium->u64Now) )
+	{
+		pMedium->u64Now = u64Until;
+	}
+	return u32Nb;
+}
+
+/*!
+ * @brief  This function give the time of the next pending event
+ *
+ * @param [in] pMedium Pointer on the medium
+ *
+ * @return The time of the next event (us), UINT64_MAX if none
+ */
+uint64_t VMedium_NextEvt(vmedium_t *pMedium)
+{
+	if (pMedium->u32HeapNb)
+	{
+		return pMedium->pHeap[0]->u64EvtTime;
+	}
+	return UINT64_MAX;
+}
+
+/*!
+ * @brief  This function compute the airtime of a frame
+ *
+ * @param [in] eModulation Modulation
+ * @param [in] u8Len       Frame length, without the L-field (as given to
+ *                         phy_if_t::pfSetSend)
+ * @param [in] bCrcOn      The PHY add the CRC
+ *
+ * @return The airtime (us)
+ */
+uint32_t VMedium_AirTime(phy_mod_e eModulation, uint8_t u8Len, uint8_t bCrcOn)
+{
+	uint32_t u32Bits;
+	if (eModulation >= PHY_NB_MOD)
+	{
+		eModulation = PHY_WM2400;
+	}
+	u32Bits = _aSyncBits_[eModulation] + ( (uint32_t)u8Len + 1 + ((bCrcOn)?(2):(0)) ) * 8;
+	return (uint32_t)( ((uint64_t)u32Bits * 1000000 + _aBitRate_[eModulation] - 1) / _aBitRate_[eModulation] );
+}
+
+/*!
+ * @brief  This function prepare the Phy device and attach it to the medium
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [in]  pCtx    Pointer on the Phy device context
+ * @param [in]  pMedium Pointer on the medium
+ * @param [in]  fX      X position (meter)
+ * @param [in]  fY      Y position (meter)
+ *
+ * @retval PHY_STATUS_OK (see @link phy_status_e::PHY_STATUS_OK @endlink)
+ * @retval PHY_STATUS_ERROR (see @link phy_status_e::PHY_STATUS_ERROR @endlink)
+ */
+int32_t Phy_VPhy_setup(phydev_t *pPhydev, vphy_dev_t *pCtx, vmedium_t *pMedium, float fX, float fY)
+{
+	int32_t i32Ret = PHY_STATUS_ERROR;
+	if (pPhydev && pCtx && pMedium)
+	{
+		if (pMedium->u32DevNb < pMedium->u32HeapMax)
+		{
+			memset(pCtx, 0, sizeof(vphy_dev_t));
+			pCtx->pMedium = pMedium;
+			pCtx->pPhydev = pPhydev;
+			pCtx->fX = fX;
+			pCtx->fY = fY;
+			pCtx->i32HeapIdx = -1;
+			pCtx->eState = VPHY_STATE_SLEEP;
+			pMedium->u32DevNb++;
+
+			pPhydev->pIf = &_phy_if;
+			pPhydev->pCxt = pCtx;
+			i32Ret = PHY_STATUS_OK;
+		}
+	}
+	return i32Ret;
+}
+
+/******************************************************************************/
+// Phy interface
+
+/*!
+ * @static
+ * @brief  This function initialize the Phy device
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @retval PHY_STATUS_OK (see @link phy_status_e::PHY_STATUS_OK @endlink)
+ * @retval PHY_STATUS_ERROR (see @link phy_status_e::PHY_STATUS_ERROR @endlink)
+ */
+static int32_t _init(phydev_t *pPhydev)
+{
+	int32_t i32Ret = PHY_STATUS_ERROR;
+	vphy_dev_t *pDev;
+	if (pPhydev && pPhydev->pCxt)
+	{
+		pDev = pPhydev->pCxt;
+		_abort_(pDev);
+		// set default parameters
+		pPhydev->i16TxFreqOffset = DEFAULT_TX_FREQ_OFFSET;
+		pPhydev->eModulation = DEFAULT_MOD;
+		pPhydev->eTxPower = DEFAULT_TX_POWER;
+		pPhydev->eChannel = DEFAULT_CH;
+		pPhydev->pfEvtCb = NULL;
+		pPhydev->pCbParam = NULL;
+		pPhydev->bPreSyncOn = 0;
+		pPhydev->bCrcOn = 0;
+		pPhydev->eTestMode = PHY_TST_MODE_NONE;
+
+		pDev->u8TxLen = 0;
+		pDev->u8RxLen = 0;
+		pDev->eState = VPHY_STATE_IDLE;
+		i32Ret = PHY_STATUS_OK;
+	}
+	return i32Ret;
+}
+
+/*!
+ * @static
+ * @brief  This function un-initialize the Phy device
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @retval PHY_STATUS_OK (see @link phy_status_e::PHY_STATUS_OK @endlink)
+ * @retval PHY_STATUS_ERROR (see @link phy_status_e::PHY_STATUS_ERROR @endlink)
+ */
+static int32_t _uninit(phydev_t *pPhydev)
+{
+	int32_t i32Ret = PHY_STATUS_ERROR;
+	vphy_dev_t *pDev;
+	if (pPhydev && pPhydev->pCxt)
+	{
+		pDev = pPhydev->pCxt;
+		_abort_(pDev);
+		pDev->eState = VPHY_STATE_SLEEP;
+		i32Ret = PHY_STATUS_OK;
+	}
+	return i32Ret;
+}
+
+/*!
+ * @static
+ * @brief  This function start a transmission on the medium
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eChannel    Channel use to TX
+ * @param [in]  eModulation Modulation use to TX
+ *
+ * @retval PHY_STATUS_OK (see @link phy_status_e::PHY_STATUS_OK @endlink)
+ * @retval PHY_STATUS_ERROR (see @link phy_status_e::PHY_STATUS_ERROR @endlink)
+ * @retval PHY_STATUS_BUSY (see @link phy_status_e::PHY_STATUS_BUSY @endlink)
+ */
+static int32_t _do_TX(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
+{
+	vphy_dev_t *pDev = pPhydev->pCxt;
+	vmedium_t *pMedium;
+	vphy_dev_t *pRx;
+	vphy_dev_t *pNext;
+	uint32_t u32AirTime;
+
+	if ( !pDev || (pDev->eState == VPHY_STATE_SLEEP) || !(pDev->u8TxLen) ||
+		 (eChannel >= PHY_NB_CH) || (eModulation >= PHY_NB_MOD) )
+	{
+		return PHY_STATUS_ERROR;
+	}
+	if (pDev->eState == VPHY_STATE_TX)
+	{
+		return PHY_STATUS_BUSY;
+	}
+	pMedium = pDev->pMedium;
+	_abort_(pDev);
+
+	pPhydev->eChannel = eChannel;
+	pPhydev->eModulation = eModulation;
+	pDev->fTxPower = pMedium->sCfg.fTxPowerMax - 6.0f * (float)(pPhydev->eTxPower);
+	pDev->eState = VPHY_STATE_TX;
+	pDev->pRxHead = NULL;
+
+	u32AirTime = VMedium_AirTime(eModulation, pDev->u8TxLen, pPhydev->bCrcOn);
+	pMedium->sStats.u32TxFrames++;
+	pMedium->sStats.aAirTime[eChannel] += u32AirTime;
+
+	// Listeners on this channel see the new frame
+	for (pRx = pMedium->aListen[eChannel]; pRx; pRx = pNext)
+	{
+		pNext = pRx->pNext;
+		_rx_on_new_tx_(pRx, pDev);
+	}
+	_list_add_(&(pMedium->aOnAir[eChannel]), pDev);
+	_evt_set_(pDev, VPHY_EVT_TX_END, pMedium->u64Now + u32AirTime);
+	return PHY_STATUS_OK;
+}
+
+/*!
+ * @static
+ * @brief  This function start to listen on the medium
+ *
+ * @details As a real PHY, frames that have started before are not detected.
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eChannel    Channel use to RX
+ * @param [in]  eModulation Modulation use to RX
+ *
+ * @retval PHY_STATUS_OK (see @link phy_status_e::PHY_STATUS_OK @endlink)
+ * @retval PHY_STATUS_ERROR (see @link phy_status_e::PHY_STATUS_ERROR @endlink)
+ * @retval PHY_STATUS_BUSY (see @link phy_status_e::PHY_STATUS_BUSY @endlink)
+ */
+static int32_t _do_RX(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
+{
+	vphy_dev_t *pDev = pPhydev->pCxt;
+
+	if ( !pDev || (pDev->eState == VPHY_STATE_SLEEP) ||
+		 (eChannel >= PHY_NB_CH) || (eModulation >= PHY_NB_MOD) )
+	{
+		return PHY_STATUS_ERROR;
+	}
+	if (pDev->eState == VPHY_STATE_TX)
+	{
+		return PHY_STATUS_BUSY;
+	}
+	_abort_(pDev);
+
+	pPhydev->eChannel = eChannel;
+	pPhydev->eModulation = eModulation;
+	pDev->eState = VPHY_STATE_RX;
+	_list_add_(&(pDev->pMedium->aListen[eChannel]), pDev);
+	return PHY_STATUS_OK;
+}
+
+/*!
+ * @static
+ * @brief  This function measure the noise on the given channel
+ *
+ * @details The noise is the strongest on air frame level, or the medium noise
+ * floor if the channel is free. It is get back with PHY_CTL_GET_NOISE.
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eChannel    Channel on which the Noise must be measured
+ * @param [in]  eModulation Modulation on which the Noise must be measured
+ *
+ * @retval PHY_STATUS_OK (see @link phy_status_e::PHY_STATUS_OK @endlink)
+ * @retval PHY_STATUS_ERROR (see @link phy_status_e::PHY_STATUS_ERROR @endlink)
+ */
+static int32_t _do_CCA(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
+{
+	vphy_dev_t *pDev = pPhydev->pCxt;
+	vphy_dev_t *pTx;
+	float fLevel;
+	float fRssi;
+	(void)eModulation;
+
+	if ( !pDev || (eChannel >= PHY_NB_CH) )
+	{
+		return PHY_STATUS_ERROR;
+	}
+	fLevel = pDev->pMedium->sCfg.fNoiseFloor;
+	for (pTx = pDev->pMedium->aOnAir[eChannel]; pTx; pTx = pTx->pNext)
+	{
+		if (pTx != pDev)
+		{
+			fRssi = _rssi_(pTx, pDev);
+			if (fRssi > fLevel)
+			{
+				fLevel = fRssi;
+			}
+		}
+	}
+	pPhydev->u16_Noise = _dbm_to_noise_(fLevel);
+	return PHY_STATUS_OK;
+}
+
+/*!
+ * @static
+ * @brief  This function set the packet to send
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [in]  pBuf    Pointer to get data to send
+ * @param [in]  u8Len   Reference on the data length to send
+ *
+ * @retval PHY_STATUS_OK (see @link phy_status_e::PHY_STATUS_OK @endlink)
+ * @retval PHY_STATUS_ERROR (see @link phy_status_e::PHY_STATUS_ERROR @endlink)
+ * @retval PHY_STATUS_BUSY (see @link phy_status_e::PHY_STATUS_BUSY @endlink)
+ */
+static int32_t _set_send(phydev_t *pPhydev, uint8_t *pBuf, uint8_t u8Len)
+{
+	vphy_dev_t *pDev = pPhydev->pCxt;
+	if ( !pBuf || !u8Len || !pDev )
+	{
+		return PHY_STATUS_ERROR;
+	}
+	if (pDev->eState == VPHY_STATE_TX)
+	{
+		return PHY_STATUS_BUSY;
+	}
+	memcpy(pDev->aTxBuf, pBuf, u8Len);
+	pDev->u8TxLen = u8Len;
+	return PHY_STATUS_OK;
+}
+
+/*!
+ * @static
+ * @brief  This function get the received packet
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [in]  pBuf    Pointer on buffer to get received data
+ * @param [in]  u8Len   Reference on received number of bytes
+ *
+ * @retval PHY_STATUS_OK (see @link phy_status_e::PHY_STATUS_OK @endlink)
+ * @retval PHY_STATUS_ERROR (see @link phy_status_e::PHY_STATUS_ERROR @endlink)
+ */
+static int32_t _get_recv(phydev_t *pPhydev, uint8_t *pBuf, uint8_t *u8Len)
+{
+	vphy_dev_t *pDev = pPhydev->pCxt;
+	if ( !pBuf || !u8Len || !pDev || !(pDev->u8RxLen) )
+	{
+		return PHY_STATUS_ERROR;
+	}
+	memcpy(pBuf, pDev->aRxBuf, pDev->u8RxLen);
+	*u8Len = pDev->u8RxLen;
+	return PHY_STATUS_OK;
+}
+
+/*!
+ * @static
+ * @brief  This function Get/Set internal configuration variable
+ *
+ * @param [in]      pPhydev Pointer on the Phy device instance
+ * @param [in]      eCtl    Id of configuration variable to get/set (see phy_ctl_e)
+ * @param [in, out] args    scalar or pointer that hold the value to set/get
+ *
+ * @retval PHY_STATUS_OK (see @link phy_status_e::PHY_STATUS_OK @endlink)
+ * @retval PHY_STATUS_ERROR (see @link phy_status_e::PHY_STATUS_ERROR @endlink)
+ */
+static int32_t _ioctl(phydev_t *pPhydev, uint32_t eCtl, uint32_t args)
+{
+	int32_t i32Ret = PHY_STATUS_OK;
+	vphy_dev_t *pDev = pPhydev->pCxt;
+	if (!pDev)
+	{
+		return PHY_STATUS_ERROR;
+	}
+	if (eCtl > PHY_CTL_CMD)
+	{
+		switch (eCtl)
+		{
+			case PHY_CTL_CMD_PWR_OFF:
+			case PHY_CTL_CMD_RESET:
+				_abort_(pDev);
+				pPhydev->bCrcOn = 0;
+				pPhydev->bPreSyncOn = 0;
+				pPhydev->eTestMode = PHY_TST_MODE_NONE;
+				pDev->eState = (eCtl == PHY_CTL_CMD_PWR_OFF)?(VPHY_STATE_SLEEP):(VPHY_STATE_IDLE);
+				break;
+			case PHY_CTL_CMD_PWR_ON:
+			case PHY_CTL_CMD_READY:
+			case PHY_CTL_CMD_SLEEP:
+				// configuration is kept while sleeping
+				_abort_(pDev);
+				pDev->eState = (eCtl == PHY_CTL_CMD_SLEEP)?(VPHY_STATE_SLEEP):(VPHY_STATE_IDLE);
+				break;
+			default:
+				i32Ret = PHY_STATUS_ERROR;
+				break;
+		}
+		return i32Ret;
+	}
+
+	switch (eCtl)
+	{
+		case PHY_CTL_SET_TX_FREQ_OFF:
+			pPhydev->i16TxFreqOffset = (int16_t)args;
+			break;
+		case PHY_CTL_SET_TX_POWER:
+			if ( (phy_power_e)args >= PHY_NB_PWR )
+			{
+				i32Ret = PHY_STATUS_ERROR;
+				break;
+			}
+			pPhydev->eTxPower = (phy_power_e)args;
+			break;
+		case PHY_CTL_SET_MULTI:
+			if ( ((phy_cfg_set_t*)args)->u8Mask & PHY_CFG_TX_FREQ_OFF )
+			{
+				pPhydev->i16TxFreqOffset = ((phy_cfg_set_t*)args)->i16TxFreqOffset;
+			}
+			if ( ((phy_cfg_set_t*)args)->u8Mask & PHY_CFG_TX_POWER )
+			{
+				pPhydev->eTxPower = ((phy_cfg_set_t*)args)->eTxPower;
+			}
+			((phy_cfg_set_t*)args)->u8Mask = 0;
+			break;
+		case PHY_CTL_SET_PA:
+			break;
+		case PHY_CTL_GET_TX_FREQ_OFF:
+			*(int16_t*)args = pPhydev->i16TxFreqOffset;
+			break;
+		case PHY_CTL_GET_TX_POWER:
+			*(uint8_t*)args = pPhydev->eTxPower;
+			break;
+		case PHY_CTL_GET_PA:
+			*(uint8_t*)args = 0;
+			break;
+		case PHY_CTL_GET_FREQ_ERR:
+			*(float*)args = 0;
+			break;
+		case PHY_CTL_GET_RSSI:
+			*(uint8_t*)args = (uint8_t)pPhydev->u16_Rssi;
+			break;
+		case PHY_CTL_GET_NOISE:
+			*(uint8_t*)args = (uint8_t)pPhydev->u16_Noise;
+			break;
+		case PHY_CTL_GET_ERR:
+			*(uint8_t*)args = PHY_STATUS_OK;
+			break;
+		case PHY_CTL_GET_SYNC_TIME:
+			*(phy_tstamp_t*)args = pPhydev->sSyncTime;
+			break;
+		case PHY_CTL_GET_STR_ERR:
+			*((uint32_t*)args) = (uint32_t)(uintptr_t)(_vphy_error_msgs_[PHY_STATUS_OK]);
+			break;
+		default:
+			i32Ret = PHY_STATUS_ERROR;
+			break;
+	}
+	return i32Ret;
+}
+
+/******************************************************************************/
+// Medium internal
+
+/*!
+ * @static
+ * @brief  This function stop the current device activity (TX or RX)
+ *
+ * @details An aborted transmission is not delivered, its locked receivers
+ * continue to listen.
+ *
+ * @param [in] pDev Pointer on the device
+ *
+ * @return None
+ */
+static void _abort_(vphy_dev_t *pDev)
+{
+	vmedium_t *pMedium = pDev->pMedium;
+	vphy_dev_t *pRx;
+	vphy_dev_t **ppRx;
+	phy_chan_e eChannel = pDev->pPhydev->eChannel;
+
+	if (pDev->eState == VPHY_STATE_TX)
+	{
+		_evt_clr_(pDev);
+		_list_del_(&(pMedium->aOnAir[eChannel]), pDev);
+		for (pRx = pDev->pRxHead; pRx; pRx = pRx->pRxNext)
+		{
+			pRx->pRxFrom = NULL;
+			_evt_clr_(pRx);
+		}
+		pDev->pRxHead = NULL;
+		pMedium->sStats.u32TxAborted++;
+	}
+	else if (pDev->eState == VPHY_STATE_RX)
+	{
+		if (pDev->pRxFrom)
+		{
+			// remove from the transmission receiver list
+			for (ppRx = &(pDev->pRxFrom->pRxHead); *ppRx; ppRx = &((*ppRx)->pRxNext))
+			{
+				if (*ppRx == pDev)
+				{
+					*ppRx = pDev->pRxNext;
+					break;
+				}
+			}
+			pDev->pRxFrom = NULL;
+			_evt_clr_(pDev);
+		}
+		_list_del_(&(pMedium->aListen[eChannel]), pDev);
+	}
+	if (pDev->eState != VPHY_STATE_SLEEP)
+	{
+		pDev->eState = VPHY_STATE_IDLE;
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function treat a new frame for a listening device
+ *
+ * @details An idle listener lock on the frame if its modulation match and its
+ * level is above the sensitivity. A listener already locked on another frame
+ * see it as interference, the locked frame is lost if it doesn't exceed the
+ * interference by the capture threshold.
+ *
+ * @param [in] pRx Pointer on the listening device
+ * @param [in] pTx Pointer on the transmitting device
+ *
+ * @return None
+ */
+static void _rx_on_new_tx_(vphy_dev_t *pRx, vphy_dev_t *pTx)
+{
+	vmedium_t *pMedium = pRx->pMedium;
+	vphy_dev_t *pOther;
+	float fRssi = _rssi_(pTx, pRx);
+
+	if (pRx->pRxFrom)
+	{
+		if ( (pRx->fRxRssi - fRssi) < pMedium->sCfg.fCaptureDb )
+		{
+			pRx->bCorrupt = 1;
+		}
+		return;
+	}
+	if (pRx->pPhydev->eModulation != pTx->pPhydev->eModulation)
+	{
+		return;
+	}
+	if (fRssi < pMedium->sCfg.fSensitivity)
+	{
+		pMedium->sStats.u32RxBelowSens++;
+		return;
+	}
+
+	pRx->pRxFrom = pTx;
+	pRx->fRxRssi = fRssi;
+	pRx->bCorrupt = 0;
+	// frames already on air are interference
+	for (pOther = pMedium->aOnAir[pTx->pPhydev->eChannel]; pOther; pOther = pOther->pNext)
+	{
+		if ( (pOther != pTx) && ( (fRssi - _rssi_(pOther, pRx)) < pMedium->sCfg.fCaptureDb) )
+		{
+			pRx->bCorrupt = 1;
+			break;
+		}
+	}
+	pRx->pRxNext = pTx->pRxHead;
+	pTx->pRxHead = pRx;
+	_evt_set_(pRx, VPHY_EVT_RX_SYNC,
+			pMedium->u64Now +
+			( (uint64_t)_aSyncBits_[pTx->pPhydev->eModulation] * 1000000 ) / _aBitRate_[pTx->pPhydev->eModulation]
+			);
+}
+
+/*!
+ * @static
+ * @brief  This function treat the end of a transmission
+ *
+ * @param [in] pTx Pointer on the transmitting device
+ *
+ * @return None
+ */
+static void _tx_end_(vphy_dev_t *pTx)
+{
+	vmedium_t *pMedium = pTx->pMedium;
+	vphy_dev_t *pRx;
+	vphy_dev_t *pNext;
+
+	_list_del_(&(pMedium->aOnAir[pTx->pPhydev->eChannel]), pTx);
+	pTx->eState = VPHY_STATE_IDLE;
+
+	// detach the receivers first, call-backs may start a new activity
+	pRx = pTx->pRxHead;
+	pTx->pRxHead = NULL;
+	for ( ; pRx; pRx = pNext)
+	{
+		pNext = pRx->pRxNext;
+		pRx->pRxNext = NULL;
+		pRx->pRxFrom = NULL;
+		_evt_clr_(pRx);
+		if (pRx->bCorrupt)
+		{
+			// frame lost, continue to listen
+			pMedium->sStats.u32RxCollisions++;
+			continue;
+		}
+		_list_del_(&(pMedium->aListen[pRx->pPhydev->eChannel]), pRx);
+		pRx->eState = VPHY_STATE_IDLE;
+		if ( _deliver_(pRx, pTx) )
+		{
+			pMedium->sStats.u32RxErrFrames++;
+		}
+		pMedium->sStats.u32RxFrames++;
+		_notify_(pRx, PHYDEV_EVT_RX_COMPLETE);
+	}
+	_notify_(pTx, PHYDEV_EVT_TX_COMPLETE);
+}
+
+/*!
+ * @static
+ * @brief  This function copy the frame to the receiver, with error injection
+ *
+ * @param [in] pRx Pointer on the receiving device
+ * @param [in] pTx Pointer on the transmitting device
+ *
+ * @retval 0 The frame is received without error
+ * @retval 1 Errors have been injected
+ */
+static uint8_t _deliver_(vphy_dev_t *pRx, vphy_dev_t *pTx)
+{
+	vmedium_t *pMedium = pRx->pMedium;
+	uint8_t bErr = 0;
+	uint8_t u8Byte;
+	uint8_t i, b;
+
+	for (i = 0; i < pTx->u8TxLen; i++)
+	{
+		u8Byte = pTx->aTxBuf[i];
+		if ( pMedium->sCfg.u32ByteErrPpm && ( (_rand_(pMedium) % 1000000) < pMedium->sCfg.u32ByteErrPpm) )
+		{
+			u8Byte ^= (uint8_t)( (_rand_(pMedium) % 255) + 1 );
+			bErr = 1;
+		}
+		if (pMedium->sCfg.u32BitErrPpm)
+		{
+			for (b = 0; b < 8; b++)
+			{
+				if ( (_rand_(pMedium) % 1000000) < pMedium->sCfg.u32BitErrPpm )
+				{
+					u8Byte ^= (1 << b);
+					bErr = 1;
+				}
+			}
+		}
+		pRx->aRxBuf[i] = u8Byte;
+	}
+	pRx->u8RxLen = pTx->u8TxLen;
+	pRx->pPhydev->u16_Rssi = _dbm_to_rssi_(pRx->fRxRssi);
+	return bErr;
+}
+
+/*!
+ * @static
+ * @brief  This function notify the upper layer
+ *
+ * @param [in] pDev Pointer on the device
+ * @param [in] eEvt Event to notify (see phydev_evt_e)
+ *
+ * @return None
+ */
+static void _notify_(vphy_dev_t *pDev, uint32_t eEvt)
+{
+	if (pDev->pPhydev->pfEvtCb)
+	{
+		pDev->pPhydev->pfEvtCb(pDev->pPhydev->pCbParam, eEvt);
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function compute the level of a transmission at a receiver
+ *
+ * @param [in] pTx Pointer on the transmitting device
+ * @param [in] pRx Pointer on the receiving device
+ *
+ * @return The RSSI (dBm)
+ */
+static float _rssi_(vphy_dev_t *pTx, vphy_dev_t *pRx)
+{
+	vmedium_t *pMedium = pRx->pMedium;
+	float fDx = pTx->fX - pRx->fX;
+	float fDy = pTx->fY - pRx->fY;
+	float fD = sqrtf(fDx * fDx + fDy * fDy);
+	if (fD < 1.0f)
+	{
+		fD = 1.0f;
+	}
+	return pTx->fTxPower - (pMedium->sCfg.fPathLoss0 + 10.0f * pMedium->sCfg.fPathLossExp * log10f(fD));
+}
+
+/*!
+ * @static
+ * @brief  This function convert a dBm level to the noise unit (as
+ * PHY_CTL_GET_NOISE)
+ *
+ * @param [in] fDbm Level (dBm)
+ *
+ * @return The opposite of the level, saturated on 0..255
+ */
+static uint8_t _dbm_to_noise_(float fDbm)
+{
+	if (fDbm >= 0.0f)
+	{
+		return 0;
+	}
+	if (fDbm <= -255.0f)
+	{
+		return 255;
+	}
+	return (uint8_t)(-fDbm + 0.5f);
+}
+
+/*!
+ * @static
+ * @brief  This function convert a dBm level to the RSSI unit (as
+ * PHY_CTL_GET_RSSI)
+ *
+ * @param [in] fDbm Level (dBm)
+ *
+ * @return The RSSI, saturated on 0..255
+ */
+static uint8_t _dbm_to_rssi_(float fDbm)
+{
+	float fRssi = fDbm * PHY_RSSI_PER_DB + PHY_RSSI_OFFSET;
+	if (fRssi <= 0.0f)
+	{
+		return 0;
+	}
+	if (fRssi >= 255.0f)
+	{
+		return 255;
+	}
+	return (uint8_t)(fRssi + 0.5f);
+}
+
+/*!
+ * @static
+ * @brief  This function give the next random value (xorshift32)
+ *
+ * @param [in] pMedium Pointer on the medium
+ *
+ * @return Random value
+ */
+static uint32_t _rand_(vmedium_t *pMedium)
+{
+	return _xorshift32_(&(pMedium->u32Rand));
+}
+
+/******************************************************************************/
+// Lists and heap
+
+/*!
+ * @static
+ * @brief  This function add a device on head of a channel list
+ *
+ * @param [in] ppHead Pointer on the list head
+ * @param [in] pDev   Pointer on the device
+ *
+ * @return None
+ */
+static void _list_add_(vphy_dev_t **ppHead, vphy_dev_t *pDev)
+{
+	pDev->pPrev = NULL;
+	pDev->pNext = *ppHead;
+	if (*ppHead)
+	{
+		(*ppHead)->pPrev = pDev;
+	}
+	*ppHead = pDev;
+}
+
+/*!
+ * @static
+ * @brief  This function remove a device from a channel list
+ *
+ * @param [in] ppHead Pointer on the list head
+ * @param [in] pDev   Pointer on the device
+ *
+ * @return None
+ */
+static void _list_del_(vphy_dev_t **ppHead, vphy_dev_t *pDev)
+{
+	if (pDev->pPrev)
+	{
+		pDev->pPrev->pNext = pDev->pNext;
+	}
+	else if (*ppHead == pDev)
+	{
+		*ppHead = pDev->pNext;
+	}
+	if (pDev->pNext)
+	{
+		pDev->pNext->pPrev = pDev->pPrev;
+	}
+	pDev->pNext = NULL;
+	pDev->pPrev = NULL;
+}
+
+/*!
+ * @static
+ * @brief  This function set (or replace) the device pending event
+ *
+ * @param [in] pDev    Pointer on the device
+ * @param [in] eEvt    Event
+ * @param [in] u64Time Time of the event (us)
+ *
+ * @return None
+ */
+static void _evt_set_(vphy_dev_t *pDev, uint8_t eEvt, uint64_t u64Time)
+{
+	vmedium_t *pMedium = pDev->pMedium;
+	_evt_clr_(pDev);
+	pDev->eEvt = eEvt;
+	pDev->u64EvtTime = u64Time;
+	pDev->i32HeapIdx = pMedium->u32HeapNb;
+	pMedium->pHeap[pMedium->u32HeapNb++] = pDev;
+	_heap_up_(pMedium, pDev->i32HeapIdx);
+}
+
+/*!
+ * @static
+ * @brief  This function remove the device pending event, if any
+ *
+ * @param [in] pDev Pointer on the device
+ *
+ * @return None
+ */
+static void _evt_clr_(vphy_dev_t *pDev)
+{
+	vmedium_t *pMedium = pDev->pMedium;
+	uint32_t i = (uint32_t)pDev->i32HeapIdx;
+	if (pDev->i32HeapIdx < 0)
+	{
+		return;
+	}
+	pMedium->u32HeapNb--;
+	if (i != pMedium->u32HeapNb)
+	{
+		_heap_swap_(pMedium, i, pMedium->u32HeapNb);
+		_heap_down_(pMedium, i);
+		_heap_up_(pMedium, i);
+	}
+	pDev->i32HeapIdx = -1;
+	pDev->eEvt = VPHY_EVT_NONE;
+}
+
+/*!
+ * @static
+ * @brief  This function swap two heap entries
+ *
+ * @param [in] pMedium Pointer on the medium
+ * @param [in] i       First entry
+ * @param [in] j       Second entry
+ *
+ * @return None
+ */
+static void _heap_swap_(vmedium_t *pMedium, uint32_t i, uint32_t j)
+{
+	vphy_dev_t *pTmp = pMedium->pHeap[i];
+	pMedium->pHeap[i] = pMedium->pHeap[j];
+	pMedium->pHeap[j] = pTmp;
+	pMedium->pHeap[i]->i32HeapIdx = i;
+	pMedium->pHeap[j]->i32HeapIdx = j;
+}
+
+/*!
+ * @static
+ * @brief  This function move up an heap entry
+ *
+ * @param [in] pMedium Pointer on the medium
+ * @param [in] i       Entry
+ *
+ * @return None
+ */
+static void _heap_up_(vmedium_t *pMedium, uint32_t i)
+{
+	uint32_t p;
+	while (i)
+	{
+		p = (i - 1) >> 1;
+		if (pMedium->pHeap[p]->u64EvtTime <= pMedium->pHeap[i]->u64EvtTime)
+		{
+			break;
+		}
+		_heap_swap_(pMedium, i, p);
+		i = p;
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function move down an heap entry
+ *
+ * @param [in] pMedium Pointer on the medium
+ * @param [in] i       Entry
+ *
+ * @return None
+ */
+static void _heap_down_(vmedium_t *pMedium, uint32_t i)
+{
+	uint32_t l, m;
+	while (1)
+	{
+		l = (i << 1) + 1;
+		m = i;
+		if ( (l < pMedium->u32HeapNb) && (pMedium->pHeap[l]->u64EvtTime < pMedium->pHeap[m]->u64EvtTime) )
+		{
+			m = l;
+		}
+		if ( (l + 1 < pMedium->u32HeapNb) && (pMedium->pHeap[l + 1]->u64EvtTime < pMedium->pHeap[m]->u64EvtTime) )
+		{
+			m = l + 1;
+		}
+		if (m == i)
+		{
+			break;
+		}
+		_heap_swap_(pMedium, i, m);
+		i = m;
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
@@ -0,0 +1,14 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(Device_PhyVirtual)
+{
+    RUN_TEST_CASE(Device_PhyVirtual, test_AirTime_Success);
+
+    RUN_TEST_CASE(Device_PhyVirtual, test_Deliver_Success);
+    RUN_TEST_CASE(Device_PhyVirtual, test_Deliver_BelowSensitivity);
+    RUN_TEST_CASE(Device_PhyVirtual, test_Deliver_Collision);
+    RUN_TEST_CASE(Device_PhyVirtual, test_Deliver_Capture);
+    RUN_TEST_CASE(Device_PhyVirtual, test_Deliver_ByteError);
+
+    RUN_TEST_CASE(Device_PhyVirtual, test_Noise_Success);
+}
@@ -0,0 +1,250 @@
+#include "unity_fixture.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+TEST_GROUP(Device_PhyVirtual);
+#include "phy_virtual.h"
+
+/******************************************************************************/
+#define DEV_NB 3
+
+struct evt_rec_s {
+	uint32_t u32RxStarted;
+	uint32_t u32RxComplete;
+	uint32_t u32TxComplete;
+};
+
+static const vmedium_cfg_t sMediumCfg = {
+	.fTxPowerMax = 14.0f,
+	.fSensitivity = -120.0f,
+	.fNoiseFloor = -130.0f,
+	.fPathLoss0 = 40.0f,
+	.fPathLossExp = 3.0f,
+	.fCaptureDb = 6.0f,
+	.u32BitErrPpm = 0,
+	.u32ByteErrPpm = 0,
+	.u32Seed = 1,
+};
+
+static vmedium_t sMedium;
+static vphy_dev_t *aHeap[DEV_NB];
+static vphy_dev_t aCtx[DEV_NB];
+static phydev_t aPhy[DEV_NB];
+static struct evt_rec_s aRec[DEV_NB];
+
+// ioctl arguments are uint32_t, keep them out of the stack
+static uint8_t u8Level;
+static uint8_t aRxBuf[VPHY_BUF_SZ];
+static uint8_t u8RxLen;
+
+static uint8_t aFrm[20] = {
+	0x44, 0x25, 0xF7, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11
+};
+
+/******************************************************************************/
+static void _evt_cb_(void *pCbParam, uint32_t eEvt)
+{
+	struct evt_rec_s *pRec = (struct evt_rec_s *)pCbParam;
+	switch (eEvt)
+	{
+		case PHYDEV_EVT_RX_STARTED:
+			pRec->u32RxStarted++;
+			break;
+		case PHYDEV_EVT_RX_COMPLETE:
+			pRec->u32RxComplete++;
+			break;
+		case PHYDEV_EVT_TX_COMPLETE:
+			pRec->u32TxComplete++;
+			break;
+		default:
+			break;
+	}
+}
+
+static void _setup_medium_(const vmedium_cfg_t *pCfg, const float aPos[DEV_NB][2])
+{
+	uint8_t i;
+	memset(aRec, 0, sizeof(aRec));
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, VMedium_Init(&sMedium, pCfg, aHeap, DEV_NB));
+	for (i = 0; i < DEV_NB; i++)
+	{
+		TEST_ASSERT_EQUAL(PHY_STATUS_OK, Phy_VPhy_setup(&aPhy[i], &aCtx[i], &sMedium, aPos[i][0], aPos[i][1]));
+		TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[i].pIf->pfInit(&aPhy[i]));
+		aPhy[i].pfEvtCb = _evt_cb_;
+		aPhy[i].pCbParam = &aRec[i];
+		aPhy[i].bPreSyncOn = 1;
+	}
+}
+
+static void _send_(uint8_t u8Dev)
+{
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[u8Dev].pIf->pfSetSend(&aPhy[u8Dev], aFrm, sizeof(aFrm)));
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[u8Dev].pIf->pfTx(&aPhy[u8Dev], PHY_CH120, PHY_WM2400));
+}
+
+static void _listen_(uint8_t u8Dev)
+{
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[u8Dev].pIf->pfRx(&aPhy[u8Dev], PHY_CH120, PHY_WM2400));
+}
+
+/******************************************************************************/
+TEST_SETUP(Device_PhyVirtual)
+{
+	memset(&sMedium, 0, sizeof(sMedium));
+	memset(aCtx, 0, sizeof(aCtx));
+	memset(aPhy, 0, sizeof(aPhy));
+}
+
+TEST_TEAR_DOWN(Device_PhyVirtual)
+{
+}
+
+/******************************************************************************/
+TEST(Device_PhyVirtual, test_AirTime_Success)
+{
+	// (16 + 16) bits of preamble and sync, (20 + 1) bytes of frame
+	TEST_ASSERT_EQUAL(83334, VMedium_AirTime(PHY_WM2400, 20, 0));
+	TEST_ASSERT_EQUAL(41667, VMedium_AirTime(PHY_WM4800, 20, 0));
+	// ... plus 2 bytes of CRC
+	TEST_ASSERT_EQUAL(90000, VMedium_AirTime(PHY_WM2400, 20, 1));
+	// (64 + 64) bits of preamble and sync
+	TEST_ASSERT_EQUAL(46250, VMedium_AirTime(PHY_WM6400, 20, 0));
+}
+
+TEST(Device_PhyVirtual, test_Deliver_Success)
+{
+	// receiver at 100 m : 14 - (40 + 30 * 2) = -86 dBm
+	const float aPos[DEV_NB][2] = { {0, 0}, {100, 0}, {0, 5000} };
+	_setup_medium_(&sMediumCfg, aPos);
+
+	_listen_(1);
+	_send_(0);
+	VMedium_Run(&sMedium, UINT64_MAX);
+
+	TEST_ASSERT_EQUAL(1, aRec[0].u32TxComplete);
+	TEST_ASSERT_EQUAL(1, aRec[1].u32RxStarted);
+	TEST_ASSERT_EQUAL(1, aRec[1].u32RxComplete);
+	TEST_ASSERT_EQUAL(83334, sMedium.u64Now);
+
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[1].pIf->pfGetRecv(&aPhy[1], aRxBuf, &u8RxLen));
+	TEST_ASSERT_EQUAL(sizeof(aFrm), u8RxLen);
+	TEST_ASSERT_EQUAL_MEMORY(aFrm, aRxBuf, sizeof(aFrm));
+
+	// RSSI unit : (-86 + 147.5) * 2
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[1].pIf->pfIoctl(&aPhy[1], PHY_CTL_GET_RSSI, (uint32_t)(&u8Level)));
+	TEST_ASSERT_EQUAL(123, u8Level);
+
+	TEST_ASSERT_EQUAL(1, sMedium.sStats.u32TxFrames);
+	TEST_ASSERT_EQUAL(1, sMedium.sStats.u32RxFrames);
+	TEST_ASSERT_EQUAL(0, sMedium.sStats.u32RxCollisions);
+	TEST_ASSERT_EQUAL(83334, sMedium.sStats.aAirTime[PHY_CH120]);
+}
+
+TEST(Device_PhyVirtual, test_Deliver_BelowSensitivity)
+{
+	// receiver at 10 km : 14 - (40 + 30 * 4) = -146 dBm
+	const float aPos[DEV_NB][2] = { {0, 0}, {10000, 0}, {0, 5000} };
+	_setup_medium_(&sMediumCfg, aPos);
+
+	_listen_(1);
+	_send_(0);
+	VMedium_Run(&sMedium, UINT64_MAX);
+
+	TEST_ASSERT_EQUAL(1, aRec[0].u32TxComplete);
+	TEST_ASSERT_EQUAL(0, aRec[1].u32RxStarted);
+	TEST_ASSERT_EQUAL(0, aRec[1].u32RxComplete);
+	TEST_ASSERT_EQUAL(1, sMedium.sStats.u32RxBelowSens);
+	TEST_ASSERT_EQUAL(0, sMedium.sStats.u32RxFrames);
+}
+
+TEST(Device_PhyVirtual, test_Deliver_Collision)
+{
+	// two transmitters at the same distance of the receiver
+	const float aPos[DEV_NB][2] = { {-100, 0}, {0, 0}, {100, 0} };
+	_setup_medium_(&sMediumCfg, aPos);
+
+	_listen_(1);
+	_send_(0);
+	VMedium_Run(&sMedium, 10000);
+	_send_(2);
+	VMedium_Run(&sMedium, UINT64_MAX);
+
+	TEST_ASSERT_EQUAL(1, aRec[0].u32TxComplete);
+	TEST_ASSERT_EQUAL(1, aRec[2].u32TxComplete);
+	TEST_ASSERT_EQUAL(0, aRec[1].u32RxComplete);
+	TEST_ASSERT_EQUAL(2, sMedium.sStats.u32TxFrames);
+	TEST_ASSERT_EQUAL(1, sMedium.sStats.u32RxCollisions);
+	TEST_ASSERT_EQUAL(0, sMedium.sStats.u32RxFrames);
+}
+
+TEST(Device_PhyVirtual, test_Deliver_Capture)
+{
+	// interferer at 1 km : -116 dBm, 30 dB below the locked frame
+	const float aPos[DEV_NB][2] = { {-100, 0}, {0, 0}, {1000, 0} };
+	_setup_medium_(&sMediumCfg, aPos);
+
+	_listen_(1);
+	_send_(0);
+	VMedium_Run(&sMedium, 10000);
+	_send_(2);
+	VMedium_Run(&sMedium, UINT64_MAX);
+
+	TEST_ASSERT_EQUAL(1, aRec[1].u32RxComplete);
+	TEST_ASSERT_EQUAL(0, sMedium.sStats.u32RxCollisions);
+	TEST_ASSERT_EQUAL(1, sMedium.sStats.u32RxFrames);
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[1].pIf->pfGetRecv(&aPhy[1], aRxBuf, &u8RxLen));
+	TEST_ASSERT_EQUAL_MEMORY(aFrm, aRxBuf, sizeof(aFrm));
+}
+
+TEST(Device_PhyVirtual, test_Deliver_ByteError)
+{
+	vmedium_cfg_t sCfg = sMediumCfg;
+	const float aPos[DEV_NB][2] = { {0, 0}, {100, 0}, {0, 5000} };
+	uint8_t i;
+
+	// every byte is replaced
+	sCfg.u32ByteErrPpm = 1000000;
+	_setup_medium_(&sCfg, aPos);
+
+	_listen_(1);
+	_send_(0);
+	VMedium_Run(&sMedium, UINT64_MAX);
+
+	TEST_ASSERT_EQUAL(1, aRec[1].u32RxComplete);
+	TEST_ASSERT_EQUAL(1, sMedium.sStats.u32RxErrFrames);
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[1].pIf->pfGetRecv(&aPhy[1], aRxBuf, &u8RxLen));
+	TEST_ASSERT_EQUAL(sizeof(aFrm), u8RxLen);
+	for (i = 0; i < sizeof(aFrm); i++)
+	{
+		TEST_ASSERT_NOT_EQUAL(aFrm[i], aRxBuf[i]);
+	}
+}
+
+TEST(Device_PhyVirtual, test_Noise_Success)
+{
+	// noise measured at 100 m of a transmitter : -86 dBm
+	const float aPos[DEV_NB][2] = { {0, 0}, {0, 100}, {0, 5000} };
+	_setup_medium_(&sMediumCfg, aPos);
+
+	// free channel : noise floor
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[1].pIf->pfNoise(&aPhy[1], PHY_CH120, PHY_WM2400));
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[1].pIf->pfIoctl(&aPhy[1], PHY_CTL_GET_NOISE, (uint32_t)(&u8Level)));
+	TEST_ASSERT_EQUAL(130, u8Level);
+
+	// busy channel
+	_send_(0);
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[1].pIf->pfNoise(&aPhy[1], PHY_CH120, PHY_WM2400));
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[1].pIf->pfIoctl(&aPhy[1], PHY_CTL_GET_NOISE, (uint32_t)(&u8Level)));
+	TEST_ASSERT_EQUAL(86, u8Level);
+	// same level as the RSSI of a frame received at the same place
+	TEST_ASSERT_EQUAL(123, Phy_NoiseToRssi(u8Level));
+
+	// other channel is free
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[1].pIf->pfNoise(&aPhy[1], PHY_CH100, PHY_WM2400));
+	TEST_ASSERT_EQUAL(PHY_STATUS_OK, aPhy[1].pIf->pfIoctl(&aPhy[1], PHY_CTL_GET_NOISE, (uint32_t)(&u8Level)));
+	TEST_ASSERT_EQUAL(130, u8Level);
+	VMedium_Run(&sMedium, UINT64_MAX);
+}
@@ -57,6 +57,35 @@ extern "C" {
 #include "phy_layer_private.h"
 
 #include "wize_api.h"
+#include "wize_sfq.h"
+
+#ifndef SFQ_ADDR
+/*!
+ * @def SFQ_ADDR
+ * @brief This macro define the store-and-forward flash area address (just
+ * after the image storage area, in bank 1)
+ */
+#define SFQ_ADDR 0x08056000
+#endif
+
+#ifndef SFQ_PAGE_SZ
+/*!
+ * @def SFQ_PAGE_SZ
+ * @brief This macro define the store-and-forward flash page size
+ */
+#define SFQ_PAGE_SZ 2048
+#endif
+
+#ifndef SFQ_PAGE_NB
+/*!
+ * @def SFQ_PAGE_NB
+ * @brief This macro define the store-and-forward flash area number of pages
+ */
+#define SFQ_PAGE_NB 8
+#endif
+
+static uint8_t _sfq_flash_write_(uint32_t u32Addr, uint64_t *pData, uint32_t u32NbDoubleWord);
+static uint8_t _sfq_flash_erase_(uint32_t u32Addr, uint32_t u32Size);
 
 /*!
  * @brief This is the context for the uart use as fake phy
@@ -68,6 +97,11 @@ static fakeuart_device_t fakeuart_ctx;
  */
 phydev_t sPhyDev;
 
+/*!
+ * @brief This store the store-and-forward queue context
+ */
+struct wize_sfq_s sSfq;
+
 /*!
  * @brief This function initialize the "system part"
  */
@@ -106,6 +140,11 @@ void Sys_Init(void)
 
    	// Setup Time Event
   	TimeEvt_Setup();
+	// Setup the store-and-forward queue (recover the pending items)
+	if ( WizeSfq_Setup(&sSfq, SFQ_ADDR, SFQ_PAGE_SZ, SFQ_PAGE_NB, _sfq_flash_write_, _sfq_flash_erase_) )
+	{
+		LOG_ERR("Store-and-forward setup failed\n");
+	}
 	// setup wize device
 	WizeApi_Setup(&sPhyDev);
   	WizeApi_Enable(1);
@@ -128,6 +167,37 @@ __attribute__ (( always_inline )) void Sys_Start(void)
 	vTaskStartScheduler();
 }
 
+/*!
+ * @static
+ * @brief This function write the store-and-forward flash area
+ *
+ * @param [in] u32Addr         Address to write
+ * @param [in] pData           Pointer on the double-words to write
+ * @param [in] u32NbDoubleWord Number of double-words to write
+ *
+ * @retval 0 Success
+ * @retval 1 Failed
+ */
+static uint8_t _sfq_flash_write_(uint32_t u32Addr, uint64_t *pData, uint32_t u32NbDoubleWord)
+{
+	return ( BSP_Flash_Write(u32Addr, pData, u32NbDoubleWord) != DEV_SUCCESS )?(1):(0);
+}
+
+/*!
+ * @static
+ * @brief This function erase the store-and-forward flash area
+ *
+ * @param [in] u32Addr Address of the area to erase
+ * @param [in] u32Size Size of the area to erase
+ *
+ * @retval 0 Success
+ * @retval 1 Failed
+ */
+static uint8_t _sfq_flash_erase_(uint32_t u32Addr, uint32_t u32Size)
+{
+	return ( BSP_Flash_EraseArea(u32Addr, u32Size) != DEV_SUCCESS )?(1):(0);
+}
+
 #ifdef __cplusplus
 }
 #endif
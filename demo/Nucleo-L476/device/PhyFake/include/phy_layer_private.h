@@ -46,6 +46,9 @@ extern "C" {
  * @{
  */
 #define BUF_SZ 515 // 2 (packet len) + 256*2 because it communicate on uart, so we need to convert hex to char + 1 (EOB)
+#ifndef PHYFAKE_NOISE_FLOOR
+#define PHYFAKE_NOISE_FLOOR 120 // Fake measured noise, opposite of the dBm value (-120 dBm)
+#endif
 
 /*!
  * @}
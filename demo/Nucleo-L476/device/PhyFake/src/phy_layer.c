@@ -286,7 +286,12 @@ static void _frame_it(void *p_CbParam, void *p_Arg)
 
 	if (u32IrqStatus == UART_EVT_RX_HCPLT)
 	{
+		struct timeval tv;
 		eEvt = PHYDEV_EVT_RX_STARTED;
+		// Time stamp the "sync word" detection
+		BSP_Rtc_Time_ReadMicro(&tv);
+		pPhydev->sSyncTime.u32Sec = (uint32_t)tv.tv_sec;
+		pPhydev->sSyncTime.u32USec = (uint32_t)tv.tv_usec;
 		//if (pDevice->NAD == pPhydev->eChannel) { }
 	}
 	if (u32IrqStatus == UART_EVT_TX_CPLT)
@@ -375,6 +380,10 @@ static int32_t _do_RX(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulat
  * @static
  * @brief  This function execute a Noise Measurement sequence
  *
+ * @details There is no radio behind the fake PHY, so the measured noise is
+ * the PHYFAKE_NOISE_FLOOR constant (get it with PHY_CTL_GET_NOISE). The
+ * measurement is refused while transmitting or receiving.
+ *
  * @param [in]  pPhydev     Pointer on the Phy device instance
  * @param [in]  eChannel    Channel on which the Noise must be measured
  * @param [in]  eModulation Modulation on which the Noise must be measured
@@ -385,8 +394,22 @@ static int32_t _do_RX(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulat
  */
 static int32_t _do_CCA(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
 {
-    int32_t i32Ret = PHY_STATUS_OK;
-
+    int32_t i32Ret = PHY_STATUS_ERROR;
+	fakeuart_device_t *pDevice = pPhydev->pCxt;
+	if ( (!pDevice) || (eChannel >= PHY_NB_CH) || (eModulation >= PHY_NB_MOD) )
+	{
+		return i32Ret;
+	}
+	if ( pDevice->eState & (TRANSMITTING_STATE | RECEIVING_STATE) )
+	{
+		pDevice->eError = FAKEUART_BUSY;
+		i32Ret = PHY_STATUS_BUSY;
+	}
+	else
+	{
+		pPhydev->u16_Noise = PHYFAKE_NOISE_FLOOR;
+		i32Ret = PHY_STATUS_OK;
+	}
     return i32Ret;
 }
 
@@ -500,6 +523,19 @@ static int32_t _ioctl(phydev_t *pPhydev, uint32_t eCtl, uint32_t args)
 				case PHY_CTL_SET_PA:
 					// TODO :
 					break;
+				case PHY_CTL_SET_MULTI:
+					if ( ((phy_cfg_set_t*)args)->u8Mask & PHY_CFG_TX_FREQ_OFF )
+					{
+						pPhydev->i16TxFreqOffset = ((phy_cfg_set_t*)args)->i16TxFreqOffset;
+					}
+					if ( ((phy_cfg_set_t*)args)->u8Mask & PHY_CFG_TX_POWER )
+					{
+						pPhydev->eTxPower = ((phy_cfg_set_t*)args)->eTxPower;
+						// run-time configure TX power is required
+						// TODO :
+					}
+					((phy_cfg_set_t*)args)->u8Mask = 0;
+					break;
 				case PHY_CTL_SET_TX_FREQ_OFF:
 					pPhydev->i16TxFreqOffset = (int16_t)args;
 					break;
@@ -532,14 +568,16 @@ static int32_t _ioctl(phydev_t *pPhydev, uint32_t eCtl, uint32_t args)
 					*(uint8_t*)args = 0;
 					break;
 				case PHY_CTL_GET_NOISE:
-					// TODO :
 					//*(uint8_t*)args = PHY_CONV_Signed11ToRssi( pPhydev->u16_Noise );
-					*(uint8_t*)args = 0;
+					*(uint8_t*)args = (uint8_t)pPhydev->u16_Noise;
 					break;
 				case PHY_CTL_GET_ERR:
 					// TODO :
 					*(uint8_t*)args = pDevice->eError;
 					break;
+				case PHY_CTL_GET_SYNC_TIME:
+					*(phy_tstamp_t*)args = pPhydev->sSyncTime;
+					break;
 				default:
 					break;
 			}
@@ -41,7 +41,33 @@ extern "C" {
 
 #include "parameters_def.h"
 
+/*!
+ * @def PARAM_ID_ALL
+ * @brief This macro define the Id given to the write call-backs when all the
+ * parameters have been written (see Param_Init).
+ */
+#define PARAM_ID_ALL 0xFF
+
+/*!
+ * @brief This define the call-back called on each successful parameter write
+ * (local, remote or direct access)
+ *
+ * @param [in] u8_Id The written parameter Id (PARAM_ID_ALL : all of them).
+ */
+typedef void (*pfParamWriteCb_t)(uint8_t u8_Id);
+
+/*!
+ * @brief This struct define a write call-back registration (see
+ * Param_AddWriteCb). It is owned by the caller.
+ */
+typedef struct param_write_nb_s {
+    pfParamWriteCb_t pf_Cb;          //!< The call-back
+    struct param_write_nb_s *p_Next; //!< The next registration (internal)
+} param_write_nb_s;
+
 void Param_Init(const uint8_t *p_Param);
+void Param_AddWriteCb(param_write_nb_s *p_Nb);
+void Param_RemoveWriteCb(param_write_nb_s *p_Nb);
 uint8_t Param_IsValidId(uint8_t u8_Id);
 uint8_t Param_GetSize(uint8_t u8_Id);
 param_access_e Param_GetLocAccess(uint8_t u8_Id);
@@ -37,7 +37,7 @@
 #include <limits.h>
 #include <string.h>
 
-#include "parameters_def.h"
+#include "parameters.h"
 
 /*!
  * @brief This external variable hold the parameters table value size
@@ -66,7 +66,13 @@ extern const uint8_t u8_ParamRestrCfgSz;
  */
 extern const restr_s a_ParamRestr[];
 
+/*!
+ * @brief This hold the write call-back list (see Param_AddWriteCb)
+ */
+static param_write_nb_s *p_ParamWriteNb = NULL;
+
 static uint8_t _param_access_(uint8_t u8_Id, uint8_t* p_Data, uint8_t u8_Dir, uint8_t u8_Access);
+static void _param_notify_(uint8_t u8_Id);
 static restr_s* _get_restr_add_(uint8_t u8_Id);
 static uint8_t _check_conform_modulo_(restr_s *p_Restr, uint8_t* p_Data);
 static uint8_t _check_conform_enum_(restr_s *p_Restr, uint8_t* p_Data);
@@ -115,6 +121,9 @@ static uint8_t _param_access_(uint8_t u8_Id, uint8_t* p_Data, uint8_t u8_Dir, ui
             memcpy(pvDest, pvSrc, a_ParamAccess[u8_Id].u8_size);
             //_param_unlock_((void*)&(a_ParamAccess[u8_Id].u8_access));
             u8_ret = 1;
+            if (u8_Dir) {
+                _param_notify_(u8_Id);
+            }
         }
     }
     else {
@@ -257,7 +266,8 @@ static uint8_t _check_conform_range_(restr_s *p_Restr, uint8_t* p_Data)
 
 
 /*!
-  * @brief Init parameters by with default values
+  * @brief Init parameters by with default values. The write call-backs are
+  * called with PARAM_ID_ALL.
   *
   * @param [in] p_Param Pointer on input parameters table.
   * @return None
@@ -265,6 +275,68 @@ static uint8_t _check_conform_range_(restr_s *p_Restr, uint8_t* p_Data)
 void Param_Init(const uint8_t *p_Param)
 {
 	memcpy(a_ParamValue, p_Param, u16_ParamValueSz);
+	_param_notify_(PARAM_ID_ALL);
+}
+
+/*!
+  * @static
+  * @brief  This private function call all the registered write call-backs
+  *
+  * @param [in] u8_Id The written parameter Id (PARAM_ID_ALL : all of them).
+  * @return None
+  */
+static void _param_notify_(uint8_t u8_Id)
+{
+	param_write_nb_s *p_Nb = p_ParamWriteNb;
+	while (p_Nb) {
+		p_Nb->pf_Cb(u8_Id);
+		p_Nb = p_Nb->p_Next;
+	}
+}
+
+/*!
+  * @brief Add a call-back called on each successful parameter write, and
+  * with PARAM_ID_ALL by Param_Init. Writes done through the parameter address
+  * (see Param_GetAddOf) are not notified. The list is not locked, so
+  * call-backs should be added and removed before the tasks start.
+  *
+  * @param [in] p_Nb The registration (must remain valid until it is removed).
+  * @return None
+  */
+void Param_AddWriteCb(param_write_nb_s *p_Nb)
+{
+	param_write_nb_s *p_Cur = p_ParamWriteNb;
+	if (!p_Nb || !p_Nb->pf_Cb) {
+		return;
+	}
+	// already in the list
+	while (p_Cur) {
+		if (p_Cur == p_Nb) {
+			return;
+		}
+		p_Cur = p_Cur->p_Next;
+	}
+	p_Nb->p_Next = p_ParamWriteNb;
+	p_ParamWriteNb = p_Nb;
+}
+
+/*!
+  * @brief Remove a write call-back (see Param_AddWriteCb).
+  *
+  * @param [in] p_Nb The registration.
+  * @return None
+  */
+void Param_RemoveWriteCb(param_write_nb_s *p_Nb)
+{
+	param_write_nb_s **pp_Cur = &p_ParamWriteNb;
+	while (*pp_Cur) {
+		if (*pp_Cur == p_Nb) {
+			*pp_Cur = p_Nb->p_Next;
+			p_Nb->p_Next = NULL;
+			return;
+		}
+		pp_Cur = &((*pp_Cur)->p_Next);
+	}
 }
 
 /*!
@@ -20,6 +20,9 @@ TEST_GROUP_RUNNER(Samples_Parameters)
     RUN_TEST_CASE(Samples_Parameters, test_RemoteReadAccess_Forbidden);
     RUN_TEST_CASE(Samples_Parameters, test_RemoteWriteAccess_Forbidden);
 
+    RUN_TEST_CASE(Samples_Parameters, test_WriteCb_Success);
+    RUN_TEST_CASE(Samples_Parameters, test_WriteCb_Chained);
+
     RUN_TEST_CASE(Samples_Parameters, test_DirectReadAccess_Success);
     RUN_TEST_CASE(Samples_Parameters, test_DirectWriteAccess_Success);
 
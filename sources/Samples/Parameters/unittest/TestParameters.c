@@ -24,9 +24,30 @@ TEST_SETUP(Samples_Parameters)
 	memcpy(a_ParamValue, a_ParamDefault, PARAM_DEFAULT_SZ);
 }
 
-TEST_TEAR_DOWN(Samples_Parameters)
+static uint8_t u8_WriteCbNb;
+static uint8_t u8_WriteCbId;
+static uint8_t u8_WriteCb2Nb;
+static uint8_t u8_WriteCb2Id;
+
+static void _write_cb_(uint8_t u8_Id)
 {
+	u8_WriteCbNb++;
+	u8_WriteCbId = u8_Id;
+}
 
+static void _write_cb2_(uint8_t u8_Id)
+{
+	u8_WriteCb2Nb++;
+	u8_WriteCb2Id = u8_Id;
+}
+
+static param_write_nb_s s_WriteNb = { .pf_Cb = _write_cb_ };
+static param_write_nb_s s_WriteNb2 = { .pf_Cb = _write_cb2_ };
+
+TEST_TEAR_DOWN(Samples_Parameters)
+{
+	Param_RemoveWriteCb(&s_WriteNb);
+	Param_RemoveWriteCb(&s_WriteNb2);
 }
 
 /******************************************************************************/
@@ -280,6 +301,85 @@ TEST(Samples_Parameters, test_RemoteWriteAccess_Forbidden)
 	TEST_ASSERT_EQUAL_MEMORY(a_ParamDefault, a_ParamValue, PARAM_DEFAULT_SZ);
 }
 
+TEST(Samples_Parameters, test_WriteCb_Success)
+{
+    uint8_t a_Data[8] = {0xDA, 0xC0, 0xCA, 0xDE, 0xAD, 0xBE, 0xEF, 0x00};
+	uint8_t ret;
+
+	u8_WriteCbNb = 0;
+	u8_WriteCbId = 0;
+	Param_AddWriteCb(&s_WriteNb);
+
+	// Read : not notified
+	ret = Param_LocalAccess(0x01, a_Data, 0);
+	TEST_ASSERT_EQUAL(1, ret);
+	TEST_ASSERT_EQUAL(0, u8_WriteCbNb);
+
+	// Forbidden write (local RO) : not notified
+	ret = Param_LocalAccess(0x11, a_Data, 1);
+	TEST_ASSERT_EQUAL(0, ret);
+	TEST_ASSERT_EQUAL(0, u8_WriteCbNb);
+
+	// Local, remote and direct writes : notified
+	ret = Param_LocalAccess(0x01, a_Data, 1);
+	TEST_ASSERT_EQUAL(1, ret);
+	TEST_ASSERT_EQUAL(1, u8_WriteCbNb);
+	TEST_ASSERT_EQUAL(0x01, u8_WriteCbId);
+
+	ret = Param_RemoteAccess(0x11, a_Data, 1);
+	TEST_ASSERT_EQUAL(1, ret);
+	TEST_ASSERT_EQUAL(2, u8_WriteCbNb);
+	TEST_ASSERT_EQUAL(0x11, u8_WriteCbId);
+
+	ret = Param_Access(0x02, a_Data, 1);
+	TEST_ASSERT_EQUAL(1, ret);
+	TEST_ASSERT_EQUAL(3, u8_WriteCbNb);
+	TEST_ASSERT_EQUAL(0x02, u8_WriteCbId);
+
+	// Removed
+	Param_RemoveWriteCb(&s_WriteNb);
+	ret = Param_Access(0x02, a_Data, 1);
+	TEST_ASSERT_EQUAL(1, ret);
+	TEST_ASSERT_EQUAL(3, u8_WriteCbNb);
+}
+
+TEST(Samples_Parameters, test_WriteCb_Chained)
+{
+    uint8_t a_Data[8] = {0xDA, 0xC0, 0xCA, 0xDE, 0xAD, 0xBE, 0xEF, 0x00};
+	uint8_t ret;
+
+	u8_WriteCbNb = 0;
+	u8_WriteCb2Nb = 0;
+	Param_AddWriteCb(&s_WriteNb);
+	Param_AddWriteCb(&s_WriteNb2);
+	// Added twice : notified once
+	Param_AddWriteCb(&s_WriteNb);
+	// Invalid : ignored
+	Param_AddWriteCb(NULL);
+
+	ret = Param_Access(0x02, a_Data, 1);
+	TEST_ASSERT_EQUAL(1, ret);
+	TEST_ASSERT_EQUAL(1, u8_WriteCbNb);
+	TEST_ASSERT_EQUAL(0x02, u8_WriteCbId);
+	TEST_ASSERT_EQUAL(1, u8_WriteCb2Nb);
+	TEST_ASSERT_EQUAL(0x02, u8_WriteCb2Id);
+
+	// Init : all parameters written
+	Param_Init(a_ParamDefault);
+	TEST_ASSERT_EQUAL(2, u8_WriteCbNb);
+	TEST_ASSERT_EQUAL(PARAM_ID_ALL, u8_WriteCbId);
+	TEST_ASSERT_EQUAL(2, u8_WriteCb2Nb);
+	TEST_ASSERT_EQUAL(PARAM_ID_ALL, u8_WriteCb2Id);
+
+	// Remove the last added one, the first is still notified
+	Param_RemoveWriteCb(&s_WriteNb2);
+	Param_RemoveWriteCb(&s_WriteNb2);
+	ret = Param_Access(0x02, a_Data, 1);
+	TEST_ASSERT_EQUAL(1, ret);
+	TEST_ASSERT_EQUAL(3, u8_WriteCbNb);
+	TEST_ASSERT_EQUAL(2, u8_WriteCb2Nb);
+}
+
 
 /******************************************************************************/
 /* Tests on Direct Access Functions */
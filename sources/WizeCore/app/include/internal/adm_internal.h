@@ -41,7 +41,79 @@ extern "C" {
 #include "proto.h"
 #include "app_layer.h"
 
+/*!
+ * @def ADM_INT_RSP_SZ_MAX
+ * @brief This macro define the greatest response size (response buffer size,
+ * see SEND_BUFFER_SZ in adm_mgr.h)
+ */
+#define ADM_INT_RSP_SZ_MAX 229
+
+/*!
+ * @def ADM_INT_HDL_NB
+ * @brief This macro define the number of application (manufacturer) command
+ * handlers that can be registered
+ */
+#ifndef ADM_INT_HDL_NB
+	#define ADM_INT_HDL_NB 4
+#endif
+
+/*!
+ * @def ADM_INT_CACHE_NB
+ * @brief This macro define the number of cached READ_PARAM responses (0 :
+ * no cache)
+ */
+#ifndef ADM_INT_CACHE_NB
+	#define ADM_INT_CACHE_NB 4
+#endif
+
+/*!
+ * @def ADM_INT_CACHE_KEY_SZ
+ * @brief This macro define the greatest number of parameter ids of a cached
+ * READ_PARAM
+ */
+#ifndef ADM_INT_CACHE_KEY_SZ
+	#define ADM_INT_CACHE_KEY_SZ 16
+#endif
+
+/*!
+ * @def ADM_INT_CACHE_VAL_SZ
+ * @brief This macro define the greatest size of a cached READ_PARAM response
+ * (ids and values, without the response header)
+ */
+#ifndef ADM_INT_CACHE_VAL_SZ
+	#define ADM_INT_CACHE_VAL_SZ 64
+#endif
+
+/*!
+ * @brief This define the command handler function
+ *
+ * @param [in,out] pReqMsg Pointer on request message
+ * @param [in,out] pRspMsg Pointer on response message (the handler write the
+ *                         response in pRspMsg->pData and set pRspMsg->u8Size)
+ */
+typedef void (*pfAdmCmd_t)(net_msg_t *pReqMsg, net_msg_t *pRspMsg);
+
+/*!
+ * @brief This struct define a command handler
+ */
+struct adm_cmd_hdl_s
+{
+	pfAdmCmd_t pfRsp;  /*!< Check the command and build the response (must not
+	                        execute it) */
+	pfAdmCmd_t pfPost; /*!< Execute the command, once its response has been
+	                        sent without error (may be NULL) */
+	uint8_t u8CmdId;   /*!< The L7CommandId */
+	uint8_t u8RspMax;  /*!< The greatest response size (up to ADM_INT_RSP_SZ_MAX) */
+	uint8_t bDeferred; /*!< The response is built on the command repetition (as
+	                        EXECINSTPING), not on its first reception */
+};
+
 uint8_t AdmInt_PreCmd(net_msg_t *pReqMsg, net_msg_t *pRspMsg);
+void AdmInt_PostCmd(net_msg_t *pReqMsg, net_msg_t *pRspMsg);
+int32_t AdmInt_Register(const struct adm_cmd_hdl_s *pHdl);
+int32_t AdmInt_Unregister(uint8_t u8CmdId);
+void AdmInt_CacheSetup(void);
+void AdmInt_ParamChanged(uint8_t u8ParamId);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,168 @@
+/**
+  * @file: link_internal.h
+  * @brief This file define the functions and structures of the link adaptation
+  *
+  * @details The link adaptation select the uplink TX power and modulation from
+  * the link quality observed on recent exchanges (install session PONG, received
+  * ADM commands and noise level).
+  *
+  * All levels (RSSI, sensitivity and margins) are expressed in the RSSI unit
+  * given by the L7 and the phy device (higher value is a stronger signal). The
+  * noise is the one measured by the LBT (as PHY_CTL_GET_NOISE, the opposite of
+  * the dBm value), it is converted to the RSSI unit when used.
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  *
+  */
+
+/*!
+ * @addtogroup wize_app
+ * @{
+ *
+ */
+#ifndef _LINK_INTERNAL_H_
+#define _LINK_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "net_api_private.h"
+
+#include <stdint.h>
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+
+#ifndef LINK_RSSI_PER_DB
+	#define LINK_RSSI_PER_DB 2 // Number of RSSI unit per dB
+#endif
+
+#ifndef LINK_ADAPT_EN
+	#define LINK_ADAPT_EN (LINK_ADAPT_PWR | LINK_ADAPT_MOD)
+#endif
+
+#ifndef LINK_SENS_RSSI
+	#define LINK_SENS_RSSI 50 // Gateway sensitivity with WM2400 (RSSI unit)
+#endif
+
+#ifndef LINK_MARGIN_DB
+	#define LINK_MARGIN_DB 10 // Target margin above the sensitivity (dB)
+#endif
+
+#ifndef LINK_HYST_DB
+	#define LINK_HYST_DB 3 // Additional margin to step to a cheaper setting (dB)
+#endif
+
+#ifndef LINK_SNR_MIN_DB
+	#define LINK_SNR_MIN_DB 8 // Minimum signal to noise ratio (dB)
+#endif
+
+#ifndef LINK_STEP_NB
+	#define LINK_STEP_NB 2 // Number of consecutive good samples to step to a cheaper setting
+#endif
+
+#ifndef LINK_FAIL_NB
+	#define LINK_FAIL_NB 1 // Number of consecutive failures to fallback
+#endif
+
+#ifndef LINK_EWMA_SHIFT
+	#define LINK_EWMA_SHIFT 2 // EWMA weight is 1/(2^LINK_EWMA_SHIFT)
+#endif
+
+#define LINK_DB(db) ((db) * LINK_RSSI_PER_DB)
+
+/*!
+ * @}
+ * @endcond
+ */
+
+/*!
+ * @brief This enum defines the link adaptation enable mask.
+ */
+typedef enum {
+	LINK_ADAPT_NONE = 0x00, /*!< Link adaptation disabled */
+	LINK_ADAPT_PWR  = 0x01, /*!< TX power adaptation enabled */
+	LINK_ADAPT_MOD  = 0x02, /*!< TX modulation adaptation enabled */
+} link_adapt_e;
+
+/*!
+ * @brief This struct defines the link adaptation configuration.
+ */
+struct link_adapt_cfg_s
+{
+	uint8_t u8Enable;   /*!< Enable mask (see @link link_adapt_e @endlink) */
+	uint8_t u8Sens;     /*!< Gateway sensitivity with WM2400 */
+	uint8_t u8Margin;   /*!< Target margin above the sensitivity */
+	uint8_t u8Hyst;     /*!< Additional margin required to step to a cheaper setting */
+	uint8_t u8SnrMin;   /*!< Minimum signal to noise ratio */
+	uint8_t u8StepNb;   /*!< Number of consecutive good samples to step to a cheaper setting */
+	uint8_t u8FailNb;   /*!< Number of consecutive failures to fallback */
+	int8_t  i8DwnOffset;/*!< Default correction from downlink RSSI to uplink RSSI at full power */
+};
+
+/*!
+ * @brief This struct defines the link adaptation statistics.
+ */
+struct link_adapt_stats_s
+{
+	uint16_t u16PongNb;     /*!< Number of PONG samples */
+	uint16_t u16DwnNb;      /*!< Number of downlink samples */
+	uint16_t u16StepDown;   /*!< Number of step to a cheaper setting */
+	uint16_t u16StepUp;     /*!< Number of step to a more robust setting */
+	uint16_t u16Fallback;   /*!< Number of fallback */
+};
+
+/*!
+ * @brief This struct defines the link adaptation context.
+ */
+struct link_adapt_ctx_s
+{
+	struct link_adapt_cfg_s sCfg;     /*!< Configuration */
+	struct link_adapt_stats_s sStats; /*!< Statistics */
+	int16_t i16Margin;                /*!< Uplink margin at full power with WM2400 (Q4 fixed point) */
+	int8_t  i8DwnOffset;              /*!< Correction from downlink RSSI to uplink RSSI at full power (learned on PONG) */
+	uint8_t bValid;                   /*!< The margin estimation is valid */
+	uint8_t bNewSample;               /*!< A sample has been received since the last selection */
+	uint8_t u8GoodNb;                 /*!< Number of consecutive good samples for a cheaper setting */
+	uint8_t u8FailNb;                 /*!< Number of consecutive failures */
+	uint8_t u8Noise;                  /*!< Last noise level, as PHY_CTL_GET_NOISE (0 : unknown) */
+	uint8_t eMod;                     /*!< Last selected modulation (see @link phy_mod_e @endlink) */
+	uint8_t ePower;                   /*!< Last selected TX power (see @link phy_power_e @endlink) */
+};
+
+void LinkInt_Init(struct link_adapt_ctx_s *pCtx);
+void LinkInt_Pong(struct link_adapt_ctx_s *pCtx, uint8_t u8RssiUp, uint8_t u8RssiDwn);
+void LinkInt_Dwn(struct link_adapt_ctx_s *pCtx, uint8_t u8Rssi);
+void LinkInt_Noise(struct link_adapt_ctx_s *pCtx, uint8_t u8Noise);
+void LinkInt_Fail(struct link_adapt_ctx_s *pCtx);
+void LinkInt_Fallback(struct link_adapt_ctx_s *pCtx);
+void LinkInt_Apply(struct link_adapt_ctx_s *pCtx, struct medium_cfg_s *pMediumCfg);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _LINK_INTERNAL_H_ */
+
+/*! @} */
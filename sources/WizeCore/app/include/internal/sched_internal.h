@@ -0,0 +1,147 @@
+/**
+  * @file: sched_internal.h
+  * @brief This file define the functions and structures of the session
+  * scheduler
+  *
+  * @details The session scheduler keep the session requests (from the API) that
+  * can't start immediately, because another session is running. They are
+  * started later, by priority, if they can still meet their deadline.
+  *
+  * All times are expressed in tick.
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  *
+  */
+
+/*!
+ * @addtogroup wize_app
+ * @{
+ *
+ */
+#ifndef _SCHED_INTERNAL_H_
+#define _SCHED_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+
+#ifndef SCHED_QUEUE_NB
+	#define SCHED_QUEUE_NB 4 // Maximum number of pending session requests
+#endif
+
+#ifndef SCHED_DEADLINE_MS
+	#define SCHED_DEADLINE_MS 120000 // Default time allowed to start a pending request (ms)
+#endif
+
+#define SCHED_NONE 0xFF // No request
+
+#define SCHED_REQ_POS 20 // First session request bit, in the dispatcher notification
+#define SCHED_REQ_MSK 0x00F00000 // Session request bits (one per session)
+#define SCHED_REQ(id) (1UL << ((id) + SCHED_REQ_POS)) // Request bit of a session
+
+#ifndef SCHED_GUARD_MS
+	#define SCHED_GUARD_MS 1000 // Margin kept before the next download window (ms)
+#endif
+
+#ifndef SCHED_GAP_MAX_MS
+	#define SCHED_GAP_MAX_MS 3600000 // Greatest gap given (ms), far longer than a session
+#endif
+
+/*!
+ * @}
+ * @endcond
+ */
+
+/*!
+ * @brief This enum defines the session request priorities (lower is first).
+ */
+typedef enum {
+	SCHED_PRIO_DATA_PRIO = 0x00, /*!< ADM session with DATA_PRIO message */
+	SCHED_PRIO_INST      = 0x01, /*!< INST session (PING/PONG) */
+	SCHED_PRIO_DATA      = 0x02, /*!< ADM session with DATA message */
+} sched_prio_e;
+
+/*!
+ * @brief This struct defines a pending session request.
+ */
+struct sched_req_s
+{
+	uint32_t u32Submit;   /*!< Submit time */
+	uint32_t u32Start;    /*!< Earliest start time */
+	uint32_t u32Deadline; /*!< Latest start time */
+	uint32_t u32Duration; /*!< Estimated session duration */
+	uint8_t  eSesId;      /*!< Session id (see @link ses_type_t @endlink) */
+	uint8_t  u8Prio;      /*!< Priority (see @link sched_prio_e @endlink) */
+};
+
+/*!
+ * @brief This struct defines the session scheduler statistics.
+ */
+struct sched_stats_s
+{
+	uint32_t u32Queued;      /*!< Number of queued requests */
+	uint32_t u32Started;     /*!< Number of started queued requests */
+	uint32_t u32Interleaved; /*!< Number of started in a download gap */
+	uint32_t u32Expired;     /*!< Number of requests dropped on deadline */
+	uint32_t u32Rejected;    /*!< Number of requests rejected (queue full) */
+	uint32_t u32Missed;      /*!< Number of download windows missed */
+	uint32_t u32WaitMax;     /*!< Maximum queue latency */
+	uint32_t u32WaitSum;     /*!< Cumulated queue latency (of started requests) */
+	uint8_t  u8Depth;        /*!< Current queue depth */
+	uint8_t  u8DepthMax;     /*!< Maximum queue depth */
+};
+
+/*!
+ * @brief This struct defines the session scheduler context.
+ */
+struct sched_ctx_s
+{
+	struct sched_req_s aReq[SCHED_QUEUE_NB]; /*!< Pending requests, by priority */
+	struct sched_stats_s sStats;             /*!< Statistics */
+	uint32_t u32DwnPend;                     /*!< Missed download window event (0 : none) */
+};
+
+void SchedInt_Init(struct sched_ctx_s *pCtx);
+int32_t SchedInt_Push(struct sched_ctx_s *pCtx, struct sched_req_s *pReq);
+uint32_t SchedInt_Expire(struct sched_ctx_s *pCtx, uint32_t u32Now);
+int32_t SchedInt_Cancel(struct sched_ctx_s *pCtx, uint8_t eSesId);
+uint8_t SchedInt_Next(struct sched_ctx_s *pCtx, uint32_t u32Now, uint32_t u32Gap);
+void SchedInt_GetStats(struct sched_ctx_s *pCtx, struct sched_stats_s *pStats, uint8_t bClear);
+void SchedInt_DwnMiss(struct sched_ctx_s *pCtx, uint32_t u32Event);
+uint32_t SchedInt_DwnReplay(struct sched_ctx_s *pCtx);
+uint32_t SchedInt_Gap(uint64_t u64WaitMs, uint32_t u32PrepMs);
+uint32_t SchedInt_Duration(uint8_t u8Delay, uint8_t u8Length, uint8_t u8Resp);
+uint8_t SchedInt_ReqNext(uint32_t *pu32Event);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _SCHED_INTERNAL_H_ */
+
+/*! @} */
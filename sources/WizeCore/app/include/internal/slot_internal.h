@@ -0,0 +1,122 @@
+/**
+  * @file: slot_internal.h
+  * @brief This file define the functions and structures of the transmit slot
+  * allocator
+  *
+  * @details Devices configured the same way tend to transmit at the same time
+  * (e.g. on day pass). The slot allocator gives to each device a transmit
+  * offset, inside a configurable window, derived from its address (so it is
+  * deterministic and spread over the fleet), plus an optional random jitter.
+  *
+  * All times are expressed in millisecond.
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  *
+  */
+
+/*!
+ * @addtogroup wize_app
+ * @{
+ *
+ */
+#ifndef _SLOT_INTERNAL_H_
+#define _SLOT_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+
+#ifndef SLOT_DATA_WINDOW_MS
+	#define SLOT_DATA_WINDOW_MS 0 // Default DATA window (0 : disabled)
+#endif
+
+/*
+ * Note : The periodic install (PING) is delayed by its slot offset, so by up
+ * to SLOT_INST_WINDOW_MS (1 hour by default) after the day it is due on has
+ * passed. Define it at build time, or call WizeApi_SetSlotCfg, to shorten the
+ * window (0 : the install is sent as soon as it is due).
+ */
+#ifndef SLOT_INST_WINDOW_MS
+	#define SLOT_INST_WINDOW_MS 3600000 // Default periodic install window
+#endif
+
+#ifndef SLOT_DAILY_WINDOW_MS
+	#define SLOT_DAILY_WINDOW_MS 3600000 // Default daily task window
+#endif
+
+#ifndef SLOT_JITTER_PCT
+	#define SLOT_JITTER_PCT 10 // Default random jitter (percent of the window)
+#endif
+
+/*!
+ * @}
+ * @endcond
+ */
+
+/*!
+ * @brief This enum defines the transmit slot classes.
+ */
+typedef enum {
+	SLOT_CLASS_DATA  = 0x00, /*!< DATA message (not DATA_PRIO) */
+	SLOT_CLASS_INST  = 0x01, /*!< Periodic install (PING) */
+	SLOT_CLASS_DAILY = 0x02, /*!< Daily application task */
+	//
+	SLOT_CLASS_NB
+} slot_class_e;
+
+/*!
+ * @brief This struct defines the slot allocator configuration.
+ */
+struct slot_cfg_s
+{
+	uint32_t aWindowMs[SLOT_CLASS_NB]; /*!< Window per class (ms, 0 : no offset) */
+	uint8_t  u8JitterPct;              /*!< Random jitter, in percent of the window */
+};
+
+/*!
+ * @brief This struct defines the slot allocator context.
+ */
+struct slot_ctx_s
+{
+	struct slot_cfg_s sCfg; /*!< Configuration */
+	uint32_t u32Hash;       /*!< Device hash (from its address) */
+	uint32_t u32Rand;       /*!< Jitter random generator state */
+};
+
+void SlotInt_Init(struct slot_ctx_s *pCtx);
+int32_t SlotInt_Config(struct slot_ctx_s *pCtx, const struct slot_cfg_s *pCfg);
+void SlotInt_SetId(struct slot_ctx_s *pCtx, const uint8_t *pId, uint8_t u8Size, uint32_t u32Seed);
+uint32_t SlotInt_Offset(struct slot_ctx_s *pCtx, uint8_t eClass);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _SLOT_INTERNAL_H_ */
+
+/*! @} */
@@ -46,10 +46,13 @@ extern "C" {
 
 #include "inst_internal.h"
 #include "adm_internal.h"
+#include "link_internal.h"
+#include "sched_internal.h"
+#include "slot_internal.h"
 
 /******************************************************************************/
 
-#define SES_MGR_EVT_POS 24
+#define SES_MGR_EVT_POS SCHED_REQ_POS
 #define SES_MGR_FLG_POS 16
 
 /*!
@@ -57,12 +60,13 @@ extern "C" {
  */
 typedef enum
 {
-	SES_MGR_EVT_MSK        = 0xFF000000,
-	SES_MGR_INST_EVT_OPEN  = (SES_INST << SES_MGR_EVT_POS) | SES_EVT_OPEN,
-	SES_MGR_INST_EVT_CLOSE = (SES_INST << SES_MGR_EVT_POS) | SES_EVT_CLOSE,
+	// one bit per session (given with eSetBits), in SES_EVT_MSK
+	SES_MGR_EVT_MSK        = SCHED_REQ_MSK,
+	SES_MGR_INST_EVT_OPEN  = SCHED_REQ(SES_INST) | SES_EVT_OPEN,
+	SES_MGR_INST_EVT_CLOSE = SCHED_REQ(SES_INST) | SES_EVT_CLOSE,
 
-	SES_MGR_ADM_EVT_OPEN   = (SES_ADM << SES_MGR_EVT_POS) | SES_EVT_OPEN,
-	SES_MGR_ADM_EVT_CLOSE  = (SES_ADM << SES_MGR_EVT_POS) | SES_EVT_CLOSE,
+	SES_MGR_ADM_EVT_OPEN   = SCHED_REQ(SES_ADM) | SES_EVT_OPEN,
+	SES_MGR_ADM_EVT_CLOSE  = SCHED_REQ(SES_ADM) | SES_EVT_CLOSE,
 } ses_mgr_evt_e;
 
 /*!
@@ -170,6 +174,24 @@ typedef enum
 	SES_DWN_SES_PEND  = 0x40,
 } ses_disp_pending_e;
 
+/*!
+ * @brief This defines the session completion call-back (asynchronous request)
+ *
+ * @param [in] pArg      The call-back argument
+ * @param [in] eSesId    The session
+ * @param [in] u32BckFlg The result flags (see @link ses_mgr_flg_e @endlink)
+ */
+typedef void (*pfSesDisp_Cpl_t)(void *pArg, uint8_t eSesId, uint32_t u32BckFlg);
+
+/*!
+ * @brief This struct defines the session completion of an asynchronous request.
+ */
+struct ses_disp_cpl_s
+{
+	pfSesDisp_Cpl_t pfCpl; /*!< Call-back (NULL : result given in the event group) */
+	void *pArg;            /*!< Call-back argument */
+};
+
 /*!
  * @brief This struct defines the session dispatcher context.
  */
@@ -189,9 +211,20 @@ struct ses_disp_ctx_s
 
 	ses_type_t eActiveId;
 	ses_type_t eReqId;
+	ses_type_t eSuspId; // session suspended by an interleaved one (download)
+
+	struct sched_ctx_s sSchedCtx; // pending session requests
+	uint32_t u32DwnWinTick; // last download window start (in tick)
+
+	struct ses_disp_cpl_s aCpl[SES_NB]; // asynchronous request completion
+	uint8_t u8CancelMsk;    // cancel requests (1 << session id)
+	uint8_t u8IntMsk;       // requests from the dispatcher itself, not notified (1 << session id)
+
+	struct slot_ctx_s sSlotCtx; // transmit slot allocator
 
 	ses_disp_state_e eState;
 	struct ping_reply_ctx_s sPingReplyCtx;
+	struct link_adapt_ctx_s sLinkCtx;
 
 	uint16_t u16PeriodInst; // in days (from param EXECPING_PERIOD convert from month to days)
 	uint16_t u16FullPower; // in days
@@ -200,6 +233,10 @@ struct ses_disp_ctx_s
 
 void SesDisp_Setup(struct ses_disp_ctx_s *pCtx);
 void SesDisp_Init(struct ses_disp_ctx_s *pCtx, uint8_t bEnable);
+void SesDisp_GetSchedStats(struct ses_disp_ctx_s *pCtx, struct sched_stats_s *pStats, uint8_t bClear);
+int32_t SesDisp_SetSlotCfg(struct ses_disp_ctx_s *pCtx, const struct slot_cfg_s *pCfg);
+void SesDisp_SetSlotId(struct ses_disp_ctx_s *pCtx, const uint8_t *pManuf, const uint8_t *pAddr);
+uint32_t SesDisp_GetSlot(struct ses_disp_ctx_s *pCtx, uint8_t eClass);
 
 static inline uint32_t _get_pos(uint32_t ulFlg)
 {
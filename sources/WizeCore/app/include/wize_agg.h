@@ -0,0 +1,115 @@
+/**
+  * @file: wize_agg.h
+  * @brief This file define the Wize aggregation API (several application
+  * records in one DATA message)
+  *
+  * @details Records are packed in the L7 payload with a TLV framing :
+  *
+  * | Type (1 byte) | Length (1 byte) | Value (Length bytes) | Type | ...
+  *
+  * The payload is sent (see WizeApi_Send) when the next record doesn't fit in
+  * L7TRANSMIT_LENGTH_MAX, when the maximum hold time is reached, or on demand.
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+/*!
+ * @addtogroup wize_api
+ * @{
+ *
+ */
+#ifndef _WIZE_AGG_H_
+#define _WIZE_AGG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "wize_api.h"
+#include "time_evt.h"
+
+/*!
+ * @def WIZE_AGG_BUF_SZ
+ * @brief This macro define the aggregation buffer size (the greatest L7
+ * payload)
+ */
+#ifndef WIZE_AGG_BUF_SZ
+	#define WIZE_AGG_BUF_SZ 229
+#endif
+
+/*!
+ * @def WIZE_AGG_TLV_HDR_SZ
+ * @brief This macro define the TLV record header size (type and length)
+ */
+#define WIZE_AGG_TLV_HDR_SZ 2
+
+/*!
+ * @brief This struct define an unpacked record
+ */
+typedef struct
+{
+	uint8_t u8Type;       /*!< The record type */
+	uint8_t u8Size;       /*!< The record value size */
+	const uint8_t *pData; /*!< The record value (in the received payload) */
+} wize_agg_rec_t;
+
+/*!
+ * @brief This struct define the aggregation statistics
+ */
+struct wize_agg_stats_s
+{
+	uint32_t u32RecNb;  /*!< Number of sent records */
+	uint32_t u32FrmNb;  /*!< Number of sent DATA messages */
+	uint32_t u32HoldNb; /*!< Number of sends on maximum hold time */
+	uint32_t u32FailNb; /*!< Number of failed sends */
+};
+
+/*!
+ * @brief This struct define the aggregation context
+ */
+struct wize_agg_s
+{
+	uint8_t aBuf[WIZE_AGG_BUF_SZ];    /*!< The L7 payload being filled */
+	struct wize_agg_stats_s sStats;   /*!< Statistics */
+	time_evt_t sTimeEvt;              /*!< Maximum hold timer */
+	uint32_t u32Event;                /*!< Event notified on maximum hold time */
+	uint8_t u8Size;                   /*!< Current payload size */
+	uint8_t u8RecNb;                  /*!< Current number of records */
+	uint8_t u8Type;                   /*!< Type of message (APP_DATA or APP_DATA_PRIO) */
+	uint8_t u8HoldSec;                /*!< Maximum hold time (s, 0 : send each record) */
+	uint8_t bTimer;                   /*!< A task is notified on maximum hold time */
+};
+
+wize_api_ret_e WizeAgg_Init(struct wize_agg_s *pCtx, uint8_t u8Type, uint8_t u8HoldSec, void *hTask, uint32_t u32Event);
+wize_api_ret_e WizeAgg_Add(struct wize_agg_s *pCtx, uint8_t u8RecType, const uint8_t *pRec, uint8_t u8Size);
+wize_api_ret_e WizeAgg_Flush(struct wize_agg_s *pCtx);
+wize_api_ret_e WizeAgg_Expire(struct wize_agg_s *pCtx);
+int32_t WizeAgg_Unpack(const uint8_t *pData, uint8_t u8Size, uint8_t *pu8Offset, wize_agg_rec_t *pRec);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _WIZE_AGG_H_ */
+
+/*! @} */
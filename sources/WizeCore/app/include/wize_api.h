@@ -67,10 +67,46 @@ typedef enum
 
 	WIZE_API_ACCESS_TIMEOUT,
 	WIZE_API_INVALID_PARAM,
+
+	WIZE_API_CANCELED,
 } wize_api_ret_e;
 
+struct adm_log_s;
+
+/*!
+ * @brief This struct define the completion of an asynchronous request
+ */
+typedef struct
+{
+	uint16_t u16Handle;       /*!< The request handle */
+	wize_api_ret_e eRet;      /*!< The request result (as the blocking call) */
+	const net_msg_t *pAdmCmd; /*!< The last received ADM command, if any (not copied) */
+	const net_msg_t *pAdmRsp; /*!< The last sent ADM response, if any (not copied) */
+	const struct adm_log_s *pAdmLog; /*!< All the ADM commands received in the session, if any (not copied) */
+} wize_api_cpl_t;
+
+/*!
+ * @brief This defines the asynchronous request completion call-back.
+ *
+ * It is called from the Wize stack task, so it must be short and must not
+ * block.
+ */
+typedef void (*pfWizeApi_Cpl_t)(const wize_api_cpl_t *pCpl, void *pArg);
+
+/*!
+ * @brief This struct define how the completion of an asynchronous request is
+ * notified (call-back and/or queue item)
+ */
+typedef struct
+{
+	pfWizeApi_Cpl_t pfCb; /*!< Completion call-back (may be NULL) */
+	void *pArg;           /*!< Completion call-back argument */
+	void *hQueue;         /*!< Completion queue of wize_api_cpl_t items (may be NULL) */
+} wize_api_notify_t;
+
 wize_api_ret_e WizeApi_GetAdmCmd(net_msg_t *pAdmMsg);
 wize_api_ret_e WizeApi_GetAdmRsp(net_msg_t *pAdmMsg);
+wize_api_ret_e WizeApi_GetAdmLog(struct adm_log_s *pLog);
 wize_api_ret_e WizeApi_GetStats(net_stats_t *pStats);
 wize_api_ret_e WizeApi_SetDeviceId(device_id_t *pDevId);
 wize_api_ret_e WizeApi_GetDeviceId(device_id_t *pDevId);
@@ -79,6 +115,23 @@ wize_api_ret_e WizeApi_ExecPing(void);
 wize_api_ret_e WizeApi_Send(uint8_t *pData, uint8_t u8Size, uint8_t u8Type);
 wize_api_ret_e WizeApi_SendEx(uint8_t *pData, uint8_t u8Size, uint8_t u8Type);
 
+wize_api_ret_e WizeApi_ExecPingAsync(const wize_api_notify_t *pNotify, uint16_t *pu16Handle);
+wize_api_ret_e WizeApi_SendAsync(uint8_t *pData, uint8_t u8Size, uint8_t u8Type, const wize_api_notify_t *pNotify, uint16_t *pu16Handle);
+wize_api_ret_e WizeApi_Cancel(uint16_t u16Handle);
+
+struct sched_stats_s;
+wize_api_ret_e WizeApi_GetSchedStats(struct sched_stats_s *pStats, uint8_t bClear);
+
+struct slot_cfg_s;
+wize_api_ret_e WizeApi_SetSlotCfg(const struct slot_cfg_s *pCfg);
+uint32_t WizeApi_GetSlot(uint8_t eClass);
+
+wize_api_ret_e WizeApi_SetAdmCmdMax(uint8_t u8CmdMax);
+
+struct adm_cmd_hdl_s;
+wize_api_ret_e WizeApi_RegisterAdmCmd(const struct adm_cmd_hdl_s *pHdl);
+wize_api_ret_e WizeApi_UnregisterAdmCmd(uint8_t u8CmdId);
+
 void WizeApi_Setup(phydev_t *pPhyDev);
 void WizeApi_Enable(uint8_t bFlag);
 
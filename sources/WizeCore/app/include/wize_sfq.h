@@ -0,0 +1,138 @@
+/**
+  * @file: wize_sfq.h
+  * @brief This file define the Wize store-and-forward API (persistent queue of
+  * pending DATA messages)
+  *
+  * @details The pending payloads are kept in a flash area (a circular list of
+  * pages), so they survive a reset and can be sent later, back to back, at a
+  * configured time of day.
+  *
+  * Page layout (double-word aligned) :
+  *
+  * | Page header (magic, sequence) | Obsolete mark | Record | Record | ...
+  *
+  * Record layout :
+  *
+  * | Header (magic, size, type, time) | Data (padded) | Commit mark | Consumed mark |
+  *
+  * A record is only taken into account once its commit mark is written (after
+  * the header and data), and it is dropped once its consumed mark is written.
+  * A page is marked obsolete before being erased. So, a power failure at any
+  * time leaves the queue consistent : at worst, the last record is lost (not
+  * committed) or the last sent one is sent again (not consumed).
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+/*!
+ * @addtogroup wize_api
+ * @{
+ *
+ */
+#ifndef _WIZE_SFQ_H_
+#define _WIZE_SFQ_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "wize_api.h"
+#include "time_evt.h"
+#include "img_storage.h"
+
+/*!
+ * @def WIZE_SFQ_PAGE_HDR_SZ
+ * @brief This macro define the page header size (header and obsolete mark)
+ */
+#define WIZE_SFQ_PAGE_HDR_SZ 16
+
+/*!
+ * @def WIZE_SFQ_REC_SZ
+ * @brief This macro define the flash size of a record from its data size
+ */
+#define WIZE_SFQ_REC_SZ(size) ( 8 + ( ( (uint32_t)(size) + 7 ) & ~7UL ) + 16 )
+
+/*!
+ * @brief This struct define a pending item
+ */
+typedef struct
+{
+	uint32_t u32Time;     /*!< Time when the item has been queued (epoch) */
+	uint8_t u8Type;       /*!< Type of message (APP_DATA or APP_DATA_PRIO) */
+	uint8_t u8Size;       /*!< The item size */
+	const uint8_t *pData; /*!< The item data (in flash) */
+} wize_sfq_item_t;
+
+/*!
+ * @brief This struct define the store-and-forward statistics
+ */
+struct wize_sfq_stats_s
+{
+	uint32_t u32PushNb;  /*!< Number of queued items */
+	uint32_t u32PopNb;   /*!< Number of sent (dropped) items */
+	uint32_t u32FullNb;  /*!< Number of items refused (queue full) */
+	uint32_t u32TornNb;  /*!< Number of not committed records found on setup */
+	uint32_t u32EraseNb; /*!< Number of erased pages */
+	uint32_t u32DrainNb; /*!< Number of drains */
+	uint32_t u32FailNb;  /*!< Number of drains stopped on failure */
+};
+
+/*!
+ * @brief This struct define the store-and-forward context
+ */
+struct wize_sfq_s
+{
+	pfWriteFlash_t pfWrite;          /*!< Flash write function */
+	pfEraseFlash_t pfErase;          /*!< Flash erase function */
+	uint32_t u32Addr;                /*!< Flash area address (page aligned) */
+	uint32_t u32PageSz;              /*!< Flash page size */
+	uint32_t u32Head;                /*!< Address of the oldest pending record */
+	uint32_t u32Tail;                /*!< Address of the next record to write */
+	uint32_t u32Seq;                 /*!< Sequence number of the last opened page */
+	uint16_t u16PageNb;              /*!< Number of pages in the flash area */
+	uint16_t u16HeadPage;            /*!< Page of the oldest pending record */
+	uint16_t u16TailPage;            /*!< Page of the next record to write */
+	uint16_t u16Count;               /*!< Number of pending items */
+	struct wize_sfq_stats_s sStats;  /*!< Statistics */
+	time_evt_t sTimeEvt;             /*!< Drain timer */
+	uint32_t u32Event;               /*!< Event notified on drain time */
+	uint32_t u32DrainTod;            /*!< Drain time of day (s) */
+	uint8_t bTimer;                  /*!< A task is notified on drain time */
+};
+
+int32_t WizeSfq_Setup(struct wize_sfq_s *pCtx, uint32_t u32Addr, uint32_t u32PageSz, uint16_t u16PageNb, pfWriteFlash_t pfWrite, pfEraseFlash_t pfErase);
+int32_t WizeSfq_Push(struct wize_sfq_s *pCtx, uint8_t u8Type, const uint8_t *pData, uint8_t u8Size);
+int32_t WizeSfq_Peek(struct wize_sfq_s *pCtx, wize_sfq_item_t *pItem);
+int32_t WizeSfq_Pop(struct wize_sfq_s *pCtx);
+uint16_t WizeSfq_GetCount(struct wize_sfq_s *pCtx);
+
+int32_t WizeSfq_SetDrain(struct wize_sfq_s *pCtx, void *hTask, uint32_t u32Event, uint32_t u32TimeOfDay);
+wize_api_ret_e WizeSfq_Drain(struct wize_sfq_s *pCtx, uint16_t u16MaxNb);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _WIZE_SFQ_H_ */
+
+/*! @} */
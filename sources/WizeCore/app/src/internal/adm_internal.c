@@ -47,6 +47,12 @@ extern "C" {
 
 #include <time.h>
 #include <string.h>
+#include <machine/endian.h>
+
+#if defined ( __OS__ ) && ( OS_FreeRTOS == 1 )
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
 
 
 static void _adm_unknown_(net_msg_t *pReqMsg, net_msg_t *pRspMsg);
@@ -56,6 +62,88 @@ static void _adm_write_key_(net_msg_t *pReqMsg, net_msg_t *pRspMsg);
 static void _adm_anndownload_(net_msg_t *pReqMsg, net_msg_t *pRspMsg);
 static void _adm_execping_(net_msg_t *pReqMsg, net_msg_t *pRspMsg);
 
+static const struct adm_cmd_hdl_s *_adm_find_(uint8_t u8CmdId);
+static void _adm_rsp_check_(const struct adm_cmd_hdl_s *pHdl, net_msg_t *pReqMsg, net_msg_t *pRspMsg);
+
+#if ADM_INT_CACHE_NB > 0
+static uint8_t _adm_cache_get_(const uint8_t *pKey, uint8_t u8KeySz, uint8_t *pOut, uint8_t u8OutMax);
+static void _adm_cache_put_(const uint8_t *pKey, uint8_t u8KeySz, const uint8_t *pVal, uint8_t u8ValSz, uint32_t u32Seq);
+#endif
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+
+/*
+ * Note : The application handlers are (un)registered from the application
+ * task(s), while the session dispatcher task look for them.
+ */
+#if defined ( __OS__ ) && ( OS_FreeRTOS == 1 )
+	#define ADM_INT_LOCK() taskENTER_CRITICAL()
+	#define ADM_INT_UNLOCK() taskEXIT_CRITICAL()
+#else
+	#define ADM_INT_LOCK()
+	#define ADM_INT_UNLOCK()
+#endif
+
+/*
+ * Note : The standard commands are executed (post) by the session dispatcher,
+ * which hold the context they act on (download, keys...), so they don't have
+ * pfPost here.
+ */
+static const struct adm_cmd_hdl_s aAdmCmdStd[] =
+{
+	{ .u8CmdId = ADM_READ_PARAM,   .pfRsp = _adm_read_param_,  .u8RspMax = ADM_INT_RSP_SZ_MAX },
+	{ .u8CmdId = ADM_WRITE_PARAM,  .pfRsp = _adm_write_param_, .u8RspMax = sizeof(admin_rsp_err_t) },
+	{ .u8CmdId = ADM_WRITE_KEY,    .pfRsp = _adm_write_key_,   .u8RspMax = sizeof(admin_rsp_err_t) },
+	{ .u8CmdId = ADM_ANNDOWNLOAD,  .pfRsp = _adm_anndownload_, .u8RspMax = sizeof(admin_rsp_err_t) },
+	{ .u8CmdId = ADM_EXECINSTPING, .pfRsp = _adm_execping_,    .u8RspMax = sizeof(admin_rsp_execinstping_t), .bDeferred = 1 },
+};
+
+static const struct adm_cmd_hdl_s sAdmCmdUnk =
+{
+	.u8CmdId = ADM_UNK_CMD, .pfRsp = _adm_unknown_, .u8RspMax = sizeof(admin_rsp_cmderr_t)
+};
+
+static const struct adm_cmd_hdl_s *aAdmCmdApp[ADM_INT_HDL_NB];
+
+#define ADM_CMD_STD_NB ( sizeof(aAdmCmdStd) / sizeof(aAdmCmdStd[0]) )
+
+#if ADM_INT_CACHE_NB > 0
+/*
+ * Note : A cached READ_PARAM response is keyed by the requested id list and
+ * hold the encoded ids and values (the header, with the RSSI, is always built
+ * again). An entry is dropped as soon as one of its parameters is written (see
+ * Param_AddWriteCb), all of them on Param_Init. As writes may come from other
+ * tasks, the cache is only accessed under ADM_INT_LOCK, and u32AdmCacheSeq is
+ * changed on each write : a response is only cached if no write happened while
+ * it was built. Parameters updated through their address (the clock, by the
+ * time manager) are never cached.
+ */
+struct adm_cache_s {
+	uint8_t aKey[ADM_INT_CACHE_KEY_SZ]; // requested parameter ids
+	uint8_t aVal[ADM_INT_CACHE_VAL_SZ]; // encoded response (without header)
+	uint8_t u8KeySz;                    // number of ids (0 : free entry)
+	uint8_t u8ValSz;                    // encoded response size
+	uint8_t u8Used;                     // last use (LRU)
+};
+
+static struct adm_cache_s aAdmCache[ADM_INT_CACHE_NB];
+static volatile uint32_t u32AdmCacheSeq;
+static uint8_t u8AdmCacheUse;
+static param_write_nb_s sAdmCacheWriteNb = { .pf_Cb = AdmInt_ParamChanged };
+
+static const uint8_t aAdmCacheVolatile[] = {
+	CLOCK_CURRENT_EPOC,
+	CLOCK_OFFSET_CORRECTION,
+};
+#endif
+
+/*!
+ * @}
+ * @endcond
+ */
 
 /******************************************************************************/
 
@@ -63,6 +151,12 @@ static void _adm_execping_(net_msg_t *pReqMsg, net_msg_t *pRspMsg);
   * @brief This function treat the command and build the response. The command
   * is not effectively executed here.
   *
+  * @details The response is built by the command handler (standard or
+  * registered one, see AdmInt_Register) directly into the response message. A
+  * response greater than the handler u8RspMax or than L7TRANSMIT_LENGTH_MAX is
+  * rejected : it is replaced by the unknown command one, so the command is not
+  * executed.
+  *
   * @param [in,out] pReqMsg Pointer on request message
   * @param [in,out] pRspMsg Pointer on response message
   *
@@ -72,49 +166,332 @@ static void _adm_execping_(net_msg_t *pReqMsg, net_msg_t *pRspMsg);
   */
 uint8_t AdmInt_PreCmd(net_msg_t *pReqMsg, net_msg_t *pRspMsg)
 {
+	const struct adm_cmd_hdl_s *pHdl = _adm_find_(pReqMsg->pData[0]); //L7CommandId
 	uint8_t ret = 1;
 	// check if CMD Id has not previously been received
 	if (pReqMsg->u16Id != pRspMsg->u16Id)
 	{
 		pRspMsg->u8Type = APP_ADMIN;
 		pRspMsg->u16Id = pReqMsg->u16Id;
-		switch (pReqMsg->pData[0]) //L7CommandId
+		if (pHdl->bDeferred)
 		{
-			case ADM_READ_PARAM :
-				_adm_read_param_(pReqMsg, pRspMsg);
-				break;
-			case ADM_WRITE_PARAM :
-				_adm_write_param_(pReqMsg, pRspMsg);
-				break;
-			case ADM_WRITE_KEY :
-				_adm_write_key_(pReqMsg, pRspMsg);
-				break;
-			case ADM_ANNDOWNLOAD :
-				_adm_anndownload_(pReqMsg, pRspMsg);
-				break;
-			case ADM_EXECINSTPING :
-				// response not yet available
-				ret = 0;
-				break;
-			default :
-				_adm_unknown_(pReqMsg, pRspMsg);
-				break;
+			// response not yet available
+			ret = 0;
+		}
+		else
+		{
+			pHdl->pfRsp(pReqMsg, pRspMsg);
+			_adm_rsp_check_(pHdl, pReqMsg, pRspMsg);
 		}
 	}
 	else // CMD was previously processed
 	{
 		// if RSP is available, send it (previously build RSP)
-		// else, build RSP => EXEC_PING case only
-		if (pReqMsg->pData[0] == ADM_EXECINSTPING)
+		// else, build RSP => EXEC_PING case
+		if (pHdl->bDeferred)
 		{
 			// build rsp
-			_adm_execping_(pReqMsg, pRspMsg);
+			pHdl->pfRsp(pReqMsg, pRspMsg);
+			_adm_rsp_check_(pHdl, pReqMsg, pRspMsg);
 		}
 		ret = 2;
 	}
 	return ret;
 }
 
+/*!
+  * @brief This function execute a registered (application) command, once its
+  * response has been sent. The standard commands are executed by the session
+  * dispatcher.
+  *
+  * @param [in,out] pReqMsg Pointer on request message
+  * @param [in,out] pRspMsg Pointer on response message
+  *
+  * @return None
+  */
+void AdmInt_PostCmd(net_msg_t *pReqMsg, net_msg_t *pRspMsg)
+{
+	const struct adm_cmd_hdl_s *pHdl = _adm_find_(pReqMsg->pData[0]);
+	if (pHdl->pfPost)
+	{
+		pHdl->pfPost(pReqMsg, pRspMsg);
+	}
+}
+
+/*!
+  * @brief This function register an application (e.g. manufacturer) command
+  * handler
+  *
+  * @details The handler is not copied, it must remain valid until it is
+  * unregistered. A standard command can't be replaced. Registering again the
+  * same command id replace the previous handler.
+  *
+  * @param [in] pHdl Pointer on the command handler
+  *
+  * @retval  0 Success
+  * @retval -1 Invalid handler (standard command id, response too long...)
+  * @retval -2 No more free handler
+  */
+int32_t AdmInt_Register(const struct adm_cmd_hdl_s *pHdl)
+{
+	uint8_t i;
+	uint8_t u8Free = ADM_INT_HDL_NB;
+
+	if ( !pHdl || !pHdl->pfRsp || (pHdl->u8CmdId == ADM_UNK_CMD) ||
+		 (pHdl->u8RspMax < sizeof(admin_rsp_cmderr_t)) ||
+		 (pHdl->u8RspMax > ADM_INT_RSP_SZ_MAX) )
+	{
+		return -1;
+	}
+	for (i = 0; i < ADM_CMD_STD_NB; i++)
+	{
+		if (aAdmCmdStd[i].u8CmdId == pHdl->u8CmdId)
+		{
+			return -1;
+		}
+	}
+	ADM_INT_LOCK();
+	for (i = 0; i < ADM_INT_HDL_NB; i++)
+	{
+		if ( aAdmCmdApp[i] && (aAdmCmdApp[i]->u8CmdId == pHdl->u8CmdId) )
+		{
+			u8Free = i;
+			break;
+		}
+		if ( !aAdmCmdApp[i] && (u8Free == ADM_INT_HDL_NB) )
+		{
+			u8Free = i;
+		}
+	}
+	if (u8Free == ADM_INT_HDL_NB)
+	{
+		ADM_INT_UNLOCK();
+		return -2;
+	}
+	aAdmCmdApp[u8Free] = pHdl;
+	ADM_INT_UNLOCK();
+	return 0;
+}
+
+/*!
+  * @brief This function unregister an application command handler
+  *
+  * @param [in] u8CmdId The command id
+  *
+  * @retval  0 Success
+  * @retval -1 This command id is not registered
+  */
+int32_t AdmInt_Unregister(uint8_t u8CmdId)
+{
+	uint8_t i;
+	int32_t i32Ret = -1;
+	ADM_INT_LOCK();
+	for (i = 0; i < ADM_INT_HDL_NB; i++)
+	{
+		if ( aAdmCmdApp[i] && (aAdmCmdApp[i]->u8CmdId == u8CmdId) )
+		{
+			aAdmCmdApp[i] = NULL;
+			i32Ret = 0;
+			break;
+		}
+	}
+	ADM_INT_UNLOCK();
+	return i32Ret;
+}
+
+/*!
+  * @brief This function clear the READ_PARAM responses cache and register the
+  * parameter write notification
+  *
+  * @return None
+  */
+void AdmInt_CacheSetup(void)
+{
+#if ADM_INT_CACHE_NB > 0
+	ADM_INT_LOCK();
+	memset(aAdmCache, 0, sizeof(aAdmCache));
+	u8AdmCacheUse = 0;
+	u32AdmCacheSeq++;
+	ADM_INT_UNLOCK();
+	Param_AddWriteCb(&sAdmCacheWriteNb);
+#endif
+}
+
+/*!
+  * @brief This function drop the cached READ_PARAM responses that hold the
+  * given parameter (see Param_AddWriteCb).
+  *
+  * @param [in] u8ParamId The written parameter id (PARAM_ID_ALL : all of them)
+  *
+  * @return None
+  */
+void AdmInt_ParamChanged(uint8_t u8ParamId)
+{
+#if ADM_INT_CACHE_NB > 0
+	uint8_t i;
+	ADM_INT_LOCK();
+	u32AdmCacheSeq++;
+	for (i = 0; i < ADM_INT_CACHE_NB; i++)
+	{
+		if ( aAdmCache[i].u8KeySz && ( (u8ParamId == PARAM_ID_ALL) ||
+			 memchr(aAdmCache[i].aKey, u8ParamId, aAdmCache[i].u8KeySz) ) )
+		{
+			aAdmCache[i].u8KeySz = 0;
+		}
+	}
+	ADM_INT_UNLOCK();
+#else
+	(void)u8ParamId;
+#endif
+}
+
+/*!
+  * @static
+  * @brief This function find the handler of the given command
+  *
+  * @param [in] u8CmdId The command id
+  *
+  * @return The command handler (the unknown command one if not found)
+  */
+static const struct adm_cmd_hdl_s *_adm_find_(uint8_t u8CmdId)
+{
+	const struct adm_cmd_hdl_s *pHdl;
+	uint8_t i;
+	for (i = 0; i < ADM_CMD_STD_NB; i++)
+	{
+		if (aAdmCmdStd[i].u8CmdId == u8CmdId)
+		{
+			return &(aAdmCmdStd[i]);
+		}
+	}
+	for (i = 0; i < ADM_INT_HDL_NB; i++)
+	{
+		pHdl = aAdmCmdApp[i];
+		if ( pHdl && (pHdl->u8CmdId == u8CmdId) )
+		{
+			return pHdl;
+		}
+	}
+	return &sAdmCmdUnk;
+}
+
+/*!
+  * @static
+  * @brief This function reject a response greater than the handler u8RspMax
+  * or than L7TRANSMIT_LENGTH_MAX (replaced by the unknown command one)
+  *
+  * @param [in]     pHdl    Pointer on the command handler
+  * @param [in]     pReqMsg Pointer on request message
+  * @param [in,out] pRspMsg Pointer on response message
+  *
+  * @return None
+  */
+static void _adm_rsp_check_(const struct adm_cmd_hdl_s *pHdl, net_msg_t *pReqMsg, net_msg_t *pRspMsg)
+{
+	uint8_t u8L7TransLenMax;
+
+	Param_Access(L7TRANSMIT_LENGTH_MAX, (uint8_t*)(&u8L7TransLenMax), 0);
+	if ( (pRspMsg->u8Size > pHdl->u8RspMax) || (pRspMsg->u8Size > u8L7TransLenMax) )
+	{
+		_adm_unknown_(pReqMsg, pRspMsg);
+	}
+}
+
+#if ADM_INT_CACHE_NB > 0
+/*!
+  * @static
+  * @brief This function get a cached READ_PARAM response
+  *
+  * @param [in]  pKey     Pointer on the requested parameter ids
+  * @param [in]  u8KeySz  Number of requested parameter ids
+  * @param [out] pOut     Pointer on the response (after its header)
+  * @param [in]  u8OutMax The greatest response size (after its header)
+  *
+  * @return The response size (0 : not cached)
+  */
+static uint8_t _adm_cache_get_(const uint8_t *pKey, uint8_t u8KeySz, uint8_t *pOut, uint8_t u8OutMax)
+{
+	uint8_t i;
+	uint8_t u8ValSz = 0;
+	if (!u8KeySz)
+	{
+		return 0;
+	}
+	ADM_INT_LOCK();
+	for (i = 0; i < ADM_INT_CACHE_NB; i++)
+	{
+		if ( (aAdmCache[i].u8KeySz == u8KeySz) &&
+			 (memcmp(aAdmCache[i].aKey, pKey, u8KeySz) == 0) )
+		{
+			// else, L7TRANSMIT_LENGTH_MAX has been reduced, build it again
+			if (aAdmCache[i].u8ValSz <= u8OutMax)
+			{
+				u8ValSz = aAdmCache[i].u8ValSz;
+				memcpy(pOut, aAdmCache[i].aVal, u8ValSz);
+				aAdmCache[i].u8Used = ++u8AdmCacheUse;
+			}
+			break;
+		}
+	}
+	ADM_INT_UNLOCK();
+	return u8ValSz;
+}
+
+/*!
+  * @static
+  * @brief This function cache a READ_PARAM response (the least recently used
+  * entry is replaced)
+  *
+  * @param [in] pKey    Pointer on the requested parameter ids
+  * @param [in] u8KeySz Number of requested parameter ids
+  * @param [in] pVal    Pointer on the response (after its header)
+  * @param [in] u8ValSz The response size (after its header)
+  * @param [in] u32Seq  The write sequence when the response has been built
+  *
+  * @return None
+  */
+static void _adm_cache_put_(const uint8_t *pKey, uint8_t u8KeySz, const uint8_t *pVal, uint8_t u8ValSz, uint32_t u32Seq)
+{
+	struct adm_cache_s *pEntry = &(aAdmCache[0]);
+	uint8_t i;
+
+	if ( !u8KeySz || (u8KeySz > ADM_INT_CACHE_KEY_SZ) || (u8ValSz > ADM_INT_CACHE_VAL_SZ) )
+	{
+		return;
+	}
+	for (i = 0; i < sizeof(aAdmCacheVolatile); i++)
+	{
+		if ( memchr(pKey, aAdmCacheVolatile[i], u8KeySz) )
+		{
+			return;
+		}
+	}
+	ADM_INT_LOCK();
+	for (i = 0; i < ADM_INT_CACHE_NB; i++)
+	{
+		if ( !aAdmCache[i].u8KeySz )
+		{
+			pEntry = &(aAdmCache[i]);
+			break;
+		}
+		if ( (uint8_t)(u8AdmCacheUse - aAdmCache[i].u8Used) > (uint8_t)(u8AdmCacheUse - pEntry->u8Used) )
+		{
+			pEntry = &(aAdmCache[i]);
+		}
+	}
+	pEntry->u8KeySz = 0;
+	memcpy(pEntry->aKey, pKey, u8KeySz);
+	memcpy(pEntry->aVal, pVal, u8ValSz);
+	pEntry->u8ValSz = u8ValSz;
+	pEntry->u8Used = ++u8AdmCacheUse;
+	if (u32Seq == u32AdmCacheSeq)
+	{
+		pEntry->u8KeySz = u8KeySz;
+	}
+	ADM_INT_UNLOCK();
+}
+#endif
+
 /******************************************************************************/
 
 /*!
@@ -129,7 +506,7 @@ static void _adm_unknown_(net_msg_t *pReqMsg, net_msg_t *pRspMsg)
 {
 	((admin_rsp_cmderr_t*)(pRspMsg->pData))->L7ResponseId = pReqMsg->pData[0];
 	((admin_rsp_cmderr_t*)(pRspMsg->pData))->L7ErrorCode = ADM_UNK_CMD;
-	pReqMsg->u8Size = sizeof(admin_rsp_cmderr_t);
+	pRspMsg->u8Size = sizeof(admin_rsp_cmderr_t);
 }
 
 /*!
@@ -150,6 +527,9 @@ static void _adm_read_param_(net_msg_t *pReqMsg, net_msg_t *pRspMsg)
 
 	uint8_t *pIn = &(pReqMsg->pData[1]);
 	uint8_t *pOut = pRspMsg->pData;
+#if ADM_INT_CACHE_NB > 0
+	uint32_t u32Seq;
+#endif
 
 	// Warning : the response buffer size must equal the L7TransLenMax
 	Param_Access(L7TRANSMIT_LENGTH_MAX, (uint8_t*)(&u8L7TransLenMax), 0);
@@ -164,6 +544,16 @@ static void _adm_read_param_(net_msg_t *pReqMsg, net_msg_t *pRspMsg)
 
 	// update the position with header
 	pOut += sizeof(admin_rsp_t);
+#if ADM_INT_CACHE_NB > 0
+	// already built
+	idx = _adm_cache_get_(pIn, u8NbParam, pOut, u8L7TransLenMax - sizeof(admin_rsp_t));
+	if (idx)
+	{
+		pRspMsg->u8Size += idx;
+		return;
+	}
+	u32Seq = u32AdmCacheSeq;
+#endif
 	for (idx = 0; idx < u8NbParam; idx++)
 	{
 		u8ParamId = pIn[idx];
@@ -220,6 +610,14 @@ static void _adm_read_param_(net_msg_t *pReqMsg, net_msg_t *pRspMsg)
 			break;
 		}
 	}
+#if ADM_INT_CACHE_NB > 0
+	if (((admin_rsp_t*)pRspMsg->pData)->L7ErrorCode == ADM_NONE)
+	{
+		_adm_cache_put_(pIn, u8NbParam,
+			&(pRspMsg->pData[sizeof(admin_rsp_t)]),
+			pRspMsg->u8Size - sizeof(admin_rsp_t), u32Seq);
+	}
+#endif
 }
 
 /*!
@@ -639,80 +1037,6 @@ static void _adm_anndownload_(net_msg_t *pReqMsg, net_msg_t *pRspMsg)
 	}
 }
 
-/*
-typedef void (*pfCmd_t)(net_msg_t *pReqMsg, net_msg_t *pRspMsg);
-
-struct exec_cmd_s{
-	pfCmd_t pfCmd;
-	uint8_t u8CmdId;
-	union {
-		uint8_t u8State;
-		struct
-		{
-			uint8_t rsp_ready:1;
-			uint8_t cmd_imm:1;
-		};
-	};
-};
-
-const struct exec_cmd_s aExecCmd[] =
-{
-	[0] = {	.u8CmdId = ADM_READ_PARAM,   .pfCmd = _adm_read_param_,  .rsp_ready = 1, .cmd_imm = 0},
-	[1] = {	.u8CmdId = ADM_WRITE_PARAM,  .pfCmd = _adm_write_param_, .rsp_ready = 1, .cmd_imm = 0},
-	[2] = {	.u8CmdId = ADM_ANNDOWNLOAD,  .pfCmd = _adm_anndownload_, .rsp_ready = 1, .cmd_imm = 0},
-	[3] = {	.u8CmdId = ADM_EXECINSTPING, .pfCmd = _adm_execping_,    .rsp_ready = 0, .cmd_imm = 1},
-	[4] = {	.u8CmdId = ADM_WRITE_KEY,    .pfCmd = _adm_write_key_,   .rsp_ready = 1, .cmd_imm = 0},
-	// UNKNOWN CMD must be the last one
-	[5] = {	.u8CmdId = 0xFF,             .pfCmd = _adm_unknown_,     .rsp_ready = 1, .cmd_imm = 0},
-};
-
-uint8_t AdmInt_PreCmd(net_msg_t *pReqMsg, net_msg_t *pRspMsg)
-{
-	uint8_t ret = 1;
-
-
-	uint8_t i;
-	const struct exec_cmd_s *pExecCmd = &(aExecCmd[sizeof(aExecCmd)-1]);
-	for (i =0; i < sizeof(aExecCmd); i++)
-	{
-		if (aExecCmd[i].u8CmdId == pReqMsg->pData[0])
-		{
-			if(aExecCmd[i].pfCmd)
-			{
-				pExecCmd = &(aExecCmd[i]);
-				break;
-			}
-			break;
-		}
-	}
-
-	// check if CMD Id has not previously been received
-	if (pReqMsg->u16Id != pRspMsg->u16Id)
-	{
-		pRspMsg->u8Type = APP_ADMIN;
-		pRspMsg->u16Id = pReqMsg->u16Id;
-
-		if (pExecCmd->rsp_ready == 1)
-		{
-			pExecCmd->pfCmd(pReqMsg, pRspMsg);
-		}
-		ret = pExecCmd->u8State;
-
-	}
-	else // CMD was previously processed
-	{
-		if (pExecCmd->rsp_ready == 0)
-		{
-			pExecCmd->pfCmd(pReqMsg, pRspMsg);
-		}
-		ret = pExecCmd->u8State;
-		// if RSP is available, send it (previously build RSP)
-		// else, build RSP => EXEC_PING case only
-	}
-	return ret;
-}
-*/
-
 #ifdef __cplusplus
 }
 #endif
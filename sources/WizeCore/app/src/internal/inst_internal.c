@@ -198,7 +198,15 @@ void InstInt_Add(struct ping_reply_ctx_s *ping_reply_ctx, net_msg_t *pNetMsg)
 	// fill the new one
 	memcpy(&(pNew->xPingReply), pNetMsg->pData, 8);
 	pNew->xPingReply.L7RssiDownstream = pNetMsg->u8Rssi;
-    time(&t);
+	// Prefer the sync word detection time, if the net layer gives it
+	if (pNetMsg->u32RxEpoch)
+	{
+		t = pNetMsg->u32RxEpoch;
+	}
+	else
+	{
+		time(&t);
+	}
 	pNew->u32RecvEpoch = t - EPOCH_UNIX_TO_OURS;
 	pNew->u32PongEpoch = pNetMsg->u32Epoch;
 	pNew->i16PongFreqOff = pNetMsg->i16TxFreqOffset;
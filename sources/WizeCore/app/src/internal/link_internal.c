@@ -0,0 +1,441 @@
+/**
+  * @file link_internal.c
+  * @brief This file implement the link adaptation (uplink TX power and
+  * modulation selection).
+  *
+  * @details
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  *
+  */
+
+/*!
+ * @addtogroup wize_app
+ * @{
+ *
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "link_internal.h"
+
+#include <string.h>
+
+/*
+ * Note : The link is modeled by one value, the uplink margin, that is the RSSI
+ * received by the gateway with full TX power minus the gateway sensitivity with
+ * WM2400. The margin expected with a given setting is :
+ *
+ *   margin(mod, pwr) = i16Margin - attenuation(pwr) - penalty(mod)
+ *
+ * The selection take the cheapest setting (faster modulation first, then lower
+ * TX power) that keep the target margin. The TX power and modulation given by
+ * the parameters (TX_POWER, RF_UPLINK_MOD) are the most robust setting allowed,
+ * so they are used as long as the margin is unknown and on fallback.
+ *
+ * The margin is estimated from :
+ * - the PONG RSSI upstream (the gateway view of our PING), that is a direct
+ *   measure. It also calibrate the downlink to uplink correction.
+ * - the received ADM command RSSI (downlink), corrected to uplink, and limited
+ *   by the noise level. It is filtered by an EWMA.
+ */
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+
+#define LINK_Q 4
+
+/*! TX power attenuation (dB) */
+static const uint8_t _aPwrAtt_[PHY_NB_PWR] = {
+	[PHY_PMAX_minus_0db]  = 0,
+	[PHY_PMAX_minus_6db]  = 6,
+	[PHY_PMAX_minus_12db] = 12,
+};
+
+/*! Modulation sensitivity penalty, relative to WM2400 (dB) */
+static const uint8_t _aModPen_[PHY_NB_MOD] = {
+	[PHY_WM2400] = 0,
+	[PHY_WM4800] = 3,
+	[PHY_WM6400] = 5,
+};
+
+/*!
+ * @}
+ * @endcond
+ */
+
+static int16_t _link_margin_(struct link_adapt_ctx_s *pCtx, uint8_t eMod, uint8_t ePower);
+static uint8_t _link_rank_(uint8_t eMod, uint8_t ePower);
+static void _link_select_(
+	struct link_adapt_ctx_s *pCtx,
+	uint8_t eBaseMod, uint8_t eBasePower, int16_t i16Req,
+	uint8_t *pMod, uint8_t *pPower);
+static void _link_sample_(struct link_adapt_ctx_s *pCtx, int16_t i16Sample, uint8_t bSeed);
+
+/*!
+ * @brief This function initialize the link adaptation context
+ *
+ * @param [in] pCtx Pointer on the link adaptation context
+ *
+ * @return None
+ */
+void LinkInt_Init(struct link_adapt_ctx_s *pCtx)
+{
+	if (pCtx)
+	{
+		memset(pCtx, 0, sizeof(struct link_adapt_ctx_s));
+		pCtx->sCfg.u8Enable    = LINK_ADAPT_EN;
+		pCtx->sCfg.u8Sens      = LINK_SENS_RSSI;
+		pCtx->sCfg.u8Margin    = LINK_DB(LINK_MARGIN_DB);
+		pCtx->sCfg.u8Hyst      = LINK_DB(LINK_HYST_DB);
+		pCtx->sCfg.u8SnrMin    = LINK_DB(LINK_SNR_MIN_DB);
+		pCtx->sCfg.u8StepNb    = LINK_STEP_NB;
+		pCtx->sCfg.u8FailNb    = LINK_FAIL_NB;
+		pCtx->sCfg.i8DwnOffset = 0;
+		LinkInt_Fallback(pCtx);
+		pCtx->sStats.u16Fallback = 0;
+	}
+}
+
+/*!
+ * @brief This function treat the result of an install session (best PONG)
+ *
+ * @param [in] pCtx      Pointer on the link adaptation context
+ * @param [in] u8RssiUp  RSSI of our PING, measured by the gateway
+ * @param [in] u8RssiDwn RSSI of the gateway PONG, measured by the device
+ *
+ * @return None
+ */
+void LinkInt_Pong(struct link_adapt_ctx_s *pCtx, uint8_t u8RssiUp, uint8_t u8RssiDwn)
+{
+	int16_t i16Up;
+	int16_t i16Off;
+	if (pCtx)
+	{
+		// Uplink RSSI, as if it was sent with full power
+		i16Up = (int16_t)u8RssiUp;
+		if (pCtx->ePower < PHY_NB_PWR)
+		{
+			i16Up += LINK_DB(_aPwrAtt_[pCtx->ePower]);
+		}
+		// Learn the downlink to uplink correction
+		i16Off = i16Up - (int16_t)u8RssiDwn;
+		if (i16Off > INT8_MAX) { i16Off = INT8_MAX; }
+		if (i16Off < INT8_MIN) { i16Off = INT8_MIN; }
+		pCtx->i8DwnOffset = (int8_t)i16Off;
+
+		_link_sample_(pCtx, i16Up - pCtx->sCfg.u8Sens, 1);
+		pCtx->sStats.u16PongNb++;
+	}
+}
+
+/*!
+ * @brief This function treat the RSSI of a received downlink frame
+ *
+ * @param [in] pCtx   Pointer on the link adaptation context
+ * @param [in] u8Rssi RSSI of the received frame
+ *
+ * @return None
+ */
+void LinkInt_Dwn(struct link_adapt_ctx_s *pCtx, uint8_t u8Rssi)
+{
+	int16_t i16Sample;
+	int16_t i16Snr;
+	if (pCtx && u8Rssi)
+	{
+		i16Sample = (int16_t)u8Rssi + pCtx->i8DwnOffset - pCtx->sCfg.u8Sens;
+		// A frame heard close to the noise is not an evidence of a good link
+		if (pCtx->u8Noise)
+		{
+			i16Snr = (int16_t)u8Rssi - Phy_NoiseToRssi(pCtx->u8Noise) - pCtx->sCfg.u8SnrMin;
+			if (i16Snr < i16Sample)
+			{
+				i16Sample = i16Snr;
+			}
+		}
+		_link_sample_(pCtx, i16Sample, 0);
+		pCtx->sStats.u16DwnNb++;
+	}
+}
+
+/*!
+ * @brief This function set the current noise level
+ *
+ * @param [in] pCtx    Pointer on the link adaptation context
+ * @param [in] u8Noise Noise level, as PHY_CTL_GET_NOISE (opposite of the dBm
+ *                     value, 0 : unknown)
+ *
+ * @return None
+ */
+void LinkInt_Noise(struct link_adapt_ctx_s *pCtx, uint8_t u8Noise)
+{
+	if (pCtx)
+	{
+		pCtx->u8Noise = u8Noise;
+	}
+}
+
+/*!
+ * @brief This function treat an exchange failure (e.g. no PONG received)
+ *
+ * @details After sCfg.u8FailNb consecutive failures, the link adaptation fall
+ * back to the parameters setting.
+ *
+ * @param [in] pCtx Pointer on the link adaptation context
+ *
+ * @return None
+ */
+void LinkInt_Fail(struct link_adapt_ctx_s *pCtx)
+{
+	if (pCtx)
+	{
+		pCtx->u8GoodNb = 0;
+		pCtx->u8FailNb++;
+		if (pCtx->u8FailNb >= pCtx->sCfg.u8FailNb)
+		{
+			LinkInt_Fallback(pCtx);
+		}
+	}
+}
+
+/*!
+ * @brief This function fall back to the parameters setting (TX_POWER,
+ * RF_UPLINK_MOD) until a new sample is received
+ *
+ * @param [in] pCtx Pointer on the link adaptation context
+ *
+ * @return None
+ */
+void LinkInt_Fallback(struct link_adapt_ctx_s *pCtx)
+{
+	if (pCtx)
+	{
+		pCtx->i16Margin = 0;
+		pCtx->i8DwnOffset = pCtx->sCfg.i8DwnOffset;
+		pCtx->bValid = 0;
+		pCtx->bNewSample = 0;
+		pCtx->u8GoodNb = 0;
+		pCtx->u8FailNb = 0;
+		pCtx->eMod = PHY_NB_MOD;
+		pCtx->ePower = PHY_NB_PWR;
+		pCtx->sStats.u16Fallback++;
+	}
+}
+
+/*!
+ * @brief This function select the TX modulation and power
+ *
+ * @details The given medium configuration hold the parameters setting, that is
+ * the most robust allowed. Its TX modulation and power are replaced by the
+ * selected ones.
+ *
+ * @param [in]     pCtx       Pointer on the link adaptation context
+ * @param [in,out] pMediumCfg Pointer on the medium configuration
+ *
+ * @return None
+ */
+void LinkInt_Apply(struct link_adapt_ctx_s *pCtx, struct medium_cfg_s *pMediumCfg)
+{
+	uint8_t eBaseMod, eBasePower;
+	uint8_t eMod, ePower;
+	int16_t i16Req;
+
+	if ( !pCtx || !pMediumCfg )
+	{
+		return;
+	}
+	eBaseMod = (uint8_t)pMediumCfg->eTxModulation;
+	eBasePower = (uint8_t)pMediumCfg->eTxPower;
+	if ( eBaseMod >= PHY_NB_MOD || eBasePower >= PHY_NB_PWR )
+	{
+		return;
+	}
+
+	if ( !pCtx->sCfg.u8Enable || !pCtx->bValid )
+	{
+		pCtx->eMod = eBaseMod;
+		pCtx->ePower = eBasePower;
+		pCtx->u8GoodNb = 0;
+		return;
+	}
+
+	// The parameters setting may have been changed (e.g. by the head-end)
+	if ( pCtx->eMod < eBaseMod || pCtx->eMod >= PHY_NB_MOD ||
+	     pCtx->ePower < eBasePower || pCtx->ePower >= PHY_NB_PWR )
+	{
+		pCtx->eMod = eBaseMod;
+		pCtx->ePower = eBasePower;
+		pCtx->u8GoodNb = 0;
+	}
+
+	i16Req = pCtx->sCfg.u8Margin << LINK_Q;
+	if ( _link_margin_(pCtx, pCtx->eMod, pCtx->ePower) < i16Req )
+	{
+		// Current setting doesn't keep the target margin : step up now
+		_link_select_(pCtx, eBaseMod, eBasePower, i16Req, &eMod, &ePower);
+		if ( _link_rank_(eMod, ePower) > _link_rank_(pCtx->eMod, pCtx->ePower) )
+		{
+			pCtx->eMod = eMod;
+			pCtx->ePower = ePower;
+			pCtx->sStats.u16StepUp++;
+		}
+		pCtx->u8GoodNb = 0;
+	}
+	else
+	{
+		// Step down only with hysteresis and enough consecutive good samples
+		i16Req += pCtx->sCfg.u8Hyst << LINK_Q;
+		_link_select_(pCtx, eBaseMod, eBasePower, i16Req, &eMod, &ePower);
+		if ( _link_rank_(eMod, ePower) < _link_rank_(pCtx->eMod, pCtx->ePower) )
+		{
+			if (pCtx->bNewSample)
+			{
+				pCtx->u8GoodNb++;
+			}
+			if (pCtx->u8GoodNb >= pCtx->sCfg.u8StepNb)
+			{
+				pCtx->eMod = eMod;
+				pCtx->ePower = ePower;
+				pCtx->u8GoodNb = 0;
+				pCtx->sStats.u16StepDown++;
+			}
+		}
+		else
+		{
+			pCtx->u8GoodNb = 0;
+		}
+	}
+	pCtx->bNewSample = 0;
+
+	pMediumCfg->eTxModulation = (phy_mod_e)pCtx->eMod;
+	pMediumCfg->eTxPower = (phy_power_e)pCtx->ePower;
+}
+
+/******************************************************************************/
+
+/*!
+ * @static
+ * @brief This function compute the margin expected with the given setting
+ *
+ * @param [in] pCtx   Pointer on the link adaptation context
+ * @param [in] eMod   The modulation
+ * @param [in] ePower The TX power
+ *
+ * @return The expected margin (Q4)
+ */
+static int16_t _link_margin_(struct link_adapt_ctx_s *pCtx, uint8_t eMod, uint8_t ePower)
+{
+	return pCtx->i16Margin
+		- (LINK_DB(_aPwrAtt_[ePower]) << LINK_Q)
+		- (LINK_DB(_aModPen_[eMod]) << LINK_Q);
+}
+
+/*!
+ * @static
+ * @brief This function give the rank of the given setting (0 is the cheapest)
+ *
+ * @param [in] eMod   The modulation
+ * @param [in] ePower The TX power
+ *
+ * @return The rank
+ */
+static uint8_t _link_rank_(uint8_t eMod, uint8_t ePower)
+{
+	return (PHY_NB_MOD - 1 - eMod) * PHY_NB_PWR + (PHY_NB_PWR - 1 - ePower);
+}
+
+/*!
+ * @static
+ * @brief This function select the cheapest setting that keep the required
+ * margin, from the enabled and allowed ones
+ *
+ * @param [in]  pCtx       Pointer on the link adaptation context
+ * @param [in]  eBaseMod   The most robust modulation allowed
+ * @param [in]  eBasePower The highest TX power allowed
+ * @param [in]  i16Req     The required margin (Q4)
+ * @param [out] pMod       The selected modulation
+ * @param [out] pPower     The selected TX power
+ *
+ * @return None
+ */
+static void _link_select_(
+	struct link_adapt_ctx_s *pCtx,
+	uint8_t eBaseMod, uint8_t eBasePower, int16_t i16Req,
+	uint8_t *pMod, uint8_t *pPower)
+{
+	int8_t eMod, ePower;
+	int8_t eModMax, ePowerMax;
+
+	eModMax = (pCtx->sCfg.u8Enable & LINK_ADAPT_MOD)?(PHY_NB_MOD - 1):(eBaseMod);
+	ePowerMax = (pCtx->sCfg.u8Enable & LINK_ADAPT_PWR)?(PHY_NB_PWR - 1):(eBasePower);
+
+	// Faster modulation first (shorter airtime), then lower TX power
+	for (eMod = eModMax; eMod >= (int8_t)eBaseMod; eMod--)
+	{
+		for (ePower = ePowerMax; ePower >= (int8_t)eBasePower; ePower--)
+		{
+			if ( _link_margin_(pCtx, eMod, ePower) >= i16Req )
+			{
+				*pMod = eMod;
+				*pPower = ePower;
+				return;
+			}
+		}
+	}
+	*pMod = eBaseMod;
+	*pPower = eBasePower;
+}
+
+/*!
+ * @static
+ * @brief This function update the margin estimation
+ *
+ * @param [in] pCtx      Pointer on the link adaptation context
+ * @param [in] i16Sample The margin sample
+ * @param [in] bSeed     The sample is a direct measure, that replace the estimation
+ *
+ * @return None
+ */
+static void _link_sample_(struct link_adapt_ctx_s *pCtx, int16_t i16Sample, uint8_t bSeed)
+{
+	int16_t i16Q = i16Sample << LINK_Q;
+	if (bSeed || !pCtx->bValid)
+	{
+		pCtx->i16Margin = i16Q;
+	}
+	else
+	{
+		pCtx->i16Margin += (i16Q - pCtx->i16Margin) / (1 << LINK_EWMA_SHIFT);
+	}
+	pCtx->bValid = 1;
+	pCtx->bNewSample = 1;
+	pCtx->u8FailNb = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
@@ -0,0 +1,393 @@
+/**
+  * @file sched_internal.c
+  * @brief This file implement the session scheduler (pending session requests).
+  *
+  * @details
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  *
+  */
+
+/*!
+ * @addtogroup wize_app
+ * @{
+ *
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sched_internal.h"
+
+#include <string.h>
+
+/*
+ * Note : The pending requests are kept sorted by priority, then by deadline
+ * (earliest first), so the first eligible one is the one to start. A request
+ * is eligible when its earliest start time is reached and, if the session has
+ * to fit in a gap (between two download windows), when its estimated duration
+ * is shorter than the gap.
+ */
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+
+#define _SCHED_AFTER_(a, b) ( (int32_t)((a) - (b)) > 0 )
+
+static void _sched_remove_(struct sched_ctx_s *pCtx, uint8_t u8Idx);
+
+/*!
+ * @}
+ * @endcond
+ */
+
+/*!
+ * @brief This function initialize the session scheduler
+ *
+ * @param [in] pCtx Pointer on the scheduler context
+ *
+ * @return None
+ */
+void SchedInt_Init(struct sched_ctx_s *pCtx)
+{
+	if (pCtx)
+	{
+		memset(pCtx, 0, sizeof(struct sched_ctx_s));
+	}
+}
+
+/*!
+ * @brief This function queue a session request
+ *
+ * @param [in] pCtx Pointer on the scheduler context
+ * @param [in] pReq Pointer on the request to queue
+ *
+ * @retval  0 Success
+ * @retval -1 Queue is full, or a request for this session is already pending
+ */
+int32_t SchedInt_Push(struct sched_ctx_s *pCtx, struct sched_req_s *pReq)
+{
+	uint8_t i, u8Pos;
+	struct sched_stats_s *pStats;
+
+	if ( !pCtx || !pReq )
+	{
+		return -1;
+	}
+	pStats = &(pCtx->sStats);
+	u8Pos = pStats->u8Depth;
+	for (i = 0; i < pStats->u8Depth; i++)
+	{
+		if (pCtx->aReq[i].eSesId == pReq->eSesId)
+		{
+			pStats->u32Rejected++;
+			return -1;
+		}
+		if ( (u8Pos == pStats->u8Depth) &&
+			 ( (pReq->u8Prio < pCtx->aReq[i].u8Prio) ||
+			   ( (pReq->u8Prio == pCtx->aReq[i].u8Prio) &&
+				 _SCHED_AFTER_(pCtx->aReq[i].u32Deadline, pReq->u32Deadline) ) ) )
+		{
+			u8Pos = i;
+		}
+	}
+	if (pStats->u8Depth >= SCHED_QUEUE_NB)
+	{
+		pStats->u32Rejected++;
+		return -1;
+	}
+	for (i = pStats->u8Depth; i > u8Pos; i--)
+	{
+		pCtx->aReq[i] = pCtx->aReq[i-1];
+	}
+	pCtx->aReq[u8Pos] = *pReq;
+	pStats->u8Depth++;
+	if (pStats->u8Depth > pStats->u8DepthMax)
+	{
+		pStats->u8DepthMax = pStats->u8Depth;
+	}
+	pStats->u32Queued++;
+	return 0;
+}
+
+/*!
+ * @brief This function drop the requests that missed their deadline
+ *
+ * @param [in] pCtx   Pointer on the scheduler context
+ * @param [in] u32Now Current time
+ *
+ * @return The mask of session ids (1 << eSesId) of the dropped requests
+ */
+uint32_t SchedInt_Expire(struct sched_ctx_s *pCtx, uint32_t u32Now)
+{
+	uint32_t u32Mask = 0;
+	uint8_t i = 0;
+
+	if ( !pCtx )
+	{
+		return 0;
+	}
+	while (i < pCtx->sStats.u8Depth)
+	{
+		if ( _SCHED_AFTER_(u32Now, pCtx->aReq[i].u32Deadline) )
+		{
+			u32Mask |= 1 << pCtx->aReq[i].eSesId;
+			pCtx->sStats.u32Expired++;
+			_sched_remove_(pCtx, i);
+		}
+		else
+		{
+			i++;
+		}
+	}
+	return u32Mask;
+}
+
+/*!
+ * @brief This function drop the pending request of a session
+ *
+ * @param [in] pCtx   Pointer on the scheduler context
+ * @param [in] eSesId The session id
+ *
+ * @retval  0 Success
+ * @retval -1 No pending request for this session
+ */
+int32_t SchedInt_Cancel(struct sched_ctx_s *pCtx, uint8_t eSesId)
+{
+	uint8_t i;
+
+	if ( !pCtx )
+	{
+		return -1;
+	}
+	for (i = 0; i < pCtx->sStats.u8Depth; i++)
+	{
+		if (pCtx->aReq[i].eSesId == eSesId)
+		{
+			_sched_remove_(pCtx, i);
+			return 0;
+		}
+	}
+	return -1;
+}
+
+/*!
+ * @brief This function take the next request to start
+ *
+ * @param [in] pCtx   Pointer on the scheduler context
+ * @param [in] u32Now Current time
+ * @param [in] u32Gap Time available for the session (0xFFFFFFFF : no limit)
+ *
+ * @return The session id of the request to start, SCHED_NONE if none
+ */
+uint8_t SchedInt_Next(struct sched_ctx_s *pCtx, uint32_t u32Now, uint32_t u32Gap)
+{
+	uint32_t u32Wait;
+	uint8_t eSesId;
+	uint8_t i;
+
+	if ( !pCtx || !u32Gap )
+	{
+		return SCHED_NONE;
+	}
+	for (i = 0; i < pCtx->sStats.u8Depth; i++)
+	{
+		if ( _SCHED_AFTER_(pCtx->aReq[i].u32Start, u32Now) )
+		{
+			continue; // not yet
+		}
+		if ( (u32Gap != 0xFFFFFFFF) && (pCtx->aReq[i].u32Duration > u32Gap) )
+		{
+			continue; // doesn't fit
+		}
+		eSesId = pCtx->aReq[i].eSesId;
+		u32Wait = u32Now - pCtx->aReq[i].u32Submit;
+		pCtx->sStats.u32WaitSum += u32Wait;
+		if (u32Wait > pCtx->sStats.u32WaitMax)
+		{
+			pCtx->sStats.u32WaitMax = u32Wait;
+		}
+		pCtx->sStats.u32Started++;
+		if (u32Gap != 0xFFFFFFFF)
+		{
+			pCtx->sStats.u32Interleaved++;
+		}
+		_sched_remove_(pCtx, i);
+		return eSesId;
+	}
+	return SCHED_NONE;
+}
+
+/*!
+ * @brief This function get the scheduler statistics
+ *
+ * @param [in]  pCtx   Pointer on the scheduler context
+ * @param [out] pStats Pointer on the statistics
+ * @param [in]  bClear Clear the statistics (except the current depth)
+ *
+ * @return None
+ */
+void SchedInt_GetStats(struct sched_ctx_s *pCtx, struct sched_stats_s *pStats, uint8_t bClear)
+{
+	uint8_t u8Depth;
+	if ( pCtx && pStats )
+	{
+		*pStats = pCtx->sStats;
+		if (bClear)
+		{
+			u8Depth = pCtx->sStats.u8Depth;
+			memset(&(pCtx->sStats), 0, sizeof(struct sched_stats_s));
+			pCtx->sStats.u8Depth = u8Depth;
+			pCtx->sStats.u8DepthMax = u8Depth;
+		}
+	}
+}
+
+/*!
+ * @brief This function keep a download window missed while an interleaved
+ * session is active
+ *
+ * @param [in] pCtx     Pointer on the scheduler context
+ * @param [in] u32Event The download session event of this window
+ *
+ * @return None
+ */
+void SchedInt_DwnMiss(struct sched_ctx_s *pCtx, uint32_t u32Event)
+{
+	if (pCtx)
+	{
+		pCtx->u32DwnPend = u32Event;
+		pCtx->sStats.u32Missed++;
+	}
+}
+
+/*!
+ * @brief This function take the missed download window, if any, to give it
+ * when the interleaved session is done
+ *
+ * @param [in] pCtx Pointer on the scheduler context
+ *
+ * @return The download session event of the missed window, 0 if none
+ */
+uint32_t SchedInt_DwnReplay(struct sched_ctx_s *pCtx)
+{
+	uint32_t u32Event = 0;
+	if (pCtx)
+	{
+		u32Event = pCtx->u32DwnPend;
+		pCtx->u32DwnPend = 0;
+	}
+	return u32Event;
+}
+
+/*!
+ * @brief This function compute the gap available for an interleaved session
+ *
+ * @details The PHY is woken up u32PrepMs before the download window (see
+ * NetMgr_ListenAt), and SCHED_GUARD_MS is kept as margin. The result is
+ * bounded to SCHED_GAP_MAX_MS.
+ *
+ * @param [in] u64WaitMs Time until the next download window (ms)
+ * @param [in] u32PrepMs Time to prepare the PHY before the window (ms)
+ *
+ * @return The gap (ms), 0 if none
+ */
+uint32_t SchedInt_Gap(uint64_t u64WaitMs, uint32_t u32PrepMs)
+{
+	uint64_t u64Margin = (uint64_t)u32PrepMs + SCHED_GUARD_MS;
+
+	if (u64WaitMs <= u64Margin)
+	{
+		return 0;
+	}
+	u64WaitMs -= u64Margin;
+	return (u64WaitMs < SCHED_GAP_MAX_MS)?((uint32_t)u64WaitMs):(SCHED_GAP_MAX_MS);
+}
+
+/*!
+ * @brief This function estimate a session duration, from its delays
+ *
+ * @param [in] u8Delay  Reception delay, after the first message (s)
+ * @param [in] u8Length Reception window length (s)
+ * @param [in] u8Resp   Response delay, after the reception (s)
+ *
+ * @return The estimated duration (ms)
+ */
+uint32_t SchedInt_Duration(uint8_t u8Delay, uint8_t u8Length, uint8_t u8Resp)
+{
+	// one more second to send the first message
+	return 1000UL * ((uint32_t)u8Delay + u8Length + u8Resp + 1);
+}
+
+/*!
+ * @brief This function give the next session requested in a notification
+ *
+ * @details The session requests are posted with eSetBits, one bit per session
+ * (see SCHED_REQ), so requests given before the dispatcher runs are all kept.
+ * The lowest session id is given first, and its bit is cleared.
+ *
+ * @param [in,out] pu32Event Pointer on the notified events
+ *
+ * @return The session id (SCHED_NONE if no more request)
+ */
+uint8_t SchedInt_ReqNext(uint32_t *pu32Event)
+{
+	uint8_t eSesId;
+	for (eSesId = 0; SCHED_REQ(eSesId) & SCHED_REQ_MSK; eSesId++)
+	{
+		if (*pu32Event & SCHED_REQ(eSesId))
+		{
+			*pu32Event &= ~SCHED_REQ(eSesId);
+			return eSesId;
+		}
+	}
+	return SCHED_NONE;
+}
+
+/******************************************************************************/
+
+/*!
+ * @static
+ * @brief This function remove a request from the queue
+ *
+ * @param [in] pCtx   Pointer on the scheduler context
+ * @param [in] u8Idx  Index of the request to remove
+ *
+ * @return None
+ */
+static void _sched_remove_(struct sched_ctx_s *pCtx, uint8_t u8Idx)
+{
+	uint8_t i;
+	for (i = u8Idx; i + 1 < pCtx->sStats.u8Depth; i++)
+	{
+		pCtx->aReq[i] = pCtx->aReq[i+1];
+	}
+	pCtx->sStats.u8Depth--;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
@@ -0,0 +1,210 @@
+/**
+  * @file slot_internal.c
+  * @brief This file implement the transmit slot allocator.
+  *
+  * @details
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  *
+  */
+
+/*!
+ * @addtogroup wize_app
+ * @{
+ *
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "slot_internal.h"
+#include "wize_utils.h"
+
+#include <string.h>
+
+/*
+ * Note : The deterministic part of the offset is a hash of the device address
+ * (FNV-1a, then mixed per class), so two devices with close addresses get
+ * unrelated offsets, and a device keeps the same offset over resets. The
+ * jitter is a random part added to it (modulo the window), so that two devices
+ * sharing the same deterministic offset don't collide every time.
+ */
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+
+#define SLOT_FNV_OFFSET 0x811C9DC5UL
+#define SLOT_FNV_PRIME  0x01000193UL
+#define SLOT_GOLDEN     0x9E3779B9UL
+
+static uint32_t _slot_mix_(uint32_t u32Val);
+static uint32_t _slot_rand_(struct slot_ctx_s *pCtx);
+
+/*!
+ * @}
+ * @endcond
+ */
+
+/*!
+ * @brief This function initialize the slot allocator (default configuration)
+ *
+ * @param [in] pCtx Pointer on the slot allocator context
+ *
+ * @return None
+ */
+void SlotInt_Init(struct slot_ctx_s *pCtx)
+{
+	if (pCtx)
+	{
+		memset(pCtx, 0, sizeof(struct slot_ctx_s));
+		pCtx->sCfg.aWindowMs[SLOT_CLASS_DATA] = SLOT_DATA_WINDOW_MS;
+		pCtx->sCfg.aWindowMs[SLOT_CLASS_INST] = SLOT_INST_WINDOW_MS;
+		pCtx->sCfg.aWindowMs[SLOT_CLASS_DAILY] = SLOT_DAILY_WINDOW_MS;
+		pCtx->sCfg.u8JitterPct = SLOT_JITTER_PCT;
+		pCtx->u32Hash = SLOT_FNV_OFFSET;
+		pCtx->u32Rand = SLOT_GOLDEN;
+	}
+}
+
+/*!
+ * @brief This function configure the slot allocator
+ *
+ * @param [in] pCtx Pointer on the slot allocator context
+ * @param [in] pCfg Pointer on the configuration
+ *
+ * @retval  0 Success
+ * @retval -1 Invalid configuration (jitter over 100%)
+ */
+int32_t SlotInt_Config(struct slot_ctx_s *pCtx, const struct slot_cfg_s *pCfg)
+{
+	if ( !pCtx || !pCfg || (pCfg->u8JitterPct > 100) )
+	{
+		return -1;
+	}
+	pCtx->sCfg = *pCfg;
+	return 0;
+}
+
+/*!
+ * @brief This function set the device identification the offsets derive from
+ *
+ * @param [in] pCtx    Pointer on the slot allocator context
+ * @param [in] pId     Pointer on the device identification (e.g. M-field and A-field)
+ * @param [in] u8Size  The device identification size
+ * @param [in] u32Seed Additional seed for the jitter (e.g. current time)
+ *
+ * @return None
+ */
+void SlotInt_SetId(struct slot_ctx_s *pCtx, const uint8_t *pId, uint8_t u8Size, uint32_t u32Seed)
+{
+	uint32_t u32Hash = SLOT_FNV_OFFSET;
+	uint8_t i;
+
+	if ( !pCtx || !pId )
+	{
+		return;
+	}
+	for (i = 0; i < u8Size; i++)
+	{
+		u32Hash ^= pId[i];
+		u32Hash *= SLOT_FNV_PRIME;
+	}
+	pCtx->u32Hash = u32Hash;
+	pCtx->u32Rand = _slot_mix_(u32Hash ^ u32Seed);
+	if (!pCtx->u32Rand)
+	{
+		pCtx->u32Rand = SLOT_GOLDEN;
+	}
+}
+
+/*!
+ * @brief This function get the transmit offset of the given class
+ *
+ * @param [in] pCtx   Pointer on the slot allocator context
+ * @param [in] eClass The slot class (see @link slot_class_e @endlink)
+ *
+ * @return The offset (ms), from the nominal transmit time, in [0, window[
+ */
+uint32_t SlotInt_Offset(struct slot_ctx_s *pCtx, uint8_t eClass)
+{
+	uint32_t u32Window;
+	uint32_t u32Jitter;
+	uint32_t u32Offset;
+
+	if ( !pCtx || (eClass >= SLOT_CLASS_NB) )
+	{
+		return 0;
+	}
+	u32Window = pCtx->sCfg.aWindowMs[eClass];
+	if (!u32Window)
+	{
+		return 0;
+	}
+	u32Offset = _slot_mix_(pCtx->u32Hash ^ ( (uint32_t)(eClass + 1) * SLOT_GOLDEN ) ) % u32Window;
+	u32Jitter = (uint32_t)( ( (uint64_t)u32Window * pCtx->sCfg.u8JitterPct ) / 100 );
+	if (u32Jitter)
+	{
+		u32Offset = (uint32_t)( ( (uint64_t)u32Offset + _slot_rand_(pCtx) % u32Jitter ) % u32Window );
+	}
+	return u32Offset;
+}
+
+/******************************************************************************/
+
+/*!
+ * @static
+ * @brief This function mix (avalanche) a 32 bits value
+ *
+ * @param [in] u32Val The value to mix
+ *
+ * @return The mixed value
+ */
+static uint32_t _slot_mix_(uint32_t u32Val)
+{
+	u32Val ^= u32Val >> 16;
+	u32Val *= 0x85EBCA6BUL;
+	u32Val ^= u32Val >> 13;
+	u32Val *= 0xC2B2AE35UL;
+	u32Val ^= u32Val >> 16;
+	return u32Val;
+}
+
+/*!
+ * @static
+ * @brief This function get the next jitter random value (xorshift32)
+ *
+ * @param [in] pCtx Pointer on the slot allocator context
+ *
+ * @return The random value
+ */
+static uint32_t _slot_rand_(struct slot_ctx_s *pCtx)
+{
+	return _xorshift32_(&(pCtx->u32Rand));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
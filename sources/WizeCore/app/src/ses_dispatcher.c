@@ -52,6 +52,8 @@ extern "C" {
 
 #include "rtos_macro.h"
 
+#include <time.h>
+
 /******************************************************************************/
 /*!
  * @cond INTERNAL
@@ -74,7 +76,16 @@ static void _ses_disp_bckflg_(struct ses_disp_ctx_s *pCtx, uint32_t u32Flag);
 static uint32_t _ses_disp_postCmd_(struct ses_disp_ctx_s *pCtx);
 static uint32_t _ses_disp_OnDayPass_(struct ses_disp_ctx_s *pCtx);
 
-static void _ses_disp_get_param_(void);
+static void _ses_disp_notify_(struct ses_disp_ctx_s *pCtx, ses_type_t eSesId, uint32_t u32BckFlg);
+static void _ses_disp_cancel_(struct ses_disp_ctx_s *pCtx);
+static void _ses_disp_start_(struct ses_disp_ctx_s *pCtx, ses_type_t eSesId);
+static void _ses_disp_queue_(struct ses_disp_ctx_s *pCtx, ses_type_t eSesId, uint32_t u32Delay);
+static void _ses_disp_schedule_(struct ses_disp_ctx_s *pCtx);
+static uint32_t _ses_disp_wait_(struct ses_disp_ctx_s *pCtx);
+static uint32_t _ses_disp_gap_(struct ses_disp_ctx_s *pCtx, uint32_t u32Now);
+static uint32_t _ses_disp_duration_(ses_type_t eSesId);
+
+static void _ses_disp_get_param_(struct ses_disp_ctx_s *pCtx);
 static inline void _adm_mgr_get_param_(struct adm_mgr_ctx_s *pCtx);
 static inline void _inst_mgr_get_param_(struct inst_mgr_ctx_s *pCtx);
 
@@ -118,6 +129,10 @@ void SesDisp_Setup(struct ses_disp_ctx_s *pCtx)
 	AdmMgr_Setup(&(pCtx->sSesCtx[SES_ADM]));
 	DwnMgr_Setup(&(pCtx->sSesCtx[SES_DWN]));
 
+	LinkInt_Init(&(pCtx->sLinkCtx));
+	SlotInt_Init(&(pCtx->sSlotCtx));
+	AdmInt_CacheSetup();
+
 	pCtx->eState = SES_DISP_STATE_DISABLE;
 }
 
@@ -141,6 +156,10 @@ void SesDisp_Init(struct ses_disp_ctx_s *pCtx, uint8_t bEnable)
 	pCtx->pActive = NULL;
 	pCtx->eActiveId = SES_NONE;
 	pCtx->eReqId = SES_NONE;
+	pCtx->eSuspId = SES_NONE;
+	pCtx->u8CancelMsk = 0;
+	pCtx->u8IntMsk = 0;
+	SchedInt_Init(&(pCtx->sSchedCtx));
 	if (bEnable)
 	{
 		pCtx->eState = SES_DISP_STATE_ENABLE;
@@ -151,6 +170,84 @@ void SesDisp_Init(struct ses_disp_ctx_s *pCtx, uint8_t bEnable)
 	}
 }
 
+/*!
+ * @brief This function get the session scheduler statistics
+ *
+ * @details Queue latencies are given in tick, from the request to the start of
+ * the session.
+ *
+ * @param [in]  pCtx   Pointer on the current context
+ * @param [out] pStats Pointer on the statistics
+ * @param [in]  bClear Clear the statistics (except the current depth)
+ *
+ * @return None
+ */
+void SesDisp_GetSchedStats(struct ses_disp_ctx_s *pCtx, struct sched_stats_s *pStats, uint8_t bClear)
+{
+	assert(pCtx);
+	taskENTER_CRITICAL();
+	SchedInt_GetStats(&(pCtx->sSchedCtx), pStats, bClear);
+	taskEXIT_CRITICAL();
+}
+
+/*!
+ * @brief This function configure the transmit slot allocator
+ *
+ * @param [in] pCtx Pointer on the current context
+ * @param [in] pCfg Pointer on the slot configuration
+ *
+ * @retval  0 Success
+ * @retval -1 Invalid configuration
+ */
+int32_t SesDisp_SetSlotCfg(struct ses_disp_ctx_s *pCtx, const struct slot_cfg_s *pCfg)
+{
+	int32_t i32Ret;
+	assert(pCtx);
+	taskENTER_CRITICAL();
+	i32Ret = SlotInt_Config(&(pCtx->sSlotCtx), pCfg);
+	taskEXIT_CRITICAL();
+	return i32Ret;
+}
+
+/*!
+ * @brief This function set the device identification the transmit slots
+ * derive from
+ *
+ * @param [in] pCtx   Pointer on the current context
+ * @param [in] pManuf Pointer on the device manufacturer id (M-field)
+ * @param [in] pAddr  Pointer on the device address (A-field)
+ *
+ * @return None
+ */
+void SesDisp_SetSlotId(struct ses_disp_ctx_s *pCtx, const uint8_t *pManuf, const uint8_t *pAddr)
+{
+	uint8_t aId[MFIELD_SZ + AFIELD_SZ];
+	assert(pCtx);
+	memcpy(aId, pManuf, MFIELD_SZ);
+	memcpy(&(aId[MFIELD_SZ]), pAddr, AFIELD_SZ);
+	taskENTER_CRITICAL();
+	SlotInt_SetId(&(pCtx->sSlotCtx), aId, sizeof(aId), xTaskGetTickCount());
+	taskEXIT_CRITICAL();
+}
+
+/*!
+ * @brief This function get a transmit slot offset
+ *
+ * @param [in] pCtx   Pointer on the current context
+ * @param [in] eClass The slot class (see @link slot_class_e @endlink)
+ *
+ * @return The offset (ms) to add to the nominal transmit time
+ */
+uint32_t SesDisp_GetSlot(struct ses_disp_ctx_s *pCtx, uint8_t eClass)
+{
+	uint32_t u32Offset;
+	assert(pCtx);
+	taskENTER_CRITICAL();
+	u32Offset = SlotInt_Offset(&(pCtx->sSlotCtx), eClass);
+	taskEXIT_CRITICAL();
+	return u32Offset;
+}
+
 /******************************************************************************/
 
 /*!
@@ -170,10 +267,15 @@ static void _ses_disp_main_(void const * argument)
 	SesDisp_Init(pCtx, 1);
 	while(1)
 	{
-		if (xTaskNotifyWait(0, ULONG_MAX, &ulEvent, SES_DISP_TIMEOUT_EVT ))
+		if (xTaskNotifyWait(0, ULONG_MAX, &ulEvent, _ses_disp_wait_(pCtx) ))
 		{
 			_ses_disp_fsm_(pCtx, ulEvent);
 		}
+		else
+		{
+			// a pending request may start or has expired
+			_ses_disp_schedule_(pCtx);
+		}
 	}
 }
 
@@ -225,6 +327,8 @@ static void _ses_disp_fsm_(struct ses_disp_ctx_s *pCtx, uint32_t u32Event)
 	// From SES_STATE_SENDING
 	//    (net)   - SES_EVT_SEND_DONE               : SES_FLG_ERROR, SES_FLG_RSP_SENT, SES_FLG_DATA_SENT
 	//    (net)   - SES_EVT_TIMEOUT                 : SES_FLG_TIMEOUT
+	// (after SES_FLG_RSP_SENT, back into SES_STATE_WAITING_RX_DELAY while
+	//  less than u8CmdMax commands have been received)
 
 	// back from DWN on :
 	// SES_EVT_CLOSE
@@ -248,53 +352,52 @@ static void _ses_disp_fsm_(struct ses_disp_ctx_s *pCtx, uint32_t u32Event)
 		if (u32Event & SES_EVT_DAY_PASSED)
 		{
 			ulBckFlg = _ses_disp_OnDayPass_(pCtx);
-			if (ulBckFlg & GLO_FLG_PERIODIC_INST)
+			if ( (ulBckFlg & GLO_FLG_PERIODIC_INST) && !(pCtx->u8IntMsk & (1 << SES_INST)) )
 			{
-				pCtx->eReqId = SES_INST;
+				// spread the periodic install over the fleet
+				pCtx->u8IntMsk |= 1 << SES_INST;
+				_ses_disp_queue_(pCtx, SES_INST,
+					pdMS_TO_TICKS(SesDisp_GetSlot(pCtx, SLOT_CLASS_INST)) );
 			}
 		}
 	}
 
-	// Event from API
+	// Event from API (cancel request, see u8CancelMsk)
 	if (u32Event & SES_EVT_MSK)
 	{
-		ses_type_t eApiReqSesId = (u32Event & SES_MGR_EVT_MSK) >> SES_MGR_EVT_POS;
+		uint32_t u32Req = u32Event & SES_MGR_EVT_MSK;
+		ses_type_t eApiReqSesId;
+		uint32_t u32Delay;
 
-		// None active session exist
-		if( pCtx->eActiveId == SES_NONE )
+		// one bit per requested session, requests given back-to-back are all here
+		while ( (eApiReqSesId = SchedInt_ReqNext(&u32Req)) != SCHED_NONE )
 		{
-			pCtx->eReqId = eApiReqSesId;
-
-			pCtx->eActiveId = eApiReqSesId;
-			pCtx->pActive = &(pCtx->sSesCtx[pCtx->eActiveId]);
-			NetMgr_Open(NULL);
-			_ses_disp_get_param_();
-
-			if (eApiReqSesId == SES_INST)
+			if (eApiReqSesId >= SES_NB)
 			{
-				struct inst_mgr_ctx_s *pPrvCtx = &(pCtx->sInstMgrCtx);
-				// Init delays
-				_inst_mgr_get_param_(pPrvCtx);
-
-				// Init and prepare the message
-				InstInt_Init(&(pCtx->sPingReplyCtx), &(pPrvCtx->sCmdMsg));
+				continue;
 			}
-			else
+			u32Delay = 0;
+			// the API request replace the pending internal one, if any
+			if ( (pCtx->u8IntMsk & (1 << eApiReqSesId)) &&
+				 (SchedInt_Cancel(&(pCtx->sSchedCtx), eApiReqSesId) == 0) )
 			{
-				_adm_mgr_get_param_(&(pCtx->sAdmMgrCtx));
+				pCtx->u8IntMsk &= ~(1 << eApiReqSesId);
 			}
-			ulFlg = pCtx->pActive->fsm(pCtx->pActive, SES_EVT_OPEN);
-			if (ulFlg & ( SES_FLG_COMPLETE | SES_FLG_ERROR) )
+			if ( (eApiReqSesId == SES_ADM) && (pCtx->sAdmMgrCtx.sDataMsg.u8Type == APP_DATA) )
 			{
-				// the current active session is completed
-				_ses_disp_bckflg_(pCtx, ulFlg);
+				u32Delay = pdMS_TO_TICKS(SesDisp_GetSlot(pCtx, SLOT_CLASS_DATA));
+			}
+
+			// None active session exist
+			if( (pCtx->eActiveId == SES_NONE) && !u32Delay )
+			{
+				_ses_disp_start_(pCtx, eApiReqSesId);
+			}
+			// An active session already exist (or DATA slot) => wait for it
+			else
+			{
+				_ses_disp_queue_(pCtx, eApiReqSesId, u32Delay);
 			}
-		}
-		// An active session already exist => FAILED
-		else
-		{
-			ulBckFlg = (eApiReqSesId <<  SES_MGR_FLG_POS) | SES_MGR_FLG_FAILED;
-			xEventGroupSetBits(pCtx->hEvents, ulBckFlg);
 		}
 	}
 
@@ -314,7 +417,15 @@ static void _ses_disp_fsm_(struct ses_disp_ctx_s *pCtx, uint32_t u32Event)
 			{
 				struct adm_mgr_ctx_s *pPrvCtx = &(pCtx->sAdmMgrCtx);
 				// treat CMD and prepare RSP
+				LinkInt_Dwn(&(pCtx->sLinkCtx), pPrvCtx->sCmdMsg.u8Rssi);
 				uint8_t eRet = AdmInt_PreCmd( &(pPrvCtx->sCmdMsg), &(pPrvCtx->sRspMsg) );
+				// No further command in this session after an EXECPING (the
+				// install session follows) or an ANNDOWNLOAD (the download
+				// session start from the response time)
+				if ( (eRet == 0) || (pPrvCtx->sCmdMsg.pData[0] == ADM_ANNDOWNLOAD) )
+				{
+					pPrvCtx->u8CmdLast = 1;
+				}
 				if ( eRet == 0) // response not yet available (EXECPING case)
 				{
 					pCtx->bPendAction |= SES_ADM_RSP_PEND;
@@ -376,7 +487,18 @@ static void _ses_disp_fsm_(struct ses_disp_ctx_s *pCtx, uint32_t u32Event)
 
 				if(pCtx->eActiveId == SES_INST)
 				{
-					InstInt_End( &(pCtx->sPingReplyCtx) );
+					if ( InstInt_End( &(pCtx->sPingReplyCtx) ) == 0 )
+					{
+						ping_reply_list_t *pBest = pCtx->sPingReplyCtx.pBest;
+						LinkInt_Pong(&(pCtx->sLinkCtx),
+							pBest->xPingReply.L7RssiUpstream,
+							pBest->xPingReply.L7RssiDownstream);
+					}
+					else
+					{
+						// No gateway answer
+						LinkInt_Fail(&(pCtx->sLinkCtx));
+					}
 					// EXEC_PING was pending
 					if (pCtx->bPendAction & ADM_RSP_PEND)
 					{
@@ -404,6 +526,21 @@ static void _ses_disp_fsm_(struct ses_disp_ctx_s *pCtx, uint32_t u32Event)
 		}
 	}
 
+	if (u32Event & SES_EVT_DWN_DELAY_EXPIRED)
+	{
+		if (pCtx->eSuspId == SES_DWN)
+		{
+			// the download window is missed, give it when the interleaved
+			// session is done
+			SchedInt_DwnMiss(&(pCtx->sSchedCtx), SES_EVT_DWN_DELAY_EXPIRED);
+			u32Event &= ~SES_EVT_DWN_DELAY_EXPIRED;
+		}
+		else
+		{
+			pCtx->u32DwnWinTick = xTaskGetTickCount();
+		}
+	}
+
 	// Event from TimeEvt DELAY_EXPIRED => one session should become active
 	if (u32Event & SES_EVT_SES_MGR_MSK)
 	{
@@ -491,6 +628,10 @@ static void _ses_disp_fsm_(struct ses_disp_ctx_s *pCtx, uint32_t u32Event)
 			}
 		}
 	}
+
+	// Cancelled and pending requests
+	_ses_disp_cancel_(pCtx);
+	_ses_disp_schedule_(pCtx);
 }
 
 /*!
@@ -505,6 +646,7 @@ static void _ses_disp_fsm_(struct ses_disp_ctx_s *pCtx, uint32_t u32Event)
 static void _ses_disp_bckflg_(struct ses_disp_ctx_s *pCtx, uint32_t u32Flag)
 {
 	uint32_t ulBckFlg;
+	uint32_t u32Pend;
 	if (u32Flag & SES_FLG_ERROR)
 	{
 		ulBckFlg = SES_MGR_FLG_FAILED;
@@ -524,12 +666,389 @@ static void _ses_disp_bckflg_(struct ses_disp_ctx_s *pCtx, uint32_t u32Flag)
 	// session is closed
 	if (u32Flag & SES_FLG_COMPLETE)
 	{
+		ses_type_t eDoneId = pCtx->eActiveId;
 		pCtx->eReqId = SES_NONE;
-		pCtx->eActiveId = SES_NONE;
-		pCtx->pActive = NULL;
-		NetMgr_Close();
-		xEventGroupSetBits(pCtx->hEvents, ulBckFlg);
+		taskENTER_CRITICAL();
+		pCtx->u8CancelMsk &= ~(1 << eDoneId);
+		taskEXIT_CRITICAL();
+		if (pCtx->eSuspId != SES_NONE)
+		{
+			// interleaved session is done, back to the suspended one
+			pCtx->eActiveId = pCtx->eSuspId;
+			pCtx->pActive = &(pCtx->sSesCtx[pCtx->eActiveId]);
+			pCtx->eSuspId = SES_NONE;
+			_ses_disp_notify_(pCtx, eDoneId, ulBckFlg);
+			u32Pend = SchedInt_DwnReplay(&(pCtx->sSchedCtx));
+			if (u32Pend)
+			{
+				// give the missed download window
+				pCtx->u32DwnWinTick = xTaskGetTickCount();
+				u32Flag = pCtx->pActive->fsm(pCtx->pActive, u32Pend);
+				if (u32Flag & ( SES_FLG_COMPLETE | SES_FLG_ERROR) )
+				{
+					_ses_disp_bckflg_(pCtx, u32Flag);
+				}
+			}
+		}
+		else
+		{
+			pCtx->eActiveId = SES_NONE;
+			pCtx->pActive = NULL;
+			NetMgr_Close();
+			_ses_disp_notify_(pCtx, eDoneId, ulBckFlg);
+		}
+	}
+}
+
+/*!
+ * @static
+ * @brief This function give the session result to the requester
+ *
+ * @details An asynchronous requester is called back (from the session
+ * dispatcher task), otherwise the result is set in the event group.
+ *
+ * @param [in] pCtx      Pointer on the current session dispatcher context
+ * @param [in] eSesId    The session
+ * @param [in] u32BckFlg The result flags (see @link ses_mgr_flg_e @endlink)
+ *
+ * @return None
+ */
+static void _ses_disp_notify_(struct ses_disp_ctx_s *pCtx, ses_type_t eSesId, uint32_t u32BckFlg)
+{
+	struct ses_disp_cpl_s *pCpl = &(pCtx->aCpl[eSesId]);
+	pfSesDisp_Cpl_t pfCpl;
+	void *pArg;
+
+	// set by the requester task (see _wize_api_async_)
+	taskENTER_CRITICAL();
+	pfCpl = pCpl->pfCpl;
+	pArg = pCpl->pArg;
+	if ( !(pCtx->u8IntMsk & (1 << eSesId)) )
+	{
+		pCpl->pfCpl = NULL;
+	}
+	taskEXIT_CRITICAL();
+
+	if (pCtx->u8IntMsk & (1 << eSesId))
+	{
+		// requested by the dispatcher itself, nobody is waiting for it
+		pCtx->u8IntMsk &= ~(1 << eSesId);
+	}
+	else if (pfCpl)
+	{
+		pfCpl(pArg, eSesId, u32BckFlg);
+	}
+	else
+	{
+		xEventGroupSetBits(pCtx->hEvents, u32BckFlg);
+	}
+}
+
+/*!
+ * @static
+ * @brief This function treat the cancel requests
+ *
+ * @details A pending request is dropped. An active session is closed, but
+ * only when it doesn't send or listen, otherwise the cancel is kept until then
+ * (or until the session ends). The requester get the FAILED result.
+ *
+ * @param [in] pCtx Pointer on the current session dispatcher context
+ *
+ * @return None
+ */
+static void _ses_disp_cancel_(struct ses_disp_ctx_s *pCtx)
+{
+	uint8_t u8Msk;
+	uint8_t eSesId;
+	int32_t i32Ret;
+
+	taskENTER_CRITICAL();
+	u8Msk = pCtx->u8CancelMsk;
+	taskEXIT_CRITICAL();
+
+	for (eSesId = 0; eSesId < SES_NB; eSesId++)
+	{
+		if ( !(u8Msk & (1 << eSesId)) )
+		{
+			continue;
+		}
+		if ( (eSesId == pCtx->eActiveId) && (pCtx->pActive) )
+		{
+			if ( (pCtx->pActive->eState == SES_STATE_SENDING) ||
+				 (pCtx->pActive->eState == SES_STATE_LISTENING) )
+			{
+				continue; // later
+			}
+			pCtx->pActive->fsm(pCtx->pActive, SES_EVT_CANCEL);
+			// clear the cancel request
+			_ses_disp_bckflg_(pCtx, SES_FLG_COMPLETE | SES_FLG_ERROR);
+			continue;
+		}
+		taskENTER_CRITICAL();
+		i32Ret = SchedInt_Cancel(&(pCtx->sSchedCtx), eSesId);
+		pCtx->u8CancelMsk &= ~(1 << eSesId);
+		taskEXIT_CRITICAL();
+		if (i32Ret == 0)
+		{
+			_ses_disp_notify_(pCtx, eSesId, (eSesId << SES_MGR_FLG_POS) | SES_MGR_FLG_FAILED);
+		}
+	}
+}
+
+/*!
+ * @static
+ * @brief This function start a session
+ *
+ * @details When the session is interleaved with a suspended one (download),
+ * the NetMgr is already open.
+ *
+ * @param [in] pCtx   Pointer on the current session dispatcher context
+ * @param [in] eSesId The session to start
+ *
+ * @return None
+ */
+static void _ses_disp_start_(struct ses_disp_ctx_s *pCtx, ses_type_t eSesId)
+{
+	uint32_t ulFlg;
+
+	pCtx->eReqId = eSesId;
+
+	pCtx->eActiveId = eSesId;
+	pCtx->pActive = &(pCtx->sSesCtx[pCtx->eActiveId]);
+	if (pCtx->eSuspId == SES_NONE)
+	{
+		NetMgr_Open(NULL);
+	}
+	_ses_disp_get_param_(pCtx);
+
+	if (eSesId == SES_INST)
+	{
+		struct inst_mgr_ctx_s *pPrvCtx = &(pCtx->sInstMgrCtx);
+		// Init delays
+		_inst_mgr_get_param_(pPrvCtx);
+
+		// Init and prepare the message
+		InstInt_Init(&(pCtx->sPingReplyCtx), &(pPrvCtx->sCmdMsg));
+	}
+	else
+	{
+		_adm_mgr_get_param_(&(pCtx->sAdmMgrCtx));
+	}
+	ulFlg = pCtx->pActive->fsm(pCtx->pActive, SES_EVT_OPEN);
+	if (ulFlg & ( SES_FLG_COMPLETE | SES_FLG_ERROR) )
+	{
+		// the current active session is completed
+		_ses_disp_bckflg_(pCtx, ulFlg);
+	}
+}
+
+/*!
+ * @static
+ * @brief This function queue a session request while another session is active
+ * (or until its transmit slot)
+ *
+ * @details DATA_PRIO sends come first, then install, then DATA sends. The
+ * request fails if it can't start before SCHED_DEADLINE_MS (from its slot).
+ *
+ * @param [in] pCtx     Pointer on the current session dispatcher context
+ * @param [in] eSesId   The requested session
+ * @param [in] u32Delay Delay before the request may start (in tick)
+ *
+ * @return None
+ */
+static void _ses_disp_queue_(struct ses_disp_ctx_s *pCtx, ses_type_t eSesId, uint32_t u32Delay)
+{
+	struct sched_req_s sReq;
+	int32_t i32Ret;
+
+	sReq.u32Submit = xTaskGetTickCount();
+	sReq.u32Start = sReq.u32Submit + u32Delay;
+	sReq.u32Deadline = sReq.u32Start + pdMS_TO_TICKS(SCHED_DEADLINE_MS);
+	sReq.u32Duration = _ses_disp_duration_(eSesId);
+	sReq.eSesId = eSesId;
+	if (eSesId == SES_INST)
+	{
+		sReq.u8Prio = SCHED_PRIO_INST;
+	}
+	else
+	{
+		sReq.u8Prio = (pCtx->sAdmMgrCtx.sDataMsg.u8Type == APP_DATA_PRIO)?
+				(SCHED_PRIO_DATA_PRIO):(SCHED_PRIO_DATA);
+	}
+
+	taskENTER_CRITICAL();
+	i32Ret = SchedInt_Push(&(pCtx->sSchedCtx), &sReq);
+	taskEXIT_CRITICAL();
+	if (i32Ret)
+	{
+		_ses_disp_notify_(pCtx, eSesId, (eSesId << SES_MGR_FLG_POS) | SES_MGR_FLG_FAILED);
+	}
+}
+
+/*!
+ * @static
+ * @brief This function start the pending requests that can be
+ *
+ * @details A pending request start when there is no active session, or when
+ * the download session wait for its next window and the request estimated
+ * duration fit in the gap. Requests that missed their deadline fail.
+ *
+ * @param [in] pCtx Pointer on the current session dispatcher context
+ *
+ * @return None
+ */
+static void _ses_disp_schedule_(struct ses_disp_ctx_s *pCtx)
+{
+	uint32_t u32Now;
+	uint32_t u32Mask;
+	uint32_t u32Gap;
+	uint8_t eSesId;
+	uint8_t i;
+
+	do {
+		u32Now = xTaskGetTickCount();
+		taskENTER_CRITICAL();
+		u32Mask = SchedInt_Expire(&(pCtx->sSchedCtx), u32Now);
+		taskEXIT_CRITICAL();
+		for (i = 0; i < SES_NB; i++)
+		{
+			if (u32Mask & (1 << i))
+			{
+				_ses_disp_notify_(pCtx, i, (i << SES_MGR_FLG_POS) | SES_MGR_FLG_FAILED);
+			}
+		}
+
+		if (pCtx->eActiveId == SES_NONE)
+		{
+			u32Gap = 0xFFFFFFFF;
+		}
+		else if ( (pCtx->eActiveId == SES_DWN) && (pCtx->eSuspId == SES_NONE) )
+		{
+			u32Gap = _ses_disp_gap_(pCtx, u32Now);
+		}
+		else
+		{
+			break;
+		}
+
+		taskENTER_CRITICAL();
+		eSesId = SchedInt_Next(&(pCtx->sSchedCtx), u32Now, u32Gap);
+		taskEXIT_CRITICAL();
+		if (eSesId == SCHED_NONE)
+		{
+			break;
+		}
+		if (u32Gap != 0xFFFFFFFF)
+		{
+			pCtx->eSuspId = pCtx->eActiveId;
+		}
+		_ses_disp_start_(pCtx, eSesId);
+	} while (1);
+}
+
+/*!
+ * @static
+ * @brief This function compute how long the dispatcher may wait for an event
+ *
+ * @param [in] pCtx Pointer on the current session dispatcher context
+ *
+ * @return The time to wait (in tick), until the next pending request start or
+ *         deadline
+ */
+static uint32_t _ses_disp_wait_(struct ses_disp_ctx_s *pCtx)
+{
+	struct sched_ctx_s *pSched = &(pCtx->sSchedCtx);
+	uint32_t u32Now = xTaskGetTickCount();
+	uint32_t u32Wait = SES_DISP_TIMEOUT_EVT;
+	int32_t i32Wait;
+	uint8_t i;
+
+	for (i = 0; i < pSched->sStats.u8Depth; i++)
+	{
+		i32Wait = (int32_t)(pSched->aReq[i].u32Start - u32Now);
+		if (i32Wait <= 0)
+		{
+			i32Wait = (int32_t)(pSched->aReq[i].u32Deadline - u32Now) + 1;
+		}
+		if (i32Wait < 1)
+		{
+			i32Wait = 1;
+		}
+		if ((uint32_t)i32Wait < u32Wait)
+		{
+			u32Wait = (uint32_t)i32Wait;
+		}
 	}
+	return u32Wait;
+}
+
+/*!
+ * @static
+ * @brief This function compute the gap before the next download window
+ *
+ * @param [in] pCtx   Pointer on the current session dispatcher context
+ * @param [in] u32Now Current time (in tick)
+ *
+ * @return The gap (in tick), 0 if the download session is not waiting
+ */
+static uint32_t _ses_disp_gap_(struct ses_disp_ctx_s *pCtx, uint32_t u32Now)
+{
+	struct dwn_mgr_ctx_s *pPrvCtx = &(pCtx->sDwnMgrCtx);
+	uint64_t u64WaitMs = 0;
+	uint32_t u32Elapse;
+	uint32_t u32Window;
+	time_t t;
+
+	if (pCtx->sSesCtx[SES_DWN].eState == SES_STATE_WAITING)
+	{
+		// waiting for the next download day
+		time(&t);
+		if (pPrvCtx->_u32DayNext > (uint32_t)t)
+		{
+			u64WaitMs = 1000ULL * (pPrvCtx->_u32DayNext - (uint32_t)t);
+		}
+	}
+	else if (pCtx->sSesCtx[SES_DWN].eState == SES_STATE_WAITING_RX_DELAY)
+	{
+		// waiting for the next block window
+		u32Elapse = u32Now - pCtx->u32DwnWinTick;
+		u32Window = pdMS_TO_TICKS(1000UL * pPrvCtx->u8DeltaSec);
+		if (u32Elapse < u32Window)
+		{
+			u64WaitMs = ( 1000ULL * (u32Window - u32Elapse) ) / configTICK_RATE_HZ;
+		}
+	}
+
+	// the PHY is woken up in advance (see NetMgr_ListenAt)
+	return pdMS_TO_TICKS(SchedInt_Gap(u64WaitMs, NET_MGR_RX_PREP_MS));
+}
+
+/*!
+ * @static
+ * @brief This function estimate a session duration, from its delays
+ *
+ * @param [in] eSesId The session
+ *
+ * @return The estimated duration (in tick)
+ */
+static uint32_t _ses_disp_duration_(ses_type_t eSesId)
+{
+	uint8_t u8Delay;
+	uint8_t u8Length;
+	uint8_t u8Resp = 0;
+
+	if (eSesId == SES_INST)
+	{
+		Param_Access(PING_RX_DELAY,  &u8Delay, 0);
+		Param_Access(PING_RX_LENGTH, &u8Length, 0);
+	}
+	else
+	{
+		Param_Access(EXCH_RX_DELAY,       &u8Delay, 0);
+		Param_Access(EXCH_RX_LENGTH,      &u8Length, 0);
+		Param_Access(EXCH_RESPONSE_DELAY, &u8Resp, 0);
+	}
+	return pdMS_TO_TICKS(SchedInt_Duration(u8Delay, u8Length, u8Resp));
 }
 
 
@@ -619,7 +1138,11 @@ static uint32_t _ses_disp_postCmd_(struct ses_disp_ctx_s *pCtx)
 			// do install
 			//pCtx->sSesCtx[SES_INST].fsm(&(pCtx->sSesCtx[SES_INST]), SES_EVT_OPEN);
 		}
-		//else // nothing to do
+		else
+		{
+			// registered (application) command, if any
+			AdmInt_PostCmd(pCmdMsg, pRspMsg);
+		}
 	}
 	if (u32BckFlag) {
 		LOG_INF("%s CMD done\n", _ses_log_str_[_get_pos(u32BckFlag)]);
@@ -664,6 +1187,7 @@ static uint32_t _ses_disp_OnDayPass_(struct ses_disp_ctx_s *pCtx)
 		// go back in full power
 		temp = PHY_PMAX_minus_0db;
 		Param_Access(TX_POWER, &temp, 1 );
+		LinkInt_Fallback(&(pCtx->sLinkCtx));
 
 		ulBckFlg |= GLO_FLG_FULL_POWER;
 		pCtx->u16FullPower = 0;
@@ -679,14 +1203,20 @@ static uint32_t _ses_disp_OnDayPass_(struct ses_disp_ctx_s *pCtx)
  * @static
  * @brief This function get parameters from global table and setup internal variables.
  *
+ * @details The TX modulation and power given by the parameters are the most
+ * robust allowed. The link adaptation may select cheaper ones.
+ *
+ * @param [in] pCtx Pointer in the current context
+ *
  * @return      None
  */
-static void _ses_disp_get_param_(void)
+static void _ses_disp_get_param_(struct ses_disp_ctx_s *pCtx)
 {
 	int32_t ret = NETDEV_STATUS_OK;
 
 	struct medium_cfg_s sMediumCfg;
 	struct proto_config_s sProto_Cfg;
+	net_stats_t sNetStats;
 
 	Param_Access(RF_UPLINK_CHANNEL,     &(sMediumCfg.eTxChannel), 0 );
 	sMediumCfg.eTxChannel = (sMediumCfg.eTxChannel -100)/10;
@@ -697,6 +1227,12 @@ static void _ses_disp_get_param_(void)
 	Param_Access(RF_DOWNLINK_CHANNEL,   &(sMediumCfg.eRxChannel), 0 );
 	sMediumCfg.eRxChannel = (sMediumCfg.eRxChannel -100)/10;
 	Param_Access(RF_DOWNLINK_MOD,       &(sMediumCfg.eRxModulation), 0 );
+
+	if ( NetMgr_Ioctl(NETDEV_CTL_GET_STATS, (uint32_t)(&sNetStats)) == NETDEV_STATUS_OK )
+	{
+		LinkInt_Noise(&(pCtx->sLinkCtx), sNetStats.u8TxNoiseAvg);
+	}
+	LinkInt_Apply(&(pCtx->sLinkCtx), &sMediumCfg);
 	ret = NetMgr_Ioctl(NETDEV_CTL_CFG_MEDIUM, (uint32_t)(&sMediumCfg));
 
 	Param_Access(L7TRANSMIT_LENGTH_MAX, &(sProto_Cfg.u8TransLenMax), 0 );
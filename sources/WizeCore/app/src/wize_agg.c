@@ -0,0 +1,292 @@
+/**
+  * @file wize_agg.c
+  * @brief This file implement the Wize aggregation API (several application
+  * records in one DATA message).
+  *
+  * @details
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  *
+  */
+
+/*!
+ * @addtogroup wize_api
+ * @{
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+
+#include "wize_agg.h"
+
+#include "parameters.h"
+#include "parameters_lan_ids.h"
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+
+static uint8_t _wize_agg_max_(void);
+
+/*!
+ * @}
+ * @endcond
+ */
+
+/******************************************************************************/
+
+/*!
+ * @brief This function initialize an aggregation context
+ *
+ * @details On maximum hold time, the given task is notified with u32Event, it
+ * should then call WizeAgg_Expire. Without task, the records are only sent
+ * when the payload is full or on WizeAgg_Flush.
+ *
+ * The context is not protected, it must be used from one task.
+ *
+ * @param [in] pCtx      Pointer on the aggregation context
+ * @param [in] u8Type    Type of message (APP_DATA or APP_DATA_PRIO)
+ * @param [in] u8HoldSec Maximum hold time of the first record (s, 0 : no aggregation)
+ * @param [in] hTask     Task to notify on maximum hold time (may be NULL)
+ * @param [in] u32Event  Event to notify on maximum hold time
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if everything is fine
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if given parameter(s) is/are invalid
+ */
+wize_api_ret_e WizeAgg_Init(struct wize_agg_s *pCtx, uint8_t u8Type, uint8_t u8HoldSec, void *hTask, uint32_t u32Event)
+{
+	if ( !pCtx || ( (u8Type != APP_DATA) && (u8Type != APP_DATA_PRIO) ) )
+	{
+		return WIZE_API_INVALID_PARAM;
+	}
+	memset(pCtx, 0, sizeof(struct wize_agg_s));
+	pCtx->u8Type = u8Type;
+	pCtx->u8HoldSec = u8HoldSec;
+	pCtx->u32Event = u32Event;
+	if (hTask && u8HoldSec)
+	{
+		if ( TimeEvt_TimerInit(&(pCtx->sTimeEvt), hTask, TIMEEVT_CFG_ONESHOT) == 0 )
+		{
+			pCtx->bTimer = 1;
+		}
+	}
+	return WIZE_API_SUCCESS;
+}
+
+/*!
+ * @brief This function add a record
+ *
+ * @details If the record doesn't fit in the current payload, this one is sent
+ * first (see WizeApi_Send, so the call may block for the exchange). If it
+ * fails, the current payload is kept and the record is not added.
+ *
+ * @param [in] pCtx      Pointer on the aggregation context
+ * @param [in] u8RecType The record type
+ * @param [in] pRec      Pointer on the record value
+ * @param [in] u8Size    The record value size
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if everything is fine
+ *         return wize_api_ret_e::WIZE_API_FAILED (1) if the send failed
+ *         return wize_api_ret_e::WIZE_API_ADM_SUCCESS (2) if ADM CMD has been received
+ *         return wize_api_ret_e::WIZE_API_ACCESS_TIMEOUT (3) if access is refused
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if given parameter(s) is/are invalid
+ */
+wize_api_ret_e WizeAgg_Add(struct wize_agg_s *pCtx, uint8_t u8RecType, const uint8_t *pRec, uint8_t u8Size)
+{
+	wize_api_ret_e eRet = WIZE_API_SUCCESS;
+	uint8_t u8Max;
+
+	if ( !pCtx || (!pRec && u8Size) )
+	{
+		return WIZE_API_INVALID_PARAM;
+	}
+	u8Max = _wize_agg_max_();
+	if ( (uint16_t)u8Size + WIZE_AGG_TLV_HDR_SZ > u8Max )
+	{
+		return WIZE_API_INVALID_PARAM;
+	}
+
+	// doesn't fit, send the current payload
+	if ( (uint16_t)pCtx->u8Size + WIZE_AGG_TLV_HDR_SZ + u8Size > u8Max )
+	{
+		eRet = WizeAgg_Flush(pCtx);
+		if ( (eRet != WIZE_API_SUCCESS) && (eRet != WIZE_API_ADM_SUCCESS) )
+		{
+			return eRet;
+		}
+	}
+
+	pCtx->aBuf[pCtx->u8Size++] = u8RecType;
+	pCtx->aBuf[pCtx->u8Size++] = u8Size;
+	if (u8Size)
+	{
+		memcpy(&(pCtx->aBuf[pCtx->u8Size]), pRec, u8Size);
+		pCtx->u8Size += u8Size;
+	}
+	pCtx->u8RecNb++;
+
+	if ( !(pCtx->u8HoldSec) )
+	{
+		// no aggregation
+		return WizeAgg_Flush(pCtx);
+	}
+	if ( (pCtx->u8RecNb == 1) && pCtx->bTimer )
+	{
+		// first record, start the maximum hold timer
+		TimeEvt_TimerStart(&(pCtx->sTimeEvt), pCtx->u8HoldSec, 0, pCtx->u32Event);
+	}
+	return eRet;
+}
+
+/*!
+ * @brief This function send the current payload, if any
+ *
+ * @details The payload is sent with WizeApi_Send, so the call block for the
+ * exchange. If it fails, the payload is kept to be sent later.
+ *
+ * @param [in] pCtx Pointer on the aggregation context
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if everything is fine
+ *         return wize_api_ret_e::WIZE_API_FAILED (1) if the send failed
+ *         return wize_api_ret_e::WIZE_API_ADM_SUCCESS (2) if ADM CMD has been received
+ *         return wize_api_ret_e::WIZE_API_ACCESS_TIMEOUT (3) if access is refused
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if given parameter(s) is/are invalid
+ */
+wize_api_ret_e WizeAgg_Flush(struct wize_agg_s *pCtx)
+{
+	wize_api_ret_e eRet;
+
+	if ( !pCtx )
+	{
+		return WIZE_API_INVALID_PARAM;
+	}
+	if ( !(pCtx->u8RecNb) )
+	{
+		return WIZE_API_SUCCESS;
+	}
+	if (pCtx->bTimer)
+	{
+		TimeEvt_TimerStop(&(pCtx->sTimeEvt));
+	}
+
+	eRet = WizeApi_Send(pCtx->aBuf, pCtx->u8Size, pCtx->u8Type);
+	if ( (eRet == WIZE_API_SUCCESS) || (eRet == WIZE_API_ADM_SUCCESS) )
+	{
+		pCtx->sStats.u32RecNb += pCtx->u8RecNb;
+		pCtx->sStats.u32FrmNb++;
+		pCtx->u8Size = 0;
+		pCtx->u8RecNb = 0;
+	}
+	else
+	{
+		pCtx->sStats.u32FailNb++;
+	}
+	return eRet;
+}
+
+/*!
+ * @brief This function send the current payload on maximum hold time
+ *
+ * @details To be called by the task notified with the u32Event given to
+ * WizeAgg_Init.
+ *
+ * @param [in] pCtx Pointer on the aggregation context
+ *
+ * @retval see WizeAgg_Flush
+ */
+wize_api_ret_e WizeAgg_Expire(struct wize_agg_s *pCtx)
+{
+	if ( pCtx && pCtx->u8RecNb )
+	{
+		pCtx->sStats.u32HoldNb++;
+	}
+	return WizeAgg_Flush(pCtx);
+}
+
+/*!
+ * @brief This function get the next record of a received payload
+ *
+ * @details Start with *pu8Offset at 0, then call it again until it returns 0.
+ *
+ * @param [in]     pData     Pointer on the payload
+ * @param [in]     u8Size    The payload size
+ * @param [in,out] pu8Offset Position of the next record in the payload
+ * @param [out]    pRec      The record (its value is not copied)
+ *
+ * @retval  1 A record is given
+ * @retval  0 No more record
+ * @retval -1 The payload is malformed (or invalid parameter)
+ */
+int32_t WizeAgg_Unpack(const uint8_t *pData, uint8_t u8Size, uint8_t *pu8Offset, wize_agg_rec_t *pRec)
+{
+	uint8_t u8Off;
+
+	if ( !pData || !pu8Offset || !pRec )
+	{
+		return -1;
+	}
+	u8Off = *pu8Offset;
+	if (u8Off >= u8Size)
+	{
+		return 0;
+	}
+	if ( (uint16_t)u8Off + WIZE_AGG_TLV_HDR_SZ > u8Size )
+	{
+		return -1;
+	}
+	pRec->u8Type = pData[u8Off];
+	pRec->u8Size = pData[u8Off + 1];
+	if ( (uint16_t)u8Off + WIZE_AGG_TLV_HDR_SZ + pRec->u8Size > u8Size )
+	{
+		return -1;
+	}
+	pRec->pData = &(pData[u8Off + WIZE_AGG_TLV_HDR_SZ]);
+	*pu8Offset = u8Off + WIZE_AGG_TLV_HDR_SZ + pRec->u8Size;
+	return 1;
+}
+
+/******************************************************************************/
+
+/*!
+ * @static
+ * @brief This function get the greatest payload size
+ *
+ * @return The greatest payload size (L7TRANSMIT_LENGTH_MAX, bounded by the
+ *         buffer size)
+ */
+static uint8_t _wize_agg_max_(void)
+{
+	uint8_t u8L7MaxLen;
+	Param_Access(L7TRANSMIT_LENGTH_MAX, &u8L7MaxLen, 0);
+	return (u8L7MaxLen < WIZE_AGG_BUF_SZ)?(u8L7MaxLen):(WIZE_AGG_BUF_SZ);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
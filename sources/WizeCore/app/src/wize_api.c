@@ -54,6 +54,31 @@ extern "C" {
 static wize_net_t sNetCtx;
 static struct ses_disp_ctx_s sSesDispCtx;
 static struct time_upd_s sTimeUpdCtx;
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+/*!
+ * @brief This struct define an asynchronous request (one per session)
+ */
+struct wize_api_async_s
+{
+	wize_api_notify_t sNotify; /*!< How to notify the completion */
+	uint16_t u16Handle;        /*!< The request handle */
+	uint8_t bBusy;             /*!< A request is in progress */
+	uint8_t bCancel;           /*!< The request has been canceled */
+};
+
+static struct wize_api_async_s sAsync[SES_NB];
+static uint16_t u16AsyncHandle;
+
+static wize_api_ret_e _wize_api_async_(ses_type_t eSesId, const wize_api_notify_t *pNotify, uint16_t *pu16Handle);
+static void _wize_api_cpl_(void *pArg, uint8_t eSesId, uint32_t u32BckFlg);
+/*!
+ * @}
+ * @endcond
+ */
 /******************************************************************************/
 
 /*!
@@ -69,6 +94,7 @@ wize_api_ret_e WizeApi_SetDeviceId(device_id_t *pDevId)
 	pProtoCtx = &(sNetCtx.sProtoCtx);
 	memcpy(pProtoCtx->aDeviceManufID, pDevId->aDevInfo, MFIELD_SZ);
 	memcpy(pProtoCtx->aDeviceAddr, pDevId->aAddr, AFIELD_SZ);
+	SesDisp_SetSlotId(&sSesDispCtx, pProtoCtx->aDeviceManufID, pProtoCtx->aDeviceAddr);
 	return WIZE_API_SUCCESS;
 }
 
@@ -108,8 +134,14 @@ wize_api_ret_e WizeApi_ExecPing(void)
 
 	if ( xSemaphoreTake( pCtx->hMutex, SES_MGR_INST_REQ_TMO_MSK ) )
 	{
+		if (sAsync[SES_INST].bBusy)
+		{
+			// an asynchronous request is in progress
+			xSemaphoreGive(pCtx->hMutex);
+			return WIZE_API_ACCESS_TIMEOUT;
+		}
 		// Request for INSTALL session
-		xTaskNotify(sSesDispCtx.hTask, SES_MGR_INST_EVT_OPEN, eSetValueWithOverwrite);
+		xTaskNotify(sSesDispCtx.hTask, SES_MGR_INST_EVT_OPEN, eSetBits);
 		u32Ret = xEventGroupWaitBits(sSesDispCtx.hEvents, SES_MGR_INST_FLG_ALL_MSK, pdTRUE, pdFALSE, SES_MGR_INST_FLG_TMO_MSK);
 
 		xSemaphoreGive(pCtx->hMutex);
@@ -134,6 +166,10 @@ wize_api_ret_e WizeApi_ExecPing(void)
 /*!
  * @brief This function get the last received ADM command message
  *
+ * @details When the session hold a sequence of commands (see
+ * WizeApi_SetAdmCmdMax), this is the last one of the sequence. The whole
+ * sequence is given by WizeApi_GetAdmLog.
+ *
  * @param [out] pMsg Pointer on message buffer
  *
  * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if everything is fine
@@ -170,6 +206,10 @@ wize_api_ret_e WizeApi_GetAdmCmd(net_msg_t *pMsg)
 /*!
  * @brief This function get the last sent ADM response message
  *
+ * @details When the session hold a sequence of commands (see
+ * WizeApi_SetAdmCmdMax), this is the response of the last one. The whole
+ * sequence is given by WizeApi_GetAdmLog.
+ *
  * @param [out] pMsg Pointer on message buffer
  *
  * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if everything is fine
@@ -203,6 +243,40 @@ wize_api_ret_e WizeApi_GetAdmRsp(net_msg_t *pMsg)
 	return WIZE_API_INVALID_PARAM;
 }
 
+/*!
+ * @brief This function get the ADM commands received in the last session
+ *
+ * @details Each command id and its response error code are given in
+ * reception order (the first ADM_LOG_SZ ones), so an early command of the
+ * sequence is not hidden by the last one.
+ *
+ * @param [out] pLog Pointer on the log
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if everything is fine
+ *         return wize_api_ret_e::WIZE_API_ACCESS_TIMEOUT (3) if access is refused
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if given parameter(s) is/are invalid
+ */
+wize_api_ret_e WizeApi_GetAdmLog(struct adm_log_s *pLog)
+{
+	struct ses_ctx_s *pCtx = &(sSesDispCtx.sSesCtx[SES_ADM]);
+	struct adm_mgr_ctx_s *pPrvCtx;
+	if (pLog)
+	{
+		if ( xSemaphoreTake( pCtx->hMutex, SES_MGR_ADM_REQ_TIMEOUT_MSK ) )
+		{
+			pPrvCtx = (struct adm_mgr_ctx_s *)pCtx->pPrivate;
+			memcpy(pLog, &(pPrvCtx->sLog), sizeof(struct adm_log_s));
+			xSemaphoreGive(pCtx->hMutex);
+			return WIZE_API_SUCCESS;
+		}
+		else
+		{
+			return WIZE_API_ACCESS_TIMEOUT;
+		}
+	}
+	return WIZE_API_INVALID_PARAM;
+}
+
 /*!
  * @brief This function send a DATA message
  *
@@ -237,6 +311,12 @@ wize_api_ret_e WizeApi_SendEx(uint8_t *pData, uint8_t u8Size, uint8_t u8Type)
 		// Ensure that only one request at the time
 		if ( xSemaphoreTake( pCtx->hMutex, SES_MGR_ADM_REQ_TIMEOUT_MSK ) )
 		{
+			if (sAsync[SES_ADM].bBusy)
+			{
+				// an asynchronous request is in progress
+				xSemaphoreGive(pCtx->hMutex);
+				return WIZE_API_ACCESS_TIMEOUT;
+			}
 			// Request for DATA, ADMIN session
 			net_msg_t *pMsg = &((struct adm_mgr_ctx_s*)(pCtx->pPrivate))->sDataMsg;
 			pMsg->pData = pData;
@@ -244,11 +324,12 @@ wize_api_ret_e WizeApi_SendEx(uint8_t *pData, uint8_t u8Size, uint8_t u8Type)
 			pMsg->u8Size = u8Size;
 			pMsg->u8Type = u8Type;
 			pMsg->u16Id++;
-			xTaskNotify(sSesDispCtx.hTask, SES_MGR_ADM_EVT_OPEN, eSetValueWithOverwrite);
+			xTaskNotify(sSesDispCtx.hTask, SES_MGR_ADM_EVT_OPEN, eSetBits);
 			u32Ret = xEventGroupWaitBits(sSesDispCtx.hEvents, SES_MGR_ADM_FLG_ALL_MSK, pdTRUE, pdFALSE, SES_MGR_ADM_FLG_TIMEOUT_MSK);
 			if (u32Ret == SES_MGR_ADM_FLG_REQUEST)
 			{
-				if (((struct adm_mgr_ctx_s*)(pCtx->pPrivate))->sCmdMsg.pData[0] == ADM_WRITE_PARAM)
+				// any command of the session, not only the last one
+				if (((struct adm_mgr_ctx_s*)(pCtx->pPrivate))->sLog.bWriteParam)
 				{
 					u32Ret = WIZE_API_ADM_SUCCESS;
 				}
@@ -307,17 +388,26 @@ wize_api_ret_e WizeApi_Send(uint8_t *pData, uint8_t u8Size, uint8_t u8Type)
 		}
 		if ( xSemaphoreTake( pCtx->hMutex, SES_MGR_ADM_REQ_TIMEOUT_MSK ) )
 		{
+			if (sAsync[SES_ADM].bBusy)
+			{
+				// an asynchronous request is in progress
+				xSemaphoreGive(pCtx->hMutex);
+				return WIZE_API_ACCESS_TIMEOUT;
+			}
 			// Request for DATA, ADMIN session
 			net_msg_t *pMsg = &((struct adm_mgr_ctx_s*)(pCtx->pPrivate))->sDataMsg;
 			pMsg->pData = pData;
+			// may have been set by a previous WizeApi_SendEx or WizeApi_SendAsync
+			pMsg->Option_b.App = 0;
 			pMsg->u8Size = u8Size;
 			pMsg->u8Type = u8Type;
 			pMsg->u16Id++;
-			xTaskNotify(sSesDispCtx.hTask, SES_MGR_ADM_EVT_OPEN, eSetValueWithOverwrite);
+			xTaskNotify(sSesDispCtx.hTask, SES_MGR_ADM_EVT_OPEN, eSetBits);
 			u32Ret = xEventGroupWaitBits(sSesDispCtx.hEvents, SES_MGR_ADM_FLG_ALL_MSK, pdTRUE, pdFALSE, SES_MGR_ADM_FLG_TIMEOUT_MSK);
 			if (u32Ret & SES_MGR_FLG_REQUEST)
 			{
-				if (((struct adm_mgr_ctx_s*)(pCtx->pPrivate))->sCmdMsg.pData[0] == ADM_WRITE_PARAM)
+				// any command of the session, not only the last one
+				if (((struct adm_mgr_ctx_s*)(pCtx->pPrivate))->sLog.bWriteParam)
 				{
 					u32Ret = WIZE_API_ADM_SUCCESS;
 				}
@@ -346,6 +436,383 @@ wize_api_ret_e WizeApi_Send(uint8_t *pData, uint8_t u8Size, uint8_t u8Type)
 
 /******************************************************************************/
 
+/*!
+ * @brief This function start a INST (PING/PONG) session, without waiting for
+ * its end
+ *
+ * @details The completion is notified by the call-back and/or the queue given
+ * in pNotify (see WizeApi_ExecPing for the result).
+ *
+ * @param [in]  pNotify    How to notify the completion
+ * @param [out] pu16Handle The request handle (see WizeApi_Cancel)
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if the request is started
+ *         return wize_api_ret_e::WIZE_API_ACCESS_TIMEOUT (3) if another request is in progress
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if given parameter(s) is/are invalid
+ */
+wize_api_ret_e WizeApi_ExecPingAsync(const wize_api_notify_t *pNotify, uint16_t *pu16Handle)
+{
+	struct ses_ctx_s *pCtx = &(sSesDispCtx.sSesCtx[SES_INST]);
+	wize_api_ret_e eRet;
+
+	// Don't wait, the INST session may be in use for seconds
+	if ( xSemaphoreTake( pCtx->hMutex, 0 ) )
+	{
+		eRet = _wize_api_async_(SES_INST, pNotify, pu16Handle);
+		xSemaphoreGive(pCtx->hMutex);
+		return eRet;
+	}
+	return WIZE_API_ACCESS_TIMEOUT;
+}
+
+/*!
+ * @brief This function send a DATA message, without waiting for the end of the
+ * exchange
+ *
+ * @details The completion is notified by the call-back and/or the queue given
+ * in pNotify (see WizeApi_SendEx for the result). The data are not copied, so
+ * pData must stay valid until then. The completion refers to the received
+ * command and to the response, that are valid until the next ADM session.
+ *
+ * @param [in]  pData      Pointer on raw data to send
+ * @param [in]  u8Size     Number of byte to send
+ * @param [in]  u8Type     Type of frame DATA or DATA_PRIO
+ * @param [in]  pNotify    How to notify the completion
+ * @param [out] pu16Handle The request handle (see WizeApi_Cancel)
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if the request is started
+ *         return wize_api_ret_e::WIZE_API_ACCESS_TIMEOUT (3) if another request is in progress
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if given parameter(s) is/are invalid
+ */
+wize_api_ret_e WizeApi_SendAsync(uint8_t *pData, uint8_t u8Size, uint8_t u8Type, const wize_api_notify_t *pNotify, uint16_t *pu16Handle)
+{
+	struct ses_ctx_s *pCtx = &(sSesDispCtx.sSesCtx[SES_ADM]);
+	net_msg_t *pMsg;
+	uint8_t u8L7MaxLen;
+	wize_api_ret_e eRet;
+
+	if ( !pData || !pNotify || !pu16Handle )
+	{
+		return WIZE_API_INVALID_PARAM;
+	}
+	Param_Access(L7TRANSMIT_LENGTH_MAX, (uint8_t*)&u8L7MaxLen, 0);
+	if ( u8Size > u8L7MaxLen)
+	{
+		return WIZE_API_INVALID_PARAM;
+	}
+	if ( (u8Type != APP_DATA) && (u8Type != APP_DATA_PRIO))
+	{
+		return WIZE_API_INVALID_PARAM;
+	}
+	// Don't wait, the ADM session may be in use for seconds
+	if ( xSemaphoreTake( pCtx->hMutex, 0 ) )
+	{
+		if (sAsync[SES_ADM].bBusy)
+		{
+			xSemaphoreGive(pCtx->hMutex);
+			return WIZE_API_ACCESS_TIMEOUT;
+		}
+		pMsg = &((struct adm_mgr_ctx_s*)(pCtx->pPrivate))->sDataMsg;
+		pMsg->pData = pData;
+		pMsg->Option_b.App = 1;
+		pMsg->u8Size = u8Size;
+		pMsg->u8Type = u8Type;
+		eRet = _wize_api_async_(SES_ADM, pNotify, pu16Handle);
+		if (eRet == WIZE_API_SUCCESS)
+		{
+			pMsg->u16Id++;
+		}
+		xSemaphoreGive(pCtx->hMutex);
+		return eRet;
+	}
+	return WIZE_API_ACCESS_TIMEOUT;
+}
+
+/*!
+ * @brief This function cancel an asynchronous request
+ *
+ * @details A request not yet started is dropped. A started one is stopped when
+ * it doesn't send or listen. In both cases the completion is notified with
+ * the WIZE_API_CANCELED result. If the request end before, it is notified as
+ * usual.
+ *
+ * @param [in] u16Handle The request handle
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if the cancel is requested
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if the request doesn't exist (or is done)
+ */
+wize_api_ret_e WizeApi_Cancel(uint16_t u16Handle)
+{
+	uint8_t i;
+	for (i = 0; i < SES_NB; i++)
+	{
+		taskENTER_CRITICAL();
+		if ( sAsync[i].bBusy && (sAsync[i].u16Handle == u16Handle) )
+		{
+			sAsync[i].bCancel = 1;
+			sSesDispCtx.u8CancelMsk |= 1 << i;
+			taskEXIT_CRITICAL();
+			// Wake up the dispatcher (a pending event will do the same)
+			xTaskNotify(sSesDispCtx.hTask, SES_EVT_CANCEL, eSetBits);
+			return WIZE_API_SUCCESS;
+		}
+		taskEXIT_CRITICAL();
+	}
+	return WIZE_API_INVALID_PARAM;
+}
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+
+/*!
+ * @static
+ * @brief This function request a session, the result is notified by
+ * _wize_api_cpl_
+ *
+ * @details The caller must own the session mutex.
+ *
+ * @param [in]  eSesId     The session to request
+ * @param [in]  pNotify    How to notify the completion
+ * @param [out] pu16Handle The request handle
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if the request is started
+ *         return wize_api_ret_e::WIZE_API_ACCESS_TIMEOUT (3) if another request is in progress
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if given parameter(s) is/are invalid
+ */
+static wize_api_ret_e _wize_api_async_(ses_type_t eSesId, const wize_api_notify_t *pNotify, uint16_t *pu16Handle)
+{
+	struct wize_api_async_s *pAsync = &(sAsync[eSesId]);
+
+	if ( !pNotify || !pu16Handle || ( !(pNotify->pfCb) && !(pNotify->hQueue) ) )
+	{
+		return WIZE_API_INVALID_PARAM;
+	}
+	// Ensure that only one request at the time
+	taskENTER_CRITICAL();
+	if (pAsync->bBusy)
+	{
+		taskEXIT_CRITICAL();
+		return WIZE_API_ACCESS_TIMEOUT;
+	}
+	u16AsyncHandle++;
+	if ( !u16AsyncHandle )
+	{
+		u16AsyncHandle++;
+	}
+	pAsync->sNotify = *pNotify;
+	pAsync->u16Handle = u16AsyncHandle;
+	pAsync->bCancel = 0;
+	pAsync->bBusy = 1;
+	// read by the session dispatcher task on completion
+	sSesDispCtx.aCpl[eSesId].pArg = pAsync;
+	sSesDispCtx.aCpl[eSesId].pfCpl = _wize_api_cpl_;
+	*pu16Handle = pAsync->u16Handle;
+	taskEXIT_CRITICAL();
+
+	xTaskNotify(sSesDispCtx.hTask, SCHED_REQ(eSesId) | SES_EVT_OPEN, eSetBits);
+	return WIZE_API_SUCCESS;
+}
+
+/*!
+ * @static
+ * @brief This function notify the completion of an asynchronous request
+ *
+ * @details It is called from the session dispatcher task.
+ *
+ * @param [in] pArg      The asynchronous request
+ * @param [in] eSesId    The session
+ * @param [in] u32BckFlg The session result
+ *
+ * @return None
+ */
+static void _wize_api_cpl_(void *pArg, uint8_t eSesId, uint32_t u32BckFlg)
+{
+	struct wize_api_async_s *pAsync = (struct wize_api_async_s *)pArg;
+	struct adm_mgr_ctx_s *pPrvCtx = &(sSesDispCtx.sAdmMgrCtx);
+	wize_api_notify_t sNotify;
+	wize_api_cpl_t sCpl;
+
+	sCpl.u16Handle = pAsync->u16Handle;
+	sCpl.pAdmCmd = NULL;
+	sCpl.pAdmRsp = NULL;
+	sCpl.pAdmLog = NULL;
+	if (pAsync->bCancel)
+	{
+		sCpl.eRet = WIZE_API_CANCELED;
+	}
+	else if ( (u32BckFlg & ~SES_MGR_FLG_MSK) == SES_MGR_FLG_FAILED )
+	{
+		sCpl.eRet = WIZE_API_FAILED;
+	}
+	else if ( (eSesId == SES_ADM) && ((u32BckFlg & ~SES_MGR_FLG_MSK) == SES_MGR_FLG_REQUEST) )
+	{
+		// at least one command has been received
+		sCpl.pAdmCmd = &(pPrvCtx->sCmdMsg);
+		sCpl.pAdmRsp = &(pPrvCtx->sRspMsg);
+		sCpl.pAdmLog = &(pPrvCtx->sLog);
+		sCpl.eRet = (pPrvCtx->sLog.bWriteParam)?
+				(WIZE_API_ADM_SUCCESS):(WIZE_API_SUCCESS);
+	}
+	else
+	{
+		sCpl.eRet = WIZE_API_SUCCESS;
+	}
+
+	// Release the request before the notification, so a new one can be done
+	sNotify = pAsync->sNotify;
+	taskENTER_CRITICAL();
+	pAsync->bBusy = 0;
+	pAsync->bCancel = 0;
+	taskEXIT_CRITICAL();
+
+	if (sNotify.pfCb)
+	{
+		sNotify.pfCb(&sCpl, sNotify.pArg);
+	}
+	if (sNotify.hQueue)
+	{
+		xQueueSend(sNotify.hQueue, &sCpl, 0);
+	}
+}
+
+/*!
+ * @}
+ * @endcond
+ */
+
+/******************************************************************************/
+
+/*!
+ * @brief This function get the session scheduler statistics
+ *
+ * @details A session requested while another one is active is queued, then
+ * started when possible. This give the queue depth and latency (in tick).
+ *
+ * @param [out] pStats Pointer on the statistics
+ * @param [in]  bClear Clear the statistics
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if everything is fine
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if given parameter(s) is/are invalid
+ */
+wize_api_ret_e WizeApi_GetSchedStats(struct sched_stats_s *pStats, uint8_t bClear)
+{
+	if (pStats)
+	{
+		SesDisp_GetSchedStats(&sSesDispCtx, pStats, bClear);
+		return WIZE_API_SUCCESS;
+	}
+	return WIZE_API_INVALID_PARAM;
+}
+
+/*!
+ * @brief This function configure the transmit slots
+ *
+ * @details Each device transmit with an offset (derived from its address, plus
+ * a random jitter) inside a window, to avoid the whole fleet to transmit at
+ * the same time. The DATA window apply to WizeApi_Send (not to DATA_PRIO), the
+ * install one to the periodic install, the daily one to the application daily
+ * tasks (see WizeApi_GetSlot). Each offset is in [0, window[, so a periodic
+ * install can be delayed by up to its window (SLOT_INST_WINDOW_MS, 1 hour, by
+ * default).
+ *
+ * @param [in] pCfg Pointer on the slot configuration
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if everything is fine
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if given parameter(s) is/are invalid
+ */
+wize_api_ret_e WizeApi_SetSlotCfg(const struct slot_cfg_s *pCfg)
+{
+	if ( SesDisp_SetSlotCfg(&sSesDispCtx, pCfg) == 0 )
+	{
+		return WIZE_API_SUCCESS;
+	}
+	return WIZE_API_INVALID_PARAM;
+}
+
+/*!
+ * @brief This function get the transmit slot offset of this device
+ *
+ * @param [in] eClass The slot class (see @link slot_class_e @endlink)
+ *
+ * @return The offset (ms) to add to the nominal transmit time
+ */
+uint32_t WizeApi_GetSlot(uint8_t eClass)
+{
+	return SesDisp_GetSlot(&sSesDispCtx, eClass);
+}
+
+/*!
+ * @brief This function set the maximum number of ADM commands per session
+ *
+ * @details After each response, a new command window is opened (same delay
+ * and length as the one after the DATA), until this number of commands has
+ * been received or a window stay empty. So, the head-end can send a sequence
+ * of commands (e.g. to write many parameters) in one session. An EXECPING or
+ * ANNDOWNLOAD command always end the session. WizeApi_GetAdmCmd and
+ * WizeApi_GetAdmRsp only give the last command, the sequence is given by
+ * WizeApi_GetAdmLog (or the pAdmLog of the asynchronous completion).
+ *
+ * @param [in] u8CmdMax The maximum number of commands (0 or 1 : one command,
+ *                      after the DATA only)
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if everything is fine
+ */
+wize_api_ret_e WizeApi_SetAdmCmdMax(uint8_t u8CmdMax)
+{
+	taskENTER_CRITICAL();
+	sSesDispCtx.sAdmMgrCtx.u8CmdMax = u8CmdMax;
+	taskEXIT_CRITICAL();
+	return WIZE_API_SUCCESS;
+}
+
+/*!
+ * @brief This function register an application (e.g. manufacturer) ADM
+ * command handler
+ *
+ * @details On reception of this command, the handler pfRsp build the response
+ * directly into the response message (from the session dispatcher task, so it
+ * must be short). Once the response has been sent, and if it has no error, the
+ * handler pfPost execute the command. The handler is not copied, it must
+ * remain valid until it is unregistered.
+ *
+ * @param [in] pHdl Pointer on the command handler
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if everything is fine
+ *         return wize_api_ret_e::WIZE_API_FAILED (1) if there is no more free handler
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if given parameter(s) is/are invalid
+ */
+wize_api_ret_e WizeApi_RegisterAdmCmd(const struct adm_cmd_hdl_s *pHdl)
+{
+	int32_t i32Ret;
+	i32Ret = AdmInt_Register(pHdl);
+	if (i32Ret == 0)
+	{
+		return WIZE_API_SUCCESS;
+	}
+	return (i32Ret == -1)?(WIZE_API_INVALID_PARAM):(WIZE_API_FAILED);
+}
+
+/*!
+ * @brief This function unregister an application ADM command handler
+ *
+ * @param [in] u8CmdId The command id
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if everything is fine
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if this command is not registered
+ */
+wize_api_ret_e WizeApi_UnregisterAdmCmd(uint8_t u8CmdId)
+{
+	if ( AdmInt_Unregister(u8CmdId) == 0 )
+	{
+		return WIZE_API_SUCCESS;
+	}
+	return WIZE_API_INVALID_PARAM;
+}
+
+/******************************************************************************/
+
 /*!
  * @brief This function Clear the Time Update state
  *
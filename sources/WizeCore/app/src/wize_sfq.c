@@ -0,0 +1,648 @@
+/**
+  * @file wize_sfq.c
+  * @brief This file implement the Wize store-and-forward API (persistent queue
+  * of pending DATA messages).
+  *
+  * @details
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  *
+  */
+
+/*!
+ * @addtogroup wize_api
+ * @{
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+
+#include "wize_sfq.h"
+#include "slot_internal.h"
+
+/*
+ * Note : The flash area is read directly (memory mapped), as ImgStorage does.
+ * Pages are used in a circular way : the pages from u16HeadPage to u16TailPage
+ * are in use, the others are erased. The page sequence number give the order
+ * on setup.
+ */
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+
+#define SFQ_ERASED     0xFFFFFFFFFFFFFFFFULL
+#define SFQ_PAGE_MAGIC 0x51465357UL          // "WSFQ"
+#define SFQ_REC_MAGIC  0x5AF0
+#define SFQ_OBSOLETE   0x5346510000000000ULL
+#define SFQ_COMMIT     0x5346510000000001ULL
+#define SFQ_CONSUMED   0x5346510000000002ULL
+
+#define SFQ_DAY_SEC 86400
+
+#define _SFQ_RD_(addr) ( *((const volatile uint64_t*)(uintptr_t)(addr)) )
+#define _SFQ_PAGE_(pCtx, idx) ( (pCtx)->u32Addr + (uint32_t)(idx) * (pCtx)->u32PageSz )
+#define _SFQ_NEXT_(pCtx, idx) ( (uint16_t)( ((idx) + 1) % (pCtx)->u16PageNb ) )
+#define _SFQ_IS_REC_(hdr) ( ((hdr) & 0xFFFF) == SFQ_REC_MAGIC )
+#define _SFQ_REC_SIZE_(hdr) ( (uint8_t)((hdr) >> 16) )
+
+static int32_t _sfq_write_(struct wize_sfq_s *pCtx, uint32_t u32Addr, uint64_t u64Val);
+static int32_t _sfq_open_(struct wize_sfq_s *pCtx, uint16_t u16Page);
+static void _sfq_release_(struct wize_sfq_s *pCtx, uint16_t u16Page);
+static uint8_t _sfq_is_live_(uint32_t u32Rec);
+static void _sfq_seek_(struct wize_sfq_s *pCtx, uint32_t u32Addr);
+static uint8_t _sfq_is_erased_(struct wize_sfq_s *pCtx, uint16_t u16Page);
+static int32_t _sfq_arm_(struct wize_sfq_s *pCtx);
+
+/*!
+ * @}
+ * @endcond
+ */
+
+/******************************************************************************/
+
+/*!
+ * @brief This function setup the store-and-forward queue, and recover the
+ * pending items from flash
+ *
+ * @param [in] pCtx      Pointer on the store-and-forward context
+ * @param [in] u32Addr   Flash area address (page aligned)
+ * @param [in] u32PageSz Flash page size
+ * @param [in] u16PageNb Number of pages in the flash area (at least 2)
+ * @param [in] pfWrite   Function pointer on write sub function
+ * @param [in] pfErase   Function pointer on erase sub function
+ *
+ * @retval  0 Success
+ * @retval  1 Failed (at least one of given parameters is out of range)
+ * @retval -1 Fatal (unable to write or erase the flash memory area)
+ */
+int32_t WizeSfq_Setup(struct wize_sfq_s *pCtx, uint32_t u32Addr, uint32_t u32PageSz, uint16_t u16PageNb, pfWriteFlash_t pfWrite, pfEraseFlash_t pfErase)
+{
+	uint64_t u64Hdr;
+	uint32_t u32Seq, u32Rec, u32End;
+	uint16_t i;
+	uint8_t bFound = 0;
+
+	if ( !pCtx || !pfWrite || !pfErase || (u32Addr & 0x7) || (u32PageSz & 0x7) ||
+		 (u16PageNb < 2) || (u32PageSz < WIZE_SFQ_PAGE_HDR_SZ + WIZE_SFQ_REC_SZ(1)) )
+	{
+		return 1;
+	}
+	memset(pCtx, 0, sizeof(struct wize_sfq_s));
+	pCtx->pfWrite = pfWrite;
+	pCtx->pfErase = pfErase;
+	pCtx->u32Addr = u32Addr;
+	pCtx->u32PageSz = u32PageSz;
+	pCtx->u16PageNb = u16PageNb;
+
+	// find the pages in use, the oldest and the newest one
+	for (i = 0; i < u16PageNb; i++)
+	{
+		u64Hdr = _SFQ_RD_(_SFQ_PAGE_(pCtx, i));
+		if ( ( (u64Hdr & 0xFFFFFFFF) != SFQ_PAGE_MAGIC ) ||
+			 ( _SFQ_RD_(_SFQ_PAGE_(pCtx, i) + 8) != SFQ_ERASED ) )
+		{
+			// not in use (obsolete, erase interrupted...)
+			if ( !_sfq_is_erased_(pCtx, i) )
+			{
+				_sfq_release_(pCtx, i);
+			}
+			continue;
+		}
+		u32Seq = (uint32_t)(u64Hdr >> 32);
+		if ( !bFound || ( (int32_t)(u32Seq - pCtx->u32Seq) > 0 ) )
+		{
+			pCtx->u32Seq = u32Seq;
+			pCtx->u16TailPage = i;
+		}
+		if ( !bFound || ( (int32_t)(u32Seq - (uint32_t)(_SFQ_RD_(_SFQ_PAGE_(pCtx, pCtx->u16HeadPage)) >> 32)) < 0 ) )
+		{
+			pCtx->u16HeadPage = i;
+		}
+		bFound = 1;
+	}
+
+	if ( !bFound )
+	{
+		// empty queue
+		if ( _sfq_open_(pCtx, 0) )
+		{
+			return -1;
+		}
+		pCtx->u32Head = pCtx->u32Tail;
+		return 0;
+	}
+
+	// find the end of the last page
+	u32Rec = _SFQ_PAGE_(pCtx, pCtx->u16TailPage) + WIZE_SFQ_PAGE_HDR_SZ;
+	u32End = _SFQ_PAGE_(pCtx, pCtx->u16TailPage) + u32PageSz;
+	while ( u32Rec + 8 <= u32End )
+	{
+		u64Hdr = _SFQ_RD_(u32Rec);
+		if ( !_SFQ_IS_REC_(u64Hdr) )
+		{
+			if (u64Hdr != SFQ_ERASED)
+			{
+				// corrupted, don't write anymore in this page
+				u32Rec = u32End;
+			}
+			break;
+		}
+		if ( (u32Rec + WIZE_SFQ_REC_SZ(_SFQ_REC_SIZE_(u64Hdr))) > u32End )
+		{
+			u32Rec = u32End;
+			break;
+		}
+		u32Rec += WIZE_SFQ_REC_SZ(_SFQ_REC_SIZE_(u64Hdr));
+	}
+	pCtx->u32Tail = u32Rec;
+
+	// count the pending items
+	i = pCtx->u16HeadPage;
+	while (1)
+	{
+		u32Rec = _SFQ_PAGE_(pCtx, i) + WIZE_SFQ_PAGE_HDR_SZ;
+		u32End = (i == pCtx->u16TailPage)?(pCtx->u32Tail):(_SFQ_PAGE_(pCtx, i) + u32PageSz);
+		while ( u32Rec + 8 <= u32End )
+		{
+			u64Hdr = _SFQ_RD_(u32Rec);
+			if ( !_SFQ_IS_REC_(u64Hdr) ||
+				 ( (u32Rec + WIZE_SFQ_REC_SZ(_SFQ_REC_SIZE_(u64Hdr))) > u32End ) )
+			{
+				break;
+			}
+			if ( _sfq_is_live_(u32Rec) )
+			{
+				pCtx->u16Count++;
+			}
+			else if ( _SFQ_RD_(u32Rec + WIZE_SFQ_REC_SZ(_SFQ_REC_SIZE_(u64Hdr)) - 16) != SFQ_COMMIT )
+			{
+				pCtx->sStats.u32TornNb++;
+			}
+			u32Rec += WIZE_SFQ_REC_SZ(_SFQ_REC_SIZE_(u64Hdr));
+		}
+		if (i == pCtx->u16TailPage)
+		{
+			break;
+		}
+		i = _SFQ_NEXT_(pCtx, i);
+	}
+
+	// move on the oldest pending item (release the already sent pages)
+	_sfq_seek_(pCtx, _SFQ_PAGE_(pCtx, pCtx->u16HeadPage) + WIZE_SFQ_PAGE_HDR_SZ);
+	return 0;
+}
+
+/*!
+ * @brief This function queue an item
+ *
+ * @param [in] pCtx   Pointer on the store-and-forward context
+ * @param [in] u8Type Type of message (APP_DATA or APP_DATA_PRIO)
+ * @param [in] pData  Pointer on the item data
+ * @param [in] u8Size The item size
+ *
+ * @retval  0 Success
+ * @retval  1 Failed (the queue is full)
+ * @retval -1 Fatal (invalid parameter, or unable to write the flash memory)
+ */
+int32_t WizeSfq_Push(struct wize_sfq_s *pCtx, uint8_t u8Type, const uint8_t *pData, uint8_t u8Size)
+{
+	uint64_t aRec[1 + 32];
+	uint32_t u32RecSz;
+	uint32_t u32Rec;
+	uint16_t u16Next;
+	time_t t;
+
+	if ( !pCtx || !(pCtx->pfWrite) || !pData || !u8Size ||
+		 ( (u8Type != APP_DATA) && (u8Type != APP_DATA_PRIO) ) )
+	{
+		return -1;
+	}
+	u32RecSz = WIZE_SFQ_REC_SZ(u8Size);
+	if ( u32RecSz > pCtx->u32PageSz - WIZE_SFQ_PAGE_HDR_SZ )
+	{
+		return -1;
+	}
+
+	if ( pCtx->u32Tail + u32RecSz > _SFQ_PAGE_(pCtx, pCtx->u16TailPage) + pCtx->u32PageSz )
+	{
+		// doesn't fit, go to next page
+		u16Next = _SFQ_NEXT_(pCtx, pCtx->u16TailPage);
+		if (u16Next == pCtx->u16HeadPage)
+		{
+			pCtx->sStats.u32FullNb++;
+			return 1;
+		}
+		if ( _sfq_open_(pCtx, u16Next) )
+		{
+			return -1;
+		}
+		if ( !(pCtx->u16Count) )
+		{
+			// nothing pending in the previous page
+			_sfq_seek_(pCtx, pCtx->u32Head);
+		}
+	}
+
+	// header and data first...
+	time(&t);
+	memset(aRec, 0xFF, sizeof(aRec));
+	aRec[0] = ( (uint64_t)(uint32_t)t << 32 ) | ( (uint64_t)u8Type << 24 ) |
+			  ( (uint64_t)u8Size << 16 ) | SFQ_REC_MAGIC;
+	memcpy(&(aRec[1]), pData, u8Size);
+	u32Rec = pCtx->u32Tail;
+	pCtx->u32Tail += u32RecSz;
+	if ( pCtx->pfWrite(u32Rec, aRec, (u32RecSz - 16) >> 3) )
+	{
+		return -1;
+	}
+	// ...then commit
+	if ( _sfq_write_(pCtx, u32Rec + u32RecSz - 16, SFQ_COMMIT) )
+	{
+		return -1;
+	}
+	if ( !(pCtx->u16Count) )
+	{
+		pCtx->u32Head = u32Rec;
+		pCtx->u16HeadPage = pCtx->u16TailPage;
+	}
+	pCtx->u16Count++;
+	pCtx->sStats.u32PushNb++;
+	return 0;
+}
+
+/*!
+ * @brief This function get the oldest pending item (without removing it)
+ *
+ * @param [in]  pCtx  Pointer on the store-and-forward context
+ * @param [out] pItem Pointer on the item (its data are not copied)
+ *
+ * @retval  1 An item is given
+ * @retval  0 The queue is empty
+ * @retval -1 Invalid parameter
+ */
+int32_t WizeSfq_Peek(struct wize_sfq_s *pCtx, wize_sfq_item_t *pItem)
+{
+	uint64_t u64Hdr;
+
+	if ( !pCtx || !pItem )
+	{
+		return -1;
+	}
+	if ( !(pCtx->u16Count) )
+	{
+		return 0;
+	}
+	u64Hdr = _SFQ_RD_(pCtx->u32Head);
+	pItem->u32Time = (uint32_t)(u64Hdr >> 32);
+	pItem->u8Type = (uint8_t)(u64Hdr >> 24);
+	pItem->u8Size = _SFQ_REC_SIZE_(u64Hdr);
+	pItem->pData = (const uint8_t*)(uintptr_t)(pCtx->u32Head + 8);
+	return 1;
+}
+
+/*!
+ * @brief This function remove the oldest pending item
+ *
+ * @param [in] pCtx Pointer on the store-and-forward context
+ *
+ * @retval  0 Success
+ * @retval  1 Failed (the queue is empty)
+ * @retval -1 Fatal (invalid parameter, or unable to write the flash memory)
+ */
+int32_t WizeSfq_Pop(struct wize_sfq_s *pCtx)
+{
+	uint32_t u32RecSz;
+
+	if ( !pCtx || !(pCtx->pfWrite) )
+	{
+		return -1;
+	}
+	if ( !(pCtx->u16Count) )
+	{
+		return 1;
+	}
+	u32RecSz = WIZE_SFQ_REC_SZ(_SFQ_REC_SIZE_(_SFQ_RD_(pCtx->u32Head)));
+	if ( _sfq_write_(pCtx, pCtx->u32Head + u32RecSz - 8, SFQ_CONSUMED) )
+	{
+		return -1;
+	}
+	pCtx->u16Count--;
+	pCtx->sStats.u32PopNb++;
+	_sfq_seek_(pCtx, pCtx->u32Head + u32RecSz);
+	return 0;
+}
+
+/*!
+ * @brief This function get the number of pending items
+ *
+ * @param [in] pCtx Pointer on the store-and-forward context
+ *
+ * @return The number of pending items
+ */
+uint16_t WizeSfq_GetCount(struct wize_sfq_s *pCtx)
+{
+	return (pCtx)?(pCtx->u16Count):(0);
+}
+
+/*!
+ * @brief This function set the daily drain time
+ *
+ * @details At the given time of day, the given task is notified with u32Event,
+ * it should then call WizeSfq_Drain (that set the next day drain).
+ *
+ * @param [in] pCtx         Pointer on the store-and-forward context
+ * @param [in] hTask        Task to notify on drain time
+ * @param [in] u32Event     Event to notify on drain time
+ * @param [in] u32TimeOfDay Drain time of day (s, UTC)
+ *
+ * @retval  0 Success
+ * @retval  1 Failed (at least one of given parameters is out of range)
+ */
+int32_t WizeSfq_SetDrain(struct wize_sfq_s *pCtx, void *hTask, uint32_t u32Event, uint32_t u32TimeOfDay)
+{
+	if ( !pCtx || !hTask || (u32TimeOfDay >= SFQ_DAY_SEC) )
+	{
+		return 1;
+	}
+	if (pCtx->bTimer)
+	{
+		TimeEvt_TimerStop(&(pCtx->sTimeEvt));
+	}
+	pCtx->bTimer = 0;
+	if ( TimeEvt_TimerInit(&(pCtx->sTimeEvt), hTask, TIMEEVT_CFG_ABSOLUTE) )
+	{
+		return 1;
+	}
+	pCtx->bTimer = 1;
+	pCtx->u32Event = u32Event;
+	pCtx->u32DrainTod = u32TimeOfDay;
+	return _sfq_arm_(pCtx);
+}
+
+/*!
+ * @brief This function send the pending items, back to back
+ *
+ * @details Each item is sent with WizeApi_Send (so the call blocks for all
+ * the exchanges), and removed once sent. The drain stops on the first failure,
+ * the remaining items are kept for the next drain. The next day drain is set,
+ * if any.
+ *
+ * @param [in] pCtx     Pointer on the store-and-forward context
+ * @param [in] u16MaxNb Maximum number of items to send (0 : all)
+ *
+ * @retval return wize_api_ret_e::WIZE_API_SUCCESS (0) if everything is fine
+ *         return wize_api_ret_e::WIZE_API_FAILED (1) if a send failed
+ *         return wize_api_ret_e::WIZE_API_ADM_SUCCESS (2) if ADM CMD has been received
+ *         return wize_api_ret_e::WIZE_API_ACCESS_TIMEOUT (3) if access is refused
+ *         return wize_api_ret_e::WIZE_API_INVALID_PARAM (4) if given parameter(s) is/are invalid
+ */
+wize_api_ret_e WizeSfq_Drain(struct wize_sfq_s *pCtx, uint16_t u16MaxNb)
+{
+	wize_api_ret_e eRet = WIZE_API_SUCCESS;
+	wize_api_ret_e eSend;
+	wize_sfq_item_t sItem;
+	uint16_t u16Nb = 0;
+
+	if ( !pCtx )
+	{
+		return WIZE_API_INVALID_PARAM;
+	}
+	pCtx->sStats.u32DrainNb++;
+	while ( ( !u16MaxNb || (u16Nb < u16MaxNb) ) && ( WizeSfq_Peek(pCtx, &sItem) == 1 ) )
+	{
+		eSend = WizeApi_Send((uint8_t*)sItem.pData, sItem.u8Size, sItem.u8Type);
+		if ( (eSend != WIZE_API_SUCCESS) && (eSend != WIZE_API_ADM_SUCCESS) )
+		{
+			pCtx->sStats.u32FailNb++;
+			eRet = eSend;
+			break;
+		}
+		if (eSend == WIZE_API_ADM_SUCCESS)
+		{
+			eRet = eSend;
+		}
+		if ( WizeSfq_Pop(pCtx) )
+		{
+			eRet = WIZE_API_FAILED;
+			break;
+		}
+		u16Nb++;
+	}
+	if (pCtx->bTimer)
+	{
+		_sfq_arm_(pCtx);
+	}
+	return eRet;
+}
+
+/******************************************************************************/
+
+/*!
+ * @static
+ * @brief This function write one double-word
+ *
+ * @param [in] pCtx    Pointer on the store-and-forward context
+ * @param [in] u32Addr Address to write
+ * @param [in] u64Val  Value to write
+ *
+ * @retval  0 Success
+ * @retval -1 Failed
+ */
+static int32_t _sfq_write_(struct wize_sfq_s *pCtx, uint32_t u32Addr, uint64_t u64Val)
+{
+	return ( pCtx->pfWrite(u32Addr, &u64Val, 1) )?(-1):(0);
+}
+
+/*!
+ * @static
+ * @brief This function start to use a page (erased) as the last one
+ *
+ * @param [in] pCtx    Pointer on the store-and-forward context
+ * @param [in] u16Page The page
+ *
+ * @retval  0 Success
+ * @retval -1 Failed
+ */
+static int32_t _sfq_open_(struct wize_sfq_s *pCtx, uint16_t u16Page)
+{
+	pCtx->u32Seq++;
+	if ( _sfq_write_(pCtx, _SFQ_PAGE_(pCtx, u16Page), ( (uint64_t)pCtx->u32Seq << 32 ) | SFQ_PAGE_MAGIC) )
+	{
+		return -1;
+	}
+	pCtx->u16TailPage = u16Page;
+	pCtx->u32Tail = _SFQ_PAGE_(pCtx, u16Page) + WIZE_SFQ_PAGE_HDR_SZ;
+	return 0;
+}
+
+/*!
+ * @static
+ * @brief This function release a page (mark it obsolete, then erase it)
+ *
+ * @param [in] pCtx    Pointer on the store-and-forward context
+ * @param [in] u16Page The page
+ *
+ * @return None
+ */
+static void _sfq_release_(struct wize_sfq_s *pCtx, uint16_t u16Page)
+{
+	uint32_t u32Page = _SFQ_PAGE_(pCtx, u16Page);
+	if ( _SFQ_RD_(u32Page + 8) == SFQ_ERASED )
+	{
+		_sfq_write_(pCtx, u32Page + 8, SFQ_OBSOLETE);
+	}
+	// on failure, the page will be erased again on next setup
+	pCtx->pfErase(u32Page, pCtx->u32PageSz);
+	pCtx->sStats.u32EraseNb++;
+}
+
+/*!
+ * @static
+ * @brief This function check if a record is pending (committed and not
+ * consumed)
+ *
+ * @param [in] u32Rec The record address
+ *
+ * @retval 0 The record is not pending
+ * @retval 1 The record is pending
+ */
+static uint8_t _sfq_is_live_(uint32_t u32Rec)
+{
+	uint32_t u32RecSz = WIZE_SFQ_REC_SZ(_SFQ_REC_SIZE_(_SFQ_RD_(u32Rec)));
+	return ( ( _SFQ_RD_(u32Rec + u32RecSz - 16) == SFQ_COMMIT ) &&
+			 ( _SFQ_RD_(u32Rec + u32RecSz - 8) == SFQ_ERASED ) );
+}
+
+/*!
+ * @static
+ * @brief This function move the head on the first pending record from the
+ * given address (the passed pages are released)
+ *
+ * @param [in] pCtx    Pointer on the store-and-forward context
+ * @param [in] u32Addr The address to start from (in the head page)
+ *
+ * @return None
+ */
+static void _sfq_seek_(struct wize_sfq_s *pCtx, uint32_t u32Addr)
+{
+	uint64_t u64Hdr;
+	uint32_t u32End;
+	uint16_t u16Page = pCtx->u16HeadPage;
+
+	while (1)
+	{
+		if (u32Addr == pCtx->u32Tail)
+		{
+			break;
+		}
+		u32End = _SFQ_PAGE_(pCtx, u16Page) + pCtx->u32PageSz;
+		if (u32Addr + 8 <= u32End)
+		{
+			u64Hdr = _SFQ_RD_(u32Addr);
+			if ( _SFQ_IS_REC_(u64Hdr) &&
+				 ( (u32Addr + WIZE_SFQ_REC_SZ(_SFQ_REC_SIZE_(u64Hdr))) <= u32End ) )
+			{
+				if ( _sfq_is_live_(u32Addr) )
+				{
+					break;
+				}
+				u32Addr += WIZE_SFQ_REC_SZ(_SFQ_REC_SIZE_(u64Hdr));
+				continue;
+			}
+		}
+		// end of page
+		if (u16Page == pCtx->u16TailPage)
+		{
+			u32Addr = pCtx->u32Tail;
+			break;
+		}
+		_sfq_release_(pCtx, u16Page);
+		u16Page = _SFQ_NEXT_(pCtx, u16Page);
+		u32Addr = _SFQ_PAGE_(pCtx, u16Page) + WIZE_SFQ_PAGE_HDR_SZ;
+	}
+	pCtx->u32Head = u32Addr;
+	pCtx->u16HeadPage = u16Page;
+}
+
+/*!
+ * @static
+ * @brief This function check if a page is erased
+ *
+ * @param [in] pCtx    Pointer on the store-and-forward context
+ * @param [in] u16Page The page
+ *
+ * @retval 0 The page is not erased
+ * @retval 1 The page is erased
+ */
+static uint8_t _sfq_is_erased_(struct wize_sfq_s *pCtx, uint16_t u16Page)
+{
+	uint32_t u32Addr = _SFQ_PAGE_(pCtx, u16Page);
+	uint32_t u32End = u32Addr + pCtx->u32PageSz;
+	for (; u32Addr < u32End; u32Addr += 8)
+	{
+		if (_SFQ_RD_(u32Addr) != SFQ_ERASED)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*!
+ * @static
+ * @brief This function start the drain timer on the next drain time
+ *
+ * @details The drain time is shifted by the daily transmit slot of this device
+ * (see WizeApi_GetSlot).
+ *
+ * @param [in] pCtx Pointer on the store-and-forward context
+ *
+ * @retval  0 Success
+ * @retval  1 Failed
+ */
+static int32_t _sfq_arm_(struct wize_sfq_s *pCtx)
+{
+	time_t t;
+	uint32_t u32Next;
+
+	time(&t);
+	u32Next = (uint32_t)t - ((uint32_t)t % SFQ_DAY_SEC) + pCtx->u32DrainTod;
+	u32Next += WizeApi_GetSlot(SLOT_CLASS_DAILY) / 1000;
+	if ( u32Next <= (uint32_t)t )
+	{
+		u32Next += SFQ_DAY_SEC;
+	}
+	TimeEvt_TimerStop(&(pCtx->sTimeEvt));
+	return ( TimeEvt_TimerStart(&(pCtx->sTimeEvt), u32Next, 0, pCtx->u32Event) )?(1):(0);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
@@ -0,0 +1,62 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(WizeCore_app_link)
+{
+    RUN_TEST_CASE(WizeCore_app_link, test_LinkInt_Dwn_NoiseUnknown);
+    RUN_TEST_CASE(WizeCore_app_link, test_LinkInt_Dwn_NoiseQuiet);
+    RUN_TEST_CASE(WizeCore_app_link, test_LinkInt_Dwn_NoiseBusy);
+    RUN_TEST_CASE(WizeCore_app_link, test_LinkInt_Apply_NoiseBusy);
+}
+
+TEST_GROUP_RUNNER(WizeCore_app_sfq)
+{
+    RUN_TEST_CASE(WizeCore_app_sfq, test_WizeSfq_RecordLayout);
+    RUN_TEST_CASE(WizeCore_app_sfq, test_WizeSfq_PeekPop);
+    RUN_TEST_CASE(WizeCore_app_sfq, test_WizeSfq_Recover);
+    RUN_TEST_CASE(WizeCore_app_sfq, test_WizeSfq_TornWrite);
+    RUN_TEST_CASE(WizeCore_app_sfq, test_WizeSfq_TornErase);
+    RUN_TEST_CASE(WizeCore_app_sfq, test_WizeSfq_FullWrap);
+    RUN_TEST_CASE(WizeCore_app_sfq, test_WizeSfq_Drain);
+}
+
+TEST_GROUP_RUNNER(WizeCore_app_adm)
+{
+    RUN_TEST_CASE(WizeCore_app_adm, test_AdmInt_Register_Invalid);
+    RUN_TEST_CASE(WizeCore_app_adm, test_AdmInt_Register_Full);
+    RUN_TEST_CASE(WizeCore_app_adm, test_AdmInt_PreCmd_AppCmd);
+    RUN_TEST_CASE(WizeCore_app_adm, test_AdmInt_PreCmd_RspMax);
+    RUN_TEST_CASE(WizeCore_app_adm, test_AdmInt_PreCmd_L7Max);
+    RUN_TEST_CASE(WizeCore_app_adm, test_AdmInt_PreCmd_Deferred);
+    RUN_TEST_CASE(WizeCore_app_adm, test_AdmInt_Cache_Hit);
+    RUN_TEST_CASE(WizeCore_app_adm, test_AdmInt_Cache_Invalidation);
+    RUN_TEST_CASE(WizeCore_app_adm, test_AdmInt_Cache_WriteWhileBuild);
+    RUN_TEST_CASE(WizeCore_app_adm, test_AdmInt_Cache_Lru);
+    RUN_TEST_CASE(WizeCore_app_adm, test_AdmInt_Cache_Errors);
+    RUN_TEST_CASE(WizeCore_app_adm, test_AdmInt_Cache_Volatile);
+}
+
+TEST_GROUP_RUNNER(WizeCore_app_slot)
+{
+    RUN_TEST_CASE(WizeCore_app_slot, test_SlotInt_Default);
+    RUN_TEST_CASE(WizeCore_app_slot, test_SlotInt_Config_Invalid);
+    RUN_TEST_CASE(WizeCore_app_slot, test_SlotInt_Distribution);
+    RUN_TEST_CASE(WizeCore_app_slot, test_SlotInt_Seed);
+    RUN_TEST_CASE(WizeCore_app_slot, test_SlotInt_SmallWindow);
+}
+
+TEST_GROUP_RUNNER(WizeCore_app_agg)
+{
+    RUN_TEST_CASE(WizeCore_app_agg, test_WizeAgg_Init);
+    RUN_TEST_CASE(WizeCore_app_agg, test_WizeAgg_Full);
+    RUN_TEST_CASE(WizeCore_app_agg, test_WizeAgg_Unpack);
+    RUN_TEST_CASE(WizeCore_app_agg, test_WizeAgg_HoldExpiry);
+}
+
+TEST_GROUP_RUNNER(WizeCore_app_sched)
+{
+    RUN_TEST_CASE(WizeCore_app_sched, test_SchedInt_Priority);
+    RUN_TEST_CASE(WizeCore_app_sched, test_SchedInt_Slot);
+    RUN_TEST_CASE(WizeCore_app_sched, test_SchedInt_DwnGap);
+    RUN_TEST_CASE(WizeCore_app_sched, test_SchedInt_DwnReplay);
+    RUN_TEST_CASE(WizeCore_app_sched, test_SchedInt_ReqBits);
+}
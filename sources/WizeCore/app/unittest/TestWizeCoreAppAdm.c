@@ -0,0 +1,514 @@
+#include "unity_fixture.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+TEST_GROUP(WizeCore_app_adm);
+#include "adm_internal.h"
+#include "parameters.h"
+#include "parameters_lan_ids.h"
+
+/******************************************************************************/
+
+/*
+ * A small parameter table stands for the Parameters module. Each parameter
+ * value is 2 bytes.
+ */
+#define FAKE_PARAM_SZ 2
+
+struct fake_param_s {
+	uint8_t u8Id;
+	param_access_e eRem;
+	uint8_t aVal[FAKE_PARAM_SZ];
+};
+
+static struct fake_param_s aFakeParam[] = {
+	{ .u8Id = VERS_FW_TRX,           .eRem = RO, .aVal = { 0x01, 0x02 } },
+	{ .u8Id = L7TRANSMIT_LENGTH_MAX, .eRem = RO, .aVal = { 80, 0 } },
+	{ .u8Id = 0x30,                  .eRem = RW, .aVal = { 0x30, 0x31 } },
+	{ .u8Id = 0x31,                  .eRem = RW, .aVal = { 0x40, 0x41 } },
+	{ .u8Id = 0x32,                  .eRem = WO, .aVal = { 0x50, 0x51 } },
+	{ .u8Id = CLOCK_CURRENT_EPOC,    .eRem = RW, .aVal = { 0x60, 0x61 } },
+};
+#define FAKE_PARAM_NB ( sizeof(aFakeParam) / sizeof(aFakeParam[0]) )
+
+static uint32_t u32RemoteRead;
+static uint32_t u32WriteOnRead;
+static param_write_nb_s *pWriteNb;
+
+static struct fake_param_s *_fake_find_(uint8_t u8_Id)
+{
+	uint8_t i;
+	for (i = 0; i < FAKE_PARAM_NB; i++)
+	{
+		if (aFakeParam[i].u8Id == u8_Id)
+		{
+			return &(aFakeParam[i]);
+		}
+	}
+	return NULL;
+}
+
+void Param_AddWriteCb(param_write_nb_s *p_Nb)
+{
+	pWriteNb = p_Nb;
+}
+
+void Param_RemoveWriteCb(param_write_nb_s *p_Nb)
+{
+	if (pWriteNb == p_Nb)
+	{
+		pWriteNb = NULL;
+	}
+}
+
+uint8_t Param_IsValidId(uint8_t u8_Id)
+{
+	return (_fake_find_(u8_Id) != NULL);
+}
+
+uint8_t Param_GetSize(uint8_t u8_Id)
+{
+	return (_fake_find_(u8_Id))?(FAKE_PARAM_SZ):(0);
+}
+
+param_access_e Param_GetRemAccess(uint8_t u8_Id)
+{
+	struct fake_param_s *p = _fake_find_(u8_Id);
+	return (p)?(p->eRem):(NA);
+}
+
+uint8_t Param_CheckConformity(uint8_t u8_Id, uint8_t* p_Data)
+{
+	(void)u8_Id;
+	(void)p_Data;
+	return 1;
+}
+
+uint8_t Param_Access(uint8_t u8_Id, uint8_t* p_Data, uint8_t u8_Dir)
+{
+	struct fake_param_s *p = _fake_find_(u8_Id);
+	if (!p)
+	{
+		return 0;
+	}
+	if (u8_Dir)
+	{
+		memcpy(p->aVal, p_Data, FAKE_PARAM_SZ);
+	}
+	else
+	{
+		// L7TRANSMIT_LENGTH_MAX is a 1 byte parameter
+		memcpy(p_Data, p->aVal, (u8_Id == L7TRANSMIT_LENGTH_MAX)?(1):(FAKE_PARAM_SZ));
+	}
+	return 1;
+}
+
+uint8_t Param_RemoteAccess(uint8_t u8_Id, uint8_t* p_Data, uint8_t u8_Dir)
+{
+	struct fake_param_s *p = _fake_find_(u8_Id);
+	if ( !p || !(p->eRem & ((u8_Dir)?(WO):(RO))) )
+	{
+		return 0;
+	}
+	if (!u8_Dir)
+	{
+		u32RemoteRead++;
+		// emulate a write from an other task, while the response is built
+		if ( (u32RemoteRead == u32WriteOnRead) && pWriteNb )
+		{
+			pWriteNb->pf_Cb(0x7F);
+		}
+	}
+	return Param_Access(u8_Id, p_Data, u8_Dir);
+}
+
+/******************************************************************************/
+
+#define APP_CMD_ID 0xA0
+
+static uint8_t aReq[32];
+static uint8_t aRsp[ADM_INT_RSP_SZ_MAX];
+static net_msg_t sReqMsg;
+static net_msg_t sRspMsg;
+
+static uint8_t u8HdlRspSz;
+static uint8_t u8HdlRspNb;
+static uint8_t u8HdlPostNb;
+
+static void _hdl_rsp_(net_msg_t *pReqMsg, net_msg_t *pRspMsg)
+{
+	((admin_rsp_cmderr_t*)(pRspMsg->pData))->L7ResponseId = pReqMsg->pData[0];
+	((admin_rsp_cmderr_t*)(pRspMsg->pData))->L7ErrorCode = ADM_NONE;
+	memset(&(pRspMsg->pData[sizeof(admin_rsp_cmderr_t)]), 0x5A, u8HdlRspSz - sizeof(admin_rsp_cmderr_t));
+	pRspMsg->u8Size = u8HdlRspSz;
+	u8HdlRspNb++;
+}
+
+static void _hdl_post_(net_msg_t *pReqMsg, net_msg_t *pRspMsg)
+{
+	(void)pReqMsg;
+	(void)pRspMsg;
+	u8HdlPostNb++;
+}
+
+static struct adm_cmd_hdl_s sAppHdl;
+
+/*
+ * With the cache disabled (ADM_INT_CACHE_NB = 0), each response is built
+ * again, so the expected number of parameter reads differs.
+ */
+#if ADM_INT_CACHE_NB > 0
+	#define CACHED(with, without) (with)
+#else
+	#define CACHED(with, without) (without)
+#endif
+
+static uint8_t _cmd_(uint8_t u8CmdId, const uint8_t *pArg, uint8_t u8ArgSz, uint16_t u16Id)
+{
+	aReq[0] = u8CmdId;
+	memcpy(&aReq[1], pArg, u8ArgSz);
+	sReqMsg.u8Size = u8ArgSz + 1;
+	sReqMsg.u16Id = u16Id;
+	memset(aRsp, 0, sizeof(aRsp));
+	return AdmInt_PreCmd(&sReqMsg, &sRspMsg);
+}
+
+/******************************************************************************/
+TEST_SETUP(WizeCore_app_adm)
+{
+	uint8_t i;
+	memset(&sReqMsg, 0, sizeof(sReqMsg));
+	memset(&sRspMsg, 0, sizeof(sRspMsg));
+	sReqMsg.pData = aReq;
+	sRspMsg.pData = aRsp;
+	sRspMsg.u16Id = 0xFFFF;
+
+	aFakeParam[1].aVal[0] = 80;
+	u32RemoteRead = 0;
+	u32WriteOnRead = 0;
+	pWriteNb = NULL;
+
+	u8HdlRspSz = sizeof(admin_rsp_cmderr_t);
+	u8HdlRspNb = 0;
+	u8HdlPostNb = 0;
+	memset(&sAppHdl, 0, sizeof(sAppHdl));
+	sAppHdl.u8CmdId = APP_CMD_ID;
+	sAppHdl.pfRsp = _hdl_rsp_;
+	sAppHdl.pfPost = _hdl_post_;
+	sAppHdl.u8RspMax = 60;
+
+	for (i = 0; i < 0xFF; i++)
+	{
+		AdmInt_Unregister(i);
+	}
+	AdmInt_CacheSetup();
+}
+
+TEST_TEAR_DOWN(WizeCore_app_adm)
+{
+}
+
+/******************************************************************************/
+TEST(WizeCore_app_adm, test_AdmInt_Register_Invalid)
+{
+	struct adm_cmd_hdl_s sHdl;
+
+	TEST_ASSERT_EQUAL_INT32(-1, AdmInt_Register(NULL));
+
+	sHdl = sAppHdl;
+	sHdl.pfRsp = NULL;
+	TEST_ASSERT_EQUAL_INT32(-1, AdmInt_Register(&sHdl));
+
+	// standard command can't be replaced
+	sHdl = sAppHdl;
+	sHdl.u8CmdId = ADM_WRITE_PARAM;
+	TEST_ASSERT_EQUAL_INT32(-1, AdmInt_Register(&sHdl));
+	sHdl.u8CmdId = ADM_UNK_CMD;
+	TEST_ASSERT_EQUAL_INT32(-1, AdmInt_Register(&sHdl));
+
+	sHdl = sAppHdl;
+	sHdl.u8RspMax = sizeof(admin_rsp_cmderr_t) - 1;
+	TEST_ASSERT_EQUAL_INT32(-1, AdmInt_Register(&sHdl));
+	sHdl.u8RspMax = ADM_INT_RSP_SZ_MAX + 1;
+	TEST_ASSERT_EQUAL_INT32(-1, AdmInt_Register(&sHdl));
+
+	TEST_ASSERT_EQUAL_INT32(-1, AdmInt_Unregister(APP_CMD_ID));
+}
+
+TEST(WizeCore_app_adm, test_AdmInt_Register_Full)
+{
+	struct adm_cmd_hdl_s aHdl[ADM_INT_HDL_NB + 1];
+	uint8_t i;
+
+	for (i = 0; i < ADM_INT_HDL_NB + 1; i++)
+	{
+		aHdl[i] = sAppHdl;
+		aHdl[i].u8CmdId = APP_CMD_ID + i;
+	}
+	for (i = 0; i < ADM_INT_HDL_NB; i++)
+	{
+		TEST_ASSERT_EQUAL_INT32(0, AdmInt_Register(&aHdl[i]));
+	}
+	TEST_ASSERT_EQUAL_INT32(-2, AdmInt_Register(&aHdl[ADM_INT_HDL_NB]));
+
+	// same id replace the previous one
+	TEST_ASSERT_EQUAL_INT32(0, AdmInt_Register(&sAppHdl));
+
+	// free one
+	TEST_ASSERT_EQUAL_INT32(0, AdmInt_Unregister(APP_CMD_ID + 1));
+	TEST_ASSERT_EQUAL_INT32(-1, AdmInt_Unregister(APP_CMD_ID + 1));
+	TEST_ASSERT_EQUAL_INT32(0, AdmInt_Register(&aHdl[ADM_INT_HDL_NB]));
+}
+
+TEST(WizeCore_app_adm, test_AdmInt_PreCmd_AppCmd)
+{
+	const uint8_t aArg[] = { 0x01, 0x02 };
+
+	// not registered
+	TEST_ASSERT_EQUAL_UINT8(1, _cmd_(APP_CMD_ID, aArg, sizeof(aArg), 1));
+	TEST_ASSERT_EQUAL_UINT8(sizeof(admin_rsp_cmderr_t), sRspMsg.u8Size);
+	TEST_ASSERT_EQUAL_HEX8(ADM_UNK_CMD, aRsp[1]);
+	TEST_ASSERT_EQUAL_UINT8(0, u8HdlRspNb);
+
+	TEST_ASSERT_EQUAL_INT32(0, AdmInt_Register(&sAppHdl));
+	u8HdlRspSz = 10;
+	TEST_ASSERT_EQUAL_UINT8(1, _cmd_(APP_CMD_ID, aArg, sizeof(aArg), 2));
+	TEST_ASSERT_EQUAL_UINT8(1, u8HdlRspNb);
+	TEST_ASSERT_EQUAL_UINT8(10, sRspMsg.u8Size);
+	TEST_ASSERT_EQUAL_HEX8(APP_CMD_ID, aRsp[0]);
+	TEST_ASSERT_EQUAL_HEX8(ADM_NONE, aRsp[1]);
+
+	// repeated command : response already built
+	TEST_ASSERT_EQUAL_UINT8(2, AdmInt_PreCmd(&sReqMsg, &sRspMsg));
+	TEST_ASSERT_EQUAL_UINT8(1, u8HdlRspNb);
+
+	AdmInt_PostCmd(&sReqMsg, &sRspMsg);
+	TEST_ASSERT_EQUAL_UINT8(1, u8HdlPostNb);
+
+	TEST_ASSERT_EQUAL_INT32(0, AdmInt_Unregister(APP_CMD_ID));
+	AdmInt_PostCmd(&sReqMsg, &sRspMsg);
+	TEST_ASSERT_EQUAL_UINT8(1, u8HdlPostNb);
+}
+
+TEST(WizeCore_app_adm, test_AdmInt_PreCmd_RspMax)
+{
+	const uint8_t aArg[] = { 0x01 };
+
+	sAppHdl.u8RspMax = 20;
+	TEST_ASSERT_EQUAL_INT32(0, AdmInt_Register(&sAppHdl));
+
+	// as great as allowed
+	u8HdlRspSz = 20;
+	TEST_ASSERT_EQUAL_UINT8(1, _cmd_(APP_CMD_ID, aArg, sizeof(aArg), 1));
+	TEST_ASSERT_EQUAL_UINT8(20, sRspMsg.u8Size);
+	TEST_ASSERT_EQUAL_HEX8(ADM_NONE, aRsp[1]);
+
+	// greater than the handler maximum : rejected
+	u8HdlRspSz = 21;
+	TEST_ASSERT_EQUAL_UINT8(1, _cmd_(APP_CMD_ID, aArg, sizeof(aArg), 2));
+	TEST_ASSERT_EQUAL_UINT8(2, u8HdlRspNb);
+	TEST_ASSERT_EQUAL_UINT8(sizeof(admin_rsp_cmderr_t), sRspMsg.u8Size);
+	TEST_ASSERT_EQUAL_HEX8(APP_CMD_ID, aRsp[0]);
+	TEST_ASSERT_EQUAL_HEX8(ADM_UNK_CMD, aRsp[1]);
+}
+
+TEST(WizeCore_app_adm, test_AdmInt_PreCmd_L7Max)
+{
+	const uint8_t aArg[] = { 0x01 };
+
+	TEST_ASSERT_EQUAL_INT32(0, AdmInt_Register(&sAppHdl));
+	aFakeParam[1].aVal[0] = 40; // L7TRANSMIT_LENGTH_MAX
+
+	u8HdlRspSz = 40;
+	TEST_ASSERT_EQUAL_UINT8(1, _cmd_(APP_CMD_ID, aArg, sizeof(aArg), 1));
+	TEST_ASSERT_EQUAL_UINT8(40, sRspMsg.u8Size);
+	TEST_ASSERT_EQUAL_HEX8(ADM_NONE, aRsp[1]);
+
+	// within the handler maximum, but greater than the L7 one : rejected
+	u8HdlRspSz = 41;
+	TEST_ASSERT_EQUAL_UINT8(1, _cmd_(APP_CMD_ID, aArg, sizeof(aArg), 2));
+	TEST_ASSERT_EQUAL_UINT8(sizeof(admin_rsp_cmderr_t), sRspMsg.u8Size);
+	TEST_ASSERT_EQUAL_HEX8(ADM_UNK_CMD, aRsp[1]);
+}
+
+TEST(WizeCore_app_adm, test_AdmInt_PreCmd_Deferred)
+{
+	const uint8_t aArg[] = { 0x01 };
+
+	sAppHdl.bDeferred = 1;
+	sAppHdl.u8RspMax = 20;
+	TEST_ASSERT_EQUAL_INT32(0, AdmInt_Register(&sAppHdl));
+
+	// built on the repetition, then checked the same way
+	u8HdlRspSz = 30;
+	TEST_ASSERT_EQUAL_UINT8(0, _cmd_(APP_CMD_ID, aArg, sizeof(aArg), 1));
+	TEST_ASSERT_EQUAL_UINT8(0, u8HdlRspNb);
+	TEST_ASSERT_EQUAL_UINT8(2, AdmInt_PreCmd(&sReqMsg, &sRspMsg));
+	TEST_ASSERT_EQUAL_UINT8(1, u8HdlRspNb);
+	TEST_ASSERT_EQUAL_UINT8(sizeof(admin_rsp_cmderr_t), sRspMsg.u8Size);
+	TEST_ASSERT_EQUAL_HEX8(ADM_UNK_CMD, aRsp[1]);
+}
+
+/******************************************************************************/
+TEST(WizeCore_app_adm, test_AdmInt_Cache_Hit)
+{
+	const uint8_t aIds[] = { 0x30, 0x31 };
+	uint8_t aFirst[sizeof(admin_rsp_t) + 6];
+
+	TEST_ASSERT_EQUAL_UINT8(1, _cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 1));
+	TEST_ASSERT_EQUAL_HEX8(ADM_NONE, aRsp[1]);
+	TEST_ASSERT_EQUAL_UINT8(sizeof(admin_rsp_t) + 6, sRspMsg.u8Size);
+	TEST_ASSERT_EQUAL_UINT32(2, u32RemoteRead);
+	memcpy(aFirst, aRsp, sizeof(aFirst));
+
+	// changed without notification : only seen when not cached
+	aFakeParam[2].aVal[0] = 0xEE;
+	sReqMsg.u8Rssi = 0x42;
+	TEST_ASSERT_EQUAL_UINT8(1, _cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 2));
+	TEST_ASSERT_EQUAL_UINT32(CACHED(2, 4), u32RemoteRead);
+	TEST_ASSERT_EQUAL_UINT8(sizeof(admin_rsp_t) + 6, sRspMsg.u8Size);
+	TEST_ASSERT_EQUAL_HEX8(CACHED(0x30, 0xEE), aRsp[sizeof(admin_rsp_t) + 1]);
+	// the header is always built again
+	TEST_ASSERT_EQUAL_HEX8(0x42, ((admin_rsp_t*)aRsp)->L7Rssi);
+	TEST_ASSERT_EQUAL_MEMORY(&aFirst[sizeof(admin_rsp_t) + 3], &aRsp[sizeof(admin_rsp_t) + 3], 3);
+	aFakeParam[2].aVal[0] = 0x30;
+}
+
+TEST(WizeCore_app_adm, test_AdmInt_Cache_Invalidation)
+{
+	const uint8_t aIds[] = { 0x30, 0x31 };
+
+#if ADM_INT_CACHE_NB > 0
+	// registered on setup
+	TEST_ASSERT_NOT_NULL(pWriteNb);
+	TEST_ASSERT_EQUAL_PTR(AdmInt_ParamChanged, pWriteNb->pf_Cb);
+#endif
+	TEST_ASSERT_EQUAL_UINT8(1, _cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 1));
+	TEST_ASSERT_EQUAL_UINT32(2, u32RemoteRead);
+
+	// not a requested one : kept
+	AdmInt_ParamChanged(0x32);
+	_cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 2);
+	TEST_ASSERT_EQUAL_UINT32(CACHED(2, 4), u32RemoteRead);
+
+	// a requested one : dropped
+	u32RemoteRead = 0;
+	AdmInt_ParamChanged(0x31);
+	_cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 3);
+	TEST_ASSERT_EQUAL_UINT32(2, u32RemoteRead);
+
+	// all of them (Param_Init) : dropped
+	u32RemoteRead = 0;
+	AdmInt_ParamChanged(PARAM_ID_ALL);
+	_cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 4);
+	TEST_ASSERT_EQUAL_UINT32(2, u32RemoteRead);
+
+	// setup again : dropped
+	u32RemoteRead = 0;
+	AdmInt_CacheSetup();
+	_cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 5);
+	TEST_ASSERT_EQUAL_UINT32(2, u32RemoteRead);
+}
+
+TEST(WizeCore_app_adm, test_AdmInt_Cache_WriteWhileBuild)
+{
+	const uint8_t aIds[] = { 0x30, 0x31 };
+
+	// a write happen while the response is built : not cached
+	u32WriteOnRead = 1;
+	_cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 1);
+	TEST_ASSERT_EQUAL_HEX8(ADM_NONE, aRsp[1]);
+	_cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 2);
+	TEST_ASSERT_EQUAL_UINT32(4, u32RemoteRead);
+	_cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 3);
+	TEST_ASSERT_EQUAL_UINT32(CACHED(4, 6), u32RemoteRead);
+}
+
+TEST(WizeCore_app_adm, test_AdmInt_Cache_Lru)
+{
+#if ADM_INT_CACHE_NB > 0
+	uint8_t aIds[ADM_INT_CACHE_NB + 1];
+	uint8_t i;
+
+	memset(aIds, 0x30, sizeof(aIds));
+	// fill the cache, with keys of 1 to ADM_INT_CACHE_NB ids
+	for (i = 1; i <= ADM_INT_CACHE_NB; i++)
+	{
+		_cmd_(ADM_READ_PARAM, aIds, i, i);
+	}
+	// use the first one
+	u32RemoteRead = 0;
+	_cmd_(ADM_READ_PARAM, aIds, 1, 0x100);
+	TEST_ASSERT_EQUAL_UINT32(0, u32RemoteRead);
+
+	// a new one replace the least recently used (the second)
+	_cmd_(ADM_READ_PARAM, aIds, ADM_INT_CACHE_NB + 1, 0x101);
+	TEST_ASSERT_EQUAL_UINT32(ADM_INT_CACHE_NB + 1, u32RemoteRead);
+
+	u32RemoteRead = 0;
+	_cmd_(ADM_READ_PARAM, aIds, 1, 0x102);
+	_cmd_(ADM_READ_PARAM, aIds, ADM_INT_CACHE_NB + 1, 0x103);
+	for (i = 3; i <= ADM_INT_CACHE_NB; i++)
+	{
+		_cmd_(ADM_READ_PARAM, aIds, i, 0x100 + i);
+	}
+	TEST_ASSERT_EQUAL_UINT32(0, u32RemoteRead);
+	_cmd_(ADM_READ_PARAM, aIds, 2, 0x110);
+	TEST_ASSERT_EQUAL_UINT32(2, u32RemoteRead);
+#endif
+}
+
+TEST(WizeCore_app_adm, test_AdmInt_Cache_Errors)
+{
+	const uint8_t aDenied[] = { 0x30, 0x32 };
+	const uint8_t aUnknown[] = { 0x30, 0x33 };
+	uint8_t aLong[ADM_INT_CACHE_KEY_SZ + 1];
+	const uint8_t aIds[] = { 0x30, 0x31 };
+
+	// error responses are not cached
+	_cmd_(ADM_READ_PARAM, aDenied, sizeof(aDenied), 1);
+	TEST_ASSERT_EQUAL_HEX8(READ_ACCES_DENIED, aRsp[1]);
+	_cmd_(ADM_READ_PARAM, aDenied, sizeof(aDenied), 2);
+	TEST_ASSERT_EQUAL_HEX8(READ_ACCES_DENIED, aRsp[1]);
+	TEST_ASSERT_EQUAL_UINT32(2, u32RemoteRead);
+
+	u32RemoteRead = 0;
+	_cmd_(ADM_READ_PARAM, aUnknown, sizeof(aUnknown), 3);
+	TEST_ASSERT_EQUAL_HEX8(READ_UNK_PARAM, aRsp[1]);
+	TEST_ASSERT_EQUAL_HEX8(0x33, ((admin_rsp_err_t*)aRsp)->L7ErrorParam);
+	_cmd_(ADM_READ_PARAM, aUnknown, sizeof(aUnknown), 4);
+	TEST_ASSERT_EQUAL_HEX8(READ_UNK_PARAM, aRsp[1]);
+	TEST_ASSERT_EQUAL_UINT32(2, u32RemoteRead);
+
+	// too many ids : not cached
+	u32RemoteRead = 0;
+	memset(aLong, 0x30, sizeof(aLong));
+	_cmd_(ADM_READ_PARAM, aLong, sizeof(aLong), 5);
+	TEST_ASSERT_EQUAL_HEX8(ADM_NONE, aRsp[1]);
+	_cmd_(ADM_READ_PARAM, aLong, sizeof(aLong), 6);
+	TEST_ASSERT_EQUAL_UINT32(2 * sizeof(aLong), u32RemoteRead);
+
+	// cached, then L7TRANSMIT_LENGTH_MAX reduced below its size : built again
+	u32RemoteRead = 0;
+	_cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 7);
+	aFakeParam[1].aVal[0] = sizeof(admin_rsp_t) + 3;
+	_cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 8);
+	TEST_ASSERT_EQUAL_HEX8(READ_LENGTH_EXCEED, aRsp[1]);
+	TEST_ASSERT_EQUAL_UINT32(3, u32RemoteRead);
+}
+
+TEST(WizeCore_app_adm, test_AdmInt_Cache_Volatile)
+{
+	const uint8_t aIds[] = { 0x30, CLOCK_CURRENT_EPOC };
+
+	// the clock is updated through its address : never cached
+	_cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 1);
+	TEST_ASSERT_EQUAL_HEX8(ADM_NONE, aRsp[1]);
+	aFakeParam[5].aVal[0] = 0x70;
+	_cmd_(ADM_READ_PARAM, aIds, sizeof(aIds), 2);
+	TEST_ASSERT_EQUAL_UINT32(4, u32RemoteRead);
+	TEST_ASSERT_EQUAL_HEX8(0x70, aRsp[sizeof(admin_rsp_t) + 4]);
+	aFakeParam[5].aVal[0] = 0x60;
+}
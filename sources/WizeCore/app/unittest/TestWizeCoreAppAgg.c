@@ -0,0 +1,204 @@
+#include "unity_fixture.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+TEST_GROUP(WizeCore_app_agg);
+#include "wize_agg.h"
+#include "parameters.h"
+#include "parameters_lan_ids.h"
+#include "TestWizeCoreAppFake.h"
+
+/******************************************************************************/
+
+/*
+ * The greatest payload is set to 20 bytes, so three 4 bytes records (6 bytes
+ * with their TLV header) fill it up.
+ */
+#define AGG_L7_MAX    20
+#define AGG_HOLD_SEC  10
+#define AGG_EVT       0x00000100
+#define AGG_REC_SZ    4
+
+static struct wize_agg_s sAgg;
+static uint8_t u8Task;
+
+static void _set_l7_max_(uint8_t u8Max)
+{
+	uint8_t aVal[2] = { u8Max, 0 };
+	Param_Access(L7TRANSMIT_LENGTH_MAX, aVal, 1);
+}
+
+static wize_api_ret_e _add_(uint8_t u8Val)
+{
+	uint8_t aRec[AGG_REC_SZ];
+	memset(aRec, u8Val, sizeof(aRec));
+	return WizeAgg_Add(&sAgg, u8Val, aRec, sizeof(aRec));
+}
+
+/******************************************************************************/
+TEST_SETUP(WizeCore_app_agg)
+{
+	FakeApp_Reset();
+	_set_l7_max_(AGG_L7_MAX);
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, WizeAgg_Init(&sAgg, APP_DATA, AGG_HOLD_SEC, &u8Task, AGG_EVT));
+}
+
+TEST_TEAR_DOWN(WizeCore_app_agg)
+{
+	_set_l7_max_(80);
+}
+
+/******************************************************************************/
+TEST(WizeCore_app_agg, test_WizeAgg_Init)
+{
+	TEST_ASSERT_EQUAL(WIZE_API_INVALID_PARAM, WizeAgg_Init(NULL, APP_DATA, 1, NULL, 0));
+	TEST_ASSERT_EQUAL(WIZE_API_INVALID_PARAM, WizeAgg_Init(&sAgg, APP_INSTALL, 1, NULL, 0));
+
+	// no aggregation, each record is sent on its own
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, WizeAgg_Init(&sAgg, APP_DATA_PRIO, 0, &u8Task, AGG_EVT));
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, _add_(0x11));
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, _add_(0x22));
+	TEST_ASSERT_EQUAL_UINT8(2, sFakeApp.u8SendNb);
+	TEST_ASSERT_EQUAL_UINT8(APP_DATA_PRIO, sFakeApp.aSendType[1]);
+	TEST_ASSERT_EQUAL_UINT8(WIZE_AGG_TLV_HDR_SZ + AGG_REC_SZ, sFakeApp.aSendSize[1]);
+	TEST_ASSERT_EQUAL_UINT8(0, sFakeApp.u8TimerStartNb);
+}
+
+TEST(WizeCore_app_agg, test_WizeAgg_Full)
+{
+	const uint8_t aExp[] = {
+		0x11, AGG_REC_SZ, 0x11, 0x11, 0x11, 0x11,
+		0x22, AGG_REC_SZ, 0x22, 0x22, 0x22, 0x22,
+		0x33, AGG_REC_SZ, 0x33, 0x33, 0x33, 0x33,
+	};
+	uint8_t aRec[AGG_L7_MAX];
+
+	// held until the payload is full, the hold timer start on the first one
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, _add_(0x11));
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, _add_(0x22));
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, _add_(0x33));
+	TEST_ASSERT_EQUAL_UINT8(0, sFakeApp.u8SendNb);
+	TEST_ASSERT_EQUAL_UINT8(1, sFakeApp.u8TimerStartNb);
+	TEST_ASSERT_EQUAL_UINT32(AGG_HOLD_SEC, sFakeApp.u32TimerElapse);
+	TEST_ASSERT_EQUAL_UINT32(AGG_EVT, sFakeApp.u32TimerEvent);
+
+	// doesn't fit : the send fails, the payload is kept, the record rejected
+	sFakeApp.eSendRet[0] = WIZE_API_ACCESS_TIMEOUT;
+	TEST_ASSERT_EQUAL(WIZE_API_ACCESS_TIMEOUT, _add_(0x44));
+	TEST_ASSERT_EQUAL_UINT8(1, sFakeApp.u8SendNb);
+	TEST_ASSERT_EQUAL_UINT32(1, sAgg.sStats.u32FailNb);
+	TEST_ASSERT_EQUAL_UINT8(3, sAgg.u8RecNb);
+	TEST_ASSERT_EQUAL_UINT8(sizeof(aExp), sAgg.u8Size);
+
+	// doesn't fit : the current payload is sent first
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, _add_(0x44));
+	TEST_ASSERT_EQUAL_UINT8(2, sFakeApp.u8SendNb);
+	TEST_ASSERT_EQUAL_UINT8(APP_DATA, sFakeApp.aSendType[1]);
+	TEST_ASSERT_EQUAL_UINT8(sizeof(aExp), sFakeApp.aSendSize[1]);
+	TEST_ASSERT_EQUAL_HEX8_ARRAY(aExp, sFakeApp.aSendData[1], sizeof(aExp));
+	TEST_ASSERT_EQUAL_UINT32(3, sAgg.sStats.u32RecNb);
+	TEST_ASSERT_EQUAL_UINT32(1, sAgg.sStats.u32FrmNb);
+	TEST_ASSERT_EQUAL_UINT32(0, sAgg.sStats.u32HoldNb);
+	// ... and the new one start a new payload, and the hold timer again
+	TEST_ASSERT_EQUAL_UINT8(1, sAgg.u8RecNb);
+	TEST_ASSERT_EQUAL_UINT8(WIZE_AGG_TLV_HDR_SZ + AGG_REC_SZ, sAgg.u8Size);
+	TEST_ASSERT_EQUAL_UINT8(2, sFakeApp.u8TimerStartNb);
+
+	// a record greater than the payload is rejected, nothing sent
+	memset(aRec, 0x55, sizeof(aRec));
+	TEST_ASSERT_EQUAL(WIZE_API_INVALID_PARAM,
+		WizeAgg_Add(&sAgg, 0x55, aRec, AGG_L7_MAX - WIZE_AGG_TLV_HDR_SZ + 1));
+	TEST_ASSERT_EQUAL(WIZE_API_INVALID_PARAM, WizeAgg_Add(&sAgg, 0x55, NULL, 1));
+	TEST_ASSERT_EQUAL_UINT8(2, sFakeApp.u8SendNb);
+	TEST_ASSERT_EQUAL_UINT8(1, sAgg.u8RecNb);
+
+	// a record as great as the payload fits, alone
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS,
+		WizeAgg_Add(&sAgg, 0x55, aRec, AGG_L7_MAX - WIZE_AGG_TLV_HDR_SZ));
+	TEST_ASSERT_EQUAL_UINT8(3, sFakeApp.u8SendNb);
+	TEST_ASSERT_EQUAL_UINT8(AGG_L7_MAX, sAgg.u8Size);
+}
+
+TEST(WizeCore_app_agg, test_WizeAgg_Unpack)
+{
+	const uint8_t aPld[] = {
+		0x11, 2, 0xA1, 0xA2,
+		0x22, 0,
+		0x33, 1, 0xC1,
+	};
+	const uint8_t aTrunc[] = { 0x11, 2, 0xA1, 0xA2, 0x22 };
+	const uint8_t aOver[] = { 0x11, 2, 0xA1, 0xA2, 0x22, 3, 0xB1, 0xB2 };
+	wize_agg_rec_t sRec;
+	uint8_t u8Off = 0;
+
+	TEST_ASSERT_EQUAL_INT32(1, WizeAgg_Unpack(aPld, sizeof(aPld), &u8Off, &sRec));
+	TEST_ASSERT_EQUAL_UINT8(0x11, sRec.u8Type);
+	TEST_ASSERT_EQUAL_UINT8(2, sRec.u8Size);
+	TEST_ASSERT_EQUAL_PTR(&(aPld[2]), sRec.pData);
+	TEST_ASSERT_EQUAL_INT32(1, WizeAgg_Unpack(aPld, sizeof(aPld), &u8Off, &sRec));
+	TEST_ASSERT_EQUAL_UINT8(0x22, sRec.u8Type);
+	TEST_ASSERT_EQUAL_UINT8(0, sRec.u8Size);
+	TEST_ASSERT_EQUAL_INT32(1, WizeAgg_Unpack(aPld, sizeof(aPld), &u8Off, &sRec));
+	TEST_ASSERT_EQUAL_UINT8(0x33, sRec.u8Type);
+	TEST_ASSERT_EQUAL_HEX8(0xC1, sRec.pData[0]);
+	TEST_ASSERT_EQUAL_INT32(0, WizeAgg_Unpack(aPld, sizeof(aPld), &u8Off, &sRec));
+	TEST_ASSERT_EQUAL_UINT8(sizeof(aPld), u8Off);
+
+	// truncated TLV header
+	u8Off = 0;
+	TEST_ASSERT_EQUAL_INT32(1, WizeAgg_Unpack(aTrunc, sizeof(aTrunc), &u8Off, &sRec));
+	TEST_ASSERT_EQUAL_INT32(-1, WizeAgg_Unpack(aTrunc, sizeof(aTrunc), &u8Off, &sRec));
+	TEST_ASSERT_EQUAL_UINT8(4, u8Off);
+
+	// TLV length over the payload end
+	u8Off = 0;
+	TEST_ASSERT_EQUAL_INT32(1, WizeAgg_Unpack(aOver, sizeof(aOver), &u8Off, &sRec));
+	TEST_ASSERT_EQUAL_INT32(-1, WizeAgg_Unpack(aOver, sizeof(aOver), &u8Off, &sRec));
+	TEST_ASSERT_EQUAL_UINT8(4, u8Off);
+
+	// empty payload, invalid parameters
+	u8Off = 0;
+	TEST_ASSERT_EQUAL_INT32(0, WizeAgg_Unpack(aPld, 0, &u8Off, &sRec));
+	TEST_ASSERT_EQUAL_INT32(-1, WizeAgg_Unpack(NULL, sizeof(aPld), &u8Off, &sRec));
+	TEST_ASSERT_EQUAL_INT32(-1, WizeAgg_Unpack(aPld, sizeof(aPld), NULL, &sRec));
+}
+
+TEST(WizeCore_app_agg, test_WizeAgg_HoldExpiry)
+{
+	wize_agg_rec_t sRec;
+	uint8_t u8Off = 0;
+
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, _add_(0x11));
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, _add_(0x22));
+	TEST_ASSERT_EQUAL_UINT8(1, sFakeApp.u8TimerStartNb);
+
+	// the hold time expired : the payload is sent as it is
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, WizeAgg_Expire(&sAgg));
+	TEST_ASSERT_EQUAL_UINT8(1, sFakeApp.u8SendNb);
+	TEST_ASSERT_EQUAL_UINT8(2 * (WIZE_AGG_TLV_HDR_SZ + AGG_REC_SZ), sFakeApp.aSendSize[0]);
+	TEST_ASSERT_EQUAL_UINT8(1, sFakeApp.u8TimerStopNb);
+	TEST_ASSERT_EQUAL_UINT32(1, sAgg.sStats.u32HoldNb);
+	TEST_ASSERT_EQUAL_UINT32(1, sAgg.sStats.u32FrmNb);
+	TEST_ASSERT_EQUAL_UINT32(2, sAgg.sStats.u32RecNb);
+	TEST_ASSERT_EQUAL_UINT8(0, sAgg.u8RecNb);
+	TEST_ASSERT_EQUAL_UINT8(0, sAgg.u8Size);
+
+	// the sent payload unpacks back to the records
+	TEST_ASSERT_EQUAL_INT32(1, WizeAgg_Unpack(sFakeApp.aSendData[0], sFakeApp.aSendSize[0], &u8Off, &sRec));
+	TEST_ASSERT_EQUAL_UINT8(0x11, sRec.u8Type);
+	TEST_ASSERT_EQUAL_INT32(1, WizeAgg_Unpack(sFakeApp.aSendData[0], sFakeApp.aSendSize[0], &u8Off, &sRec));
+	TEST_ASSERT_EQUAL_UINT8(0x22, sRec.u8Type);
+	TEST_ASSERT_EQUAL_UINT8(AGG_REC_SZ, sRec.u8Size);
+	TEST_ASSERT_EQUAL_INT32(0, WizeAgg_Unpack(sFakeApp.aSendData[0], sFakeApp.aSendSize[0], &u8Off, &sRec));
+
+	// nothing held, nothing sent
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, WizeAgg_Expire(&sAgg));
+	TEST_ASSERT_EQUAL_UINT8(1, sFakeApp.u8SendNb);
+	TEST_ASSERT_EQUAL_UINT32(1, sAgg.sStats.u32HoldNb);
+
+	// the next record start the hold timer again
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, _add_(0x33));
+	TEST_ASSERT_EQUAL_UINT8(2, sFakeApp.u8TimerStartNb);
+}
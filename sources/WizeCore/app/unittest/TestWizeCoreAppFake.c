@@ -0,0 +1,54 @@
+#include <string.h>
+#include <stdint.h>
+
+#include "TestWizeCoreAppFake.h"
+#include "time_evt.h"
+
+/******************************************************************************/
+
+struct fake_app_s sFakeApp;
+
+void FakeApp_Reset(void)
+{
+	memset(&sFakeApp, 0, sizeof(sFakeApp));
+}
+
+/******************************************************************************/
+// Stubs
+
+wize_api_ret_e WizeApi_Send(uint8_t *pData, uint8_t u8Size, uint8_t u8Type)
+{
+	uint8_t u8Idx = sFakeApp.u8SendNb % FAKE_SEND_NB;
+	memcpy(sFakeApp.aSendData[u8Idx], pData, u8Size);
+	sFakeApp.aSendSize[u8Idx] = u8Size;
+	sFakeApp.aSendType[u8Idx] = u8Type;
+	sFakeApp.u8SendNb++;
+	return sFakeApp.eSendRet[u8Idx];
+}
+
+uint32_t WizeApi_GetSlot(uint8_t eClass)
+{
+	return 0;
+}
+
+#if defined ( __OS__ ) && ( OS_FreeRTOS == 1 )
+uint8_t TimeEvt_TimerInit(time_evt_t *pTimeEvt, void *pvTaskHandle, time_evt_cfg_e eCfg)
+#else
+uint8_t TimeEvt_TimerInit(time_evt_t *pTimeEvt, void (*pvTaskHandle)(uint32_t evt), time_evt_cfg_e eCfg)
+#endif
+{
+	return 0;
+}
+
+uint8_t TimeEvt_TimerStart(time_evt_t *pTimeEvt, uint32_t u32Elapse, int16_t i16DeltaMs, uint32_t u32Event)
+{
+	sFakeApp.u32TimerElapse = u32Elapse;
+	sFakeApp.u32TimerEvent = u32Event;
+	sFakeApp.u8TimerStartNb++;
+	return 0;
+}
+
+void TimeEvt_TimerStop(time_evt_t *pTimeEvt)
+{
+	sFakeApp.u8TimerStopNb++;
+}
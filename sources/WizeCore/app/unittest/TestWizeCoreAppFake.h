@@ -0,0 +1,32 @@
+#ifndef _TEST_WIZE_CORE_APP_FAKE_H_
+#define _TEST_WIZE_CORE_APP_FAKE_H_
+
+#include <stdint.h>
+#include "wize_api.h"
+
+/*
+ * The WizeApi and TimeEvt functions the OS free app parts call are faked,
+ * once for all the app test groups. Each group reset the fake on its setup.
+ */
+#define FAKE_SEND_NB 4
+#define FAKE_SEND_SZ 255
+
+struct fake_app_s
+{
+	wize_api_ret_e eSendRet[FAKE_SEND_NB];        // WizeApi_Send return, per call
+	uint8_t aSendData[FAKE_SEND_NB][FAKE_SEND_SZ]; // WizeApi_Send payload, per call
+	uint8_t aSendSize[FAKE_SEND_NB];              // WizeApi_Send size, per call
+	uint8_t aSendType[FAKE_SEND_NB];              // WizeApi_Send type, per call
+	uint8_t u8SendNb;                             // WizeApi_Send number of calls
+
+	uint32_t u32TimerElapse;                      // Last TimeEvt_TimerStart elapse
+	uint32_t u32TimerEvent;                       // Last TimeEvt_TimerStart event
+	uint8_t u8TimerStartNb;                       // TimeEvt_TimerStart number of calls
+	uint8_t u8TimerStopNb;                        // TimeEvt_TimerStop number of calls
+};
+
+extern struct fake_app_s sFakeApp;
+
+void FakeApp_Reset(void);
+
+#endif /* _TEST_WIZE_CORE_APP_FAKE_H_ */
@@ -0,0 +1,89 @@
+#include "unity_fixture.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+TEST_GROUP(WizeCore_app_link);
+#include "link_internal.h"
+
+/******************************************************************************/
+
+/*
+ * Levels used by the following tests (RSSI unit is 0.5 dB, 0 is -147.5 dBm)
+ * - downlink frame at -100 dBm : RSSI 95
+ * - busy channel, LBT noise at -110 dBm : PHY_CTL_GET_NOISE 110, RSSI 75
+ * - quiet channel, LBT noise at -130 dBm : PHY_CTL_GET_NOISE 130, RSSI 35
+ */
+#define DWN_RSSI    95
+#define NOISE_BUSY  110
+#define NOISE_QUIET 130
+
+static struct link_adapt_ctx_s sLinkCtx;
+
+/******************************************************************************/
+TEST_SETUP(WizeCore_app_link)
+{
+	LinkInt_Init(&sLinkCtx);
+}
+
+TEST_TEAR_DOWN(WizeCore_app_link)
+{
+}
+
+/******************************************************************************/
+TEST(WizeCore_app_link, test_LinkInt_Dwn_NoiseUnknown)
+{
+	// Only limited by the gateway sensitivity : 95 - 50
+	LinkInt_Dwn(&sLinkCtx, DWN_RSSI);
+	TEST_ASSERT_EQUAL_UINT8(1, sLinkCtx.bValid);
+	TEST_ASSERT_EQUAL_INT16( (DWN_RSSI - LINK_SENS_RSSI) << 4, sLinkCtx.i16Margin);
+	TEST_ASSERT_EQUAL_UINT16(1, sLinkCtx.sStats.u16DwnNb);
+}
+
+TEST(WizeCore_app_link, test_LinkInt_Dwn_NoiseQuiet)
+{
+	// SNR limit : 95 - 35 - 16 = 44, just below the sensitivity limit (45)
+	TEST_ASSERT_EQUAL_INT16(35, Phy_NoiseToRssi(NOISE_QUIET));
+	LinkInt_Noise(&sLinkCtx, NOISE_QUIET);
+	LinkInt_Dwn(&sLinkCtx, DWN_RSSI);
+	TEST_ASSERT_EQUAL_INT16(
+		(DWN_RSSI - 35 - LINK_DB(LINK_SNR_MIN_DB)) << 4, sLinkCtx.i16Margin);
+}
+
+TEST(WizeCore_app_link, test_LinkInt_Dwn_NoiseBusy)
+{
+	// SNR limit : 95 - 75 - 16 = 4, the frame is only 10 dB above the noise
+	TEST_ASSERT_EQUAL_INT16(75, Phy_NoiseToRssi(NOISE_BUSY));
+	LinkInt_Noise(&sLinkCtx, NOISE_BUSY);
+	LinkInt_Dwn(&sLinkCtx, DWN_RSSI);
+	TEST_ASSERT_EQUAL_INT16(
+		(DWN_RSSI - 75 - LINK_DB(LINK_SNR_MIN_DB)) << 4, sLinkCtx.i16Margin);
+}
+
+TEST(WizeCore_app_link, test_LinkInt_Apply_NoiseBusy)
+{
+	struct medium_cfg_s sMediumCfg;
+
+	// Quiet channel : 22 dB of margin allows WM6400 (5 dB penalty) at full power
+	LinkInt_Noise(&sLinkCtx, NOISE_QUIET);
+	LinkInt_Dwn(&sLinkCtx, DWN_RSSI);
+	memset(&sMediumCfg, 0, sizeof(sMediumCfg));
+	sMediumCfg.eTxModulation = PHY_WM2400;
+	sMediumCfg.eTxPower = PHY_PMAX_minus_0db;
+	LinkInt_Apply(&sLinkCtx, &sMediumCfg);
+	LinkInt_Dwn(&sLinkCtx, DWN_RSSI);
+	LinkInt_Apply(&sLinkCtx, &sMediumCfg);
+	TEST_ASSERT_EQUAL_UINT8(PHY_WM6400, sMediumCfg.eTxModulation);
+	TEST_ASSERT_EQUAL_UINT8(PHY_PMAX_minus_0db, sMediumCfg.eTxPower);
+
+	// Busy channel : step back to the most robust setting
+	LinkInt_Fallback(&sLinkCtx);
+	LinkInt_Noise(&sLinkCtx, NOISE_BUSY);
+	LinkInt_Dwn(&sLinkCtx, DWN_RSSI);
+	sMediumCfg.eTxModulation = PHY_WM2400;
+	sMediumCfg.eTxPower = PHY_PMAX_minus_0db;
+	LinkInt_Apply(&sLinkCtx, &sMediumCfg);
+	TEST_ASSERT_EQUAL_UINT8(PHY_WM2400, sMediumCfg.eTxModulation);
+	TEST_ASSERT_EQUAL_UINT8(PHY_PMAX_minus_0db, sMediumCfg.eTxPower);
+}
@@ -0,0 +1,193 @@
+#include "unity_fixture.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+TEST_GROUP(WizeCore_app_sched);
+#include "sched_internal.h"
+
+/******************************************************************************/
+
+/*
+ * The scheduler doesn't know the sessions, any id will do. The times are in
+ * ms (1 tick is 1 ms).
+ */
+#define SES_A 0
+#define SES_B 1
+#define SES_C 2
+#define SES_D 3
+
+#define PREP_MS 50
+#define NO_GAP  0xFFFFFFFF
+
+static struct sched_ctx_s sSched;
+
+static int32_t _push_(uint8_t eSesId, uint8_t u8Prio, uint32_t u32Now, uint32_t u32Delay, uint32_t u32Duration)
+{
+	struct sched_req_s sReq;
+	sReq.u32Submit = u32Now;
+	sReq.u32Start = u32Now + u32Delay;
+	sReq.u32Deadline = sReq.u32Start + SCHED_DEADLINE_MS;
+	sReq.u32Duration = u32Duration;
+	sReq.eSesId = eSesId;
+	sReq.u8Prio = u8Prio;
+	return SchedInt_Push(&sSched, &sReq);
+}
+
+/******************************************************************************/
+TEST_SETUP(WizeCore_app_sched)
+{
+	SchedInt_Init(&sSched);
+}
+
+TEST_TEAR_DOWN(WizeCore_app_sched)
+{
+}
+
+/******************************************************************************/
+TEST(WizeCore_app_sched, test_SchedInt_Priority)
+{
+	// DATA_PRIO first, then install, then DATA, whatever the submit order
+	TEST_ASSERT_EQUAL_INT32(0, _push_(SES_A, SCHED_PRIO_DATA, 100, 0, 1000));
+	TEST_ASSERT_EQUAL_INT32(0, _push_(SES_B, SCHED_PRIO_INST, 200, 0, 1000));
+	TEST_ASSERT_EQUAL_INT32(0, _push_(SES_C, SCHED_PRIO_DATA_PRIO, 300, 0, 1000));
+	// same priority : the earliest deadline first
+	TEST_ASSERT_EQUAL_INT32(0, _push_(SES_D, SCHED_PRIO_DATA, 50, 0, 1000));
+
+	// one request per session, and no more than SCHED_QUEUE_NB
+	TEST_ASSERT_EQUAL_INT32(-1, _push_(SES_B, SCHED_PRIO_INST, 400, 0, 1000));
+	TEST_ASSERT_EQUAL_INT32(-1, _push_(SES_D + 1, SCHED_PRIO_DATA_PRIO, 400, 0, 1000));
+	TEST_ASSERT_EQUAL_UINT32(2, sSched.sStats.u32Rejected);
+	TEST_ASSERT_EQUAL_UINT8(SCHED_QUEUE_NB, sSched.sStats.u8DepthMax);
+
+	TEST_ASSERT_EQUAL_UINT8(SES_C, SchedInt_Next(&sSched, 1000, NO_GAP));
+	TEST_ASSERT_EQUAL_UINT8(SES_B, SchedInt_Next(&sSched, 1000, NO_GAP));
+	TEST_ASSERT_EQUAL_UINT8(SES_D, SchedInt_Next(&sSched, 1000, NO_GAP));
+	TEST_ASSERT_EQUAL_UINT8(SES_A, SchedInt_Next(&sSched, 1000, NO_GAP));
+	TEST_ASSERT_EQUAL_UINT8(SCHED_NONE, SchedInt_Next(&sSched, 1000, NO_GAP));
+
+	TEST_ASSERT_EQUAL_UINT32(4, sSched.sStats.u32Started);
+	TEST_ASSERT_EQUAL_UINT32(0, sSched.sStats.u32Interleaved);
+	TEST_ASSERT_EQUAL_UINT32(950, sSched.sStats.u32WaitMax);
+	TEST_ASSERT_EQUAL_UINT32(900 + 800 + 950 + 700, sSched.sStats.u32WaitSum);
+}
+
+TEST(WizeCore_app_sched, test_SchedInt_Slot)
+{
+	// a lower priority request, already in its slot, start first
+	TEST_ASSERT_EQUAL_INT32(0, _push_(SES_A, SCHED_PRIO_INST, 0, 5000, 1000));
+	TEST_ASSERT_EQUAL_INT32(0, _push_(SES_B, SCHED_PRIO_DATA, 0, 0, 1000));
+	TEST_ASSERT_EQUAL_UINT8(SES_B, SchedInt_Next(&sSched, 10, NO_GAP));
+	TEST_ASSERT_EQUAL_UINT8(SCHED_NONE, SchedInt_Next(&sSched, 4999, NO_GAP));
+	TEST_ASSERT_EQUAL_UINT8(SES_A, SchedInt_Next(&sSched, 5000, NO_GAP));
+
+	// dropped once its deadline is passed, even across the tick wrap
+	TEST_ASSERT_EQUAL_INT32(0, _push_(SES_C, SCHED_PRIO_DATA, 0xFFFFFF00, 0, 1000));
+	TEST_ASSERT_EQUAL_UINT32(0, SchedInt_Expire(&sSched, 0xFFFFFF00 + SCHED_DEADLINE_MS));
+	TEST_ASSERT_EQUAL_UINT32(1 << SES_C, SchedInt_Expire(&sSched, 0xFFFFFF01 + SCHED_DEADLINE_MS));
+	TEST_ASSERT_EQUAL_UINT32(1, sSched.sStats.u32Expired);
+	TEST_ASSERT_EQUAL_UINT8(0, sSched.sStats.u8Depth);
+}
+
+TEST(WizeCore_app_sched, test_SchedInt_DwnGap)
+{
+	// install : PING_RX_DELAY 1s, PING_RX_LENGTH 8s
+	uint32_t u32Inst = SchedInt_Duration(1, 8, 0);
+	// DATA : EXCH_RX_DELAY 1s, EXCH_RX_LENGTH 3s, EXCH_RESPONSE_DELAY 5s
+	uint32_t u32Data = SchedInt_Duration(1, 3, 5);
+	uint32_t u32Gap;
+
+	TEST_ASSERT_EQUAL_UINT32(10000, u32Inst);
+	TEST_ASSERT_EQUAL_UINT32(10000, u32Data);
+
+	// the PHY preparation and the guard are kept before the window
+	TEST_ASSERT_EQUAL_UINT32(0, SchedInt_Gap(PREP_MS + SCHED_GUARD_MS, PREP_MS));
+	TEST_ASSERT_EQUAL_UINT32(1, SchedInt_Gap(PREP_MS + SCHED_GUARD_MS + 1, PREP_MS));
+	// ... and a far window (next download day) is bounded
+	TEST_ASSERT_EQUAL_UINT32(SCHED_GAP_MAX_MS, SchedInt_Gap(2ULL * 86400000, PREP_MS));
+
+	TEST_ASSERT_EQUAL_INT32(0, _push_(SES_A, SCHED_PRIO_DATA_PRIO, 0, 0, u32Data + 1));
+	TEST_ASSERT_EQUAL_INT32(0, _push_(SES_B, SCHED_PRIO_INST, 0, 0, u32Inst));
+	TEST_ASSERT_EQUAL_INT32(0, _push_(SES_C, SCHED_PRIO_DATA, 0, 0, u32Data));
+
+	// no gap, nothing start
+	TEST_ASSERT_EQUAL_UINT8(SCHED_NONE, SchedInt_Next(&sSched, 100, 0));
+
+	// a 10 s gap : the DATA_PRIO one doesn't fit, the install does
+	u32Gap = SchedInt_Gap(10000 + PREP_MS + SCHED_GUARD_MS, PREP_MS);
+	TEST_ASSERT_EQUAL_UINT32(10000, u32Gap);
+	TEST_ASSERT_EQUAL_UINT8(SES_B, SchedInt_Next(&sSched, 100, u32Gap));
+	// next gap (the install is done), the DATA fits
+	TEST_ASSERT_EQUAL_UINT8(SES_C, SchedInt_Next(&sSched, 200, u32Gap));
+	TEST_ASSERT_EQUAL_UINT8(SCHED_NONE, SchedInt_Next(&sSched, 300, u32Gap));
+	TEST_ASSERT_EQUAL_UINT32(2, sSched.sStats.u32Interleaved);
+
+	// the download session is done
+	TEST_ASSERT_EQUAL_UINT8(SES_A, SchedInt_Next(&sSched, 400, NO_GAP));
+	TEST_ASSERT_EQUAL_UINT32(2, sSched.sStats.u32Interleaved);
+	TEST_ASSERT_EQUAL_UINT32(3, sSched.sStats.u32Started);
+}
+
+TEST(WizeCore_app_sched, test_SchedInt_DwnReplay)
+{
+	struct sched_stats_s sStats;
+
+	// nothing missed
+	TEST_ASSERT_EQUAL_UINT32(0, SchedInt_DwnReplay(&sSched));
+
+	// a window missed while an interleaved session is active
+	TEST_ASSERT_EQUAL_INT32(0, _push_(SES_B, SCHED_PRIO_INST, 0, 0, 1000));
+	TEST_ASSERT_EQUAL_UINT8(SES_B, SchedInt_Next(&sSched, 0, 5000));
+	SchedInt_DwnMiss(&sSched, 0x1234);
+	TEST_ASSERT_EQUAL_UINT32(1, sSched.sStats.u32Missed);
+
+	// clearing the statistics doesn't lose it
+	SchedInt_GetStats(&sSched, &sStats, 1);
+	TEST_ASSERT_EQUAL_UINT32(1, sStats.u32Missed);
+	TEST_ASSERT_EQUAL_UINT32(0, sSched.sStats.u32Missed);
+
+	// given back once, when the interleaved session is done
+	TEST_ASSERT_EQUAL_UINT32(0x1234, SchedInt_DwnReplay(&sSched));
+	TEST_ASSERT_EQUAL_UINT32(0, SchedInt_DwnReplay(&sSched));
+
+	// a new init forget it
+	SchedInt_DwnMiss(&sSched, 0x1234);
+	SchedInt_Init(&sSched);
+	TEST_ASSERT_EQUAL_UINT32(0, SchedInt_DwnReplay(&sSched));
+}
+
+TEST(WizeCore_app_sched, test_SchedInt_ReqBits)
+{
+	// other events given in the same notification (net, day passed)
+	const uint32_t u32Other = 0x04000010;
+	uint32_t u32Notif = 0;
+	uint32_t u32Evt;
+
+	// each session has its own bit, in the request mask
+	TEST_ASSERT_EQUAL_UINT32(0, SCHED_REQ(SES_A) & SCHED_REQ(SES_B));
+	TEST_ASSERT_EQUAL_UINT32(SCHED_REQ(SES_D), SCHED_REQ(SES_D) & SCHED_REQ_MSK);
+	TEST_ASSERT_EQUAL_UINT32(0, u32Other & SCHED_REQ_MSK);
+
+	// two asynchronous requests, back-to-back before the dispatcher runs :
+	// posted with eSetBits, both are kept
+	u32Notif |= SCHED_REQ(SES_B);
+	u32Notif |= SCHED_REQ(SES_A);
+	u32Notif |= u32Other;
+
+	u32Evt = u32Notif;
+	TEST_ASSERT_EQUAL_UINT8(SES_A, SchedInt_ReqNext(&u32Evt));
+	TEST_ASSERT_EQUAL_UINT8(SES_B, SchedInt_ReqNext(&u32Evt));
+	TEST_ASSERT_EQUAL_UINT8(SCHED_NONE, SchedInt_ReqNext(&u32Evt));
+	TEST_ASSERT_EQUAL_UINT32(u32Other, u32Evt);
+
+	// the same request given twice is seen once
+	u32Evt = SCHED_REQ(SES_D) | SCHED_REQ(SES_D);
+	TEST_ASSERT_EQUAL_UINT8(SES_D, SchedInt_ReqNext(&u32Evt));
+	TEST_ASSERT_EQUAL_UINT8(SCHED_NONE, SchedInt_ReqNext(&u32Evt));
+
+	// nothing requested
+	u32Evt = u32Other;
+	TEST_ASSERT_EQUAL_UINT8(SCHED_NONE, SchedInt_ReqNext(&u32Evt));
+	TEST_ASSERT_EQUAL_UINT32(u32Other, u32Evt);
+}
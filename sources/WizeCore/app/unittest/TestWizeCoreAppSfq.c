@@ -0,0 +1,268 @@
+#include "unity_fixture.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+TEST_GROUP(WizeCore_app_sfq);
+#include "wize_sfq.h"
+#include "TestWizeCoreAppFake.h"
+
+/******************************************************************************/
+
+/*
+ * The flash area is emulated in RAM as a NOR flash : a write can only clear
+ * bits, an erase set them all. Both can be made to fail after a given number
+ * of double-words, to emulate a power loss in the middle of the operation.
+ */
+#define SFQ_PAGE_SZ 64
+#define SFQ_PAGE_NB 3
+
+#define FLASH_NO_FAIL 0xFFFFFFFF
+
+static uint8_t aFlash[SFQ_PAGE_SZ * SFQ_PAGE_NB] __attribute__ ((aligned (8)));
+static uint32_t u32WrLeft;
+static uint32_t u32ErLeft;
+
+static struct wize_sfq_s sSfq;
+
+static uint8_t _flash_write_(uint32_t u32Addr, uint64_t *pData, uint32_t u32NbDoubleWord)
+{
+	uint64_t *p = (uint64_t*)u32Addr;
+	uint32_t i;
+	for ( i = 0; i < u32NbDoubleWord; i++)
+	{
+		if ( !u32WrLeft )
+		{
+			return 1;
+		}
+		u32WrLeft--;
+		p[i] &= pData[i];
+	}
+	return 0;
+}
+
+static uint8_t _flash_erase_(uint32_t u32Addr, uint32_t u32Size)
+{
+	uint64_t *p = (uint64_t*)u32Addr;
+	uint32_t i;
+	for ( i = 0; i < (u32Size >> 3); i++)
+	{
+		if ( !u32ErLeft )
+		{
+			return 1;
+		}
+		u32ErLeft--;
+		p[i] = 0xFFFFFFFFFFFFFFFFULL;
+	}
+	return 0;
+}
+
+static uint64_t _rd_(uint32_t u32Offset)
+{
+	return *(uint64_t*)&(aFlash[u32Offset]);
+}
+
+static int32_t _setup_(void)
+{
+	return WizeSfq_Setup(&sSfq, (uint32_t)aFlash, SFQ_PAGE_SZ, SFQ_PAGE_NB, _flash_write_, _flash_erase_);
+}
+
+static int32_t _push_(uint8_t u8Val)
+{
+	uint8_t aData[5];
+	memset(aData, u8Val, sizeof(aData));
+	return WizeSfq_Push(&sSfq, APP_DATA, aData, sizeof(aData));
+}
+
+/******************************************************************************/
+TEST_SETUP(WizeCore_app_sfq)
+{
+	memset(aFlash, 0xFF, sizeof(aFlash));
+	FakeApp_Reset();
+	u32WrLeft = FLASH_NO_FAIL;
+	u32ErLeft = FLASH_NO_FAIL;
+	TEST_ASSERT_EQUAL_INT32(0, _setup_());
+}
+
+TEST_TEAR_DOWN(WizeCore_app_sfq)
+{
+}
+
+/******************************************************************************/
+TEST(WizeCore_app_sfq, test_WizeSfq_RecordLayout)
+{
+	const uint8_t aPad[3] = { 0xFF, 0xFF, 0xFF };
+	uint8_t aData[5] = { 1, 2, 3, 4, 5 };
+	uint32_t u32Rec = WIZE_SFQ_PAGE_HDR_SZ;
+
+	// page header : sequence 1, magic "WSFQ", not obsolete
+	TEST_ASSERT_EQUAL_UINT32(0x51465357, (uint32_t)_rd_(0));
+	TEST_ASSERT_EQUAL_UINT32(1, (uint32_t)(_rd_(0) >> 32));
+	TEST_ASSERT_TRUE(_rd_(8) == 0xFFFFFFFFFFFFFFFFULL);
+
+	// record : header, data padded to 8, commit mark, consumed mark (erased)
+	TEST_ASSERT_EQUAL_INT32(0, WizeSfq_Push(&sSfq, APP_DATA_PRIO, aData, sizeof(aData)));
+	TEST_ASSERT_EQUAL_UINT32(32, WIZE_SFQ_REC_SZ(5));
+	TEST_ASSERT_EQUAL_UINT16(0x5AF0, (uint16_t)_rd_(u32Rec));
+	TEST_ASSERT_EQUAL_UINT8(5, (uint8_t)(_rd_(u32Rec) >> 16));
+	TEST_ASSERT_EQUAL_UINT8(APP_DATA_PRIO, (uint8_t)(_rd_(u32Rec) >> 24));
+	TEST_ASSERT_EQUAL_MEMORY(aData, &(aFlash[u32Rec + 8]), sizeof(aData));
+	TEST_ASSERT_EQUAL_MEMORY(aPad, &(aFlash[u32Rec + 8 + 5]), sizeof(aPad));
+	TEST_ASSERT_TRUE(_rd_(u32Rec + 16) == 0x5346510000000001ULL);
+	TEST_ASSERT_TRUE(_rd_(u32Rec + 24) == 0xFFFFFFFFFFFFFFFFULL);
+	TEST_ASSERT_EQUAL_UINT16(1, WizeSfq_GetCount(&sSfq));
+	TEST_ASSERT_EQUAL_UINT32(1, sSfq.sStats.u32PushNb);
+}
+
+TEST(WizeCore_app_sfq, test_WizeSfq_PeekPop)
+{
+	wize_sfq_item_t sItem;
+	uint32_t u32Rec = WIZE_SFQ_PAGE_HDR_SZ;
+
+	TEST_ASSERT_EQUAL_INT32(0, WizeSfq_Peek(&sSfq, &sItem));
+	TEST_ASSERT_EQUAL_INT32(1, WizeSfq_Pop(&sSfq));
+
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA1));
+	TEST_ASSERT_EQUAL_INT32(1, WizeSfq_Peek(&sSfq, &sItem));
+	TEST_ASSERT_EQUAL_UINT8(APP_DATA, sItem.u8Type);
+	TEST_ASSERT_EQUAL_UINT8(5, sItem.u8Size);
+	TEST_ASSERT_TRUE(sItem.pData == &(aFlash[u32Rec + 8]));
+
+	// the consumed mark is written, nothing else
+	TEST_ASSERT_EQUAL_INT32(0, WizeSfq_Pop(&sSfq));
+	TEST_ASSERT_TRUE(_rd_(u32Rec + 16) == 0x5346510000000001ULL);
+	TEST_ASSERT_TRUE(_rd_(u32Rec + 24) == 0x5346510000000002ULL);
+	TEST_ASSERT_EQUAL_UINT16(0, WizeSfq_GetCount(&sSfq));
+	TEST_ASSERT_EQUAL_INT32(0, WizeSfq_Peek(&sSfq, &sItem));
+}
+
+TEST(WizeCore_app_sfq, test_WizeSfq_Recover)
+{
+	wize_sfq_item_t sItem;
+
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA1));
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA2));
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA3));
+	TEST_ASSERT_EQUAL_INT32(0, WizeSfq_Pop(&sSfq));
+
+	// reboot
+	TEST_ASSERT_EQUAL_INT32(0, _setup_());
+	TEST_ASSERT_EQUAL_UINT16(2, WizeSfq_GetCount(&sSfq));
+	TEST_ASSERT_EQUAL_UINT32(0, sSfq.sStats.u32TornNb);
+	TEST_ASSERT_EQUAL_INT32(1, WizeSfq_Peek(&sSfq, &sItem));
+	TEST_ASSERT_EQUAL_HEX8(0xA2, sItem.pData[0]);
+
+	// continue after the last record
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA4));
+	TEST_ASSERT_EQUAL_UINT16(3, WizeSfq_GetCount(&sSfq));
+}
+
+TEST(WizeCore_app_sfq, test_WizeSfq_TornWrite)
+{
+	wize_sfq_item_t sItem;
+
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA1));
+
+	// power loss after the header and data, before the commit mark (page 1)
+	u32WrLeft = 2;
+	TEST_ASSERT_EQUAL_INT32(-1, _push_(0xA2));
+	TEST_ASSERT_TRUE(_rd_(SFQ_PAGE_SZ + WIZE_SFQ_PAGE_HDR_SZ + 16) == 0xFFFFFFFFFFFFFFFFULL);
+
+	// reboot : the torn record is counted and skipped
+	u32WrLeft = FLASH_NO_FAIL;
+	TEST_ASSERT_EQUAL_INT32(0, _setup_());
+	TEST_ASSERT_EQUAL_UINT32(1, sSfq.sStats.u32TornNb);
+	TEST_ASSERT_EQUAL_UINT16(1, WizeSfq_GetCount(&sSfq));
+	TEST_ASSERT_EQUAL_INT32(0, WizeSfq_Pop(&sSfq));
+	TEST_ASSERT_EQUAL_INT32(0, WizeSfq_Peek(&sSfq, &sItem));
+
+	// power loss in the middle of the data
+	TEST_ASSERT_EQUAL_INT32(0, _setup_());
+	u32WrLeft = 1;
+	TEST_ASSERT_EQUAL_INT32(-1, _push_(0xA3));
+	u32WrLeft = FLASH_NO_FAIL;
+	TEST_ASSERT_EQUAL_INT32(0, _setup_());
+	TEST_ASSERT_EQUAL_UINT16(0, WizeSfq_GetCount(&sSfq));
+
+	// the queue is still usable
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA4));
+	TEST_ASSERT_EQUAL_INT32(1, WizeSfq_Peek(&sSfq, &sItem));
+	TEST_ASSERT_EQUAL_HEX8(0xA4, sItem.pData[0]);
+}
+
+TEST(WizeCore_app_sfq, test_WizeSfq_TornErase)
+{
+	uint32_t i;
+
+	// page 1 : marked obsolete, erase not done
+	aFlash[SFQ_PAGE_SZ] = 0x57;
+	*(uint64_t*)&(aFlash[SFQ_PAGE_SZ + 8]) = 0x5346510000000000ULL;
+	// page 2 : erase interrupted, some garbage left
+	aFlash[2 * SFQ_PAGE_SZ + 40] = 0x00;
+
+	TEST_ASSERT_EQUAL_INT32(0, _setup_());
+	TEST_ASSERT_EQUAL_UINT32(2, sSfq.sStats.u32EraseNb);
+	for (i = SFQ_PAGE_SZ; i < sizeof(aFlash); i++)
+	{
+		TEST_ASSERT_EQUAL_HEX8(0xFF, aFlash[i]);
+	}
+
+	// erase interrupted again : done on the next setup
+	*(uint64_t*)&(aFlash[SFQ_PAGE_SZ + 8]) = 0x5346510000000000ULL;
+	u32ErLeft = 1;
+	TEST_ASSERT_EQUAL_INT32(0, _setup_());
+	u32ErLeft = FLASH_NO_FAIL;
+	TEST_ASSERT_EQUAL_INT32(0, _setup_());
+	TEST_ASSERT_EQUAL_UINT32(1, sSfq.sStats.u32EraseNb);
+	TEST_ASSERT_EQUAL_UINT16(0, WizeSfq_GetCount(&sSfq));
+}
+
+TEST(WizeCore_app_sfq, test_WizeSfq_FullWrap)
+{
+	wize_sfq_item_t sItem;
+
+	// one record per page
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA1));
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA2));
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA3));
+	TEST_ASSERT_EQUAL_INT32(1, _push_(0xA4));
+	TEST_ASSERT_EQUAL_UINT32(1, sSfq.sStats.u32FullNb);
+
+	// the first page is released once its record is sent
+	TEST_ASSERT_EQUAL_INT32(0, WizeSfq_Pop(&sSfq));
+	TEST_ASSERT_EQUAL_UINT32(1, sSfq.sStats.u32EraseNb);
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA4));
+	TEST_ASSERT_EQUAL_UINT32(4, (uint32_t)(_rd_(0) >> 32));
+
+	// reboot : order is given by the page sequence
+	TEST_ASSERT_EQUAL_INT32(0, _setup_());
+	TEST_ASSERT_EQUAL_UINT16(3, WizeSfq_GetCount(&sSfq));
+	TEST_ASSERT_EQUAL_UINT16(1, sSfq.u16HeadPage);
+	TEST_ASSERT_EQUAL_UINT16(0, sSfq.u16TailPage);
+	TEST_ASSERT_EQUAL_INT32(1, WizeSfq_Peek(&sSfq, &sItem));
+	TEST_ASSERT_EQUAL_HEX8(0xA2, sItem.pData[0]);
+}
+
+TEST(WizeCore_app_sfq, test_WizeSfq_Drain)
+{
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA1));
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA2));
+	TEST_ASSERT_EQUAL_INT32(0, _push_(0xA3));
+
+	// stop on failure, the item is kept
+	sFakeApp.eSendRet[1] = WIZE_API_FAILED;
+	TEST_ASSERT_EQUAL(WIZE_API_FAILED, WizeSfq_Drain(&sSfq, 0));
+	TEST_ASSERT_EQUAL_UINT8(2, sFakeApp.u8SendNb);
+	TEST_ASSERT_EQUAL_UINT32(1, sSfq.sStats.u32FailNb);
+	TEST_ASSERT_EQUAL_UINT16(2, WizeSfq_GetCount(&sSfq));
+
+	// in order, from the oldest
+	sFakeApp.eSendRet[1] = WIZE_API_SUCCESS;
+	sFakeApp.u8SendNb = 0;
+	TEST_ASSERT_EQUAL(WIZE_API_SUCCESS, WizeSfq_Drain(&sSfq, 0));
+	TEST_ASSERT_EQUAL_UINT8(2, sFakeApp.u8SendNb);
+	TEST_ASSERT_EQUAL_HEX8(0xA2, sFakeApp.aSendData[0][0]);
+	TEST_ASSERT_EQUAL_HEX8(0xA3, sFakeApp.aSendData[1][0]);
+	TEST_ASSERT_EQUAL_UINT16(0, WizeSfq_GetCount(&sSfq));
+}
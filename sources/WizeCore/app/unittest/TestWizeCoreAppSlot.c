@@ -0,0 +1,175 @@
+#include "unity_fixture.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+TEST_GROUP(WizeCore_app_slot);
+#include "slot_internal.h"
+#include "wize_utils.h"
+
+/******************************************************************************/
+
+#define SLOT_DEV_NB     1000
+#define SLOT_BUCKET_NB  10
+#define SLOT_ID_SZ      8
+
+static struct slot_ctx_s sSlot;
+
+static void _cfg_(uint32_t u32Window, uint8_t u8JitterPct)
+{
+	struct slot_cfg_s sCfg;
+	memset(&sCfg, 0, sizeof(sCfg));
+	sCfg.aWindowMs[SLOT_CLASS_DATA] = u32Window;
+	sCfg.aWindowMs[SLOT_CLASS_INST] = u32Window;
+	sCfg.aWindowMs[SLOT_CLASS_DAILY] = u32Window;
+	sCfg.u8JitterPct = u8JitterPct;
+	TEST_ASSERT_EQUAL_INT32(0, SlotInt_Config(&sSlot, &sCfg));
+}
+
+static void _set_dev_(uint32_t u32Dev, uint32_t u32Seed)
+{
+	// M-field then a BCD like A-field, devices have close addresses
+	uint8_t aId[SLOT_ID_SZ] = { 0x34, 0x12, 0x00, 0x00, 0x00, 0x00, 0x01, 0x07 };
+	aId[2] = (uint8_t)(u32Dev);
+	aId[3] = (uint8_t)(u32Dev >> 8);
+	SlotInt_SetId(&sSlot, aId, sizeof(aId), u32Seed);
+}
+
+/******************************************************************************/
+TEST_SETUP(WizeCore_app_slot)
+{
+	SlotInt_Init(&sSlot);
+}
+
+TEST_TEAR_DOWN(WizeCore_app_slot)
+{
+}
+
+/******************************************************************************/
+TEST(WizeCore_app_slot, test_SlotInt_Default)
+{
+	TEST_ASSERT_EQUAL_UINT32(SLOT_DATA_WINDOW_MS, sSlot.sCfg.aWindowMs[SLOT_CLASS_DATA]);
+	TEST_ASSERT_EQUAL_UINT32(SLOT_INST_WINDOW_MS, sSlot.sCfg.aWindowMs[SLOT_CLASS_INST]);
+	TEST_ASSERT_EQUAL_UINT32(SLOT_DAILY_WINDOW_MS, sSlot.sCfg.aWindowMs[SLOT_CLASS_DAILY]);
+
+	_set_dev_(1, 0);
+	// DATA is disabled by default
+	TEST_ASSERT_EQUAL_UINT32(0, SlotInt_Offset(&sSlot, SLOT_CLASS_DATA));
+	// a periodic install is delayed by less than its window
+	TEST_ASSERT_LESS_THAN_UINT32(SLOT_INST_WINDOW_MS, SlotInt_Offset(&sSlot, SLOT_CLASS_INST));
+	// unknown class
+	TEST_ASSERT_EQUAL_UINT32(0, SlotInt_Offset(&sSlot, SLOT_CLASS_NB));
+}
+
+TEST(WizeCore_app_slot, test_SlotInt_Config_Invalid)
+{
+	struct slot_cfg_s sCfg;
+	memset(&sCfg, 0, sizeof(sCfg));
+	sCfg.aWindowMs[SLOT_CLASS_INST] = 1000;
+	sCfg.u8JitterPct = 101;
+	TEST_ASSERT_EQUAL_INT32(-1, SlotInt_Config(&sSlot, &sCfg));
+	TEST_ASSERT_EQUAL_INT32(-1, SlotInt_Config(&sSlot, NULL));
+	// unchanged
+	TEST_ASSERT_EQUAL_UINT32(SLOT_INST_WINDOW_MS, sSlot.sCfg.aWindowMs[SLOT_CLASS_INST]);
+	TEST_ASSERT_EQUAL_UINT8(SLOT_JITTER_PCT, sSlot.sCfg.u8JitterPct);
+}
+
+TEST(WizeCore_app_slot, test_SlotInt_Distribution)
+{
+	uint32_t aBucket[SLOT_BUCKET_NB];
+	uint32_t u32Offset;
+	uint32_t i;
+	const uint32_t u32Window = 10000;
+	const uint32_t u32Mean = SLOT_DEV_NB / SLOT_BUCKET_NB;
+
+	memset(aBucket, 0, sizeof(aBucket));
+	_cfg_(u32Window, 0);
+	for (i = 0; i < SLOT_DEV_NB; i++)
+	{
+		_set_dev_(i, 0);
+		u32Offset = SlotInt_Offset(&sSlot, SLOT_CLASS_INST);
+		TEST_ASSERT_LESS_THAN_UINT32(u32Window, u32Offset);
+		aBucket[u32Offset / (u32Window / SLOT_BUCKET_NB)]++;
+	}
+	// close addresses are spread evenly over the window
+	for (i = 0; i < SLOT_BUCKET_NB; i++)
+	{
+		TEST_ASSERT_UINT32_WITHIN(u32Mean / 3, u32Mean, aBucket[i]);
+	}
+
+	// each class has its own offset
+	_set_dev_(1, 0);
+	TEST_ASSERT_NOT_EQUAL(
+		SlotInt_Offset(&sSlot, SLOT_CLASS_INST),
+		SlotInt_Offset(&sSlot, SLOT_CLASS_DAILY));
+}
+
+TEST(WizeCore_app_slot, test_SlotInt_Seed)
+{
+	uint32_t u32Base;
+	uint32_t u32Rand;
+	uint32_t u32Offset;
+	uint32_t i;
+	const uint32_t u32Window = 10000;
+	const uint32_t u32Jitter = u32Window * 20 / 100;
+
+	// without jitter, the offset only depends on the address (not on the seed)
+	_cfg_(u32Window, 0);
+	_set_dev_(42, 0x1234);
+	u32Base = SlotInt_Offset(&sSlot, SLOT_CLASS_INST);
+	_set_dev_(42, 0xBEEF);
+	TEST_ASSERT_EQUAL_UINT32(u32Base, SlotInt_Offset(&sSlot, SLOT_CLASS_INST));
+	TEST_ASSERT_EQUAL_UINT32(u32Base, SlotInt_Offset(&sSlot, SLOT_CLASS_INST));
+
+	// the jitter follows the xorshift32 sequence from the seeded state
+	_cfg_(u32Window, 20);
+	_set_dev_(42, 0x1234);
+	u32Rand = sSlot.u32Rand;
+	TEST_ASSERT_NOT_EQUAL(0, u32Rand);
+	for (i = 0; i < 16; i++)
+	{
+		u32Offset = (u32Base + _xorshift32_(&u32Rand) % u32Jitter) % u32Window;
+		TEST_ASSERT_EQUAL_UINT32(u32Offset, SlotInt_Offset(&sSlot, SLOT_CLASS_INST));
+	}
+
+	// the same address and seed give the same sequence
+	_set_dev_(42, 0x1234);
+	u32Rand = sSlot.u32Rand;
+	_set_dev_(42, 0x1234);
+	TEST_ASSERT_EQUAL_UINT32(u32Rand, sSlot.u32Rand);
+	// another seed give another one
+	_set_dev_(42, 0x1235);
+	TEST_ASSERT_NOT_EQUAL(u32Rand, sSlot.u32Rand);
+}
+
+TEST(WizeCore_app_slot, test_SlotInt_SmallWindow)
+{
+	uint32_t aHit[4];
+	uint32_t u32Offset;
+	uint32_t i;
+
+	// fewer slots than devices : offsets stay in the window, all slots used
+	memset(aHit, 0, sizeof(aHit));
+	_cfg_(4, 100);
+	for (i = 0; i < 100; i++)
+	{
+		_set_dev_(i, i);
+		u32Offset = SlotInt_Offset(&sSlot, SLOT_CLASS_INST);
+		TEST_ASSERT_LESS_THAN_UINT32(4, u32Offset);
+		aHit[u32Offset]++;
+	}
+	for (i = 0; i < 4; i++)
+	{
+		TEST_ASSERT_NOT_EQUAL(0, aHit[i]);
+	}
+
+	// jitter rounded down to 0 (1 ms window)
+	_cfg_(1, 50);
+	_set_dev_(7, 7);
+	TEST_ASSERT_EQUAL_UINT32(0, SlotInt_Offset(&sSlot, SLOT_CLASS_INST));
+
+	// no window, no offset
+	_cfg_(0, 100);
+	TEST_ASSERT_EQUAL_UINT32(0, SlotInt_Offset(&sSlot, SLOT_CLASS_INST));
+}
@@ -0,0 +1,86 @@
+/**
+  * @file: adm_log.h
+  * @brief This file define the log of the ADM commands received in a session.
+  *
+  * @details A session may hold a sequence of commands (see
+  * WizeApi_SetAdmCmdMax), but the command and response messages only hold the
+  * last one. So, each command id and its response error code are recorded
+  * here. It is pure logic (no RTOS call), the caller protects it.
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+/*!
+ * @addtogroup wize_admin_mgr
+ * @{
+ *
+ */
+#ifndef _ADM_LOG_H_
+#define _ADM_LOG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "proto.h"
+
+/*!
+ * @def ADM_LOG_SZ
+ * @brief This macro define the number of commands recorded per session (the
+ * first ones).
+ */
+#ifndef ADM_LOG_SZ
+	#define ADM_LOG_SZ 8
+#endif
+
+/*!
+ * @brief This struct defines one recorded command
+ */
+struct adm_log_ent_s
+{
+	uint8_t u8CmdId;   /**< The command id (L7CommandId) */
+	uint8_t u8ErrCode; /**< The response error code (L7ErrorCode), valid if bRspSent */
+	uint8_t bRspSent;  /**< The response has been sent */
+};
+
+/*!
+ * @brief This struct defines the log of the commands received in a session
+ */
+struct adm_log_s
+{
+	uint8_t u8Nb;                          /**< Number of received commands (may be greater than ADM_LOG_SZ) */
+	uint8_t bWriteParam;                   /**< At least one of them is a WRITE_PARAMETER */
+	struct adm_log_ent_s aEnt[ADM_LOG_SZ]; /**< The recorded commands, in reception order */
+};
+
+void AdmLog_Reset(struct adm_log_s *pLog);
+void AdmLog_Cmd(struct adm_log_s *pLog, const net_msg_t *pCmdMsg);
+void AdmLog_Rsp(struct adm_log_s *pLog, const net_msg_t *pRspMsg);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _ADM_LOG_H_ */
+
+/*! @} */
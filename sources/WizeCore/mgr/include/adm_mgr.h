@@ -44,6 +44,7 @@ extern "C" {
 #include <stdint.h>
 
 #include "ses_common.h"
+#include "adm_log.h"
 
 /******************************************************************************/
 
@@ -58,6 +59,10 @@ extern "C" {
 #undef SEND_BUFFER_SZ
 #define SEND_BUFFER_SZ 229 // L7: 229; L6: 13 ; L2: 12
 
+#ifndef ADM_MGR_CMD_MAX
+	#define ADM_MGR_CMD_MAX 1 // commands per session (default)
+#endif
+
 typedef enum
 {
 	ADM_RSP_NONE  = 0b00,
@@ -89,6 +94,12 @@ struct adm_mgr_ctx_s
 
 	uint8_t u8Pending;                 /**< Received command is pending */
 	uint8_t u8ByPassCmd;               /**< Bypass the Received command */
+
+	uint8_t u8CmdMax;                  /**< Maximum number of commands per session (0, 1 : one, after the DATA only) */
+	uint8_t u8CmdNb;                   /**< Number of commands received in the current session */
+	uint8_t u8CmdLast;                 /**< The current command must be the last of the session */
+
+	struct adm_log_s sLog;             /**< Commands received in the current session (sCmdMsg, sRspMsg only hold the last one) */
 };
 
 void AdmMgr_Setup(struct ses_ctx_s *pCtx);
@@ -25,6 +25,12 @@
   * Initial version
   * @par 2.0.0 : 2021/10/19[GBI]
   * Integrate a more complete management for sending and listening.
+  * @par 2.1.0 : 2026/10/19
+  * NetMgr_Send doesn't return NET_STATUS_BUSY anymore when the device is busy :
+  * the message is queued (see NET_MGR_REQ_QUEUE_NB) and NET_STATUS_OK returned.
+  * The caller is notified as for a direct send, or with NET_EVENT_TIMEOUT if it
+  * can't be started within NET_MGR_SEND_START_MS. NET_STATUS_BUSY is now only
+  * returned when the queue is full.
   *
   */
 
@@ -45,6 +51,57 @@ extern "C" {
 #include "net_api_private.h"
 #include "proto_api.h"
 #include "time_evt.h"
+#include "net_retry.h"
+
+/*!
+ * @def NET_MGR_RX_LEAD_MS
+ * @brief This macro define the default PHY wake-up lead time before a prepared
+ * listen window (see NetMgr_ListenAt, NetMgr_SetRxLead).
+ */
+#ifndef NET_MGR_RX_LEAD_MS
+	#define NET_MGR_RX_LEAD_MS 10
+#endif
+
+/*!
+ * @def NET_MGR_RX_PREP_MS
+ * @brief This macro define how long before a listen window the sessions call
+ * NetMgr_ListenAt. It must be greater than the PHY wake-up lead time.
+ */
+#ifndef NET_MGR_RX_PREP_MS
+	#define NET_MGR_RX_PREP_MS 50
+#endif
+
+/*!
+ * @def NET_MGR_REQ_QUEUE_NB
+ * @brief This macro define the number of pending requests (asynchronous ones
+ * and synchronous sends queued while the device is busy).
+ */
+#ifndef NET_MGR_REQ_QUEUE_NB
+	#define NET_MGR_REQ_QUEUE_NB 4
+#endif
+
+/*!
+ * @def NET_MGR_SEND_START_MS
+ * @brief This macro define how long a NetMgr_Send, queued because the device
+ * is busy, may wait before to be started. After that, it is dropped and the
+ * caller notified with NET_EVENT_TIMEOUT.
+ */
+#ifndef NET_MGR_SEND_START_MS
+	#define NET_MGR_SEND_START_MS 5000
+#endif
+
+/*!
+ * @def NET_MGR_TRACE_NB
+ * @brief This macro define the number of records in the trace ring (must be a
+ * power of 2, 0 to remove the trace).
+ */
+#ifndef NET_MGR_TRACE_NB
+	#define NET_MGR_TRACE_NB 64
+#endif
+
+#if (NET_MGR_TRACE_NB & (NET_MGR_TRACE_NB - 1))
+	#error "NET_MGR_TRACE_NB must be a power of 2"
+#endif
 
 /*!
  * @brief This enumeration define the net device events
@@ -59,6 +116,8 @@ typedef enum {
 	// ----
 	NET_EVENT_TIMEOUT     = 0x10, /**< Timeout event occurs */
 	NET_EVENT_FRM_PASSED  = 0x20, /**< Frame received and passed */
+	NET_EVENT_PREEMPTED   = 0x40, /**< Listen window preempted by a priority send (given with NET_EVENT_TIMEOUT) */
+	NET_EVENT_CANCELED    = 0x80, /**< Request canceled by NetMgr_Close (given with NET_EVENT_ERROR) */
 	// ----
 	NET_EVENT_MSK         = 0xFF
 } net_event_e;
@@ -70,6 +129,8 @@ typedef enum {
     NET_STATUS_OK     = 0x0, /*!< Network return status OK */
 	NET_STATUS_ERROR  = 0x1, /*!< Network return status ERROR */
 	NET_STATUS_BUSY   = 0x2, /*!< Network return status BUSY */
+	NET_STATUS_DUTY   = 0x3, /*!< Network return status duty-cycle limit reached */
+	NET_STATUS_CCA    = 0x4, /*!< Network return status channel busy (listen before talk) */
 } net_status_e;
 
 /*!
@@ -82,6 +143,174 @@ typedef enum
 	NET_LISTEN_TYPE_MANY   = 0x03, /**< Many matching messages until timeout*/
 } net_listen_type_e;
 
+/*!
+ * @brief This enumeration define the asynchronous request type
+ */
+typedef enum
+{
+	NET_REQ_SEND   = 0x01, /**< Send request */
+	NET_REQ_LISTEN = 0x02, /**< Listen request */
+} net_req_type_e;
+
+/*!
+ * @brief This enumeration define the request priority, from the L2 C-field
+ * class of the message (the lower, the higher priority)
+ */
+typedef enum
+{
+	NET_REQ_PRIO_ALARM = 0x00, /**< DATA_PRIO (APP_DATA_PRIO) */
+	NET_REQ_PRIO_ADM   = 0x01, /**< RESPONSE / COMMAND (APP_ADMIN) */
+	NET_REQ_PRIO_INST  = 0x02, /**< INSTPING / INSTPONG (APP_INSTALL) */
+	NET_REQ_PRIO_DATA  = 0x03, /**< DATA (APP_DATA) and others */
+	//
+	NET_REQ_PRIO_NB
+} net_req_prio_e;
+
+/*!
+ * @brief This struct defines an asynchronous request (see NetMgr_Submit)
+ */
+typedef struct net_req_s
+{
+	net_msg_t *pxNetMsg;           /*!< Message to send or to listen */
+	void *pUser;                   /*!< User pointer, given back with the completion */
+	uint32_t u32TimeOut;           /*!< Timeout in millisecond */
+	uint32_t u32Deadline;          /*!< Maximum wait before start in millisecond (0 : none) */
+	uint32_t u32SubmitTick;        /*!< Tick at submit time (set by NetMgr_Submit) */
+	net_req_type_e eType;          /*!< Request type */
+	net_listen_type_e eListenType; /*!< Listen type (listen request only) */
+	uint16_t u16Handle;            /*!< Request handle (set by NetMgr_Submit) */
+} net_req_t;
+
+/*!
+ * @brief This struct defines a pending request entry
+ */
+struct net_req_ent_s
+{
+	net_req_t sReq;           /*!< The request */
+	uint32_t u32DeadlineTick; /*!< Tick after which the request is dropped (if u32Deadline) */
+	uint8_t u8Prio;           /*!< Priority (see @link net_req_prio_e @endlink) */
+	uint8_t bSync;            /*!< Synchronous send queued by NetMgr_Send (result notified to the caller) */
+	void *hOwner;             /*!< Task that submitted the request */
+};
+
+/*!
+ * @brief This struct defines the pending request wait time statistics, per
+ * priority
+ */
+struct net_req_wait_s
+{
+	uint32_t u32Nb;      /*!< Number of started requests */
+	uint32_t u32SumTick; /*!< Sum of the wait time (tick) */
+	uint32_t u32MaxTick; /*!< Maximum wait time (tick) */
+};
+
+/*!
+ * @brief This struct defines the pending request statistics
+ */
+struct net_req_stats_s
+{
+	uint8_t u8Depth;                            /*!< Current number of pending requests */
+	uint8_t u8DepthMax;                         /*!< Maximum number of pending requests */
+	uint32_t u32Queued;                         /*!< Number of queued requests */
+	uint32_t u32Rejected;                       /*!< Number of rejected requests (queue full) */
+	uint32_t u32Evicted;                        /*!< Number of requests evicted by a higher priority one */
+	uint32_t u32Expired;                        /*!< Number of requests dropped on deadline */
+	uint32_t u32Preempted;                      /*!< Number of preempted listen windows */
+	struct net_req_wait_s aWait[NET_REQ_PRIO_NB]; /*!< Wait time per priority */
+};
+
+/*!
+ * @brief This struct defines the pending request queue (sorted on priority,
+ * then deadline, then submit order)
+ */
+struct net_req_queue_s
+{
+	struct net_req_ent_s aEnt[NET_MGR_REQ_QUEUE_NB]; /*!< Pending requests */
+	uint8_t u8Nb;                                    /*!< Number of pending requests */
+	struct net_req_stats_s sStats;                   /*!< Statistics */
+};
+
+/*!
+ * @brief This struct defines an asynchronous request completion (see
+ * NetMgr_Complete)
+ */
+typedef struct net_cpl_s
+{
+	net_msg_t *pxNetMsg;    /*!< Message of the request */
+	void *pUser;            /*!< User pointer of the request */
+	uint32_t u32Evt;        /*!< Events (see @link net_event_e @endlink) */
+	uint32_t u32SubmitTick; /*!< Tick at submit time */
+	uint32_t u32StartTick;  /*!< Tick at start time */
+	uint32_t u32EndTick;    /*!< Tick at completion time */
+	int32_t i32Status;      /*!< Status (see @link net_status_e @endlink) */
+	uint16_t u16Handle;     /*!< Request handle */
+	uint8_t bLast;          /*!< Last completion of the request (a many listen
+	                             give one completion per received message) */
+} net_cpl_t;
+
+/*!
+ * @brief This enumeration define the trace events
+ *
+ * @details The values are part of the trace record format (see
+ * tools/scripts/net_trace), so existing ones must not be changed.
+ */
+typedef enum
+{
+	NET_TRACE_NONE         = 0x00, /**< Empty record */
+	NET_TRACE_OPEN         = 0x01, /**< NetMgr opened (arg : status) */
+	NET_TRACE_CLOSE        = 0x02, /**< NetMgr closed */
+	NET_TRACE_SEND_START   = 0x03, /**< Send started (arg : status) */
+	NET_TRACE_SEND_RETRY   = 0x04, /**< Send failed, retry (arg : status) */
+	NET_TRACE_CCA_BACKOFF  = 0x05, /**< Channel busy, wait for backoff (arg : backoff in ms) */
+	NET_TRACE_TX_COMPLETE  = 0x06, /**< Transmission completed */
+	NET_TRACE_LISTEN_START = 0x07, /**< Listen started (arg : status) */
+	NET_TRACE_LISTEN_RETRY = 0x08, /**< Listen failed, retry (arg : status) */
+	NET_TRACE_RX_STARTED   = 0x09, /**< Frame detected (preamble and sync) */
+	NET_TRACE_RX_COMPLETE  = 0x0A, /**< Frame received */
+	NET_TRACE_RECV_DONE    = 0x0B, /**< Expected message given to the caller (arg : message type) */
+	NET_TRACE_FRM_PASSED   = 0x0C, /**< Received frame passed */
+	NET_TRACE_FRM_DROPPED  = 0x0D, /**< Received frame dropped (reception ring full) */
+	NET_TRACE_TIMEOUT      = 0x0E, /**< Send or listen timeout */
+	NET_TRACE_TMO_EXPAND   = 0x0F, /**< Listen timeout expanded on detection (arg : ms) */
+	NET_TRACE_RX_WAKE      = 0x10, /**< PHY wake-up before a prepared listen */
+	NET_TRACE_RX_ARM       = 0x11, /**< Receiver armed for a prepared listen */
+	NET_TRACE_ERROR        = 0x12, /**< Net device error (arg : error type) */
+	NET_TRACE_ABORT        = 0x13, /**< Current action aborted (arg : 1 if fatal) */
+	NET_TRACE_REQ_START    = 0x14, /**< Asynchronous request started (arg : handle) */
+	NET_TRACE_REQ_END      = 0x15, /**< Asynchronous request completed (arg : handle) */
+	NET_TRACE_PREEMPT      = 0x16, /**< Listen preempted by a priority send (arg : listen priority) */
+	NET_TRACE_REQ_DROP     = 0x17, /**< Pending request dropped (arg : handle) */
+	NET_TRACE_RETRY_AT     = 0x18, /**< Delayed send or listen retry tried again (arg : request type) */
+	//
+	NET_TRACE_NB
+} net_trace_evt_e;
+
+/*!
+ * @brief This struct defines a trace record (8 bytes, little endian on the
+ * supported targets)
+ */
+typedef struct net_trace_s
+{
+	uint32_t u32Us;  /*!< Time stamp in micro-second, at the tick resolution by default (wrap around) */
+	uint8_t u8Evt;   /*!< Event (see @link net_trace_evt_e @endlink) */
+	uint8_t u8State; /*!< Net device state (see @link netdev_state_e @endlink) */
+	uint16_t u16Arg; /*!< Event argument */
+} net_trace_t;
+
+/*!
+ * @brief This struct defines the trace ring
+ */
+struct net_trace_ring_s
+{
+#if NET_MGR_TRACE_NB
+	net_trace_t aRec[NET_MGR_TRACE_NB]; /*!< Records */
+	uint32_t u32RxStartUs;              /*!< Time stamp of the last RX_STARTED, taken on notification */
+	uint32_t u32RxEndUs;                /*!< Time stamp of the last RX_COMPLETE, taken on notification */
+	uint32_t u32TxEndUs;                /*!< Time stamp of the last TX_COMPLETE, taken on notification */
+#endif
+	uint32_t u32Seq;                    /*!< Number of records ever written */
+};
+
 /*!
  * @brief This struct defines the network manager context.
  */
@@ -96,15 +325,48 @@ struct wize_ctx_s
 	                                    internal error */
 	uint8_t u8RecvRetries;         /*!< Number of reception retry in case of
 	                                    internal error */
+	struct net_retry_s sRetry;     /*!< Retry policy (see NetMgr_SetRetry) */
 	int16_t i16ExpandTmo;          /*!< Expand timeout duration in millisecond */
 	uint8_t u8Detected;            /*!< Indicate that a listen message has been detected*/
 	uint8_t bListenPend;           /*!< Indicate that a listen is pending*/
 	uint8_t u8Type;                /*!< The expected listen application message */
 	net_listen_type_e eListenType; /*!< The current listen type */
 	time_evt_t sTimeOut;           /*!< Internal timeout on send or listen */
+
+	struct net_req_queue_s sReqQueue; /*!< Hold the pending request queue */
+	void *hCplQueue;               /*!< Hold the asynchronous completion queue */
+	net_req_t sReqCur;             /*!< The current asynchronous request
+	                                    (u16Handle is 0 if none) */
+	uint32_t u32ReqStartTick;      /*!< Tick at which the current asynchronous
+	                                    request has been started */
+	void *hReqOwner;               /*!< Task that submitted the current
+	                                    asynchronous request */
+	uint16_t u16ReqHandle;         /*!< Last given request handle */
+	uint8_t u8ReqPrio;             /*!< Priority of the current request */
+	uint8_t bReqSync;              /*!< The current request is a queued
+	                                    synchronous send */
+	uint8_t eActive;               /*!< Current device action (see
+	                                    @link net_req_type_e @endlink, 0 if none) */
+
+	time_evt_t sRxAt;              /*!< Timer to wake-up the PHY, then to arm
+	                                    the receiver (see NetMgr_ListenAt) */
+	net_msg_t *pxRxAtMsg;          /*!< Prepared listen message (NULL if none) */
+	uint32_t u32RxAtTmo;           /*!< Prepared listen timeout in millisecond */
+	net_listen_type_e eRxAtType;   /*!< Prepared listen type */
+	uint16_t u16RxLead;            /*!< PHY wake-up lead time in millisecond */
+	uint16_t u16RxAtArm;           /*!< Delay between PHY wake-up and receiver
+	                                    arm in millisecond */
+
+	time_evt_t sRetryAt;           /*!< Timer to try again the current send or
+	                                    listen after the retry delay (or the
+	                                    LBT backoff), in the net_mgr task */
+	uint8_t eRetryOp;              /*!< Send or listen to try again on sRetryAt
+	                                    (see @link net_req_type_e @endlink, 0
+	                                    if none) */
 };
 
 void NetMgr_Setup(phydev_t *pPhyDev, wize_net_t *pWizeNet);
+int32_t NetMgr_AddPhy(phydev_t *pPhyDev);
 int32_t NetMgr_Init(void);
 
 int32_t NetMgr_Open(void *hTaskToNotify);
@@ -114,9 +376,22 @@ int32_t NetMgr_SetUplink(phy_chan_e eChannel, phy_mod_e eMod);
 int32_t NetMgr_SetDwlink(phy_chan_e eChannel, phy_mod_e eMod);
 int32_t NetMgr_Ioctl(uint32_t eCtl, uint32_t args);
 int32_t NetMgr_Send(net_msg_t *pxNetMsg, uint32_t u32TimeOut);
+int32_t NetMgr_Prepare(net_msg_t *pxNetMsg);
 int32_t NetMgr_Listen(net_msg_t *pxNetMsg, uint32_t u32TimeOut, net_listen_type_e eListenType);
+int32_t NetMgr_ListenAt(net_msg_t *pxNetMsg, uint32_t u32TimeOut, net_listen_type_e eListenType, uint32_t u32DelayMs);
+void NetMgr_SetRxLead(uint16_t u16LeadMs);
 int32_t NetMgr_ListenReady(void);
 
+int32_t NetMgr_Submit(net_req_t *pxReq);
+int32_t NetMgr_Complete(net_cpl_t *pxCpl, uint32_t u32Wait);
+
+int32_t NetMgr_SetRetry(const struct net_retry_cfg_s *pCfg);
+int32_t NetMgr_GetRetryStats(struct net_retry_stats_s *pStats, uint8_t bClear);
+int32_t NetMgr_GetReqStats(struct net_req_stats_s *pStats, uint8_t bClear);
+
+uint32_t NetMgr_TraceGet(net_trace_t *pxTrace, uint32_t u32Nb, uint32_t *pu32Seq);
+void NetMgr_TraceClear(void);
+
 #ifdef __cplusplus
 }
 #endif
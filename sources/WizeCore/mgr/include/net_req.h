@@ -0,0 +1,62 @@
+/**
+  * @file: net_req.h
+  * @brief This file define the pending request queue used by the network
+  * manager.
+  *
+  * @details The queue is kept sorted on priority, then deadline, then submit
+  * order. It is pure logic (no RTOS call), the caller protects it and
+  * completes the dropped requests.
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+/*!
+ * @addtogroup wize_net_mgr
+ * @{
+ *
+ */
+#ifndef _NET_REQ_H_
+#define _NET_REQ_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "net_mgr.h"
+
+uint8_t NetReq_Prio(uint8_t u8Type);
+int32_t NetReq_Push(struct net_req_queue_s *pQueue, struct net_req_ent_s *pEnt, struct net_req_ent_s *pEvict, uint8_t *pbEvict);
+uint8_t NetReq_Pop(struct net_req_queue_s *pQueue, struct net_req_ent_s *pEnt);
+uint8_t NetReq_Expired(const struct net_req_ent_s *pEnt, uint32_t u32Now);
+uint8_t NetReq_Preempt(const struct net_req_ent_s *pEnt, uint8_t eActive, uint8_t u8ActivePrio);
+uint8_t NetReq_Complete(const net_req_t *pReq, uint32_t u32Evt, uint8_t bEnd, net_cpl_t *pCpl);
+void NetReq_Drop(const net_req_t *pReq, uint32_t u32Evt, int32_t i32Status, uint32_t u32Now, net_cpl_t *pCpl);
+int32_t NetReq_RxAt(uint8_t bActive, uint32_t u32DelayMs, uint16_t u16LeadMs, uint32_t *pu32WakeMs, uint16_t *pu16ArmMs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _NET_REQ_H_ */
+
+/*! @} */
@@ -0,0 +1,143 @@
+/**
+  * @file: net_retry.h
+  * @brief This file define the retry policy used by the network manager.
+  *
+  * @details The policy decides, after a failed attempt, if it is worth to try
+  * again and how long to wait before. It is pure logic (no RTOS call), the
+  * caller applies the delay.
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+/*!
+ * @addtogroup wize_net_mgr
+ * @{
+ *
+ */
+#ifndef _NET_RETRY_H_
+#define _NET_RETRY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*!
+ * @def NET_RETRY_BUDGET_DEFAULT
+ * @brief This macro define the default number of retries allowed per session
+ * (0 : unlimited).
+ */
+#ifndef NET_RETRY_BUDGET_DEFAULT
+	#define NET_RETRY_BUDGET_DEFAULT 0
+#endif
+
+/*!
+ * @brief This enumeration define the retry strategies
+ */
+typedef enum
+{
+	NET_RETRY_FIXED = 0x00, /**< Fixed delay between retries (0 : back to back) */
+	NET_RETRY_EXP   = 0x01, /**< Exponential backoff with jitter */
+	NET_RETRY_LINK  = 0x02, /**< Exponential backoff with jitter, give up early on bad link (noise, RSSI) */
+	//
+	NET_RETRY_STRATEGY_NB
+} net_retry_strategy_e;
+
+/*!
+ * @brief This enumeration define the failed attempt outcomes
+ */
+typedef enum
+{
+	NET_RETRY_OUT_BUSY    = 0x00, /**< Device (or PHY) busy */
+	NET_RETRY_OUT_ERROR   = 0x01, /**< Device (or PHY) error */
+	NET_RETRY_OUT_FRM_ERR = 0x02, /**< Received frame in error (CRC, authentication...) */
+	NET_RETRY_OUT_PASSED  = 0x03, /**< Received frame not the expected one */
+	//
+	NET_RETRY_OUT_NB
+} net_retry_out_e;
+
+/*!
+ * @brief This enumeration define the retry operations
+ */
+typedef enum
+{
+	NET_RETRY_OP_TX = 0x00, /**< Transmission */
+	NET_RETRY_OP_RX = 0x01, /**< Reception */
+	//
+	NET_RETRY_OP_NB
+} net_retry_op_e;
+
+/*!
+ * @brief This struct defines the retry policy configuration
+ */
+struct net_retry_cfg_s
+{
+	uint8_t eStrategy;      /*!< Strategy (see @link net_retry_strategy_e @endlink) */
+	uint8_t u8JitterPct;    /*!< Jitter, in percent of the delay (EXP and LINK) */
+	uint16_t u16DelayMs;    /*!< Fixed delay, or first backoff delay (ms) */
+	uint16_t u16DelayMaxMs; /*!< Maximum backoff delay (ms) */
+	uint16_t u16Budget;     /*!< Number of retries allowed per session (0 : unlimited) */
+	uint8_t u8NoiseMax;     /*!< LINK : give up a TX retry when the noise is above -u8NoiseMax dBm, as PHY_CTL_GET_NOISE (0 : not used) */
+	uint8_t u8RssiMin;      /*!< LINK : give up a RX retry on frame error when the RSSI is below (0 : not used) */
+};
+
+/*!
+ * @brief This struct defines the retry policy statistics
+ */
+struct net_retry_stats_s
+{
+	uint32_t aRetry[NET_RETRY_OP_NB][NET_RETRY_OUT_NB]; /*!< Retries per operation and outcome */
+	uint32_t aRecovered[NET_RETRY_OP_NB]; /*!< Operations successful after at least one retry */
+	uint32_t u32GiveUpMax;                /*!< Give up on maximum retries */
+	uint32_t u32GiveUpBudget;             /*!< Give up on exhausted session budget */
+	uint32_t u32GiveUpLink;               /*!< Give up on bad link (LINK strategy) */
+	uint32_t u32DelayMs;                  /*!< Cumulated delay between retries (ms) */
+};
+
+/*!
+ * @brief This struct defines the retry policy context
+ */
+struct net_retry_s
+{
+	struct net_retry_cfg_s sCfg;     /*!< Configuration */
+	struct net_retry_stats_s sStats; /*!< Statistics */
+	uint32_t u32Rand;                /*!< Jitter random generator state */
+	uint16_t u16BudgetLeft;          /*!< Retries left in the current session */
+	uint8_t u8Max;                   /*!< Maximum retries of the current operation */
+	uint8_t u8Attempt;               /*!< Retries done in the current operation */
+	uint8_t eOp;                     /*!< Current operation (see @link net_retry_op_e @endlink) */
+};
+
+void NetRetry_Init(struct net_retry_s *pCtx, uint32_t u32Seed);
+int32_t NetRetry_Config(struct net_retry_s *pCtx, const struct net_retry_cfg_s *pCfg);
+void NetRetry_Session(struct net_retry_s *pCtx, uint32_t u32Mix);
+void NetRetry_Start(struct net_retry_s *pCtx, uint8_t eOp, uint8_t u8Max);
+int32_t NetRetry_Next(struct net_retry_s *pCtx, uint8_t eOut, uint8_t u8Rssi, uint8_t u8Noise);
+void NetRetry_Done(struct net_retry_s *pCtx);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _NET_RETRY_H_ */
+
+/*! @} */
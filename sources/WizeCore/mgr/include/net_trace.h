@@ -0,0 +1,54 @@
+/**
+  * @file: net_trace.h
+  * @brief This file define the state-transition trace ring used by the
+  * network manager.
+  *
+  * @details The records are time stamped by the caller. It is pure logic (no
+  * RTOS call), the caller protects it.
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+/*!
+ * @addtogroup wize_net_mgr
+ * @{
+ */
+#ifndef _NET_TRACE_H_
+#define _NET_TRACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "net_mgr.h"
+
+void NetTrace_Put(struct net_trace_ring_s *pRing, uint32_t u32Us, uint8_t u8Evt, uint8_t u8State, uint16_t u16Arg);
+uint32_t NetTrace_Get(const struct net_trace_ring_s *pRing, net_trace_t *pxTrace, uint32_t u32Nb, uint32_t *pu32Seq);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _NET_TRACE_H_ */
+
+/*! @} */
@@ -0,0 +1,118 @@
+/**
+  * @file: adm_log.c
+  * @brief This file implement the log of the ADM commands received in a
+  * session.
+  *
+  * @details
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+
+#include "adm_log.h"
+#include "app_layer.h"
+
+/*!
+ * @addtogroup wize_admin_mgr
+ * @{
+ *
+ */
+
+/*!
+ * @brief This function clear the log (on session opening)
+ *
+ * @param [in] pLog Pointer on the log
+ *
+ * @return None
+ */
+void AdmLog_Reset(struct adm_log_s *pLog)
+{
+	if (pLog)
+	{
+		memset(pLog, 0, sizeof(struct adm_log_s));
+	}
+}
+
+/*!
+ * @brief This function record a received command
+ *
+ * @details Only the first ADM_LOG_SZ commands are recorded, but all of them
+ * are counted and checked for WRITE_PARAMETER.
+ *
+ * @param [in] pLog    Pointer on the log
+ * @param [in] pCmdMsg Pointer on the received command message
+ *
+ * @return None
+ */
+void AdmLog_Cmd(struct adm_log_s *pLog, const net_msg_t *pCmdMsg)
+{
+	struct adm_log_ent_s *pEnt;
+	if (pLog && pCmdMsg && pCmdMsg->pData && pCmdMsg->u8Size)
+	{
+		if (pCmdMsg->pData[0] == ADM_WRITE_PARAM)
+		{
+			pLog->bWriteParam = 1;
+		}
+		if (pLog->u8Nb < ADM_LOG_SZ)
+		{
+			pEnt = &(pLog->aEnt[pLog->u8Nb]);
+			pEnt->u8CmdId = pCmdMsg->pData[0];
+			pEnt->u8ErrCode = 0;
+			pEnt->bRspSent = 0;
+		}
+		if (pLog->u8Nb < 0xFF)
+		{
+			pLog->u8Nb++;
+		}
+	}
+}
+
+/*!
+ * @brief This function record the sent response of the last received command
+ *
+ * @param [in] pLog    Pointer on the log
+ * @param [in] pRspMsg Pointer on the sent response message
+ *
+ * @return None
+ */
+void AdmLog_Rsp(struct adm_log_s *pLog, const net_msg_t *pRspMsg)
+{
+	struct adm_log_ent_s *pEnt;
+	if (pLog && pRspMsg && pRspMsg->pData && pLog->u8Nb && (pLog->u8Nb <= ADM_LOG_SZ))
+	{
+		pEnt = &(pLog->aEnt[pLog->u8Nb - 1]);
+		pEnt->u8ErrCode = (pRspMsg->u8Size >= sizeof(admin_rsp_cmderr_t))?
+			(((const admin_rsp_cmderr_t*)(pRspMsg->pData))->L7ErrorCode):(0);
+		pEnt->bRspSent = 1;
+	}
+}
+
+/*! @} */
+
+#ifdef __cplusplus
+}
+#endif
@@ -73,6 +73,10 @@ void AdmMgr_Setup(struct ses_ctx_s *pCtx)
 	pCtx->ini = _adm_mgr_ini_;
 	pCtx->fsm = _adm_mgr_fsm_;
 	pCtx->eState = SES_STATE_DISABLE;
+	if (pCtx->pPrivate)
+	{
+		((struct adm_mgr_ctx_s*)pCtx->pPrivate)->u8CmdMax = ADM_MGR_CMD_MAX;
+	}
 	assert( 0 == TimeEvt_TimerInit( &pCtx->sTimeEvt, pCtx->hTask, TIMEEVT_CFG_ONESHOT) );
 }
 
@@ -142,7 +146,11 @@ static uint32_t _adm_mgr_fsm_(struct ses_ctx_s *pCtx, uint32_t u32Evt)
 			{
 				pPrvCtx->u8ByPassCmd = 0;
 				pPrvCtx->u8Pending = ADM_RSP_NONE;
-				// send DATA
+				pPrvCtx->u8CmdNb = 0;
+				pPrvCtx->u8CmdLast = 0;
+				AdmLog_Reset(&(pPrvCtx->sLog));
+				// send DATA. As the INST PING, it is sent right away (no
+				// transmit deadline), so it is not prepared ahead.
 				if ( NetMgr_Send( &(pPrvCtx->sDataMsg), 1000 ) )
 				{
 					// failed, go back into IDLE
@@ -159,7 +167,8 @@ static uint32_t _adm_mgr_fsm_(struct ses_ctx_s *pCtx, uint32_t u32Evt)
 				if (!pPrvCtx->u8ByPassCmd)
 				{
 					pPrvCtx->sCmdMsg.u8Type = APP_ADMIN;
-					if ( NetMgr_Listen(&(pPrvCtx->sCmdMsg), 5*pPrvCtx->u8ExchRxLength, NET_LISTEN_TYPE_DETECT) )
+					if ( NetMgr_ListenAt(&(pPrvCtx->sCmdMsg), 5*pPrvCtx->u8ExchRxLength, NET_LISTEN_TYPE_DETECT,
+							(pPrvCtx->u8ExchRxDelay)?(NET_MGR_RX_PREP_MS):(0)) )
 					{
 						pCtx->eState = SES_STATE_IDLE;
 						u32BackEvt = SES_FLG_ERROR;
@@ -179,6 +188,8 @@ static uint32_t _adm_mgr_fsm_(struct ses_ctx_s *pCtx, uint32_t u32Evt)
 			{
 				u32BackEvt |= SES_FLG_CMD_RECV;
 				pPrvCtx->u8Pending = ADM_RSP_PEND;
+				pPrvCtx->u8CmdNb++;
+				AdmLog_Cmd(&(pPrvCtx->sLog), &(pPrvCtx->sCmdMsg));
 				LOG_INF("CMD Received\n");
 
 				// check if delay before response
@@ -221,6 +232,12 @@ static uint32_t _adm_mgr_fsm_(struct ses_ctx_s *pCtx, uint32_t u32Evt)
 			}
 			break;
 		case SES_STATE_WAITING_TX_DELAY: // From SES_STATE_WAITING_TX_DELAY : SES_FLG_ERROR, SES_FLG_OUT_DATE
+			if (u32Evt & SES_EVT_ADM_READY)
+			{
+				// Build the RSP frame now, so it will only be given to the PHY
+				// when the delay expire. On failure, it will be built on send.
+				NetMgr_Prepare( &(pPrvCtx->sRspMsg) );
+			}
 			if (u32Evt & SES_EVT_ADM_DELAY_EXPIRED)
 			{
 				// Check if response is ready to be send
@@ -256,15 +273,35 @@ static uint32_t _adm_mgr_fsm_(struct ses_ctx_s *pCtx, uint32_t u32Evt)
 					pCtx->eState = SES_STATE_IDLE;
 					pPrvCtx->u8Pending = ADM_RSP_NONE;
 					LOG_INF("RSP sent\n");
+					AdmLog_Rsp(&(pPrvCtx->sLog), &(pPrvCtx->sRspMsg));
 					u32BackEvt |= SES_FLG_RSP_SENT;
+
+					// Wait for the next command, as after the DATA
+					if ( !pPrvCtx->u8ByPassCmd && !pPrvCtx->u8CmdLast &&
+						 (pPrvCtx->u8CmdNb < pPrvCtx->u8CmdMax) )
+					{
+						if ( TimeEvt_TimerStart(
+								&pCtx->sTimeEvt,
+								pPrvCtx->u8ExchRxDelay,
+								(pPrvCtx->u8ExchRxDelay)?(-NET_MGR_RX_PREP_MS):(0),
+								(uint32_t)SES_EVT_ADM_DELAY_EXPIRED
+								) == 0 )
+						{
+							pCtx->eState = SES_STATE_WAITING_RX_DELAY;
+						}
+						// else, the session is done with this command
+					}
 				}
 				else // that is DATA
 				{
 					if (!pPrvCtx->u8ByPassCmd)
 					{
+						// a bit in advance, so the PHY is ready on the command
+						// window (see NetMgr_ListenAt)
 						if ( TimeEvt_TimerStart(
 								&pCtx->sTimeEvt,
-								pPrvCtx->u8ExchRxDelay, 0,
+								pPrvCtx->u8ExchRxDelay,
+								(pPrvCtx->u8ExchRxDelay)?(-NET_MGR_RX_PREP_MS):(0),
 								(uint32_t)SES_EVT_ADM_DELAY_EXPIRED
 								))
 						{
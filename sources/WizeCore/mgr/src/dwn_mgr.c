@@ -142,10 +142,11 @@ static uint32_t _dwn_mgr_fsm_(struct ses_ctx_s *pCtx, uint32_t u32Evt)
 
 				// Init. absolute timer
 				TimeEvt_TimerInit( &pCtx->sTimeEvt, pCtx->hTask, TIMEEVT_CFG_ABSOLUTE);
-				// Start the timer for the first download day
+				// Start the timer for the first download day, a bit in advance
+				// so the PHY is ready on the block window (see NetMgr_ListenAt)
 				if ( TimeEvt_TimerStart(
 						&pCtx->sTimeEvt,
-						pPrvCtx->_u32DayNext + i32NextBlkOffset, 0,
+						pPrvCtx->_u32DayNext + i32NextBlkOffset, -NET_MGR_RX_PREP_MS,
 						(uint32_t)SES_EVT_DWN_DELAY_EXPIRED
 						)
 					)
@@ -191,8 +192,8 @@ static uint32_t _dwn_mgr_fsm_(struct ses_ctx_s *pCtx, uint32_t u32Evt)
 					}
 					else
 					{
-						// Listen					
-						if ( NetMgr_Listen(&(pPrvCtx->sRecvMsg), 1000*pPrvCtx->u8DownRxLength, NET_LISTEN_TYPE_ONE) )
+						// Listen, the block window start in NET_MGR_RX_PREP_MS
+						if ( NetMgr_ListenAt(&(pPrvCtx->sRecvMsg), 1000*pPrvCtx->u8DownRxLength, NET_LISTEN_TYPE_ONE, NET_MGR_RX_PREP_MS) )
 						{
 							pCtx->eState = SES_STATE_IDLE;
 							u32BackEvt = SES_FLG_ERROR;
@@ -216,7 +217,7 @@ static uint32_t _dwn_mgr_fsm_(struct ses_ctx_s *pCtx, uint32_t u32Evt)
 						TimeEvt_TimerInit( &pCtx->sTimeEvt, pCtx->hTask, TIMEEVT_CFG_ABSOLUTE);
 						if ( TimeEvt_TimerStart(
 								&pCtx->sTimeEvt,
-								pPrvCtx->_u32DayNext, 0,
+								pPrvCtx->_u32DayNext, -NET_MGR_RX_PREP_MS,
 								(uint32_t)SES_EVT_DWN_DELAY_EXPIRED
 								))
 						{
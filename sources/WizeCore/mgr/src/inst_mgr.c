@@ -140,7 +140,10 @@ static uint32_t _inst_mgr_fsm_(struct ses_ctx_s *pCtx, uint32_t u32Evt)
 		case SES_STATE_IDLE: // From SES_STATE_IDLE : SES_FLG_ERROR, SES_FLG_NONE
 			if (u32Evt & SES_EVT_OPEN)
 			{
-				// send INST PING request
+				// send INST PING request. It has no transmit deadline (it is
+				// sent as soon as the session is opened), so there is no wait
+				// to hide its build behind : unlike the ADM RESPONSE, it is not
+				// prepared ahead (see NetMgr_Prepare).
 				if ( NetMgr_Send( &(pPrvCtx->sCmdMsg), 1000 ) )
 				{
 					// failed, go back into IDLE
@@ -154,10 +157,12 @@ static uint32_t _inst_mgr_fsm_(struct ses_ctx_s *pCtx, uint32_t u32Evt)
 		case SES_STATE_SENDING: // From SES_STATE_SENDING : SES_FLG_NONE, SES_FLG_ERROR, SES_FLG_PING_SENT, SES_FLG_TIMEOUT
 			if (u32Evt & SES_EVT_SEND_DONE)
 			{
-				// Program an event to wait before listen INST PONG
+				// Program an event to wait before listen INST PONG, a bit in
+				// advance so the PHY is ready on the window (see NetMgr_ListenAt)
 				if ( TimeEvt_TimerStart(
 						&pCtx->sTimeEvt,
-						pPrvCtx->u8InstRxDelay, 0,
+						pPrvCtx->u8InstRxDelay,
+						(pPrvCtx->u8InstRxDelay)?(-NET_MGR_RX_PREP_MS):(0),
 						(uint32_t)SES_EVT_INST_DELAY_EXPIRED
 						))
 				{
@@ -189,7 +194,8 @@ static uint32_t _inst_mgr_fsm_(struct ses_ctx_s *pCtx, uint32_t u32Evt)
 			if (u32Evt & SES_EVT_INST_DELAY_EXPIRED)
 			{
 				pPrvCtx->sRspMsg.u8Type = APP_INSTALL;
-				if ( NetMgr_Listen(&(pPrvCtx->sRspMsg), 1000*pPrvCtx->u8InstRxLength, NET_LISTEN_TYPE_MANY) )
+				if ( NetMgr_ListenAt(&(pPrvCtx->sRspMsg), 1000*pPrvCtx->u8InstRxLength, NET_LISTEN_TYPE_MANY,
+						(pPrvCtx->u8InstRxDelay)?(NET_MGR_RX_PREP_MS):(0)) )
 				{
 					// failed, go back into IDLE
 					pCtx->eState = SES_STATE_IDLE;
@@ -36,6 +36,8 @@ extern "C" {
 #include <stdio.h>
 
 #include "net_mgr.h"
+#include "net_req.h"
+#include "net_trace.h"
 
 #include "rtos_macro.h"
 #include "logger.h"
@@ -62,16 +64,47 @@ extern "C" {
 #define _NET_MGR_EXPAND_TMO_MSK_ 0x10
 // Define the mask when the "ready to listen again" is notified
 #define _NET_MGR_REARM_LISTEN_ 0x20
+// Define the mask when an asynchronous request has been submitted
+#define _NET_MGR_REQ_PEND_ 0x40
+// Define the event to wake-up the PHY before a prepared listen
+#define _NET_MGR_RX_WAKE_ 0x80
+// Define the event to arm the receiver of a prepared listen
+#define _NET_MGR_RX_ARM_ 0x100
+// Define the event to preempt the current listen by a priority send
+#define _NET_MGR_PREEMPT_ 0x200
+// Define the event to try again a delayed send or listen
+#define _NET_MGR_RETRY_ 0x400
+
+// Define the number of pending asynchronous completions
+#define NET_MGR_CPL_QUEUE_NB 8
 
 // Define the number of retries in case of "Phy get received" failure
 #define _NET_MGR_RECV_RETRIES_ 3
 // Define the number of retries in case of "Phy transmit" failure
 #define _NET_MGR_TRANS_RETRIES_ 3
 
+// Define the trace time stamp source (micro-second, the tick resolution)
+#ifndef NET_MGR_TRACE_NOW
+	#define NET_MGR_TRACE_NOW() ( xTaskGetTickCount() * (1000000UL / configTICK_RATE_HZ) )
+#endif
+// Define the trace time stamp source, from an ISR
+#ifndef NET_MGR_TRACE_NOW_ISR
+	#define NET_MGR_TRACE_NOW_ISR() ( xTaskGetTickCountFromISR() * (1000000UL / configTICK_RATE_HZ) )
+#endif
+// Define the trace record call (time stamped now, or at the given time)
+#if NET_MGR_TRACE_NB
+	#define NET_MGR_TRACE(evt, arg) _net_mgr_trace_(NET_MGR_TRACE_NOW(), evt, (uint16_t)(arg))
+	#define NET_MGR_TRACE_AT(us, evt, arg) _net_mgr_trace_(us, evt, (uint16_t)(arg))
+#else
+	#define NET_MGR_TRACE(evt, arg)
+	#define NET_MGR_TRACE_AT(us, evt, arg)
+#endif
+
 /******************************************************************************/
 // Static context variables
 static struct wize_ctx_s sWizeCtx;
 static netdev_t sNetDev;
+static struct net_trace_ring_s sTrace;
 
 // Static functions
 static void _net_mgr_main_(void const * argument);
@@ -80,13 +113,36 @@ static inline void _net_mgr_notify_caller_(uint32_t evt);
 static uint32_t _net_mgr_fsm_(netdev_t *pNetDev, uint32_t u32Evt);
 static int32_t _net_mgr_send_with_retry_(netdev_t *pNetDev, net_msg_t *pxNetMsg, uint8_t u8Retry);
 static int32_t _net_mgr_listen_with_retry_(netdev_t *pNetDev, uint8_t u8Retry);
+static int32_t _net_mgr_send_try_(netdev_t *pNetDev, net_msg_t *pxNetMsg);
+static int32_t _net_mgr_listen_try_(netdev_t *pNetDev);
+static int32_t _net_mgr_retry_at_(uint8_t eOp, int32_t i32Delay);
+static void _net_mgr_retry_cancel_(void);
+static int32_t _net_mgr_retry_next_(netdev_t *pNetDev, uint8_t eOut);
+static uint32_t _net_mgr_drain_ring_(netdev_t *pNetDev, net_msg_t *pxNetMsg);
 static int32_t _net_mgr_error_(netdev_t *pNetDev);
-static int32_t _net_mgr_try_abort_(netdev_t *pNetDev);
+static int32_t _net_mgr_try_abort_(netdev_t *pNetDev, uint32_t u32Route);
+static uint32_t _net_mgr_phy_route_(void);
+static int32_t _net_mgr_start_send_(net_msg_t *pxNetMsg, uint32_t u32TimeOut);
+static int32_t _net_mgr_start_listen_(net_msg_t *pxNetMsg, uint32_t u32TimeOut, net_listen_type_e eListenType);
+static void _net_mgr_complete_(uint32_t u32BackEvt, uint8_t bEnd);
+static void _net_mgr_next_req_(void);
+static uint8_t _net_mgr_rx_at_timer_(uint32_t u32DelayMs, uint32_t u32Event);
+static uint32_t _net_mgr_rx_at_(netdev_t *pNetDev, uint32_t u32Evt);
+static uint8_t _net_mgr_rx_busy_(netdev_t *pNetDev);
+static uint16_t _net_mgr_req_handle_(void);
+static int32_t _net_mgr_req_push_(struct net_req_ent_s *pEnt);
+static uint8_t _net_mgr_req_pop_(struct net_req_ent_s *pEnt);
+static void _net_mgr_req_drop_(struct net_req_ent_s *pEnt, uint32_t u32Evt, int32_t i32Status);
+#if NET_MGR_TRACE_NB
+static void _net_mgr_trace_(uint32_t u32Us, uint8_t u8Evt, uint16_t u16Arg);
+#endif
 
 // net_mgr Task, Mutex, BinSem
 SYS_TASK_CREATE_DEF(netmgr, NET_MGR_TASK_STACK_SIZE, NET_MGR_TASK_PRIORITY);
 SYS_MUTEX_CREATE_DEF(netmgr);
 SYS_BINSEM_CREATE_DEF(netdev);
+// net_mgr asynchronous completion queue
+SYS_QUEUE_CREATE_DEF(netcpl, NET_MGR_CPL_QUEUE_NB, sizeof(net_cpl_t));
 /*!
  * @}
  * @endcond
@@ -120,6 +176,13 @@ void NetMgr_Setup(phydev_t *pPhyDev, wize_net_t *pWizeNet)
 	sWizeCtx.hMutex = SYS_MUTEX_CREATE_CALL(netmgr);
 	assert(sWizeCtx.hMutex);
 
+	// Create the asynchronous completion queue
+	memset(&(sWizeCtx.sReqQueue), 0, sizeof(struct net_req_queue_s));
+	sWizeCtx.hCplQueue = SYS_QUEUE_CREATE_CALL(netcpl);
+	assert(sWizeCtx.hCplQueue);
+	sWizeCtx.sReqCur.u16Handle = 0;
+	sWizeCtx.u16ReqHandle = 0;
+
 	// Create the net_mgr task
 	sWizeCtx.hTask = SYS_TASK_CREATE_CALL(netmgr, _net_mgr_main_, NULL);
 	assert(sWizeCtx.hTask);
@@ -133,11 +196,41 @@ void NetMgr_Setup(phydev_t *pPhyDev, wize_net_t *pWizeNet)
 
 	sWizeCtx.u8RecvRetries = _NET_MGR_RECV_RETRIES_;
 	sWizeCtx.u8TransRetries = _NET_MGR_TRANS_RETRIES_;
+	NetRetry_Init(&(sWizeCtx.sRetry), xTaskGetTickCount());
+	sWizeCtx.u16RxLead = NET_MGR_RX_LEAD_MS;
+	sWizeCtx.pxRxAtMsg = NULL;
+}
+
+/*!
+ * @brief This function attach an additional Phy device to the NetMgr module
+ *
+ * @details It must be called after NetMgr_Setup and before NetMgr_Init. Which
+ * Phy is used to send and to listen is then given by NetMgr_Ioctl (see
+ * NETDEV_CTL_SET_ROUTE).
+ *
+ * The NetMgr still holds one device lock, one timeout and one current action
+ * for all the Phys : a send and a listen are not done at the same time at this
+ * level, sessions are serialized as with one Phy. The route only select which
+ * Phy is used, and which one is waked-up, aborted or put to sleep.
+ *
+ * @param [in] pPhyDev  Pointer on the Phy device structure
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
+ * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ */
+int32_t NetMgr_AddPhy(phydev_t *pPhyDev)
+{
+	return WizeNet_AddPhy(&sNetDev, pPhyDev);
 }
 
 /*!
  * @brief This function initialize the NetMgr module
  *
+ * @details If the device has been suspended (see NetMgr_Close), it is only
+ * resumed (warm open). Otherwise, or if the resume failed, the device is fully
+ * initialized (cold open).
+ *
  * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
  * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
  * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
@@ -147,9 +240,18 @@ int32_t NetMgr_Init(void)
 	int32_t eStatus = NET_STATUS_ERROR;
 	if (sWizeCtx.hTask && sNetDev.pCtx && sNetDev.pPhydev)
 	{
-		if ( TimeEvt_TimerInit(&(sWizeCtx.sTimeOut), sWizeCtx.hTask, TIMEEVT_CFG_ONESHOT) == 0)
+		if ( ( TimeEvt_TimerInit(&(sWizeCtx.sTimeOut), sWizeCtx.hTask, TIMEEVT_CFG_ONESHOT) == 0) &&
+			 ( TimeEvt_TimerInit(&(sWizeCtx.sRxAt), sWizeCtx.hTask, TIMEEVT_CFG_ONESHOT) == 0) &&
+			 ( TimeEvt_TimerInit(&(sWizeCtx.sRetryAt), sWizeCtx.hTask, TIMEEVT_CFG_ONESHOT) == 0) )
 		{
-			eStatus = WizeNet_Init(&sNetDev, &_net_mgr_evtCb_);
+			if (sNetDev.eState == NETDEV_STATE_SUSPEND)
+			{
+				eStatus = WizeNet_Resume(&sNetDev);
+			}
+			if (eStatus != NET_STATUS_OK)
+			{
+				eStatus = WizeNet_Init(&sNetDev, &_net_mgr_evtCb_);
+			}
 		}
 		sWizeCtx.i16ExpandTmo = 900;
 	}
@@ -169,6 +271,9 @@ int32_t NetMgr_Uninit(void)
 	if (sWizeCtx.hTask && sNetDev.pCtx && sNetDev.pPhydev)
 	{
 		TimeEvt_TimerStop(&sWizeCtx.sTimeOut);
+		TimeEvt_TimerStop(&sWizeCtx.sRxAt);
+		sWizeCtx.pxRxAtMsg = NULL;
+		_net_mgr_retry_cancel_();
 		eStatus = WizeNet_Uninit(&sNetDev);
 	}
 	return eStatus;
@@ -195,6 +300,7 @@ int32_t NetMgr_Open(void *hTaskToNotify)
 	// Try to Init device
 	if (NetMgr_Init() != NET_STATUS_OK )
 	{
+		NET_MGR_TRACE(NET_TRACE_OPEN, NET_STATUS_ERROR);
 		xSemaphoreGive(sWizeCtx.hMutex);
 		return NET_STATUS_ERROR;
 	}
@@ -206,23 +312,65 @@ int32_t NetMgr_Open(void *hTaskToNotify)
 	{
 		sWizeCtx.hCaller = xTaskGetCurrentTaskHandle( );
 	}
+	// New session : restore the retry budget
+	NetRetry_Session(&(sWizeCtx.sRetry), xTaskGetTickCount());
 	xSemaphoreGive(sNetDev.hLock);
+	NET_MGR_TRACE(NET_TRACE_OPEN, NET_STATUS_OK);
 	return NET_STATUS_OK;
 }
 
 /*!
  * @brief This function release the device
  *
+ * @details The device is suspended, so that the next NetMgr_Open only resume
+ * it. If it can't be suspended, it is de-initialized (see NetMgr_Uninit).
+ * The current request and the not yet started ones are completed with
+ * NET_EVENT_ERROR | NET_EVENT_CANCELED, so that no caller wait for them.
+ *
  * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
  * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
  */
 int32_t NetMgr_Close(void)
 {
+	struct net_req_ent_s sEnt;
+	uint8_t bLocked;
+
 	// check if caller own the NetMgr mutex
 	if (sWizeCtx.hCaller == xTaskGetCurrentTaskHandle( ) )
 	{
-		NetMgr_Uninit();
+		TimeEvt_TimerStop(&sWizeCtx.sTimeOut);
+		TimeEvt_TimerStop(&sWizeCtx.sRxAt);
+		sWizeCtx.pxRxAtMsg = NULL;
+		_net_mgr_retry_cancel_();
+		if (WizeNet_Suspend(&sNetDev) != NETDEV_STATUS_OK)
+		{
+			WizeNet_Uninit(&sNetDev);
+		}
+		// cancel the current request
+		taskENTER_CRITICAL();
+		bLocked = (sWizeCtx.eActive || sWizeCtx.sReqCur.u16Handle)?(1):(0);
+		sEnt.sReq = sWizeCtx.sReqCur;
+		sEnt.bSync = sWizeCtx.bReqSync;
+		sEnt.hOwner = sWizeCtx.hReqOwner;
+		sWizeCtx.sReqCur.u16Handle = 0;
+		sWizeCtx.bReqSync = 0;
+		sWizeCtx.eActive = 0;
+		taskEXIT_CRITICAL();
+		if (sEnt.sReq.u16Handle)
+		{
+			_net_mgr_req_drop_(&sEnt, NET_EVENT_ERROR | NET_EVENT_CANCELED, NET_STATUS_ERROR);
+		}
+		if (bLocked)
+		{
+			xSemaphoreGive(sNetDev.hLock);
+		}
+		// cancel the not yet started requests
+		while ( _net_mgr_req_pop_(&sEnt) )
+		{
+			_net_mgr_req_drop_(&sEnt, NET_EVENT_ERROR | NET_EVENT_CANCELED, NET_STATUS_ERROR);
+		}
 		sWizeCtx.hCaller = NULL;
+		NET_MGR_TRACE(NET_TRACE_CLOSE, 0);
 		xSemaphoreGive(sWizeCtx.hMutex);
 		return NET_STATUS_OK;
 	}
@@ -318,21 +466,26 @@ int32_t NetMgr_Ioctl(uint32_t eCtl, uint32_t args)
 /*!
  * @brief This function send the given message
  *
+ * @details If the device is busy (e.g. listening), the message is queued on its
+ * priority (see @link net_req_prio_e @endlink), NET_STATUS_OK is returned, and
+ * the message is sent as soon as the device is free. The caller is then
+ * notified as usual, or with NET_EVENT_TIMEOUT if it can't be started within
+ * NET_MGR_SEND_START_MS. A DATA_PRIO message preempts a lower priority listen
+ * window. NET_STATUS_BUSY is only returned when the queue is full (or the
+ * caller doesn't own the NetMgr).
+ *
  * @param[in] pxNetMsg   Pointer to the message to send
- * @param[in] u32TimeOut Timeout in millisecond
+ * @param[in] u32TimeOut Timeout in millisecond (of the transmission itself)
  *
  * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
  * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
  * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ * @retval NET_STATUS_DUTY (see @link net_status_e::NET_STATUS_DUTY @endlink)
+ * @retval NET_STATUS_CCA (see @link net_status_e::NET_STATUS_CCA @endlink)
  */
 int32_t NetMgr_Send(net_msg_t *pxNetMsg, uint32_t u32TimeOut)
 {
 	int32_t eStatus;
-	uint32_t tmoCoarse;
-	int16_t tmoFine;
-
-	tmoCoarse = u32TimeOut/1000;
-	tmoFine = u32TimeOut - tmoCoarse*1000;
 
 	eStatus = NET_STATUS_ERROR;
 	if ( pxNetMsg && pxNetMsg->pData)
@@ -350,21 +503,80 @@ int32_t NetMgr_Send(net_msg_t *pxNetMsg, uint32_t u32TimeOut)
 			// try to acquire the Net Dev
 			if ( xSemaphoreTake( sNetDev.hLock, NET_DEV_ACQUIRE_TIMEOUT()) )
 			{
-				sWizeCtx.pBuffDesc = (void*)pxNetMsg;
-				sWizeCtx.u8Type = pxNetMsg->u8Type;
-				sWizeCtx.eListenType = 0;
-
-				// try to send
-				eStatus = _net_mgr_send_with_retry_(&sNetDev, pxNetMsg, sWizeCtx.u8TransRetries);
-				if ( eStatus == NETDEV_STATUS_OK )
+				eStatus = _net_mgr_start_send_(pxNetMsg, u32TimeOut);
+				if ( eStatus == NET_STATUS_DUTY )
 				{
-					if ( TimeEvt_TimerStart(&sWizeCtx.sTimeOut, tmoCoarse, tmoFine,	(uint32_t)NETDEV_EVT_TIMEOUT ))
-					{
-						_net_mgr_try_abort_(&sNetDev);
-						eStatus = NET_STATUS_ERROR;
-					}
+					// nothing started, the device is still free
+					LOG_WRN("Duty-cycle limit reached\n");
+					xSemaphoreGive(sNetDev.hLock);
+				}
+				else if ( eStatus == NET_STATUS_CCA )
+				{
+					// nothing started, the device is still free
+					LOG_WRN("Channel busy\n");
+					xSemaphoreGive(sNetDev.hLock);
 				}
 			}
+			else
+			{
+				// device is busy, queue the message
+				struct net_req_ent_s sEnt;
+				memset(&sEnt, 0, sizeof(sEnt));
+				sEnt.sReq.pxNetMsg = pxNetMsg;
+				sEnt.sReq.u32TimeOut = u32TimeOut;
+				sEnt.sReq.u32Deadline = NET_MGR_SEND_START_MS;
+				sEnt.sReq.u32SubmitTick = xTaskGetTickCount();
+				sEnt.sReq.eType = NET_REQ_SEND;
+				sEnt.sReq.u16Handle = _net_mgr_req_handle_();
+				sEnt.bSync = 1;
+				sEnt.hOwner = xTaskGetCurrentTaskHandle( );
+				eStatus = _net_mgr_req_push_(&sEnt);
+				if ( eStatus == NET_STATUS_OK )
+				{
+					xTaskNotify(sWizeCtx.hTask, _NET_MGR_REQ_PEND_, eSetBits);
+				}
+			}
+		}
+	}
+	return eStatus;
+}
+
+/*!
+ * @brief This function build in advance the frame of the given message
+ *
+ * @details The frame is built while the device is idle or transmitting, so the
+ * next NetMgr_Send on this message only have to give it to the PHY. It is
+ * refused while the device is listening.
+ *
+ * @param[in] pxNetMsg    Pointer to the message to prepare.
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
+ * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ */
+int32_t NetMgr_Prepare(net_msg_t *pxNetMsg)
+{
+	int32_t eStatus;
+
+	eStatus = NET_STATUS_ERROR;
+	if ( pxNetMsg && pxNetMsg->pData)
+	{
+		if ( pxNetMsg->u8Type >= APP_TYPE_NB )
+		{
+			LOG_ERR("APP type UNKNOWN\n");
+			return eStatus;
+		}
+
+		eStatus = NET_STATUS_BUSY;
+		// check if caller own the NetMgr mutex and device is not listening
+		if ( (sWizeCtx.hCaller == xTaskGetCurrentTaskHandle( ) ) &&
+			 !( _net_mgr_rx_busy_(&sNetDev) && sWizeCtx.eListenType ) )
+		{
+			eStatus = NET_STATUS_ERROR;
+			if ( WizeNet_Prepare(&sNetDev, pxNetMsg) == NETDEV_STATUS_OK )
+			{
+				eStatus = NET_STATUS_OK;
+			}
 		}
 	}
 	return eStatus;
@@ -386,11 +598,57 @@ int32_t NetMgr_Send(net_msg_t *pxNetMsg, uint32_t u32TimeOut)
 int32_t NetMgr_Listen(net_msg_t *pxNetMsg, uint32_t u32TimeOut, net_listen_type_e eListenType)
 {
 	int32_t eStatus;
-	uint32_t tmoCoarse;
-	int16_t tmoFine;
 
-	tmoCoarse = u32TimeOut/1000;
-	tmoFine = u32TimeOut - tmoCoarse*1000;
+	eStatus = NET_STATUS_ERROR;
+	if ( pxNetMsg && pxNetMsg->pData)
+	{
+		if ( pxNetMsg->u8Type >= APP_TYPE_NB )
+		{
+			LOG_ERR("APP type UNKNOWN\n");
+			return eStatus;
+		}
+
+		eStatus = NET_STATUS_BUSY;
+		// check if caller own the NetMgr mutex
+		if (sWizeCtx.hCaller == xTaskGetCurrentTaskHandle( ) )
+		{
+			// try to acquire the Net Dev
+			if ( xSemaphoreTake( sNetDev.hLock, NET_DEV_ACQUIRE_TIMEOUT())  )
+			{
+				eStatus = _net_mgr_start_listen_(pxNetMsg, u32TimeOut, eListenType);
+			}
+		}
+	}
+	return eStatus;
+}
+
+/*!
+ * @brief This function prepare a listen window that start after the given delay
+ *
+ * @details The device is acquired now. The PHY is waked-up the lead time (see
+ * NetMgr_SetRxLead) before the window, then the receiver is armed exactly when
+ * the window start. So, the PHY wake-up and settle time is not taken on the
+ * window itself. A window closer than the lead time, or already passed, wake-up
+ * the PHY now (see NetReq_RxAt). It is busy while a window is already pending,
+ * or while the device is in use. The result is given back as for
+ * NetMgr_Listen.
+ *
+ * @param[in] pxNetMsg    Pointer to the message to listen. The net_msg_t::u8Type
+ *                        field select the filtered message).
+ * @param[in] u32TimeOut  Timeout in millisecond (from the window start)
+ * @param[in] eListenType Listen type define the relationship between the
+ *                        timeout and the received message.
+ * @param[in] u32DelayMs  Delay from now to the window start, in millisecond
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
+ * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ */
+int32_t NetMgr_ListenAt(net_msg_t *pxNetMsg, uint32_t u32TimeOut, net_listen_type_e eListenType, uint32_t u32DelayMs)
+{
+	int32_t eStatus;
+	uint32_t u32WakeMs;
+	uint16_t u16ArmMs;
 
 	eStatus = NET_STATUS_ERROR;
 	if ( pxNetMsg && pxNetMsg->pData)
@@ -405,22 +663,28 @@ int32_t NetMgr_Listen(net_msg_t *pxNetMsg, uint32_t u32TimeOut, net_listen_type_
 		// check if caller own the NetMgr mutex
 		if (sWizeCtx.hCaller == xTaskGetCurrentTaskHandle( ) )
 		{
+			eStatus = NetReq_RxAt(
+				(sWizeCtx.pxRxAtMsg || sWizeCtx.eActive || sWizeCtx.sReqCur.u16Handle),
+				u32DelayMs, sWizeCtx.u16RxLead, &u32WakeMs, &u16ArmMs);
+			if (eStatus != NET_STATUS_OK)
+			{
+				return eStatus;
+			}
 			// try to acquire the Net Dev
+			eStatus = NET_STATUS_BUSY;
 			if ( xSemaphoreTake( sNetDev.hLock, NET_DEV_ACQUIRE_TIMEOUT())  )
 			{
-				sWizeCtx.pBuffDesc = (void*)pxNetMsg;
-				sWizeCtx.u8Type = pxNetMsg->u8Type;
-				sWizeCtx.eListenType = eListenType;
+				sWizeCtx.pxRxAtMsg = pxNetMsg;
+				sWizeCtx.u32RxAtTmo = u32TimeOut;
+				sWizeCtx.eRxAtType = eListenType;
+				sWizeCtx.u16RxAtArm = u16ArmMs;
 
-				// try to listen
-				eStatus = _net_mgr_listen_with_retry_(&sNetDev, sWizeCtx.u8RecvRetries);
-				if ( eStatus == NETDEV_STATUS_OK )
+				eStatus = NET_STATUS_OK;
+				if ( _net_mgr_rx_at_timer_(u32WakeMs, _NET_MGR_RX_WAKE_) )
 				{
-					if ( TimeEvt_TimerStart(&sWizeCtx.sTimeOut, tmoCoarse, tmoFine,	(uint32_t)NETDEV_EVT_TIMEOUT ))
-					{
-						_net_mgr_try_abort_(&sNetDev);
-						eStatus = NET_STATUS_ERROR;
-					}
+					sWizeCtx.pxRxAtMsg = NULL;
+					xSemaphoreGive(sNetDev.hLock);
+					eStatus = NET_STATUS_ERROR;
 				}
 			}
 		}
@@ -428,18 +692,36 @@ int32_t NetMgr_Listen(net_msg_t *pxNetMsg, uint32_t u32TimeOut, net_listen_type_
 	return eStatus;
 }
 
+/*!
+ * @brief This function set the PHY wake-up lead time before a prepared listen
+ * window (see NetMgr_ListenAt)
+ *
+ * @param[in] u16LeadMs Lead time in millisecond
+ *
+ * @return None
+ */
+void NetMgr_SetRxLead(uint16_t u16LeadMs)
+{
+	sWizeCtx.u16RxLead = u16LeadMs;
+}
+
 /*!
  * @brief This function notify that previous listened net_msg_t buffer is no more pending.
  *
+ * @details It is accepted from the task that opened the NetMgr, or from the
+ * task that submitted the current asynchronous request.
+ *
  * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
  * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
  */
 int32_t NetMgr_ListenReady(void)
 {
 	int32_t eStatus;
+	void *hTask = xTaskGetCurrentTaskHandle( );
 	eStatus = NET_STATUS_OK;
-	// check if caller own the NetMgr mutex
-	if (sWizeCtx.hCaller == xTaskGetCurrentTaskHandle( ) )
+	// check if caller own the NetMgr mutex, or the current asynchronous request
+	if ( (sWizeCtx.hCaller == hTask) ||
+		 ( sWizeCtx.sReqCur.u16Handle && (sWizeCtx.hReqOwner == hTask) ) )
 	{
 		xTaskNotify(sWizeCtx.hTask, _NET_MGR_REARM_LISTEN_, eSetBits);
 	}
@@ -450,6 +732,202 @@ int32_t NetMgr_ListenReady(void)
 	return eStatus;
 }
 
+/*!
+ * @brief This function submit an asynchronous send or listen request
+ *
+ * @details The request is queued and started by the net_mgr task as soon as
+ * the device is free. The request handle is returned in pxReq->u16Handle. The
+ * result is given back as one (or several, for a many listen) completion(s),
+ * to get with NetMgr_Complete from any task. The NetMgr must have been opened.
+ *
+ * Pending requests are started on their priority (see @link net_req_prio_e
+ * @endlink), then their deadline, then their submit order. A request not
+ * started before its deadline is completed with NET_EVENT_TIMEOUT. When the
+ * queue is full, a request evicts the lowest priority pending one (completed
+ * with NET_EVENT_ERROR and NET_STATUS_BUSY), if any. A DATA_PRIO send
+ * preempts a lower priority listen window (completed with NET_EVENT_TIMEOUT
+ * and NET_EVENT_PREEMPTED).
+ *
+ * @param[in,out] pxReq Pointer to the request (copied into the queue)
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
+ * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ */
+int32_t NetMgr_Submit(net_req_t *pxReq)
+{
+	int32_t eStatus;
+
+	eStatus = NET_STATUS_ERROR;
+	if ( pxReq && pxReq->pxNetMsg && pxReq->pxNetMsg->pData )
+	{
+		if ( pxReq->pxNetMsg->u8Type >= APP_TYPE_NB )
+		{
+			LOG_ERR("APP type UNKNOWN\n");
+			return eStatus;
+		}
+		if ( (pxReq->eType != NET_REQ_SEND) && (pxReq->eType != NET_REQ_LISTEN) )
+		{
+			return eStatus;
+		}
+
+		eStatus = NET_STATUS_BUSY;
+		// check if NetMgr is opened
+		if (sWizeCtx.hCaller)
+		{
+			struct net_req_ent_s sEnt;
+			pxReq->u16Handle = _net_mgr_req_handle_();
+			pxReq->u32SubmitTick = xTaskGetTickCount();
+			sEnt.sReq = *pxReq;
+			sEnt.bSync = 0;
+			sEnt.hOwner = xTaskGetCurrentTaskHandle( );
+			if ( _net_mgr_req_push_(&sEnt) == NET_STATUS_OK )
+			{
+				xTaskNotify(sWizeCtx.hTask, _NET_MGR_REQ_PEND_, eSetBits);
+				eStatus = NET_STATUS_OK;
+			}
+		}
+	}
+	return eStatus;
+}
+
+/*!
+ * @brief This function get the next asynchronous request completion
+ *
+ * @param[out] pxCpl   Pointer to the completion
+ * @param[in]  u32Wait Time to wait for a completion (in tick)
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
+ * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ */
+int32_t NetMgr_Complete(net_cpl_t *pxCpl, uint32_t u32Wait)
+{
+	int32_t eStatus;
+
+	eStatus = NET_STATUS_ERROR;
+	if ( pxCpl )
+	{
+		eStatus = NET_STATUS_BUSY;
+		if ( xQueueReceive(sWizeCtx.hCplQueue, pxCpl, u32Wait) == pdTRUE )
+		{
+			eStatus = NET_STATUS_OK;
+		}
+	}
+	return eStatus;
+}
+
+/*!
+ * @brief This function configure the retry policy
+ *
+ * @details The default policy retries back to back (fixed strategy without
+ * delay), as many times as the number of retries set by NetMgr_Ioctl.
+ *
+ * @param[in] pCfg Pointer to the retry policy configuration
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
+ */
+int32_t NetMgr_SetRetry(const struct net_retry_cfg_s *pCfg)
+{
+	int32_t i32Ret;
+	taskENTER_CRITICAL();
+	i32Ret = NetRetry_Config(&(sWizeCtx.sRetry), pCfg);
+	taskEXIT_CRITICAL();
+	return (i32Ret)?(NET_STATUS_ERROR):(NET_STATUS_OK);
+}
+
+/*!
+ * @brief This function get the retry statistics
+ *
+ * @param[out] pStats Pointer to the statistics
+ * @param[in]  bClear Clear the statistics
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
+ */
+int32_t NetMgr_GetRetryStats(struct net_retry_stats_s *pStats, uint8_t bClear)
+{
+	if ( !pStats )
+	{
+		return NET_STATUS_ERROR;
+	}
+	taskENTER_CRITICAL();
+	*pStats = sWizeCtx.sRetry.sStats;
+	if (bClear)
+	{
+		memset(&(sWizeCtx.sRetry.sStats), 0, sizeof(struct net_retry_stats_s));
+	}
+	taskEXIT_CRITICAL();
+	return NET_STATUS_OK;
+}
+
+/*!
+ * @brief This function get the pending request statistics
+ *
+ * @details Wait times are given in tick, from the submit to the start of the
+ * request.
+ *
+ * @param[out] pStats Pointer to the statistics
+ * @param[in]  bClear Clear the statistics (except the current depth)
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
+ */
+int32_t NetMgr_GetReqStats(struct net_req_stats_s *pStats, uint8_t bClear)
+{
+	uint8_t u8Depth;
+	if ( !pStats )
+	{
+		return NET_STATUS_ERROR;
+	}
+	taskENTER_CRITICAL();
+	*pStats = sWizeCtx.sReqQueue.sStats;
+	if (bClear)
+	{
+		u8Depth = sWizeCtx.sReqQueue.sStats.u8Depth;
+		memset(&(sWizeCtx.sReqQueue.sStats), 0, sizeof(struct net_req_stats_s));
+		sWizeCtx.sReqQueue.sStats.u8Depth = u8Depth;
+		sWizeCtx.sReqQueue.sStats.u8DepthMax = u8Depth;
+	}
+	taskEXIT_CRITICAL();
+	return NET_STATUS_OK;
+}
+
+/*!
+ * @brief This function get a snapshot of the trace ring
+ *
+ * @details The last records (at most u32Nb) are copied, the oldest first. The
+ * sequence number of the first copied record is given back, so that records
+ * lost between two snapshots can be detected.
+ *
+ * @param[out] pxTrace Pointer to the records buffer
+ * @param[in]  u32Nb   Number of records in the buffer
+ * @param[out] pu32Seq Sequence number of the first copied record (may be NULL)
+ *
+ * @return The number of copied records
+ */
+uint32_t NetMgr_TraceGet(net_trace_t *pxTrace, uint32_t u32Nb, uint32_t *pu32Seq)
+{
+	uint32_t u32Ret;
+	taskENTER_CRITICAL();
+	u32Ret = NetTrace_Get(&sTrace, pxTrace, u32Nb, pu32Seq);
+	taskEXIT_CRITICAL();
+	return u32Ret;
+}
+
+/*!
+ * @brief This function clear the trace ring
+ *
+ * @return None
+ */
+void NetMgr_TraceClear(void)
+{
+	taskENTER_CRITICAL();
+	memset(&sTrace, 0, sizeof(sTrace));
+	taskEXIT_CRITICAL();
+}
+
 /******************************************************************************/
 /*!
  * @static
@@ -464,6 +942,7 @@ static void _net_mgr_main_(void const * argument)
 {
 	uint32_t u32Evt;
 	uint32_t u32BackEvt;
+	uint32_t u32Route;
 	uint8_t bAbort = 0;
 	uint8_t bError = 0;
 
@@ -474,7 +953,8 @@ static void _net_mgr_main_(void const * argument)
 		bAbort = 0;
 
 		// waiting for event : timeout ...
-		if ( xTaskNotifyWait(0, ULONG_MAX, &u32Evt, NET_MGR_EVT_TIMEOUT()) == 1 )
+		if ( ( xTaskNotifyWait(0, ULONG_MAX, &u32Evt, NET_MGR_EVT_TIMEOUT()) == 1 ) &&
+			 ( u32Evt & ~_NET_MGR_REQ_PEND_ ) )
 		{
 			// Treat NetDev state
 			switch (sNetDev.eState)
@@ -525,21 +1005,41 @@ static void _net_mgr_main_(void const * argument)
 
 		if (bAbort)
 		{
-			// Abort the current request
-			if ( _net_mgr_try_abort_(&sNetDev) )
+			// Abort the current request, on the PHY that own it
+			u32Route = _net_mgr_phy_route_();
+			if ( _net_mgr_try_abort_(&sNetDev, u32Route) )
 			{
 				// ulBckFlag = NET_EVT_FATAL;
 			}
-			WizeNet_Ioctl(&sNetDev, NETDEV_CTL_PHY_CMD, PHY_CTL_CMD_SLEEP);
+			WizeNet_Ioctl(&sNetDev, NETDEV_CTL_PHY_CMD | u32Route, PHY_CTL_CMD_SLEEP);
 		}
 
-		// send back notify to the caller
-		_net_mgr_notify_caller_(u32BackEvt);
+		// the current send or listen is over
+		if ( bError || bAbort ||
+			 ( u32BackEvt & (NET_EVENT_SEND_DONE | NET_EVENT_TIMEOUT | NET_EVENT_ERROR) ) ||
+			 ( (u32BackEvt & NET_EVENT_RECV_DONE) && (sWizeCtx.eListenType != NET_LISTEN_TYPE_MANY) ) )
+		{
+			sWizeCtx.eActive = 0;
+			_net_mgr_retry_cancel_();
+		}
+
+		// send back notify to the caller or complete the asynchronous request
+		if (sWizeCtx.sReqCur.u16Handle)
+		{
+			_net_mgr_complete_(u32BackEvt, (bError || bAbort));
+		}
+		else
+		{
+			_net_mgr_notify_caller_(u32BackEvt);
+		}
 
 		if (bError || bAbort)
 		{
 			xSemaphoreGive(sNetDev.hLock);
 		}
+
+		// start the next asynchronous request, if any
+		_net_mgr_next_req_();
 	}
 }
 
@@ -554,8 +1054,24 @@ static void _net_mgr_main_(void const * argument)
 static void _net_mgr_evtCb_(uint32_t evt)
 {
 	BaseType_t xHigherPriorityTaskWoken;
-	xTaskNotifyFromISR(sWizeCtx.hTask, evt, eSetBits, &xHigherPriorityTaskWoken );
-	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+#if NET_MGR_TRACE_NB
+	// time stamp the event here, not when the task treats it
+	uint32_t u32Us = NET_MGR_TRACE_NOW_ISR();
+	if (evt & NETDEV_EVT_RX_STARTED)
+	{
+		sTrace.u32RxStartUs = u32Us;
+	}
+	if (evt & NETDEV_EVT_RX_COMPLETE)
+	{
+		sTrace.u32RxEndUs = u32Us;
+	}
+	if (evt & NETDEV_EVT_TX_COMPLETE)
+	{
+		sTrace.u32TxEndUs = u32Us;
+	}
+#endif
+	xTaskNotifyFromISR(sWizeCtx.hTask, evt, eSetBits, &xHigherPriorityTaskWoken );
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
 }
 
 /*!
@@ -577,6 +1093,114 @@ static inline void _net_mgr_notify_caller_(uint32_t evt)
 	}
 }
 
+/*!
+ * @static
+ * @brief Push the completion of the current asynchronous request
+ *
+ * @param [in] u32BackEvt Events of the current request
+ * @param [in] bEnd       Force the request to end (error or abort)
+ *
+ * @return      None
+ */
+static void _net_mgr_complete_(uint32_t u32BackEvt, uint8_t bEnd)
+{
+	net_cpl_t sCpl;
+
+	if ( !NetReq_Complete(&(sWizeCtx.sReqCur), u32BackEvt, bEnd, &sCpl) )
+	{
+		// nothing to complete
+		return;
+	}
+	sCpl.u32StartTick = sWizeCtx.u32ReqStartTick;
+	sCpl.u32EndTick = xTaskGetTickCount();
+
+	if (sWizeCtx.bReqSync)
+	{
+		// queued synchronous send, the caller wait for the notification
+		_net_mgr_notify_caller_(u32BackEvt);
+	}
+	else if ( xQueueSend(sWizeCtx.hCplQueue, &sCpl, 0) != pdTRUE )
+	{
+		LOG_WRN("Completion dropped\n");
+	}
+	if (sCpl.bLast)
+	{
+		NET_MGR_TRACE(NET_TRACE_REQ_END, sWizeCtx.sReqCur.u16Handle);
+		sWizeCtx.sReqCur.u16Handle = 0;
+		sWizeCtx.bReqSync = 0;
+	}
+}
+
+/*!
+ * @static
+ * @brief Start the next asynchronous request, if the device is free
+ *
+ * @return      None
+ */
+static void _net_mgr_next_req_(void)
+{
+	int32_t eStatus;
+	uint32_t u32Now, u32Wait;
+	struct net_req_ent_s sEnt;
+	struct net_req_wait_s *pWait;
+
+	while ( !(sWizeCtx.sReqCur.u16Handle) && sWizeCtx.sReqQueue.u8Nb )
+	{
+		// device is used by a synchronous request, wait until it is released
+		if ( !xSemaphoreTake( sNetDev.hLock, NET_DEV_ACQUIRE_TIMEOUT()) )
+		{
+			break;
+		}
+		if ( !_net_mgr_req_pop_(&sEnt) )
+		{
+			xSemaphoreGive(sNetDev.hLock);
+			break;
+		}
+		u32Now = xTaskGetTickCount();
+		if ( NetReq_Expired(&sEnt, u32Now) )
+		{
+			// too late
+			taskENTER_CRITICAL();
+			sWizeCtx.sReqQueue.sStats.u32Expired++;
+			taskEXIT_CRITICAL();
+			_net_mgr_req_drop_(&sEnt, NET_EVENT_TIMEOUT, NET_STATUS_ERROR);
+			xSemaphoreGive(sNetDev.hLock);
+			continue;
+		}
+		u32Wait = u32Now - sEnt.sReq.u32SubmitTick;
+		taskENTER_CRITICAL();
+		pWait = &(sWizeCtx.sReqQueue.sStats.aWait[sEnt.u8Prio]);
+		pWait->u32Nb++;
+		pWait->u32SumTick += u32Wait;
+		if (u32Wait > pWait->u32MaxTick)
+		{
+			pWait->u32MaxTick = u32Wait;
+		}
+		taskEXIT_CRITICAL();
+
+		sWizeCtx.sReqCur = sEnt.sReq;
+		sWizeCtx.bReqSync = sEnt.bSync;
+		sWizeCtx.hReqOwner = sEnt.hOwner;
+		sWizeCtx.u32ReqStartTick = u32Now;
+		NET_MGR_TRACE(NET_TRACE_REQ_START, sWizeCtx.sReqCur.u16Handle);
+
+		if (sWizeCtx.sReqCur.eType == NET_REQ_SEND)
+		{
+			eStatus = _net_mgr_start_send_(sWizeCtx.sReqCur.pxNetMsg, sWizeCtx.sReqCur.u32TimeOut);
+		}
+		else
+		{
+			eStatus = _net_mgr_start_listen_(sWizeCtx.sReqCur.pxNetMsg, sWizeCtx.sReqCur.u32TimeOut, sWizeCtx.sReqCur.eListenType);
+		}
+
+		if ( eStatus != NET_STATUS_OK )
+		{
+			_net_mgr_complete_(NET_EVENT_ERROR, 1);
+			xSemaphoreGive(sNetDev.hLock);
+		}
+	}
+}
+
 /******************************************************************************/
 
 /*!
@@ -600,27 +1224,83 @@ static uint32_t _net_mgr_fsm_(netdev_t *pNetDev, uint32_t u32Evt)
 	net_msg_t *pxNetMsg;
 
 	u32BackEvt = NET_EVENT_SUCCESS;
+
+	if ( u32Evt & (_NET_MGR_RX_WAKE_ | _NET_MGR_RX_ARM_) )
+	{
+		u32BackEvt |= _net_mgr_rx_at_(pNetDev, u32Evt);
+	}
 	pxNetMsg = (net_msg_t*)(sWizeCtx.pBuffDesc);
 
+	if (u32Evt & _NET_MGR_PREEMPT_)
+	{
+		// still a lower priority listen, and no frame on the way
+		if ( (sWizeCtx.eActive == NET_REQ_LISTEN) &&
+			 (sWizeCtx.u8ReqPrio > NET_REQ_PRIO_ALARM) &&
+			 !(sWizeCtx.u8Detected) )
+		{
+			TimeEvt_TimerStop(&sWizeCtx.sTimeOut);
+			u32BackEvt |= NET_EVENT_TIMEOUT | NET_EVENT_PREEMPTED;
+			NET_MGR_TRACE(NET_TRACE_PREEMPT, sWizeCtx.u8ReqPrio);
+			taskENTER_CRITICAL();
+			sWizeCtx.sReqQueue.sStats.u32Preempted++;
+			taskEXIT_CRITICAL();
+			return u32BackEvt;
+		}
+	}
+
+	if (u32Evt & _NET_MGR_RETRY_)
+	{
+		eStatus = NETDEV_STATUS_OK;
+		NET_MGR_TRACE(NET_TRACE_RETRY_AT, sWizeCtx.eRetryOp);
+		if (sWizeCtx.eRetryOp == NET_REQ_SEND)
+		{
+			sWizeCtx.eRetryOp = 0;
+			eStatus = _net_mgr_send_try_(pNetDev, pxNetMsg);
+		}
+		else if (sWizeCtx.eRetryOp == NET_REQ_LISTEN)
+		{
+			sWizeCtx.eRetryOp = 0;
+			eStatus = _net_mgr_listen_try_(pNetDev);
+		}
+		// else, canceled
+		if ( eStatus != NETDEV_STATUS_OK )
+		{
+			// Stop time event
+			TimeEvt_TimerStop(&sWizeCtx.sTimeOut);
+			// request failed, cancel the session
+			u32BackEvt = NET_EVENT_ERROR;
+			return u32BackEvt;
+		}
+	}
+
 	if(u32Evt & _NET_MGR_REARM_LISTEN_)
 	{
 		sWizeCtx.bListenPend = 0;
+		// deliver the next frame already waiting in the reception ring
+		if ( (sWizeCtx.eListenType == NET_LISTEN_TYPE_MANY) &&
+			 _net_mgr_rx_busy_(pNetDev) )
+		{
+			u32BackEvt |= _net_mgr_drain_ring_(pNetDev, pxNetMsg);
+		}
 	}
 
 	if (u32Evt & NETDEV_EVT_TX_COMPLETE)
 	{
+		NET_MGR_TRACE_AT(sTrace.u32TxEndUs, NET_TRACE_TX_COMPLETE, 0);
 		TimeEvt_TimerStop(&sWizeCtx.sTimeOut);
-		WizeNet_Ioctl(&sNetDev, NETDEV_CTL_PHY_CMD, PHY_CTL_CMD_SLEEP);
+		// only the TX one, the RX PHY may be another one
+		WizeNet_Ioctl(&sNetDev, NETDEV_CTL_PHY_CMD | NETDEV_CTL_PHY_TX, PHY_CTL_CMD_SLEEP);
 		xSemaphoreGive(sNetDev.hLock);
 		u32BackEvt |= NET_EVENT_SEND_DONE;
 		LOG_FRM_OUT(
-				((wize_net_t*)sNetDev.pCtx)->aSendBuff,
-				((wize_net_t*)sNetDev.pCtx)->aSendBuff[0]+1
+				((wize_net_t*)sNetDev.pCtx)->pSendBuff,
+				((wize_net_t*)sNetDev.pCtx)->pSendBuff[0]+1
 				);
 	}
 
 	if(u32Evt & NETDEV_EVT_RX_STARTED)
 	{
+		NET_MGR_TRACE_AT(sTrace.u32RxStartUs, NET_TRACE_RX_STARTED, 0);
 		if (sWizeCtx.eListenType == NET_LISTEN_TYPE_DETECT)
 		{
 			sWizeCtx.u8Detected |= 0x01;
@@ -629,17 +1309,44 @@ static uint32_t _net_mgr_fsm_(netdev_t *pNetDev, uint32_t u32Evt)
 
 	if(u32Evt & NETDEV_EVT_RX_COMPLETE)
 	{
-		// ensure to not overwriting net_msg_t buffer
-		if ( sWizeCtx.bListenPend && sWizeCtx.eListenType == NET_LISTEN_TYPE_MANY)
+		NET_MGR_TRACE_AT(sTrace.u32RxEndUs, NET_TRACE_RX_COMPLETE, 0);
+		if (sWizeCtx.eListenType == NET_LISTEN_TYPE_MANY)
 		{
-			// try to listen again
-			eStatus = _net_mgr_listen_with_retry_(pNetDev, sWizeCtx.u8RecvRetries);
-			if ( eStatus != NETDEV_STATUS_OK )
+			// capture the frame into the reception ring, so the net_msg_t
+			// buffer is never overwritten while the caller is processing it
+			eStatus = WizeNet_Capture(pNetDev);
+			if ( eStatus == NETDEV_STATUS_BUSY )
 			{
-				// Stop time event
-				TimeEvt_TimerStop(&sWizeCtx.sTimeOut);
-				// request failed, cancel the session
-				u32BackEvt = NET_EVENT_ERROR;
+				NET_MGR_TRACE(NET_TRACE_FRM_DROPPED, 0);
+				LOG_WRN("Frame dropped\n");
+			}
+			else if ( eStatus == NETDEV_STATUS_ERROR )
+			{
+				if (_net_mgr_error_(pNetDev))
+				{
+					//abort
+					// Stop time event
+					TimeEvt_TimerStop(&sWizeCtx.sTimeOut);
+					// request failed, cancel the session
+					u32BackEvt = NET_EVENT_TIMEOUT;
+				}
+			}
+
+			if ( !(u32BackEvt & NET_EVENT_TIMEOUT) )
+			{
+				// try to listen again
+				eStatus = _net_mgr_listen_with_retry_(pNetDev, sWizeCtx.u8RecvRetries);
+				if ( eStatus != NETDEV_STATUS_OK )
+				{
+					// Stop time event
+					TimeEvt_TimerStop(&sWizeCtx.sTimeOut);
+					// request failed, cancel the session
+					u32BackEvt = NET_EVENT_ERROR;
+				}
+				else if ( !(sWizeCtx.bListenPend) )
+				{
+					u32BackEvt |= _net_mgr_drain_ring_(pNetDev, pxNetMsg);
+				}
 			}
 		}
 		else
@@ -649,28 +1356,11 @@ static uint32_t _net_mgr_fsm_(netdev_t *pNetDev, uint32_t u32Evt)
 			{
 				if (pxNetMsg->u8Type == sWizeCtx.u8Type)
 				{
-					if (sWizeCtx.eListenType == NET_LISTEN_TYPE_MANY)
-					{
-						eStatus = _net_mgr_listen_with_retry_(pNetDev, sWizeCtx.u8RecvRetries);
-						if ( eStatus != NETDEV_STATUS_OK )
-						{
-							// Stop time event
-							TimeEvt_TimerStop(&sWizeCtx.sTimeOut);
-							// request failed, cancel the session
-							u32BackEvt = NET_EVENT_ERROR;
-						}
-						else
-						{
-							sWizeCtx.bListenPend = 1;
-						}
-					}
-					else
-					{
-						// Stop time event
-						TimeEvt_TimerStop(&sWizeCtx.sTimeOut);
-						xSemaphoreGive(sNetDev.hLock);
-					}
+					// Stop time event
+					TimeEvt_TimerStop(&sWizeCtx.sTimeOut);
+					xSemaphoreGive(sNetDev.hLock);
 					u32BackEvt |= NET_EVENT_RECV_DONE;
+					NET_MGR_TRACE(NET_TRACE_RECV_DONE, pxNetMsg->u8Type);
 					LOG_FRM_IN(
 							((wize_net_t*)sNetDev.pCtx)->aRecvBuff,
 							((wize_net_t*)sNetDev.pCtx)->aRecvBuff[0]+1
@@ -679,7 +1369,11 @@ static uint32_t _net_mgr_fsm_(netdev_t *pNetDev, uint32_t u32Evt)
 				else // received message doesn't match
 				{
 					// try to listen again
-					eStatus = _net_mgr_listen_with_retry_(pNetDev, sWizeCtx.u8RecvRetries);
+					eStatus = NETDEV_STATUS_ERROR;
+					if ( _net_mgr_retry_next_(pNetDev, NET_RETRY_OUT_PASSED) >= 0 )
+					{
+						eStatus = _net_mgr_listen_with_retry_(pNetDev, sWizeCtx.u8RecvRetries);
+					}
 					if ( eStatus != NETDEV_STATUS_OK )
 					{
 						// Stop time event
@@ -688,6 +1382,7 @@ static uint32_t _net_mgr_fsm_(netdev_t *pNetDev, uint32_t u32Evt)
 						u32BackEvt = NET_EVENT_ERROR;
 					}
 					u32BackEvt |= NET_EVENT_FRM_PASSED;
+					NET_MGR_TRACE(NET_TRACE_FRM_PASSED, pxNetMsg->u8Type);
 				}
 			}
 			else
@@ -703,7 +1398,11 @@ static uint32_t _net_mgr_fsm_(netdev_t *pNetDev, uint32_t u32Evt)
 				else
 				{
 					// try to listen again
-					eStatus = _net_mgr_listen_with_retry_(pNetDev, sWizeCtx.u8RecvRetries);
+					eStatus = NETDEV_STATUS_ERROR;
+					if ( _net_mgr_retry_next_(pNetDev, NET_RETRY_OUT_FRM_ERR) >= 0 )
+					{
+						eStatus = _net_mgr_listen_with_retry_(pNetDev, sWizeCtx.u8RecvRetries);
+					}
 					if ( eStatus != NETDEV_STATUS_OK )
 					{
 						// Stop time event
@@ -735,6 +1434,7 @@ static uint32_t _net_mgr_fsm_(netdev_t *pNetDev, uint32_t u32Evt)
 
 	if (u32Evt & NETDEV_EVT_TIMEOUT)
 	{
+		NET_MGR_TRACE(NET_TRACE_TIMEOUT, 0);
 		if (sWizeCtx.eListenType == NET_LISTEN_TYPE_DETECT)
 		{
 			// check if we have already expand the timeout or detected starting frame
@@ -747,6 +1447,7 @@ static uint32_t _net_mgr_fsm_(netdev_t *pNetDev, uint32_t u32Evt)
 			{
 				// set expand timeout
 				sWizeCtx.u8Detected = _NET_MGR_EXPAND_TMO_MSK_;
+				NET_MGR_TRACE(NET_TRACE_TMO_EXPAND, sWizeCtx.i16ExpandTmo);
 				if ( TimeEvt_TimerStart(
 						&sWizeCtx.sTimeOut,
 						0, sWizeCtx.i16ExpandTmo,
@@ -765,7 +1466,7 @@ static uint32_t _net_mgr_fsm_(netdev_t *pNetDev, uint32_t u32Evt)
 		/*
 		if( u32BackEvt & (NET_EVENT_ERROR | NET_EVENT_TIMEOUT) )
 		{
-			_net_mgr_try_abort_(pNetDev);
+			_net_mgr_try_abort_(pNetDev, _net_mgr_phy_route_());
 			WizeNet_Sleep(pNetDev);
 		}
 		*/
@@ -774,10 +1475,209 @@ static uint32_t _net_mgr_fsm_(netdev_t *pNetDev, uint32_t u32Evt)
 	return u32BackEvt;
 }
 
+/*!
+ * @static
+ * @brief Internal function to extract frames from the reception ring until one
+ * match the expected type
+ *
+ * @param[in] pNetDev  Pointer to NetDev device
+ * @param[in] pxNetMsg Pointer to the message that will hold the frame
+ *
+ * @retval NET_EVENT_NONE (see @link net_event_e::NET_EVENT_NONE @endlink)
+ * @retval NET_EVENT_RECV_DONE (see @link net_event_e::NET_EVENT_RECV_DONE @endlink)
+ * @retval NET_EVENT_FRM_PASSED (see @link net_event_e::NET_EVENT_FRM_PASSED @endlink)
+ */
+static uint32_t _net_mgr_drain_ring_(netdev_t *pNetDev, net_msg_t *pxNetMsg)
+{
+	uint32_t u32BackEvt = NET_EVENT_NONE;
+	wize_net_t *pCtx = (wize_net_t*)pNetDev->pCtx;
+
+	while ( WizeNet_Ioctl(pNetDev, NETDEV_CTL_GET_RECV_NB, 0) > 0 )
+	{
+		if ( WizeNet_Recv(pNetDev, pxNetMsg) == NETDEV_STATUS_OK )
+		{
+			if (pxNetMsg->u8Type == sWizeCtx.u8Type)
+			{
+				sWizeCtx.bListenPend = 1;
+				u32BackEvt |= NET_EVENT_RECV_DONE;
+				LOG_FRM_IN(
+						pCtx->sProtoCtx.pBuffer,
+						pCtx->sProtoCtx.pBuffer[0]+1
+						);
+				break;
+			}
+			u32BackEvt |= NET_EVENT_FRM_PASSED;
+		}
+		else
+		{
+			// protocol error, just show and clear it
+			_net_mgr_error_(pNetDev);
+		}
+	}
+	return u32BackEvt;
+}
+
+/*!
+ * @static
+ * @brief Internal function to start a send, the device must be acquired
+ *
+ * @param[in] pxNetMsg   Pointer to the message to send
+ * @param[in] u32TimeOut Timeout in millisecond
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
+ * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ */
+static int32_t _net_mgr_start_send_(net_msg_t *pxNetMsg, uint32_t u32TimeOut)
+{
+	int32_t eStatus;
+	uint32_t tmoCoarse;
+	int16_t tmoFine;
+
+	tmoCoarse = u32TimeOut/1000;
+	tmoFine = u32TimeOut - tmoCoarse*1000;
+
+	sWizeCtx.pBuffDesc = (void*)pxNetMsg;
+	sWizeCtx.u8Type = pxNetMsg->u8Type;
+	sWizeCtx.eListenType = 0;
+
+	// try to send
+	eStatus = _net_mgr_send_with_retry_(&sNetDev, pxNetMsg, sWizeCtx.u8TransRetries);
+	NET_MGR_TRACE(NET_TRACE_SEND_START, eStatus);
+	if ( eStatus == NETDEV_STATUS_OK )
+	{
+		sWizeCtx.u8ReqPrio = NetReq_Prio(pxNetMsg->u8Type);
+		sWizeCtx.eActive = NET_REQ_SEND;
+		if ( TimeEvt_TimerStart(&sWizeCtx.sTimeOut, tmoCoarse, tmoFine,	(uint32_t)NETDEV_EVT_TIMEOUT ))
+		{
+			_net_mgr_try_abort_(&sNetDev, NETDEV_CTL_PHY_TX);
+			eStatus = NET_STATUS_ERROR;
+		}
+	}
+	return eStatus;
+}
+
+/*!
+ * @static
+ * @brief Internal function to start a listen, the device must be acquired
+ *
+ * @param[in] pxNetMsg    Pointer to the message to listen
+ * @param[in] u32TimeOut  Timeout in millisecond
+ * @param[in] eListenType Listen type
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
+ * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ */
+static int32_t _net_mgr_start_listen_(net_msg_t *pxNetMsg, uint32_t u32TimeOut, net_listen_type_e eListenType)
+{
+	int32_t eStatus;
+	uint32_t tmoCoarse;
+	int16_t tmoFine;
+
+	tmoCoarse = u32TimeOut/1000;
+	tmoFine = u32TimeOut - tmoCoarse*1000;
+
+	sWizeCtx.pBuffDesc = (void*)pxNetMsg;
+	sWizeCtx.u8Type = pxNetMsg->u8Type;
+	sWizeCtx.eListenType = eListenType;
+
+	// frames left from a previous window are no more relevant
+	WizeNet_Ioctl(&sNetDev, NETDEV_CTL_FLUSH_RECV, 0);
+
+	// try to listen
+	eStatus = _net_mgr_listen_with_retry_(&sNetDev, sWizeCtx.u8RecvRetries);
+	NET_MGR_TRACE(NET_TRACE_LISTEN_START, eStatus);
+	if ( eStatus == NETDEV_STATUS_OK )
+	{
+		sWizeCtx.u8ReqPrio = NetReq_Prio(pxNetMsg->u8Type);
+		sWizeCtx.eActive = NET_REQ_LISTEN;
+		if ( TimeEvt_TimerStart(&sWizeCtx.sTimeOut, tmoCoarse, tmoFine,	(uint32_t)NETDEV_EVT_TIMEOUT ))
+		{
+			_net_mgr_try_abort_(&sNetDev, NETDEV_CTL_PHY_RX);
+			eStatus = NET_STATUS_ERROR;
+		}
+	}
+	return eStatus;
+}
+
+/*!
+ * @static
+ * @brief Internal function to start the prepared listen timer
+ *
+ * @param[in] u32DelayMs Delay in millisecond (0 to notify the event now)
+ * @param[in] u32Event   Event to notify
+ *
+ * @retval 0 Success
+ * @retval 1 Failed
+ */
+static uint8_t _net_mgr_rx_at_timer_(uint32_t u32DelayMs, uint32_t u32Event)
+{
+	if ( !u32DelayMs )
+	{
+		xTaskNotify(sWizeCtx.hTask, u32Event, eSetBits);
+		return 0;
+	}
+	return TimeEvt_TimerStart(&sWizeCtx.sRxAt, u32DelayMs/1000, (int16_t)(u32DelayMs%1000), u32Event);
+}
+
+/*!
+ * @static
+ * @brief Internal function to treat the prepared listen events : wake-up the
+ * PHY, then arm the receiver
+ *
+ * @param[in] pNetDev Pointer to NetDev device
+ * @param[in] u32Evt  Input events
+ *
+ * @retval NET_EVENT_NONE (see @link net_event_e::NET_EVENT_NONE @endlink)
+ * @retval NET_EVENT_ERROR (see @link net_event_e::NET_EVENT_ERROR @endlink)
+ */
+static uint32_t _net_mgr_rx_at_(netdev_t *pNetDev, uint32_t u32Evt)
+{
+	uint32_t u32BackEvt = NET_EVENT_NONE;
+
+	if ( !(sWizeCtx.pxRxAtMsg) )
+	{
+		// canceled
+		return u32BackEvt;
+	}
+
+	if (u32Evt & _NET_MGR_RX_WAKE_)
+	{
+		NET_MGR_TRACE(NET_TRACE_RX_WAKE, 0);
+		// On failure, the wake-up will be done by the listen itself
+		WizeNet_Ioctl(pNetDev, NETDEV_CTL_PHY_CMD | NETDEV_CTL_PHY_RX, PHY_CTL_CMD_READY);
+		if ( _net_mgr_rx_at_timer_(sWizeCtx.u16RxAtArm, _NET_MGR_RX_ARM_) )
+		{
+			u32Evt |= _NET_MGR_RX_ARM_;
+		}
+	}
+
+	if (u32Evt & _NET_MGR_RX_ARM_)
+	{
+		NET_MGR_TRACE(NET_TRACE_RX_ARM, 0);
+		if ( _net_mgr_start_listen_(sWizeCtx.pxRxAtMsg, sWizeCtx.u32RxAtTmo, sWizeCtx.eRxAtType) != NET_STATUS_OK )
+		{
+			u32BackEvt = NET_EVENT_ERROR;
+		}
+		sWizeCtx.pxRxAtMsg = NULL;
+	}
+	return u32BackEvt;
+}
+
 /*!
  * @static
  * @brief Internal function to send the given message with retry
  *
+ * @details When the channel is busy, the send is tried again after the backoff
+ * given by the net device, until it gives up. These attempts don't consume the
+ * retries. Otherwise, the retry policy gives the delay before the next attempt
+ * or gives up (see NetMgr_SetRetry).
+ *
+ * In the net_mgr task, a delayed attempt is scheduled on a timer (see
+ * _net_mgr_retry_at_) and NET_STATUS_OK returned, so the task keeps treating
+ * its events meanwhile.
+ *
  * @param[in] pNetDev  Pointer to device to send the message
  * @param[in] pxNetMsg Pointer to the message to send
  * @param[in] u8Retry  Number of retry
@@ -785,55 +1685,148 @@ static uint32_t _net_mgr_fsm_(netdev_t *pNetDev, uint32_t u32Evt)
  * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
  * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
  * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ * @retval NET_STATUS_DUTY (see @link net_status_e::NET_STATUS_DUTY @endlink)
+ * @retval NET_STATUS_CCA (see @link net_status_e::NET_STATUS_CCA @endlink)
  */
 static int32_t _net_mgr_send_with_retry_(netdev_t *pNetDev, net_msg_t *pxNetMsg, uint8_t u8Retry)
+{
+	NetRetry_Start(&(sWizeCtx.sRetry), NET_RETRY_OP_TX, u8Retry);
+	return _net_mgr_send_try_(pNetDev, pxNetMsg);
+}
+
+/*!
+ * @static
+ * @brief Internal function to listen for message with retry
+ *
+ * @details In the net_mgr task, a delayed attempt is scheduled on a timer (see
+ * _net_mgr_retry_at_) and NET_STATUS_OK returned.
+ *
+ * @param[in] pNetDev  Pointer to device to listen the message
+ * @param[in] u8Retry  Number of retry
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
+ * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ */
+static int32_t _net_mgr_listen_with_retry_(netdev_t *pNetDev, uint8_t u8Retry)
+{
+	NetRetry_Start(&(sWizeCtx.sRetry), NET_RETRY_OP_RX, u8Retry);
+	return _net_mgr_listen_try_(pNetDev);
+}
+
+/*!
+ * @static
+ * @brief Internal function to try (again) to send, in the current retry
+ * operation
+ *
+ * @param[in] pNetDev  Pointer to device to send the message
+ * @param[in] pxNetMsg Pointer to the message to send
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
+ * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ * @retval NET_STATUS_DUTY (see @link net_status_e::NET_STATUS_DUTY @endlink)
+ * @retval NET_STATUS_CCA (see @link net_status_e::NET_STATUS_CCA @endlink)
+ */
+static int32_t _net_mgr_send_try_(netdev_t *pNetDev, net_msg_t *pxNetMsg)
 {
 	int32_t eStatus = NETDEV_STATUS_OK;
+	int32_t i32Backoff;
+	int32_t i32Delay;
+	int32_t i32Ret;
+	uint8_t eOut;
+
 	do {
 		// try to send
 		eStatus = WizeNet_Send(pNetDev, pxNetMsg);
 		if ( eStatus == NETDEV_STATUS_OK )
 		{
+			NetRetry_Done(&(sWizeCtx.sRetry));
 			break; // everything is fine
 		}
+		else if ( eStatus == NETDEV_STATUS_DUTY)
+		{
+			break; // retry will not help
+		}
+		else if ( eStatus == NETDEV_STATUS_CCA)
+		{
+			i32Backoff = WizeNet_Ioctl(pNetDev, NETDEV_CTL_GET_BACKOFF, 0);
+			if (i32Backoff <= 0)
+			{
+				break; // give up
+			}
+			NET_MGR_TRACE(NET_TRACE_CCA_BACKOFF, i32Backoff);
+			i32Ret = _net_mgr_retry_at_(NET_REQ_SEND, i32Backoff);
+			if (i32Ret > 0)
+			{
+				eStatus = NETDEV_STATUS_OK;
+			}
+			if (i32Ret)
+			{
+				break; // scheduled, or give up
+			}
+			continue;
+		}
 		else if ( eStatus == NETDEV_STATUS_ERROR)
 		{
 			// get error
 			if ( _net_mgr_error_(pNetDev) )
 			{
 				// try to abort the current Net Device Action
-				_net_mgr_try_abort_(pNetDev);
+				_net_mgr_try_abort_(pNetDev, NETDEV_CTL_PHY_TX);
 			}
+			eOut = NET_RETRY_OUT_ERROR;
 		}
-		// else // NET_STATUS_BUSY
-		if (!u8Retry)
+		else // NET_STATUS_BUSY
 		{
-			break;
+			eOut = NET_RETRY_OUT_BUSY;
+		}
+		i32Delay = _net_mgr_retry_next_(pNetDev, eOut);
+		if (i32Delay < 0)
+		{
+			break; // give up
+		}
+		NET_MGR_TRACE(NET_TRACE_SEND_RETRY, eStatus);
+		if (i32Delay)
+		{
+			i32Ret = _net_mgr_retry_at_(NET_REQ_SEND, i32Delay);
+			if (i32Ret > 0)
+			{
+				eStatus = NETDEV_STATUS_OK;
+			}
+			if (i32Ret)
+			{
+				break; // scheduled, or give up
+			}
 		}
-		u8Retry--;
 	} while (1);
 	return eStatus;
 }
 
 /*!
  * @static
- * @brief Internal function to listen for message with retry
+ * @brief Internal function to try (again) to listen, in the current retry
+ * operation
  *
  * @param[in] pNetDev  Pointer to device to listen the message
- * @param[in] u8Retry  Number of retry
  *
  * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
  * @retval NET_STATUS_ERROR (see @link net_status_e::NET_STATUS_ERROR @endlink)
  * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
  */
-static int32_t _net_mgr_listen_with_retry_(netdev_t *pNetDev, uint8_t u8Retry)
+static int32_t _net_mgr_listen_try_(netdev_t *pNetDev)
 {
 	int32_t eStatus;
+	int32_t i32Delay;
+	int32_t i32Ret;
+	uint8_t eOut;
+
 	do {
 		// try to listen
 		eStatus = WizeNet_Listen(pNetDev);
 		if ( eStatus == NETDEV_STATUS_OK )
 		{
+			NetRetry_Done(&(sWizeCtx.sRetry));
 			break; // everything is fine
 		}
 		else if ( eStatus == NETDEV_STATUS_ERROR)
@@ -842,19 +1835,110 @@ static int32_t _net_mgr_listen_with_retry_(netdev_t *pNetDev, uint8_t u8Retry)
 			if ( _net_mgr_error_(pNetDev) )
 			{
 				// try to abort the current Net Device Action
-				_net_mgr_try_abort_(pNetDev);
+				_net_mgr_try_abort_(pNetDev, NETDEV_CTL_PHY_RX);
 			}
+			eOut = NET_RETRY_OUT_ERROR;
 		}
-		// else // NET_STATUS_BUSY
-		if (!u8Retry)
+		else // NET_STATUS_BUSY
 		{
-			break;
+			eOut = NET_RETRY_OUT_BUSY;
+		}
+		i32Delay = _net_mgr_retry_next_(pNetDev, eOut);
+		if (i32Delay < 0)
+		{
+			break; // give up
+		}
+		NET_MGR_TRACE(NET_TRACE_LISTEN_RETRY, eStatus);
+		if (i32Delay)
+		{
+			i32Ret = _net_mgr_retry_at_(NET_REQ_LISTEN, i32Delay);
+			if (i32Ret > 0)
+			{
+				eStatus = NETDEV_STATUS_OK;
+			}
+			if (i32Ret)
+			{
+				break; // scheduled, or give up
+			}
 		}
-		u8Retry--;
 	} while (1);
 	return eStatus;
 }
 
+/*!
+ * @static
+ * @brief Internal function to wait before the next send or listen attempt
+ *
+ * @details In the net_mgr task, the attempt is scheduled on the sRetryAt timer
+ * (the _NET_MGR_RETRY_ event), so the task is never blocked. In the caller
+ * task (synchronous NetMgr_Send or NetMgr_Listen), that is waiting for the
+ * result anyway, it is delayed in place.
+ *
+ * @param[in] eOp      The operation to try again (see @link net_req_type_e @endlink)
+ * @param[in] i32Delay Delay in millisecond
+ *
+ * @retval  0 Delayed in place, try again now
+ * @retval  1 Scheduled on the timer
+ * @retval -1 Failed to schedule, give up
+ */
+static int32_t _net_mgr_retry_at_(uint8_t eOp, int32_t i32Delay)
+{
+	if ( xTaskGetCurrentTaskHandle() != sWizeCtx.hTask )
+	{
+		vTaskDelay(pdMS_TO_TICKS(i32Delay));
+		return 0;
+	}
+	sWizeCtx.eRetryOp = eOp;
+	if ( TimeEvt_TimerStart(&sWizeCtx.sRetryAt, (uint32_t)i32Delay/1000, (int16_t)(i32Delay%1000), _NET_MGR_RETRY_) )
+	{
+		sWizeCtx.eRetryOp = 0;
+		return -1;
+	}
+	return 1;
+}
+
+/*!
+ * @static
+ * @brief Internal function to cancel a scheduled send or listen attempt
+ *
+ * @return None
+ */
+static void _net_mgr_retry_cancel_(void)
+{
+	TimeEvt_TimerStop(&sWizeCtx.sRetryAt);
+	sWizeCtx.eRetryOp = 0;
+}
+
+/*!
+ * @static
+ * @brief Internal function to ask the retry policy after a failed attempt
+ *
+ * @details With the LINK strategy, the average noise and RSSI are given to the
+ * policy, from the net device statistics.
+ *
+ * @param[in] pNetDev Pointer to the net device
+ * @param[in] eOut    Outcome of the failed attempt (see @link net_retry_out_e @endlink)
+ *
+ * @retval -1 Give up
+ * @retval >= 0 Retry after this delay (ms)
+ */
+static int32_t _net_mgr_retry_next_(netdev_t *pNetDev, uint8_t eOut)
+{
+	net_stats_t sStats;
+	uint8_t u8Rssi = 0;
+	uint8_t u8Noise = 0;
+
+	if ( sWizeCtx.sRetry.sCfg.eStrategy == NET_RETRY_LINK )
+	{
+		if ( WizeNet_Ioctl(pNetDev, NETDEV_CTL_GET_STATS, (uint32_t)(&sStats)) == NETDEV_STATUS_OK )
+		{
+			u8Rssi = sStats.u8RxRssiAvg;
+			u8Noise = sStats.u8TxNoiseAvg;
+		}
+	}
+	return NetRetry_Next(&(sWizeCtx.sRetry), eOut, u8Rssi, u8Noise);
+}
+
 /*!
  * @static
  * @brief  Internal function to get and clear errors
@@ -868,6 +1952,7 @@ static int32_t _net_mgr_error_(netdev_t *pNetDev)
 	const char *pErrStr = NULL;
 	// Get the current error
 	WizeNet_Ioctl(pNetDev, NETDEV_CTL_GET_STR_ERR, (uint32_t)(&pErrStr));
+	NET_MGR_TRACE(NET_TRACE_ERROR, pNetDev->eErrType);
 	switch(pNetDev->eErrType)
 	{
 		// error on protocol
@@ -896,32 +1981,200 @@ static int32_t _net_mgr_error_(netdev_t *pNetDev)
 	return eRet;
 }
 
+/*!
+ * @static
+ * @brief  Internal function to check if the PHY of the RX route is listening
+ *
+ * @param[in] pNetDev Pointer to NetDev device
+ *
+ * @retval  0 Not listening
+ * @retval  1 Listening (or receiving)
+ */
+static uint8_t _net_mgr_rx_busy_(netdev_t *pNetDev)
+{
+	int32_t i32Phy = WizeNet_Ioctl(pNetDev, NETDEV_CTL_GET_ROUTE, NETDEV_ROUTE_RX);
+	return ( WizeNet_Ioctl(pNetDev, NETDEV_CTL_GET_PHY_STATE, (uint32_t)i32Phy) == NETDEV_STATE_BUSY );
+}
+
+/*!
+ * @static
+ * @brief  Internal function to get the route of the PHY that own the current
+ *         request
+ *
+ * @retval  NETDEV_CTL_PHY_TX A send is in progress
+ * @retval  NETDEV_CTL_PHY_RX A listen is in progress, or a window is prepared
+ * @retval  0 Unknown, all PHYs
+ */
+static uint32_t _net_mgr_phy_route_(void)
+{
+	if (sWizeCtx.eActive == NET_REQ_SEND)
+	{
+		return NETDEV_CTL_PHY_TX;
+	}
+	if ( (sWizeCtx.eActive == NET_REQ_LISTEN) || sWizeCtx.pxRxAtMsg )
+	{
+		return NETDEV_CTL_PHY_RX;
+	}
+	return 0;
+}
+
 /*!
  * @static
  * @brief  Internal function to abort and clean the current net/phy state
  *
+ * @param[in] pNetDev  Pointer to NetDev device
+ * @param[in] u32Route PHY that own the request (NETDEV_CTL_PHY_TX,
+ *                     NETDEV_CTL_PHY_RX or 0 for all PHYs)
+ *
  * @retval  0 Success
  * @retval  1 Fatal : unable to Abort nor Reset the Phy device
  */
-static int32_t _net_mgr_try_abort_(netdev_t *pNetDev)
+static int32_t _net_mgr_try_abort_(netdev_t *pNetDev, uint32_t u32Route)
 {
 	int32_t eRet = 0;
-	// Abort the current request
-	if ( WizeNet_Ioctl(pNetDev, NETDEV_CTL_PHY_CMD, PHY_CTL_CMD_READY) != NETDEV_STATUS_OK )
+	// Abort the current request, the PHY of the other route is left as is
+	if ( WizeNet_Ioctl(pNetDev, NETDEV_CTL_PHY_CMD | u32Route, PHY_CTL_CMD_READY) != NETDEV_STATUS_OK )
 	{
 		// Fatal, try to restart the module
 		LOG_ERR("NET Abort\n");
 		_net_mgr_error_(pNetDev);
-		if ( WizeNet_Ioctl(pNetDev, NETDEV_CTL_PHY_CMD, PHY_CTL_CMD_RESET) != NETDEV_STATUS_OK )
+		if ( WizeNet_Ioctl(pNetDev, NETDEV_CTL_PHY_CMD | u32Route, PHY_CTL_CMD_RESET) != NETDEV_STATUS_OK )
 		{
 			LOG_ERR("NET Reset\n");
 			//assert(0);
 			eRet = 1; // should never reach it
 		}
 	}
+	NET_MGR_TRACE(NET_TRACE_ABORT, eRet);
 	return eRet;
 }
 
+/*!
+ * @static
+ * @brief  Internal function to get a new request handle
+ *
+ * @return The request handle (never 0)
+ */
+static uint16_t _net_mgr_req_handle_(void)
+{
+	uint16_t u16Handle;
+	taskENTER_CRITICAL();
+	if ( !(++sWizeCtx.u16ReqHandle) )
+	{
+		++sWizeCtx.u16ReqHandle;
+	}
+	u16Handle = sWizeCtx.u16ReqHandle;
+	taskEXIT_CRITICAL();
+	return u16Handle;
+}
+
+/*!
+ * @static
+ * @brief  Internal function to insert a request into the pending queue
+ *
+ * @details See NetReq_Push. The evicted request, if any, is completed with
+ * NET_EVENT_ERROR and NET_STATUS_BUSY.
+ *
+ * @param[in] pEnt Pointer to the entry to insert (its sReq must be filled)
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ */
+static int32_t _net_mgr_req_push_(struct net_req_ent_s *pEnt)
+{
+	struct net_req_ent_s sEvict;
+	int32_t eStatus;
+	uint8_t bEvict;
+	uint8_t bPreempt = 0;
+
+	pEnt->u32DeadlineTick = pEnt->sReq.u32SubmitTick + pdMS_TO_TICKS(pEnt->sReq.u32Deadline);
+
+	taskENTER_CRITICAL();
+	eStatus = NetReq_Push(&(sWizeCtx.sReqQueue), pEnt, &sEvict, &bEvict);
+	// priority send while a lower priority listen is on
+	if ( (eStatus == NET_STATUS_OK) &&
+		 NetReq_Preempt(pEnt, sWizeCtx.eActive, sWizeCtx.u8ReqPrio) )
+	{
+		bPreempt = 1;
+	}
+	taskEXIT_CRITICAL();
+
+	if (bEvict)
+	{
+		_net_mgr_req_drop_(&sEvict, NET_EVENT_ERROR, NET_STATUS_BUSY);
+	}
+	if (bPreempt)
+	{
+		xTaskNotify(sWizeCtx.hTask, _NET_MGR_PREEMPT_, eSetBits);
+	}
+	return eStatus;
+}
+
+/*!
+ * @static
+ * @brief  Internal function to extract the first request from the pending queue
+ *
+ * @param[out] pEnt Pointer to the extracted entry
+ *
+ * @retval  0 The queue is empty
+ * @retval  1 A request has been extracted
+ */
+static uint8_t _net_mgr_req_pop_(struct net_req_ent_s *pEnt)
+{
+	uint8_t bRet;
+
+	taskENTER_CRITICAL();
+	bRet = NetReq_Pop(&(sWizeCtx.sReqQueue), pEnt);
+	taskEXIT_CRITICAL();
+	return bRet;
+}
+
+/*!
+ * @static
+ * @brief  Internal function to complete a request that will not be started
+ *
+ * @param[in] pEnt      Pointer to the dropped entry
+ * @param[in] u32Evt    Events to give back (see @link net_event_e @endlink)
+ * @param[in] i32Status Status to give back (see @link net_status_e @endlink)
+ *
+ * @return None
+ */
+static void _net_mgr_req_drop_(struct net_req_ent_s *pEnt, uint32_t u32Evt, int32_t i32Status)
+{
+	net_cpl_t sCpl;
+
+	NET_MGR_TRACE(NET_TRACE_REQ_DROP, pEnt->sReq.u16Handle);
+	if (pEnt->bSync)
+	{
+		_net_mgr_notify_caller_(u32Evt);
+		return;
+	}
+	NetReq_Drop(&(pEnt->sReq), u32Evt, i32Status, xTaskGetTickCount(), &sCpl);
+	if ( xQueueSend(sWizeCtx.hCplQueue, &sCpl, 0) != pdTRUE )
+	{
+		LOG_WRN("Completion dropped\n");
+	}
+}
+
+#if NET_MGR_TRACE_NB
+/*!
+ * @static
+ * @brief  Internal function to add a record into the trace ring
+ *
+ * @param[in] u32Us  Time stamp of the event (see NET_MGR_TRACE_NOW)
+ * @param[in] u8Evt  Event (see @link net_trace_evt_e @endlink)
+ * @param[in] u16Arg Event argument
+ *
+ * @return None
+ */
+static void _net_mgr_trace_(uint32_t u32Us, uint8_t u8Evt, uint16_t u16Arg)
+{
+	taskENTER_CRITICAL();
+	NetTrace_Put(&sTrace, u32Us, u8Evt, (uint8_t)sNetDev.eState, u16Arg);
+	taskEXIT_CRITICAL();
+}
+#endif
+
 /*! @} */
 
 #ifdef __cplusplus
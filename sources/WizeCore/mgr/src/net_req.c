@@ -0,0 +1,295 @@
+/**
+  * @file: net_req.c
+  * @brief This file implement the pending request queue used by the network
+  * manager.
+  *
+  * @details
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+
+#include "net_req.h"
+
+/*!
+ * @addtogroup wize_net_mgr
+ * @{
+ *
+ */
+
+/*!
+ * @brief This function get the priority of a message, from its L2 C-field
+ * class
+ *
+ * @param [in] u8Type The message application type (see @link app_type_e @endlink)
+ *
+ * @return The priority (see @link net_req_prio_e @endlink)
+ */
+uint8_t NetReq_Prio(uint8_t u8Type)
+{
+	switch (u8Type)
+	{
+		case APP_DATA_PRIO: return NET_REQ_PRIO_ALARM;
+		case APP_ADMIN:     return NET_REQ_PRIO_ADM;
+		case APP_INSTALL:   return NET_REQ_PRIO_INST;
+		default:            return NET_REQ_PRIO_DATA;
+	}
+}
+
+/*!
+ * @brief This function insert a request into the pending queue
+ *
+ * @details The entry priority is set from its message type. Its deadline tick
+ * must be set by the caller (if sReq.u32Deadline). When the queue is full, the
+ * lowest priority request is evicted if the new one has a higher priority.
+ *
+ * @param [in]  pQueue  Pointer on the pending queue
+ * @param [in]  pEnt    Pointer on the entry to insert
+ * @param [out] pEvict  Pointer on the evicted entry (if any)
+ * @param [out] pbEvict Set to 1 if an entry has been evicted, 0 otherwise
+ *
+ * @retval NET_STATUS_OK (see @link net_status_e::NET_STATUS_OK @endlink)
+ * @retval NET_STATUS_BUSY (see @link net_status_e::NET_STATUS_BUSY @endlink)
+ */
+int32_t NetReq_Push(struct net_req_queue_s *pQueue, struct net_req_ent_s *pEnt, struct net_req_ent_s *pEvict, uint8_t *pbEvict)
+{
+	struct net_req_ent_s *pCur;
+	uint8_t i;
+
+	*pbEvict = 0;
+	pEnt->u8Prio = NetReq_Prio(pEnt->sReq.pxNetMsg->u8Type);
+	if (pQueue->u8Nb == NET_MGR_REQ_QUEUE_NB)
+	{
+		if ( pEnt->u8Prio >= pQueue->aEnt[NET_MGR_REQ_QUEUE_NB - 1].u8Prio )
+		{
+			pQueue->sStats.u32Rejected++;
+			return NET_STATUS_BUSY;
+		}
+		*pEvict = pQueue->aEnt[NET_MGR_REQ_QUEUE_NB - 1];
+		pQueue->u8Nb--;
+		pQueue->sStats.u32Evicted++;
+		*pbEvict = 1;
+	}
+	// find the place
+	for (i = 0; i < pQueue->u8Nb; i++)
+	{
+		pCur = &(pQueue->aEnt[i]);
+		if (pEnt->u8Prio != pCur->u8Prio)
+		{
+			if (pEnt->u8Prio < pCur->u8Prio)
+			{
+				break;
+			}
+		}
+		else if ( pEnt->sReq.u32Deadline &&
+				  ( !(pCur->sReq.u32Deadline) ||
+				    ( (int32_t)(pEnt->u32DeadlineTick - pCur->u32DeadlineTick) < 0 ) ) )
+		{
+			break;
+		}
+	}
+	memmove(&(pQueue->aEnt[i+1]), &(pQueue->aEnt[i]), (pQueue->u8Nb - i) * sizeof(struct net_req_ent_s));
+	pQueue->aEnt[i] = *pEnt;
+	pQueue->u8Nb++;
+	pQueue->sStats.u32Queued++;
+	pQueue->sStats.u8Depth = pQueue->u8Nb;
+	if (pQueue->u8Nb > pQueue->sStats.u8DepthMax)
+	{
+		pQueue->sStats.u8DepthMax = pQueue->u8Nb;
+	}
+	return NET_STATUS_OK;
+}
+
+/*!
+ * @brief This function extract the first request from the pending queue
+ *
+ * @param [in]  pQueue Pointer on the pending queue
+ * @param [out] pEnt   Pointer on the extracted entry
+ *
+ * @retval  0 The queue is empty
+ * @retval  1 A request has been extracted
+ */
+uint8_t NetReq_Pop(struct net_req_queue_s *pQueue, struct net_req_ent_s *pEnt)
+{
+	if (pQueue->u8Nb)
+	{
+		*pEnt = pQueue->aEnt[0];
+		pQueue->u8Nb--;
+		memmove(&(pQueue->aEnt[0]), &(pQueue->aEnt[1]), pQueue->u8Nb * sizeof(struct net_req_ent_s));
+		pQueue->sStats.u8Depth = pQueue->u8Nb;
+		return 1;
+	}
+	return 0;
+}
+
+/*!
+ * @brief This function check if a request has not been started before its
+ * deadline
+ *
+ * @param [in] pEnt   Pointer on the entry
+ * @param [in] u32Now Current tick
+ *
+ * @retval  0 The request can be started
+ * @retval  1 The request is expired
+ */
+uint8_t NetReq_Expired(const struct net_req_ent_s *pEnt, uint32_t u32Now)
+{
+	return ( pEnt->sReq.u32Deadline && ( (int32_t)(u32Now - pEnt->u32DeadlineTick) > 0 ) );
+}
+
+/*!
+ * @brief This function check if a request preempts the current listen
+ *
+ * @details Only a DATA_PRIO send preempts, a lower priority listen window.
+ *
+ * @param [in] pEnt         Pointer on the queued entry
+ * @param [in] eActive      Current device action (see @link net_req_type_e @endlink, 0 if none)
+ * @param [in] u8ActivePrio Priority of the current request
+ *
+ * @retval  0 The request wait for the current one
+ * @retval  1 The request preempts the current listen
+ */
+uint8_t NetReq_Preempt(const struct net_req_ent_s *pEnt, uint8_t eActive, uint8_t u8ActivePrio)
+{
+	return ( (pEnt->u8Prio == NET_REQ_PRIO_ALARM) && (pEnt->sReq.eType == NET_REQ_SEND) &&
+			 (eActive == NET_REQ_LISTEN) && (u8ActivePrio > NET_REQ_PRIO_ALARM) );
+}
+
+/*!
+ * @brief This function build the completion of the current request
+ *
+ * @details The request ends on send done, timeout or error, and on the
+ * received message of a listen (but a many listen). The caller set the start
+ * and end ticks.
+ *
+ * @param [in]  pReq   Pointer on the current request
+ * @param [in]  u32Evt Events of the request (see @link net_event_e @endlink)
+ * @param [in]  bEnd   Force the request to end (error or abort)
+ * @param [out] pCpl   Pointer on the completion
+ *
+ * @retval  0 Nothing to complete
+ * @retval  1 The completion is built (pCpl->bLast if the request ends)
+ */
+uint8_t NetReq_Complete(const net_req_t *pReq, uint32_t u32Evt, uint8_t bEnd, net_cpl_t *pCpl)
+{
+	if ( u32Evt & (NET_EVENT_SEND_DONE | NET_EVENT_TIMEOUT | NET_EVENT_ERROR) )
+	{
+		bEnd = 1;
+	}
+	if ( (u32Evt & NET_EVENT_RECV_DONE) &&
+		 ( (pReq->eType != NET_REQ_LISTEN) || (pReq->eListenType != NET_LISTEN_TYPE_MANY) ) )
+	{
+		bEnd = 1;
+	}
+	if ( !bEnd && !(u32Evt & NET_EVENT_RECV_DONE) )
+	{
+		return 0;
+	}
+	pCpl->pxNetMsg = pReq->pxNetMsg;
+	pCpl->pUser = pReq->pUser;
+	pCpl->u16Handle = pReq->u16Handle;
+	pCpl->u32Evt = u32Evt;
+	pCpl->u32SubmitTick = pReq->u32SubmitTick;
+	pCpl->bLast = bEnd;
+	if ( u32Evt & (NET_EVENT_ERROR | NET_EVENT_TIMEOUT) )
+	{
+		pCpl->i32Status = NET_STATUS_ERROR;
+	}
+	else
+	{
+		pCpl->i32Status = NET_STATUS_OK;
+	}
+	return 1;
+}
+
+/*!
+ * @brief This function build the completion of a request that will not be
+ * started (expired, evicted or canceled)
+ *
+ * @param [in]  pReq      Pointer on the dropped request
+ * @param [in]  u32Evt    Events to give back (see @link net_event_e @endlink)
+ * @param [in]  i32Status Status to give back (see @link net_status_e @endlink)
+ * @param [in]  u32Now    Current tick
+ * @param [out] pCpl      Pointer on the completion
+ *
+ * @return None
+ */
+void NetReq_Drop(const net_req_t *pReq, uint32_t u32Evt, int32_t i32Status, uint32_t u32Now, net_cpl_t *pCpl)
+{
+	pCpl->pxNetMsg = pReq->pxNetMsg;
+	pCpl->pUser = pReq->pUser;
+	pCpl->u16Handle = pReq->u16Handle;
+	pCpl->u32Evt = u32Evt;
+	pCpl->u32SubmitTick = pReq->u32SubmitTick;
+	pCpl->u32StartTick = u32Now;
+	pCpl->u32EndTick = u32Now;
+	pCpl->i32Status = i32Status;
+	pCpl->bLast = 1;
+}
+
+/*!
+ * @brief This function split the delay of a listen window (see NetMgr_ListenAt)
+ *
+ * @details The PHY is woken up u16LeadMs before the window, then the receiver
+ * is armed on the window. A window closer than the lead time (or already
+ * passed, u32DelayMs = 0) wake-up the PHY now.
+ *
+ * @param [in]  bActive    A listen window is already scheduled, or the device
+ *                         is in use (session or request in progress)
+ * @param [in]  u32DelayMs Delay from now to the window (in ms)
+ * @param [in]  u16LeadMs  PHY wake-up lead time (in ms)
+ * @param [out] pu32WakeMs Delay from now to the PHY wake-up (in ms)
+ * @param [out] pu16ArmMs  Delay from the PHY wake-up to the window (in ms)
+ *
+ * @retval  NET_STATUS_OK   The window can be scheduled
+ * @retval  NET_STATUS_BUSY The device is not available
+ */
+int32_t NetReq_RxAt(uint8_t bActive, uint32_t u32DelayMs, uint16_t u16LeadMs, uint32_t *pu32WakeMs, uint16_t *pu16ArmMs)
+{
+	if (bActive)
+	{
+		return NET_STATUS_BUSY;
+	}
+	if ( u32DelayMs > u16LeadMs )
+	{
+		*pu16ArmMs = u16LeadMs;
+		*pu32WakeMs = u32DelayMs - u16LeadMs;
+	}
+	else
+	{
+		// too late to be in advance, wake-up now
+		*pu16ArmMs = (uint16_t)u32DelayMs;
+		*pu32WakeMs = 0;
+	}
+	return NET_STATUS_OK;
+}
+
+/*! @} */
+
+#ifdef __cplusplus
+}
+#endif
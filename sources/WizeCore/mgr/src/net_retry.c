@@ -0,0 +1,298 @@
+/**
+  * @file: net_retry.c
+  * @brief This file implement the retry policy used by the network manager.
+  *
+  * @details
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+
+#include "net_retry.h"
+#include "wize_utils.h"
+
+/*!
+ * @addtogroup wize_net_mgr
+ * @{
+ *
+ */
+
+static uint32_t _net_retry_backoff_(struct net_retry_s *pCtx);
+static uint8_t _net_retry_bad_link_(struct net_retry_s *pCtx, uint8_t eOut, uint8_t u8Rssi, uint8_t u8Noise);
+
+/*!
+ * @brief This function initialize the retry policy
+ *
+ * @details The default configuration is the fixed strategy without delay
+ * (retries back to back), without session budget.
+ *
+ * @param [in] pCtx    Pointer on the retry policy context
+ * @param [in] u32Seed Seed of the jitter random generator
+ *
+ * @return None
+ */
+void NetRetry_Init(struct net_retry_s *pCtx, uint32_t u32Seed)
+{
+	if (pCtx)
+	{
+		memset(pCtx, 0, sizeof(struct net_retry_s));
+		pCtx->sCfg.eStrategy = NET_RETRY_FIXED;
+		pCtx->sCfg.u16Budget = NET_RETRY_BUDGET_DEFAULT;
+		pCtx->u32Rand = (u32Seed)?(u32Seed):(0x2545F491);
+		NetRetry_Session(pCtx, 0);
+	}
+}
+
+/*!
+ * @brief This function configure the retry policy
+ *
+ * @param [in] pCtx Pointer on the retry policy context
+ * @param [in] pCfg Pointer on the configuration
+ *
+ * @retval  0 Success
+ * @retval -1 Invalid configuration
+ */
+int32_t NetRetry_Config(struct net_retry_s *pCtx, const struct net_retry_cfg_s *pCfg)
+{
+	if ( !pCtx || !pCfg )
+	{
+		return -1;
+	}
+	if ( (pCfg->eStrategy >= NET_RETRY_STRATEGY_NB) || (pCfg->u8JitterPct > 100) )
+	{
+		return -1;
+	}
+	if ( (pCfg->eStrategy != NET_RETRY_FIXED) && (pCfg->u16DelayMaxMs < pCfg->u16DelayMs) )
+	{
+		return -1;
+	}
+	pCtx->sCfg = *pCfg;
+	NetRetry_Session(pCtx, 0);
+	return 0;
+}
+
+/*!
+ * @brief This function start a new session (restore the retry budget)
+ *
+ * @param [in] pCtx  Pointer on the retry policy context
+ * @param [in] u32Mix Value mixed into the jitter random generator (e.g. the
+ *                    current time), so devices don't synchronize (0 : none)
+ *
+ * @return None
+ */
+void NetRetry_Session(struct net_retry_s *pCtx, uint32_t u32Mix)
+{
+	if (pCtx)
+	{
+		pCtx->u16BudgetLeft = pCtx->sCfg.u16Budget;
+		if (u32Mix)
+		{
+			pCtx->u32Rand ^= u32Mix;
+			pCtx->u32Rand = (pCtx->u32Rand)?(pCtx->u32Rand):(0x2545F491);
+		}
+	}
+}
+
+/*!
+ * @brief This function start a new operation
+ *
+ * @param [in] pCtx  Pointer on the retry policy context
+ * @param [in] eOp   The operation (see @link net_retry_op_e @endlink)
+ * @param [in] u8Max Maximum number of retries for this operation
+ *
+ * @return None
+ */
+void NetRetry_Start(struct net_retry_s *pCtx, uint8_t eOp, uint8_t u8Max)
+{
+	if (pCtx)
+	{
+		pCtx->eOp = (eOp < NET_RETRY_OP_NB)?(eOp):(NET_RETRY_OP_TX);
+		pCtx->u8Max = u8Max;
+		pCtx->u8Attempt = 0;
+	}
+}
+
+/*!
+ * @brief This function decide what to do after a failed attempt
+ *
+ * @details Device busy or error outcomes consume the operation retries and
+ * the session budget, and may be delayed. Received frames in error or not
+ * expected only lead to listen again in the current window : they are counted,
+ * never delayed, and only stopped by the LINK strategy (RSSI too low).
+ *
+ * @param [in] pCtx    Pointer on the retry policy context
+ * @param [in] eOut    Outcome of the failed attempt (see @link net_retry_out_e @endlink)
+ * @param [in] u8Rssi  RSSI of the last received frame (0 : unknown)
+ * @param [in] u8Noise Current noise level, as PHY_CTL_GET_NOISE (opposite of
+ *                     the dBm value, 0 : unknown)
+ *
+ * @retval -1 Give up
+ * @retval >= 0 Retry after this delay (ms)
+ */
+int32_t NetRetry_Next(struct net_retry_s *pCtx, uint8_t eOut, uint8_t u8Rssi, uint8_t u8Noise)
+{
+	uint32_t u32Delay = 0;
+
+	if ( !pCtx || (eOut >= NET_RETRY_OUT_NB) )
+	{
+		return -1;
+	}
+
+	if ( _net_retry_bad_link_(pCtx, eOut, u8Rssi, u8Noise) )
+	{
+		pCtx->sStats.u32GiveUpLink++;
+		return -1;
+	}
+
+	if ( (eOut == NET_RETRY_OUT_BUSY) || (eOut == NET_RETRY_OUT_ERROR) )
+	{
+		if (pCtx->u8Attempt >= pCtx->u8Max)
+		{
+			pCtx->sStats.u32GiveUpMax++;
+			return -1;
+		}
+		if (pCtx->sCfg.u16Budget)
+		{
+			if ( !(pCtx->u16BudgetLeft) )
+			{
+				pCtx->sStats.u32GiveUpBudget++;
+				return -1;
+			}
+			pCtx->u16BudgetLeft--;
+		}
+		pCtx->u8Attempt++;
+
+		if (pCtx->sCfg.eStrategy == NET_RETRY_FIXED)
+		{
+			u32Delay = pCtx->sCfg.u16DelayMs;
+		}
+		else
+		{
+			u32Delay = _net_retry_backoff_(pCtx);
+		}
+		pCtx->sStats.u32DelayMs += u32Delay;
+	}
+	pCtx->sStats.aRetry[pCtx->eOp][eOut]++;
+	return (int32_t)u32Delay;
+}
+
+/*!
+ * @brief This function end the current operation with success
+ *
+ * @param [in] pCtx Pointer on the retry policy context
+ *
+ * @return None
+ */
+void NetRetry_Done(struct net_retry_s *pCtx)
+{
+	if (pCtx)
+	{
+		if (pCtx->u8Attempt)
+		{
+			pCtx->sStats.aRecovered[pCtx->eOp]++;
+		}
+		pCtx->u8Attempt = 0;
+	}
+}
+
+/******************************************************************************/
+
+/*!
+ * @static
+ * @brief This function compute the backoff delay of the current retry
+ *
+ * @param [in] pCtx Pointer on the retry policy context
+ *
+ * @return The delay (ms)
+ */
+static uint32_t _net_retry_backoff_(struct net_retry_s *pCtx)
+{
+	uint32_t u32Delay;
+	uint32_t u32Jitter;
+
+	// u8Attempt is at least 1
+	if (pCtx->u8Attempt <= 16)
+	{
+		u32Delay = (uint32_t)pCtx->sCfg.u16DelayMs << (pCtx->u8Attempt - 1);
+	}
+	else
+	{
+		u32Delay = pCtx->sCfg.u16DelayMaxMs;
+	}
+	if (u32Delay > pCtx->sCfg.u16DelayMaxMs)
+	{
+		u32Delay = pCtx->sCfg.u16DelayMaxMs;
+	}
+
+	u32Jitter = (u32Delay * pCtx->sCfg.u8JitterPct) / 100;
+	if (u32Jitter)
+	{
+		// uniform in [delay - jitter, delay + jitter]
+		u32Delay = u32Delay - u32Jitter + _xorshift32_(&(pCtx->u32Rand)) % (2 * u32Jitter + 1);
+	}
+	return u32Delay;
+}
+
+/*!
+ * @static
+ * @brief This function check if the link is too bad to retry (LINK strategy)
+ *
+ * @param [in] pCtx    Pointer on the retry policy context
+ * @param [in] eOut    Outcome of the failed attempt
+ * @param [in] u8Rssi  RSSI of the last received frame (0 : unknown)
+ * @param [in] u8Noise Current noise level, as PHY_CTL_GET_NOISE (0 : unknown)
+ *
+ * @retval 0 Retry may help
+ * @retval 1 Give up
+ */
+static uint8_t _net_retry_bad_link_(struct net_retry_s *pCtx, uint8_t eOut, uint8_t u8Rssi, uint8_t u8Noise)
+{
+	if (pCtx->sCfg.eStrategy != NET_RETRY_LINK)
+	{
+		return 0;
+	}
+	// the channel stay noisy, a TX retry will fail the same way (the noise is
+	// the opposite of the dBm value, so a louder noise is a lower value)
+	if ( (pCtx->eOp == NET_RETRY_OP_TX) && pCtx->sCfg.u8NoiseMax &&
+		 u8Noise && (u8Noise < pCtx->sCfg.u8NoiseMax) )
+	{
+		return 1;
+	}
+	// frames are received too weak to be decoded
+	if ( (pCtx->eOp == NET_RETRY_OP_RX) && (eOut == NET_RETRY_OUT_FRM_ERR) &&
+		 pCtx->sCfg.u8RssiMin && u8Rssi && (u8Rssi < pCtx->sCfg.u8RssiMin) )
+	{
+		return 1;
+	}
+	return 0;
+}
+
+/*! @} */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,117 @@
+/**
+  * @file: net_trace.c
+  * @brief This file implement the state-transition trace ring used by the
+  * network manager.
+  *
+  * @details
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "net_trace.h"
+
+/*!
+ * @addtogroup wize_net_mgr
+ * @{
+ *
+ */
+
+/*!
+ * @brief This function add a record into the trace ring
+ *
+ * @details The oldest record is overwritten when the ring is full.
+ *
+ * @param [in] pRing   Pointer on the trace ring
+ * @param [in] u32Us   Time stamp of the event (micro-second, wrap around)
+ * @param [in] u8Evt   Event (see @link net_trace_evt_e @endlink)
+ * @param [in] u8State Net device state (see @link netdev_state_e @endlink)
+ * @param [in] u16Arg  Event argument
+ *
+ * @return None
+ */
+void NetTrace_Put(struct net_trace_ring_s *pRing, uint32_t u32Us, uint8_t u8Evt, uint8_t u8State, uint16_t u16Arg)
+{
+#if NET_MGR_TRACE_NB
+	net_trace_t *pRec;
+
+	if (pRing)
+	{
+		pRec = &(pRing->aRec[pRing->u32Seq & (NET_MGR_TRACE_NB - 1)]);
+		pRing->u32Seq++;
+		pRec->u32Us = u32Us;
+		pRec->u8Evt = u8Evt;
+		pRec->u8State = u8State;
+		pRec->u16Arg = u16Arg;
+	}
+#endif
+}
+
+/*!
+ * @brief This function copy the latest records of the trace ring
+ *
+ * @details The records are copied from the oldest to the latest one.
+ *
+ * @param [in]  pRing   Pointer on the trace ring
+ * @param [out] pxTrace Pointer to the records buffer
+ * @param [in]  u32Nb   Number of records in the buffer
+ * @param [out] pu32Seq Sequence number of the first copied record (may be NULL)
+ *
+ * @return The number of copied records
+ */
+uint32_t NetTrace_Get(const struct net_trace_ring_s *pRing, net_trace_t *pxTrace, uint32_t u32Nb, uint32_t *pu32Seq)
+{
+	uint32_t u32Seq = 0;
+	uint32_t i = 0;
+#if NET_MGR_TRACE_NB
+	if ( pRing && pxTrace )
+	{
+		if (u32Nb > NET_MGR_TRACE_NB)
+		{
+			u32Nb = NET_MGR_TRACE_NB;
+		}
+		if (u32Nb > pRing->u32Seq)
+		{
+			u32Nb = pRing->u32Seq;
+		}
+		u32Seq = pRing->u32Seq - u32Nb;
+		for (i = 0; i < u32Nb; i++)
+		{
+			pxTrace[i] = pRing->aRec[(u32Seq + i) & (NET_MGR_TRACE_NB - 1)];
+		}
+	}
+#endif
+	if ( pu32Seq )
+	{
+		*pu32Seq = u32Seq;
+	}
+	return i;
+}
+
+/*! @} */
+
+#ifdef __cplusplus
+}
+#endif
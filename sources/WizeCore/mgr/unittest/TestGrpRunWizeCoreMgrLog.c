@@ -0,0 +1,10 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(WizeCore_admlog)
+{
+    RUN_TEST_CASE(WizeCore_admlog, test_AdmLog_NullPtr);
+    RUN_TEST_CASE(WizeCore_admlog, test_AdmLog_Sequence);
+    RUN_TEST_CASE(WizeCore_admlog, test_AdmLog_WriteParam);
+    RUN_TEST_CASE(WizeCore_admlog, test_AdmLog_Overflow);
+    RUN_TEST_CASE(WizeCore_admlog, test_AdmLog_Reset);
+}
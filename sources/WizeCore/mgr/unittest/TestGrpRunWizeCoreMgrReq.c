@@ -0,0 +1,15 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(WizeCore_netreq)
+{
+    RUN_TEST_CASE(WizeCore_netreq, test_NetReq_Prio);
+    RUN_TEST_CASE(WizeCore_netreq, test_NetReq_Order);
+    RUN_TEST_CASE(WizeCore_netreq, test_NetReq_Deadline);
+    RUN_TEST_CASE(WizeCore_netreq, test_NetReq_Full);
+    RUN_TEST_CASE(WizeCore_netreq, test_NetReq_Expired);
+    RUN_TEST_CASE(WizeCore_netreq, test_NetReq_SendStart);
+    RUN_TEST_CASE(WizeCore_netreq, test_NetReq_Complete);
+    RUN_TEST_CASE(WizeCore_netreq, test_NetReq_Cancel);
+    RUN_TEST_CASE(WizeCore_netreq, test_NetReq_InProgress);
+    RUN_TEST_CASE(WizeCore_netreq, test_NetReq_RxAt);
+}
@@ -0,0 +1,12 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(WizeCore_netretry)
+{
+    RUN_TEST_CASE(WizeCore_netretry, test_NetRetry_Config);
+    RUN_TEST_CASE(WizeCore_netretry, test_NetRetry_Fixed);
+    RUN_TEST_CASE(WizeCore_netretry, test_NetRetry_Budget);
+    RUN_TEST_CASE(WizeCore_netretry, test_NetRetry_Backoff);
+    RUN_TEST_CASE(WizeCore_netretry, test_NetRetry_FrmError);
+    RUN_TEST_CASE(WizeCore_netretry, test_NetRetry_LinkNoise);
+    RUN_TEST_CASE(WizeCore_netretry, test_NetRetry_LinkRssi);
+}
@@ -0,0 +1,9 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(WizeCore_nettrace)
+{
+    RUN_TEST_CASE(WizeCore_nettrace, test_NetTrace_Empty);
+    RUN_TEST_CASE(WizeCore_nettrace, test_NetTrace_Order);
+    RUN_TEST_CASE(WizeCore_nettrace, test_NetTrace_Wrap);
+    RUN_TEST_CASE(WizeCore_nettrace, test_NetTrace_Snapshot);
+}
@@ -19,6 +19,7 @@ LOG_DBG
 net_mgr
 NetMgr_Send
 NetMgr_Listen
+NetMgr_ListenAt
 
 
 time_evt
@@ -18,6 +18,7 @@ logger
 net_mgr
 	NetMgr_SetDwlink
 	NetMgr_Listen
+	NetMgr_ListenAt
 
 
 time_evt
@@ -21,6 +21,7 @@ net_mgr
 	NetMgr_ListenReady
 	NetMgr_Send
 	NetMgr_Listen
+	NetMgr_ListenAt
 
 time_evt
 	TimeEvt_TimerInit
@@ -0,0 +1,147 @@
+#include "unity_fixture.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+TEST_GROUP(WizeCore_admlog);
+#include "adm_log.h"
+#include "app_layer.h"
+
+/******************************************************************************/
+
+static struct adm_log_s sLog;
+static uint8_t aCmd[16];
+static uint8_t aRsp[16];
+static net_msg_t sCmdMsg;
+static net_msg_t sRspMsg;
+
+static void _recv_(uint8_t u8CmdId)
+{
+	aCmd[0] = u8CmdId;
+	sCmdMsg.u8Size = 3;
+	AdmLog_Cmd(&sLog, &sCmdMsg);
+}
+
+static void _send_(uint8_t u8CmdId, uint8_t u8ErrCode)
+{
+	aRsp[0] = u8CmdId;
+	aRsp[1] = u8ErrCode;
+	sRspMsg.u8Size = sizeof(admin_rsp_err_t);
+	AdmLog_Rsp(&sLog, &sRspMsg);
+}
+
+/******************************************************************************/
+TEST_SETUP(WizeCore_admlog)
+{
+	memset(&sCmdMsg, 0, sizeof(sCmdMsg));
+	memset(&sRspMsg, 0, sizeof(sRspMsg));
+	sCmdMsg.pData = aCmd;
+	sRspMsg.pData = aRsp;
+	memset(&sLog, 0xA5, sizeof(sLog));
+	AdmLog_Reset(&sLog);
+}
+
+TEST_TEAR_DOWN(WizeCore_admlog)
+{
+}
+
+/******************************************************************************/
+TEST(WizeCore_admlog, test_AdmLog_NullPtr)
+{
+	TEST_ASSERT_EQUAL_UINT8(0, sLog.u8Nb);
+	TEST_ASSERT_EQUAL_UINT8(0, sLog.bWriteParam);
+
+	AdmLog_Reset(NULL);
+	AdmLog_Cmd(NULL, &sCmdMsg);
+	AdmLog_Cmd(&sLog, NULL);
+	AdmLog_Rsp(NULL, &sRspMsg);
+	AdmLog_Rsp(&sLog, NULL);
+	// empty command
+	AdmLog_Cmd(&sLog, &sCmdMsg);
+	TEST_ASSERT_EQUAL_UINT8(0, sLog.u8Nb);
+	// response without command
+	_send_(ADM_READ_PARAM, ADM_NONE);
+	TEST_ASSERT_EQUAL_UINT8(0, sLog.aEnt[0].bRspSent);
+}
+
+TEST(WizeCore_admlog, test_AdmLog_Sequence)
+{
+	_recv_(ADM_READ_PARAM);
+	_send_(ADM_READ_PARAM, ADM_NONE);
+	_recv_(ADM_WRITE_PARAM);
+	_send_(ADM_WRITE_PARAM, WRITE_ILLEGAL_VALUE);
+	_recv_(ADM_WRITE_PARAM);
+
+	TEST_ASSERT_EQUAL_UINT8(3, sLog.u8Nb);
+	TEST_ASSERT_EQUAL_HEX8(ADM_READ_PARAM, sLog.aEnt[0].u8CmdId);
+	TEST_ASSERT_EQUAL_HEX8(ADM_NONE, sLog.aEnt[0].u8ErrCode);
+	TEST_ASSERT_EQUAL_UINT8(1, sLog.aEnt[0].bRspSent);
+	TEST_ASSERT_EQUAL_HEX8(ADM_WRITE_PARAM, sLog.aEnt[1].u8CmdId);
+	TEST_ASSERT_EQUAL_HEX8(WRITE_ILLEGAL_VALUE, sLog.aEnt[1].u8ErrCode);
+	TEST_ASSERT_EQUAL_UINT8(1, sLog.aEnt[1].bRspSent);
+	// the last response is out of date
+	TEST_ASSERT_EQUAL_HEX8(ADM_WRITE_PARAM, sLog.aEnt[2].u8CmdId);
+	TEST_ASSERT_EQUAL_UINT8(0, sLog.aEnt[2].bRspSent);
+
+	// too short response : no error code
+	aRsp[1] = WRITE_ILLEGAL_VALUE;
+	sRspMsg.u8Size = 1;
+	AdmLog_Rsp(&sLog, &sRspMsg);
+	TEST_ASSERT_EQUAL_HEX8(ADM_NONE, sLog.aEnt[2].u8ErrCode);
+	TEST_ASSERT_EQUAL_UINT8(1, sLog.aEnt[2].bRspSent);
+}
+
+TEST(WizeCore_admlog, test_AdmLog_WriteParam)
+{
+	// an earlier WRITE_PARAMETER is not hidden by the last command
+	_recv_(ADM_WRITE_PARAM);
+	_send_(ADM_WRITE_PARAM, ADM_NONE);
+	TEST_ASSERT_EQUAL_UINT8(1, sLog.bWriteParam);
+	_recv_(ADM_READ_PARAM);
+	_send_(ADM_READ_PARAM, ADM_NONE);
+	TEST_ASSERT_EQUAL_UINT8(1, sLog.bWriteParam);
+	TEST_ASSERT_EQUAL_UINT8(2, sLog.u8Nb);
+
+	AdmLog_Reset(&sLog);
+	_recv_(ADM_READ_PARAM);
+	_recv_(ADM_EXECINSTPING);
+	TEST_ASSERT_EQUAL_UINT8(0, sLog.bWriteParam);
+}
+
+TEST(WizeCore_admlog, test_AdmLog_Overflow)
+{
+	uint16_t i;
+	for (i = 0; i < ADM_LOG_SZ; i++)
+	{
+		_recv_(ADM_READ_PARAM);
+		_send_(ADM_READ_PARAM, (uint8_t)i);
+	}
+	// not recorded, but counted and checked
+	_recv_(ADM_WRITE_PARAM);
+	_send_(ADM_WRITE_PARAM, 0x55);
+	TEST_ASSERT_EQUAL_UINT8(ADM_LOG_SZ + 1, sLog.u8Nb);
+	TEST_ASSERT_EQUAL_UINT8(1, sLog.bWriteParam);
+	for (i = 0; i < ADM_LOG_SZ; i++)
+	{
+		TEST_ASSERT_EQUAL_HEX8(ADM_READ_PARAM, sLog.aEnt[i].u8CmdId);
+		TEST_ASSERT_EQUAL_HEX8(i, sLog.aEnt[i].u8ErrCode);
+	}
+
+	// the counter saturate
+	for (i = 0; i < 300; i++)
+	{
+		_recv_(ADM_READ_PARAM);
+	}
+	TEST_ASSERT_EQUAL_UINT8(0xFF, sLog.u8Nb);
+}
+
+TEST(WizeCore_admlog, test_AdmLog_Reset)
+{
+	_recv_(ADM_WRITE_PARAM);
+	_send_(ADM_WRITE_PARAM, ADM_NONE);
+	AdmLog_Reset(&sLog);
+	TEST_ASSERT_EQUAL_UINT8(0, sLog.u8Nb);
+	TEST_ASSERT_EQUAL_UINT8(0, sLog.bWriteParam);
+	TEST_ASSERT_EQUAL_UINT8(0, sLog.aEnt[0].bRspSent);
+}
@@ -31,6 +31,8 @@ logger
 net_api
 	WizeNet_Init
 	WizeNet_Uninit
+	WizeNet_Suspend
+	WizeNet_Resume
 	WizeNet_Ioctl
 	WizeNet_Recv
 	WizeNet_Send
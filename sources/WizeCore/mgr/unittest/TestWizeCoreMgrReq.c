@@ -0,0 +1,284 @@
+#include "unity_fixture.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+TEST_GROUP(WizeCore_netreq);
+#include "net_req.h"
+
+/******************************************************************************/
+
+static struct net_req_queue_s sQueue;
+static net_msg_t aMsg[APP_TYPE_NB];
+static uint16_t u16Handle;
+
+/*
+ * Fill an entry as NetMgr_Submit / NetMgr_Send do, the deadline tick being
+ * given in ms (1 tick is 1 ms here)
+ */
+static void _fill_(struct net_req_ent_s *pEnt, uint8_t u8Type, uint32_t u32Submit, uint32_t u32Deadline)
+{
+	memset(pEnt, 0, sizeof(struct net_req_ent_s));
+	aMsg[u8Type].u8Type = u8Type;
+	pEnt->sReq.pxNetMsg = &aMsg[u8Type];
+	pEnt->sReq.eType = NET_REQ_SEND;
+	pEnt->sReq.u32SubmitTick = u32Submit;
+	pEnt->sReq.u32Deadline = u32Deadline;
+	pEnt->sReq.u16Handle = ++u16Handle;
+	pEnt->u32DeadlineTick = u32Submit + u32Deadline;
+}
+
+static int32_t _push_(uint8_t u8Type, uint32_t u32Submit, uint32_t u32Deadline)
+{
+	struct net_req_ent_s sEnt, sEvict;
+	uint8_t bEvict;
+	_fill_(&sEnt, u8Type, u32Submit, u32Deadline);
+	return NetReq_Push(&sQueue, &sEnt, &sEvict, &bEvict);
+}
+
+/******************************************************************************/
+TEST_SETUP(WizeCore_netreq)
+{
+	memset(&sQueue, 0, sizeof(sQueue));
+	u16Handle = 0;
+}
+
+TEST_TEAR_DOWN(WizeCore_netreq)
+{
+}
+
+/******************************************************************************/
+TEST(WizeCore_netreq, test_NetReq_Prio)
+{
+	TEST_ASSERT_EQUAL_UINT8(NET_REQ_PRIO_ALARM, NetReq_Prio(APP_DATA_PRIO));
+	TEST_ASSERT_EQUAL_UINT8(NET_REQ_PRIO_ADM, NetReq_Prio(APP_ADMIN));
+	TEST_ASSERT_EQUAL_UINT8(NET_REQ_PRIO_INST, NetReq_Prio(APP_INSTALL));
+	TEST_ASSERT_EQUAL_UINT8(NET_REQ_PRIO_DATA, NetReq_Prio(APP_DATA));
+}
+
+TEST(WizeCore_netreq, test_NetReq_Order)
+{
+	struct net_req_ent_s sEnt;
+
+	// DATA, INSTALL, DATA_PRIO, ADMIN : started on priority, then submit order
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, _push_(APP_DATA, 0, 0));
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, _push_(APP_INSTALL, 1, 0));
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, _push_(APP_DATA_PRIO, 2, 0));
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, _push_(APP_DATA, 3, 0));
+	TEST_ASSERT_EQUAL_UINT8(4, sQueue.sStats.u8Depth);
+
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Pop(&sQueue, &sEnt));
+	TEST_ASSERT_EQUAL_UINT16(3, sEnt.sReq.u16Handle);
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Pop(&sQueue, &sEnt));
+	TEST_ASSERT_EQUAL_UINT16(2, sEnt.sReq.u16Handle);
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Pop(&sQueue, &sEnt));
+	TEST_ASSERT_EQUAL_UINT16(1, sEnt.sReq.u16Handle);
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Pop(&sQueue, &sEnt));
+	TEST_ASSERT_EQUAL_UINT16(4, sEnt.sReq.u16Handle);
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Pop(&sQueue, &sEnt));
+	TEST_ASSERT_EQUAL_UINT8(0, sQueue.sStats.u8Depth);
+	TEST_ASSERT_EQUAL_UINT8(4, sQueue.sStats.u8DepthMax);
+	TEST_ASSERT_EQUAL_UINT32(4, sQueue.sStats.u32Queued);
+}
+
+TEST(WizeCore_netreq, test_NetReq_Deadline)
+{
+	struct net_req_ent_s sEnt;
+
+	// Same priority : the earliest deadline first, without deadline last
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, _push_(APP_DATA, 0, 0));
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, _push_(APP_DATA, 0, 3000));
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, _push_(APP_DATA, 500, 1000));
+
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Pop(&sQueue, &sEnt));
+	TEST_ASSERT_EQUAL_UINT16(3, sEnt.sReq.u16Handle);
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Pop(&sQueue, &sEnt));
+	TEST_ASSERT_EQUAL_UINT16(2, sEnt.sReq.u16Handle);
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Pop(&sQueue, &sEnt));
+	TEST_ASSERT_EQUAL_UINT16(1, sEnt.sReq.u16Handle);
+}
+
+TEST(WizeCore_netreq, test_NetReq_Full)
+{
+	struct net_req_ent_s sEnt, sEvict;
+	uint8_t bEvict;
+	uint8_t i;
+
+	for (i = 0; i < NET_MGR_REQ_QUEUE_NB; i++)
+	{
+		TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, _push_(APP_DATA, i, 0));
+	}
+	// Same priority : rejected
+	_fill_(&sEnt, APP_DATA, 10, 0);
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_BUSY, NetReq_Push(&sQueue, &sEnt, &sEvict, &bEvict));
+	TEST_ASSERT_EQUAL_UINT8(0, bEvict);
+	TEST_ASSERT_EQUAL_UINT32(1, sQueue.sStats.u32Rejected);
+
+	// Higher priority : the last DATA is evicted
+	_fill_(&sEnt, APP_ADMIN, 11, 0);
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, NetReq_Push(&sQueue, &sEnt, &sEvict, &bEvict));
+	TEST_ASSERT_EQUAL_UINT8(1, bEvict);
+	TEST_ASSERT_EQUAL_UINT16(NET_MGR_REQ_QUEUE_NB, sEvict.sReq.u16Handle);
+	TEST_ASSERT_EQUAL_UINT32(1, sQueue.sStats.u32Evicted);
+	TEST_ASSERT_EQUAL_UINT8(NET_MGR_REQ_QUEUE_NB, sQueue.u8Nb);
+
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Pop(&sQueue, &sEnt));
+	TEST_ASSERT_EQUAL_UINT16(u16Handle, sEnt.sReq.u16Handle);
+}
+
+TEST(WizeCore_netreq, test_NetReq_Expired)
+{
+	struct net_req_ent_s sEnt;
+
+	// No deadline : never expired
+	_fill_(&sEnt, APP_DATA, 100, 0);
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Expired(&sEnt, 100000));
+
+	_fill_(&sEnt, APP_DATA, 100, 1000);
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Expired(&sEnt, 100));
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Expired(&sEnt, 1100));
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Expired(&sEnt, 1101));
+
+	// Tick counter wrap
+	_fill_(&sEnt, APP_DATA, 0xFFFFFF00, 1000);
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Expired(&sEnt, 0x100));
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Expired(&sEnt, 0x300));
+}
+
+TEST(WizeCore_netreq, test_NetReq_SendStart)
+{
+	struct net_req_ent_s sEnt;
+
+	// A send queued by NetMgr_Send, with a short TX timeout : it must wait for
+	// its start up to NET_MGR_SEND_START_MS, not up to its TX timeout
+	_fill_(&sEnt, APP_DATA, 0, NET_MGR_SEND_START_MS);
+	sEnt.sReq.u32TimeOut = 10;
+	sEnt.bSync = 1;
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Expired(&sEnt, 100));
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Expired(&sEnt, NET_MGR_SEND_START_MS));
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Expired(&sEnt, NET_MGR_SEND_START_MS + 1));
+}
+
+TEST(WizeCore_netreq, test_NetReq_Complete)
+{
+	struct net_req_ent_s sEnt;
+	net_cpl_t sCpl;
+	uint32_t u32User;
+
+	// a send completes once, on send done
+	_fill_(&sEnt, APP_DATA, 10, 0);
+	sEnt.sReq.pUser = &u32User;
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Complete(&sEnt.sReq, NET_EVENT_FRM_PASSED, 0, &sCpl));
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Complete(&sEnt.sReq, NET_EVENT_SEND_DONE, 0, &sCpl));
+	TEST_ASSERT_EQUAL_UINT8(1, sCpl.bLast);
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, sCpl.i32Status);
+	TEST_ASSERT_EQUAL_UINT16(sEnt.sReq.u16Handle, sCpl.u16Handle);
+	TEST_ASSERT_EQUAL_PTR(&u32User, sCpl.pUser);
+	TEST_ASSERT_EQUAL_PTR(&aMsg[APP_DATA], sCpl.pxNetMsg);
+	TEST_ASSERT_EQUAL_UINT32(10, sCpl.u32SubmitTick);
+
+	// a send failure
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Complete(&sEnt.sReq, NET_EVENT_ERROR, 0, &sCpl));
+	TEST_ASSERT_EQUAL_UINT8(1, sCpl.bLast);
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_ERROR, sCpl.i32Status);
+
+	// a many listen gives each message, then ends on timeout
+	sEnt.sReq.eType = NET_REQ_LISTEN;
+	sEnt.sReq.eListenType = NET_LISTEN_TYPE_MANY;
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Complete(&sEnt.sReq, NET_EVENT_RECV_DONE, 0, &sCpl));
+	TEST_ASSERT_EQUAL_UINT8(0, sCpl.bLast);
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, sCpl.i32Status);
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Complete(&sEnt.sReq, NET_EVENT_RECV_DONE, 0, &sCpl));
+	TEST_ASSERT_EQUAL_UINT8(0, sCpl.bLast);
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Complete(&sEnt.sReq, NET_EVENT_TIMEOUT, 0, &sCpl));
+	TEST_ASSERT_EQUAL_UINT8(1, sCpl.bLast);
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_ERROR, sCpl.i32Status);
+
+	// a one listen ends on its message
+	sEnt.sReq.eListenType = NET_LISTEN_TYPE_ONE;
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Complete(&sEnt.sReq, NET_EVENT_RECV_DONE, 0, &sCpl));
+	TEST_ASSERT_EQUAL_UINT8(1, sCpl.bLast);
+
+	// an aborted listen ends, whatever the event
+	sEnt.sReq.eListenType = NET_LISTEN_TYPE_MANY;
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Complete(&sEnt.sReq, 0, 1, &sCpl));
+	TEST_ASSERT_EQUAL_UINT8(1, sCpl.bLast);
+}
+
+TEST(WizeCore_netreq, test_NetReq_Cancel)
+{
+	struct net_req_ent_s sEnt;
+	net_cpl_t sCpl;
+	uint16_t u16Expect = 1;
+
+	// NetMgr_Close : every pending request is given back, canceled
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, _push_(APP_DATA, 0, 0));
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, _push_(APP_DATA, 1, 0));
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, _push_(APP_DATA, 2, 0));
+	while ( NetReq_Pop(&sQueue, &sEnt) )
+	{
+		NetReq_Drop(&sEnt.sReq, NET_EVENT_ERROR | NET_EVENT_CANCELED, NET_STATUS_ERROR, 100, &sCpl);
+		TEST_ASSERT_EQUAL_UINT16(u16Expect++, sCpl.u16Handle);
+		TEST_ASSERT_EQUAL_UINT32(NET_EVENT_ERROR | NET_EVENT_CANCELED, sCpl.u32Evt);
+		TEST_ASSERT_EQUAL_INT32(NET_STATUS_ERROR, sCpl.i32Status);
+		TEST_ASSERT_EQUAL_UINT8(1, sCpl.bLast);
+		TEST_ASSERT_EQUAL_UINT32(100, sCpl.u32StartTick);
+		TEST_ASSERT_EQUAL_UINT32(100, sCpl.u32EndTick);
+	}
+	TEST_ASSERT_EQUAL_UINT16(4, u16Expect);
+	TEST_ASSERT_EQUAL_UINT8(0, sQueue.sStats.u8Depth);
+}
+
+TEST(WizeCore_netreq, test_NetReq_InProgress)
+{
+	struct net_req_ent_s sEnt;
+
+	// a listen is in progress, a DATA send is queued behind it
+	_fill_(&sEnt, APP_DATA, 0, 0);
+	sEnt.u8Prio = NetReq_Prio(APP_DATA);
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Preempt(&sEnt, NET_REQ_LISTEN, NET_REQ_PRIO_INST));
+	// a DATA_PRIO send preempts it
+	_fill_(&sEnt, APP_DATA_PRIO, 0, 0);
+	sEnt.u8Prio = NetReq_Prio(APP_DATA_PRIO);
+	TEST_ASSERT_EQUAL_UINT8(1, NetReq_Preempt(&sEnt, NET_REQ_LISTEN, NET_REQ_PRIO_INST));
+	// ... but not a send in progress, nor a DATA_PRIO listen
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Preempt(&sEnt, NET_REQ_SEND, NET_REQ_PRIO_DATA));
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Preempt(&sEnt, NET_REQ_LISTEN, NET_REQ_PRIO_ALARM));
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Preempt(&sEnt, 0, NET_REQ_PRIO_DATA));
+	// a DATA_PRIO listen doesn't preempt
+	sEnt.sReq.eType = NET_REQ_LISTEN;
+	TEST_ASSERT_EQUAL_UINT8(0, NetReq_Preempt(&sEnt, NET_REQ_LISTEN, NET_REQ_PRIO_INST));
+}
+
+TEST(WizeCore_netreq, test_NetReq_RxAt)
+{
+	uint32_t u32Wake;
+	uint16_t u16Arm;
+
+	// window in the future : the PHY is waked-up the lead time before
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, NetReq_RxAt(0, 5000, NET_MGR_RX_LEAD_MS, &u32Wake, &u16Arm));
+	TEST_ASSERT_EQUAL_UINT32(5000 - NET_MGR_RX_LEAD_MS, u32Wake);
+	TEST_ASSERT_EQUAL_UINT16(NET_MGR_RX_LEAD_MS, u16Arm);
+	TEST_ASSERT_EQUAL_UINT32(5000, u32Wake + u16Arm);
+
+	// window closer than the lead time : wake-up now, armed on the window
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, NetReq_RxAt(0, NET_MGR_RX_LEAD_MS, NET_MGR_RX_LEAD_MS, &u32Wake, &u16Arm));
+	TEST_ASSERT_EQUAL_UINT32(0, u32Wake);
+	TEST_ASSERT_EQUAL_UINT16(NET_MGR_RX_LEAD_MS, u16Arm);
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, NetReq_RxAt(0, 3, NET_MGR_RX_LEAD_MS, &u32Wake, &u16Arm));
+	TEST_ASSERT_EQUAL_UINT32(0, u32Wake);
+	TEST_ASSERT_EQUAL_UINT16(3, u16Arm);
+
+	// window already passed : wake-up and arm now
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_OK, NetReq_RxAt(0, 0, NET_MGR_RX_LEAD_MS, &u32Wake, &u16Arm));
+	TEST_ASSERT_EQUAL_UINT32(0, u32Wake);
+	TEST_ASSERT_EQUAL_UINT16(0, u16Arm);
+
+	// a window is pending or a session is active : busy, nothing changed
+	u32Wake = 0x55;
+	u16Arm = 0xAA;
+	TEST_ASSERT_EQUAL_INT32(NET_STATUS_BUSY, NetReq_RxAt(1, 5000, NET_MGR_RX_LEAD_MS, &u32Wake, &u16Arm));
+	TEST_ASSERT_EQUAL_UINT32(0x55, u32Wake);
+	TEST_ASSERT_EQUAL_UINT16(0xAA, u16Arm);
+}
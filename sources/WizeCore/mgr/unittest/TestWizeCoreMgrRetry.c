@@ -0,0 +1,174 @@
+#include "unity_fixture.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+TEST_GROUP(WizeCore_netretry);
+#include "net_retry.h"
+
+/******************************************************************************/
+
+static struct net_retry_s sRetry;
+
+/******************************************************************************/
+TEST_SETUP(WizeCore_netretry)
+{
+	NetRetry_Init(&sRetry, 1);
+}
+
+TEST_TEAR_DOWN(WizeCore_netretry)
+{
+}
+
+/******************************************************************************/
+TEST(WizeCore_netretry, test_NetRetry_Config)
+{
+	struct net_retry_cfg_s sCfg;
+
+	memset(&sCfg, 0, sizeof(sCfg));
+	TEST_ASSERT_EQUAL_INT32(-1, NetRetry_Config(NULL, &sCfg));
+	TEST_ASSERT_EQUAL_INT32(-1, NetRetry_Config(&sRetry, NULL));
+
+	sCfg.eStrategy = NET_RETRY_STRATEGY_NB;
+	TEST_ASSERT_EQUAL_INT32(-1, NetRetry_Config(&sRetry, &sCfg));
+
+	sCfg.eStrategy = NET_RETRY_EXP;
+	sCfg.u8JitterPct = 101;
+	TEST_ASSERT_EQUAL_INT32(-1, NetRetry_Config(&sRetry, &sCfg));
+
+	sCfg.u8JitterPct = 0;
+	sCfg.u16DelayMs = 100;
+	sCfg.u16DelayMaxMs = 50;
+	TEST_ASSERT_EQUAL_INT32(-1, NetRetry_Config(&sRetry, &sCfg));
+
+	sCfg.u16DelayMaxMs = 1000;
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Config(&sRetry, &sCfg));
+	TEST_ASSERT_EQUAL_UINT8(NET_RETRY_EXP, sRetry.sCfg.eStrategy);
+}
+
+TEST(WizeCore_netretry, test_NetRetry_Fixed)
+{
+	// Default : back to back, up to the operation maximum
+	NetRetry_Start(&sRetry, NET_RETRY_OP_TX, 2);
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0));
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Next(&sRetry, NET_RETRY_OUT_ERROR, 0, 0));
+	TEST_ASSERT_EQUAL_INT32(-1, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, sRetry.sStats.u32GiveUpMax);
+	TEST_ASSERT_EQUAL_UINT32(1, sRetry.sStats.aRetry[NET_RETRY_OP_TX][NET_RETRY_OUT_BUSY]);
+	TEST_ASSERT_EQUAL_UINT32(1, sRetry.sStats.aRetry[NET_RETRY_OP_TX][NET_RETRY_OUT_ERROR]);
+
+	NetRetry_Start(&sRetry, NET_RETRY_OP_RX, 1);
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0));
+	NetRetry_Done(&sRetry);
+	TEST_ASSERT_EQUAL_UINT32(1, sRetry.sStats.aRecovered[NET_RETRY_OP_RX]);
+}
+
+TEST(WizeCore_netretry, test_NetRetry_Budget)
+{
+	struct net_retry_cfg_s sCfg;
+
+	memset(&sCfg, 0, sizeof(sCfg));
+	sCfg.eStrategy = NET_RETRY_FIXED;
+	sCfg.u16DelayMs = 20;
+	sCfg.u16Budget = 2;
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Config(&sRetry, &sCfg));
+
+	NetRetry_Start(&sRetry, NET_RETRY_OP_TX, 5);
+	TEST_ASSERT_EQUAL_INT32(20, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0));
+	NetRetry_Start(&sRetry, NET_RETRY_OP_TX, 5);
+	TEST_ASSERT_EQUAL_INT32(20, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0));
+	TEST_ASSERT_EQUAL_INT32(-1, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, sRetry.sStats.u32GiveUpBudget);
+	TEST_ASSERT_EQUAL_UINT32(40, sRetry.sStats.u32DelayMs);
+
+	// A new session restore the budget
+	NetRetry_Session(&sRetry, 0x1234);
+	TEST_ASSERT_EQUAL_INT32(20, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0));
+}
+
+TEST(WizeCore_netretry, test_NetRetry_Backoff)
+{
+	struct net_retry_cfg_s sCfg;
+	int32_t i32Delay;
+	uint8_t i;
+
+	memset(&sCfg, 0, sizeof(sCfg));
+	sCfg.eStrategy = NET_RETRY_EXP;
+	sCfg.u16DelayMs = 100;
+	sCfg.u16DelayMaxMs = 500;
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Config(&sRetry, &sCfg));
+
+	// Without jitter : 100, 200, 400, then capped
+	NetRetry_Start(&sRetry, NET_RETRY_OP_TX, 5);
+	TEST_ASSERT_EQUAL_INT32(100, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0));
+	TEST_ASSERT_EQUAL_INT32(200, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0));
+	TEST_ASSERT_EQUAL_INT32(400, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0));
+	TEST_ASSERT_EQUAL_INT32(500, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0));
+
+	// With 20 % jitter, always in [delay - 20 %, delay + 20 %]
+	sCfg.u8JitterPct = 20;
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Config(&sRetry, &sCfg));
+	for (i = 0; i < 50; i++)
+	{
+		NetRetry_Start(&sRetry, NET_RETRY_OP_TX, 1);
+		i32Delay = NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0);
+		TEST_ASSERT_GREATER_OR_EQUAL(80, i32Delay);
+		TEST_ASSERT_LESS_OR_EQUAL(120, i32Delay);
+	}
+}
+
+TEST(WizeCore_netretry, test_NetRetry_FrmError)
+{
+	// Received frame in error or not expected : listen again, never delayed,
+	// doesn't consume the retries
+	NetRetry_Start(&sRetry, NET_RETRY_OP_RX, 0);
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Next(&sRetry, NET_RETRY_OUT_FRM_ERR, 0, 0));
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Next(&sRetry, NET_RETRY_OUT_PASSED, 0, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, sRetry.sStats.aRetry[NET_RETRY_OP_RX][NET_RETRY_OUT_FRM_ERR]);
+	TEST_ASSERT_EQUAL_UINT32(1, sRetry.sStats.aRetry[NET_RETRY_OP_RX][NET_RETRY_OUT_PASSED]);
+}
+
+TEST(WizeCore_netretry, test_NetRetry_LinkNoise)
+{
+	struct net_retry_cfg_s sCfg;
+
+	// Give up when the noise is above -100 dBm
+	memset(&sCfg, 0, sizeof(sCfg));
+	sCfg.eStrategy = NET_RETRY_LINK;
+	sCfg.u16DelayMs = 10;
+	sCfg.u16DelayMaxMs = 10;
+	sCfg.u8NoiseMax = 100;
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Config(&sRetry, &sCfg));
+
+	// Quiet channel (-120 dBm), as measured by the LBT
+	NetRetry_Start(&sRetry, NET_RETRY_OP_TX, 5);
+	TEST_ASSERT_EQUAL_INT32(10, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 120));
+	// Exactly at the limit
+	TEST_ASSERT_EQUAL_INT32(10, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 100));
+	// Unknown noise
+	TEST_ASSERT_EQUAL_INT32(10, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 0));
+	// Noisy channel (-85 dBm)
+	TEST_ASSERT_EQUAL_INT32(-1, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 85));
+	TEST_ASSERT_EQUAL_UINT32(1, sRetry.sStats.u32GiveUpLink);
+
+	// Noise is not used on RX
+	NetRetry_Start(&sRetry, NET_RETRY_OP_RX, 5);
+	TEST_ASSERT_EQUAL_INT32(10, NetRetry_Next(&sRetry, NET_RETRY_OUT_BUSY, 0, 85));
+}
+
+TEST(WizeCore_netretry, test_NetRetry_LinkRssi)
+{
+	struct net_retry_cfg_s sCfg;
+
+	memset(&sCfg, 0, sizeof(sCfg));
+	sCfg.eStrategy = NET_RETRY_LINK;
+	sCfg.u8RssiMin = 60;
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Config(&sRetry, &sCfg));
+
+	NetRetry_Start(&sRetry, NET_RETRY_OP_RX, 5);
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Next(&sRetry, NET_RETRY_OUT_FRM_ERR, 80, 0));
+	TEST_ASSERT_EQUAL_INT32(0, NetRetry_Next(&sRetry, NET_RETRY_OUT_PASSED, 40, 0));
+	TEST_ASSERT_EQUAL_INT32(-1, NetRetry_Next(&sRetry, NET_RETRY_OUT_FRM_ERR, 40, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, sRetry.sStats.u32GiveUpLink);
+}
@@ -0,0 +1,121 @@
+#include "unity_fixture.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+TEST_GROUP(WizeCore_nettrace);
+#include "net_trace.h"
+
+/******************************************************************************/
+
+/*
+ * This is the ring NetMgr_TraceGet reads (under a critical section). The
+ * records are numbered by their sequence : time stamp 100 * seq, event and
+ * argument from the sequence.
+ */
+static struct net_trace_ring_s sRing;
+static net_trace_t aOut[NET_MGR_TRACE_NB + 4];
+
+static void _put_(uint32_t u32Nb)
+{
+	uint32_t i, u32Seq;
+	for (i = 0; i < u32Nb; i++)
+	{
+		u32Seq = sRing.u32Seq;
+		NetTrace_Put(&sRing, 100 * u32Seq, (uint8_t)(u32Seq % NET_TRACE_NB), 1, (uint16_t)u32Seq);
+	}
+}
+
+static void _check_(uint32_t u32First, uint32_t u32Nb)
+{
+	uint32_t i;
+	for (i = 0; i < u32Nb; i++)
+	{
+		TEST_ASSERT_EQUAL_UINT32(100 * (u32First + i), aOut[i].u32Us);
+		TEST_ASSERT_EQUAL_UINT8((u32First + i) % NET_TRACE_NB, aOut[i].u8Evt);
+		TEST_ASSERT_EQUAL_UINT8(1, aOut[i].u8State);
+		TEST_ASSERT_EQUAL_UINT16((uint16_t)(u32First + i), aOut[i].u16Arg);
+	}
+}
+
+/******************************************************************************/
+TEST_SETUP(WizeCore_nettrace)
+{
+	memset(&sRing, 0, sizeof(sRing));
+	memset(aOut, 0, sizeof(aOut));
+}
+
+TEST_TEAR_DOWN(WizeCore_nettrace)
+{
+}
+
+/******************************************************************************/
+TEST(WizeCore_nettrace, test_NetTrace_Empty)
+{
+	uint32_t u32Seq = 0xFFFF;
+
+	TEST_ASSERT_EQUAL_UINT32(0, NetTrace_Get(&sRing, aOut, NET_MGR_TRACE_NB, &u32Seq));
+	TEST_ASSERT_EQUAL_UINT32(0, u32Seq);
+	TEST_ASSERT_EQUAL_UINT32(0, NetTrace_Get(&sRing, NULL, NET_MGR_TRACE_NB, NULL));
+	TEST_ASSERT_EQUAL_UINT32(0, NetTrace_Get(NULL, aOut, NET_MGR_TRACE_NB, NULL));
+
+	// the record layout is part of the decoding script format
+	TEST_ASSERT_EQUAL(8, sizeof(net_trace_t));
+}
+
+TEST(WizeCore_nettrace, test_NetTrace_Order)
+{
+	uint32_t u32Seq;
+
+	_put_(5);
+	// all of them, the oldest first
+	TEST_ASSERT_EQUAL_UINT32(5, NetTrace_Get(&sRing, aOut, NET_MGR_TRACE_NB, &u32Seq));
+	TEST_ASSERT_EQUAL_UINT32(0, u32Seq);
+	_check_(0, 5);
+
+	// a smaller buffer get the latest ones
+	memset(aOut, 0, sizeof(aOut));
+	TEST_ASSERT_EQUAL_UINT32(2, NetTrace_Get(&sRing, aOut, 2, &u32Seq));
+	TEST_ASSERT_EQUAL_UINT32(3, u32Seq);
+	_check_(3, 2);
+}
+
+TEST(WizeCore_nettrace, test_NetTrace_Wrap)
+{
+	uint32_t u32Seq;
+
+	// the oldest records are overwritten
+	_put_(NET_MGR_TRACE_NB + 3);
+	TEST_ASSERT_EQUAL_UINT32(NET_MGR_TRACE_NB + 3, sRing.u32Seq);
+	TEST_ASSERT_EQUAL_UINT32(NET_MGR_TRACE_NB, NetTrace_Get(&sRing, aOut, NET_MGR_TRACE_NB + 4, &u32Seq));
+	TEST_ASSERT_EQUAL_UINT32(3, u32Seq);
+	_check_(3, NET_MGR_TRACE_NB);
+
+	// the sequence go on over many laps
+	_put_(3 * NET_MGR_TRACE_NB + 1);
+	TEST_ASSERT_EQUAL_UINT32(4, NetTrace_Get(&sRing, aOut, 4, &u32Seq));
+	TEST_ASSERT_EQUAL_UINT32(4 * NET_MGR_TRACE_NB, u32Seq);
+	_check_(4 * NET_MGR_TRACE_NB, 4);
+}
+
+TEST(WizeCore_nettrace, test_NetTrace_Snapshot)
+{
+	uint32_t u32Seq, u32Last;
+
+	// two snapshots : the records lost in between are detected
+	_put_(10);
+	TEST_ASSERT_EQUAL_UINT32(10, NetTrace_Get(&sRing, aOut, NET_MGR_TRACE_NB, &u32Seq));
+	u32Last = u32Seq + 10;
+
+	_put_(NET_MGR_TRACE_NB + 6);
+	TEST_ASSERT_EQUAL_UINT32(NET_MGR_TRACE_NB, NetTrace_Get(&sRing, aOut, NET_MGR_TRACE_NB, &u32Seq));
+	TEST_ASSERT_EQUAL_UINT32(6, u32Seq - u32Last);
+	_check_(u32Seq, NET_MGR_TRACE_NB);
+
+	// time stamps given by the caller are kept as they are (not re-ordered)
+	NetTrace_Put(&sRing, 5, NET_TRACE_RX_STARTED, 2, 0);
+	TEST_ASSERT_EQUAL_UINT32(1, NetTrace_Get(&sRing, aOut, 1, NULL));
+	TEST_ASSERT_EQUAL_UINT32(5, aOut[0].u32Us);
+	TEST_ASSERT_EQUAL_UINT8(NET_TRACE_RX_STARTED, aOut[0].u8Evt);
+}
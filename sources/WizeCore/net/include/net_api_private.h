@@ -50,6 +50,27 @@ extern "C" {
 #ifndef SEND_BUF_SZ
 #define SEND_BUF_SZ 256
 #endif
+#ifndef RECV_RING_DEPTH
+#define RECV_RING_DEPTH 4
+#endif
+#ifndef AIRTIME_SLOT_NB
+#define AIRTIME_SLOT_NB 12 // Number of slots in one airtime sliding window
+#endif
+#ifndef LBT_MAX_ATTEMPTS
+#define LBT_MAX_ATTEMPTS 4 // Default number of CCA attempts before giving up
+#endif
+#ifndef LBT_BACKOFF_MIN
+#define LBT_BACKOFF_MIN 20 // Default minimum backoff (ms)
+#endif
+#ifndef LBT_BACKOFF_MAX
+#define LBT_BACKOFF_MAX 500 // Default maximum backoff (ms)
+#endif
+#ifndef NETDEV_PHY_NB
+#define NETDEV_PHY_NB 2 // Maximum number of PHY behind one netdev (primary included)
+#endif
+#if NETDEV_PHY_NB < 2
+#error "NETDEV_PHY_NB must be at least 2"
+#endif
 /*!
  * @}
  * @endcond
@@ -92,10 +113,45 @@ typedef enum
 	_NETDEV_CTL_STATS_,        /*!< Delimiter for netdev statistics control */
 	NETDEV_CTL_GET_STATS,      /*!< Get the statistics */
 	NETDEV_CTL_CLR_STATS,      /*!< Clear the statistics */
+	NETDEV_CTL_GET_STATS_EX,   /*!< Get the extended statistics (see @link netdev_stats_s @endlink) */
+	NETDEV_CTL_GET_AIRTIME,    /*!< Get the airtime and duty-cycle usage (see @link netdev_airtime_s @endlink) */
+
+	_NETDEV_CTL_RECV_,         /*!< Delimiter for netdev reception ring control */
+	NETDEV_CTL_GET_RECV_NB,    /*!< Get the number of frames waiting in the reception ring */
+	NETDEV_CTL_FLUSH_RECV,     /*!< Flush the reception ring */
+
+	_NETDEV_CTL_PHY_,          /*!< Delimiter for netdev PHY routing control */
+	NETDEV_CTL_SET_ROUTE,      /*!< Set the PHY of a route ((route << 8) | PHY index, see netdev_route_e) */
+	NETDEV_CTL_GET_ROUTE,      /*!< Get the PHY index of the given route (see netdev_route_e) */
+	NETDEV_CTL_GET_PHY_NB,     /*!< Get the number of attached PHYs */
+	NETDEV_CTL_GET_PHY_STATE,  /*!< Get the state of the given PHY index (see netdev_state_e) */
+
+	// ---- Appended, to keep the values above unchanged
+	_NETDEV_CTL_CFG_EX_,       /*!< Delimiter for netdev additional configuration control */
+	NETDEV_CTL_SET_RECV_DEPTH, /*!< Set the reception ring depth (1 to RECV_RING_DEPTH) */
+	NETDEV_CTL_SET_DUTY_1H,    /*!< Set the TX duty-cycle limit on 1 hour (in 1/10000, 0 : no limit) */
+	NETDEV_CTL_SET_DUTY_24H,   /*!< Set the TX duty-cycle limit on 24 hours (in 1/10000, 0 : no limit) */
+	NETDEV_CTL_SET_CCA_THRES,  /*!< Set the CCA noise threshold (as PHY_CTL_GET_NOISE, 0 : no CCA) */
+	NETDEV_CTL_SET_CCA_ATTEMPTS, /*!< Set the maximum number of CCA attempts for one frame */
+	NETDEV_CTL_SET_BACKOFF,    /*!< Set the backoff range in ms ((max << 16) | min) */
+	NETDEV_CTL_GET_BACKOFF,    /*!< Get the backoff (ms) to apply before the next attempt (0 : give up), even if a PHY is busy */
 
-	NETDEV_CTL_PHY_CMD = 0x8000,  /*!< Pass command to the PHY */
+	NETDEV_CTL_PHY_RX  = 0x2000,  /*!< With NETDEV_CTL_PHY_CMD, only the PHY of the RX route */
+	NETDEV_CTL_PHY_TX  = 0x4000,  /*!< With NETDEV_CTL_PHY_CMD, only the PHY of the TX route */
+	NETDEV_CTL_PHY_CMD = 0x8000,  /*!< Pass command to the PHY (all PHYs if no route is given) */
 } netdev_ctl_e;
 
+/*!
+ * @brief This define the netdev routes, that is which PHY is used for each
+ * direction
+ */
+typedef enum {
+	NETDEV_ROUTE_TX = 0x0, /*!< Transmission (WizeNet_Send) */
+	NETDEV_ROUTE_RX = 0x1, /*!< Reception (WizeNet_Listen, WizeNet_Recv, WizeNet_Capture) */
+	//
+	NETDEV_ROUTE_NB,
+} netdev_route_e;
+
 /*!
  * @brief This define the netdev possible events
  */
@@ -119,8 +175,20 @@ typedef enum {
     NETDEV_STATUS_OK     = 0x0, /*!< Net device return status OK */
 	NETDEV_STATUS_ERROR  = 0x1, /*!< Net device return status ERROR */
 	NETDEV_STATUS_BUSY   = 0x2, /*!< Net device return status BUSY */
+	NETDEV_STATUS_DUTY   = 0x3, /*!< Net device return status duty-cycle limit reached */
+	NETDEV_STATUS_CCA    = 0x4, /*!< Net device return status channel busy (CCA) */
 } netdev_status_e;
 
+/*!
+ * @brief This define the airtime sliding windows
+ */
+typedef enum {
+	AIRTIME_WIN_1H  = 0x0, /*!< 1 hour window (AIRTIME_SLOT_NB slots) */
+	AIRTIME_WIN_24H = 0x1, /*!< 24 hours window (AIRTIME_SLOT_NB slots) */
+	//
+	AIRTIME_WIN_NB,
+} airtime_win_e;
+
 /*!
  * @brief This define the netdev possible error types
  */
@@ -138,6 +206,7 @@ typedef enum {
     NETDEV_STATE_UNKWON = 0x0, /*!< Net Device state is UNKNOWN */
 	NETDEV_STATE_IDLE   = 0x1, /*!< Net device is IDLE */
 	NETDEV_STATE_BUSY   = 0x2, /*!< Net device is BUSY */
+	NETDEV_STATE_SUSPEND = 0x4, /*!< Net device is SUSPENDED (PHY sleeping, configuration kept) */
 	NETDEV_STATE_ERROR  = 0x8, /*!< Net device is ERROR */
 } netdev_state_e;
 
@@ -151,16 +220,32 @@ typedef struct netdev_s netdev_t;
  */
 typedef void (*netdev_evt_cb_t)(uint32_t eEvt);
 
+/*!
+ * @brief This define an additional PHY (see WizeNet_AddPhy)
+ */
+struct netdev_phy_s {
+    phydev_t *pPhydev;          /*!< Pointer on phy context */
+    netdev_t *pNetdev;          /*!< Owner netdev (phy call-back parameter) */
+    netdev_state_e eState;      /*!< Current state */
+    uint8_t u8Id;               /*!< PHY index */
+};
+
 /*!
  * @brief This define the netdev context
+ *
+ * @details The primary PHY (index 0) is pPhydev, its state is eState.
+ * Additional PHYs (index 1 to u8PhyNb - 1) are in aPhyEx.
  */
 struct netdev_s {
     void *pCtx;                 /*!< Pointer on internal context */
     void *hLock;                /*!< Pointer on lock */
-    phydev_t *pPhydev;          /*!< Pointer on phy context */
-    netdev_state_e eState;      /*!< Current state  */
+    phydev_t *pPhydev;          /*!< Pointer on (primary) phy context */
+    netdev_state_e eState;      /*!< Current state (of the primary phy) */
     netdev_evt_cb_t cbEvent;    /*!< Event call-back */
     netdev_err_type_e eErrType; /*!< Last error type */
+    struct netdev_phy_s aPhyEx[NETDEV_PHY_NB - 1]; /*!< Additional PHYs */
+    uint8_t u8PhyNb;            /*!< Number of attached PHYs (primary included) */
+    uint8_t aRoute[NETDEV_ROUTE_NB]; /*!< PHY index per route (see netdev_route_e) */
  };
 
 /*!
@@ -179,6 +264,196 @@ struct medium_cfg_s {
 } ;
 
 
+/*!
+ * @brief This structure define the per channel and per modulation statistics
+ */
+struct link_stats_s {
+	uint32_t aTxFrmPerCh[PHY_NB_CH];   /*!< Number of transmitted frames per channel */
+	uint32_t aRxFrmPerCh[PHY_NB_CH];   /*!< Number of received frames (without error) per channel */
+	uint32_t aRxErrPerCh[PHY_NB_CH];   /*!< Number of received frames with error per channel */
+	uint32_t aTxFrmPerMod[PHY_NB_MOD]; /*!< Number of transmitted frames per modulation */
+	uint32_t aRxFrmPerMod[PHY_NB_MOD]; /*!< Number of received frames (without error) per modulation */
+	uint32_t aRxErrPerMod[PHY_NB_MOD]; /*!< Number of received frames with error per modulation */
+};
+
+/*!
+ * @brief This structure define the reception ring statistics
+ */
+struct recv_ring_stats_s {
+	uint32_t u32Queued;   /*!< Number of frames put into the ring */
+	uint32_t u32Overflow; /*!< Number of frames dropped because the ring was full */
+	uint32_t u32Flushed;  /*!< Number of frames dropped by a flush */
+	uint8_t  u8HighWater; /*!< Maximum number of frames seen in the ring */
+	uint8_t  u8Depth;     /*!< Current ring depth */
+	uint8_t  u8Reserved[2];
+};
+
+/*!
+ * @brief This structure define one raw received frame
+ */
+struct recv_frm_s {
+	uint32_t u32Epoch;           /*!< Reception time */
+	phy_tstamp_t sSyncTime;      /*!< Sync word detection time */
+	phy_chan_e eChannel;         /*!< Channel the frame was received on */
+	phy_mod_e  eModulation;      /*!< Modulation the frame was received with */
+	uint8_t  u8Phy;              /*!< PHY index that received the frame */
+	uint8_t  u8Rssi;             /*!< Reception RSSI */
+	uint8_t  u8Size;             /*!< Frame size (as given by the PHY) */
+	uint8_t  aBuff[RECV_BUF_SZ]; /*!< Raw frame (first byte is reserved for the L-field) */
+};
+
+/*!
+ * @brief This structure define the reception ring. It is filled from the RX
+ * complete path (see WizeNet_Capture) and drained by WizeNet_Recv.
+ */
+struct recv_ring_s {
+	struct recv_frm_s aFrm[RECV_RING_DEPTH]; /*!< Frames */
+	uint8_t u8Head;                          /*!< Next slot to write */
+	uint8_t u8Tail;                          /*!< Next slot to read */
+	uint8_t u8Count;                         /*!< Number of frames in the ring */
+	struct recv_ring_stats_s sStats;         /*!< Ring statistics */
+};
+
+/*!
+ * @brief This structure define the PHY configuration shadow statistics
+ */
+struct phy_shadow_stats_s {
+	uint32_t u32Writes;  /*!< Number of PHY configuration writes (ioctl calls) */
+	uint32_t u32Avoided; /*!< Number of PHY configuration writes avoided (unchanged field) */
+	uint32_t u32Batched; /*!< Number of PHY configuration writes done with PHY_CTL_SET_MULTI */
+};
+
+/*!
+ * @brief This structure define the PHY configuration shadow, that is what have
+ * been applied on the PHY. Only the changed fields are pushed to the PHY.
+ */
+struct phy_shadow_s {
+	phy_power_e eTxPower;             /*!< TX power applied on the PHY */
+	int16_t     i16TxFreqOffset;      /*!< TX frequency offset applied on the PHY */
+	uint8_t     u8Valid;              /*!< Fields known to be applied (see phy_cfg_field_e) */
+	struct phy_shadow_stats_s sStats; /*!< Shadow statistics */
+};
+
+/*!
+ * @brief This structure define one airtime sliding window. Each slot hold the
+ * time (in ms) spent in TX and RX during its period, per channel.
+ */
+struct airtime_win_s {
+	uint32_t aTx[PHY_NB_CH][AIRTIME_SLOT_NB]; /*!< TX time per channel and slot */
+	uint32_t aRx[PHY_NB_CH][AIRTIME_SLOT_NB]; /*!< RX-on time per channel and slot */
+	uint32_t u32SlotId;                       /*!< Current slot (time / slot duration) */
+};
+
+/*!
+ * @brief This structure define the airtime accounting and the duty-cycle limits
+ */
+struct airtime_s {
+	struct airtime_win_s aWin[AIRTIME_WIN_NB]; /*!< Sliding windows */
+	uint32_t aTxTotal[PHY_NB_CH];  /*!< Total TX time per channel (ms) */
+	uint32_t aRxTotal[PHY_NB_CH];  /*!< Total RX-on time per channel (ms) */
+	uint32_t u32Rejected;          /*!< Number of transmissions refused by the duty-cycle limit */
+	uint32_t u32RxStart;           /*!< RX start time (ms) */
+	uint16_t aDutyLimit[AIRTIME_WIN_NB]; /*!< TX duty-cycle limit (in 1/10000, 0 : no limit) */
+	phy_chan_e eRxChannel;         /*!< Channel of the current RX */
+	uint8_t  bRxOn;                /*!< RX is on */
+};
+
+/*!
+ * @brief This structure define the airtime usage returned by
+ * NETDEV_CTL_GET_AIRTIME
+ */
+typedef struct netdev_airtime_s {
+	uint32_t aTxTotal[PHY_NB_CH];                /*!< Total TX time per channel (ms) */
+	uint32_t aRxTotal[PHY_NB_CH];                /*!< Total RX-on time per channel (ms) */
+	uint32_t aTxWin[AIRTIME_WIN_NB][PHY_NB_CH];  /*!< TX time per window and channel (ms) */
+	uint32_t aRxWin[AIRTIME_WIN_NB][PHY_NB_CH];  /*!< RX-on time per window and channel (ms) */
+	uint32_t aTxBudget[AIRTIME_WIN_NB];          /*!< Remaining TX time per window (ms, UINT32_MAX : no limit) */
+	uint16_t aDutyUsed[AIRTIME_WIN_NB];          /*!< TX duty-cycle used per window (in 1/10000, all channels) */
+	uint16_t aDutyLimit[AIRTIME_WIN_NB];         /*!< TX duty-cycle limit per window (in 1/10000, 0 : no limit) */
+	uint32_t u32Rejected;                        /*!< Number of transmissions refused by the duty-cycle limit */
+} netdev_airtime_t;
+
+/*!
+ * @brief This structure define the listen before talk statistics
+ */
+struct lbt_stats_s {
+	uint32_t u32Cca;       /*!< Number of CCA done */
+	uint32_t u32Busy;      /*!< Number of CCA that find the channel busy */
+	uint32_t u32Backoff;   /*!< Number of backoff given */
+	uint32_t u32BackoffMs; /*!< Total backoff time given (ms) */
+	uint32_t u32GiveUp;    /*!< Number of frames given up after the maximum attempts */
+};
+
+/*!
+ * @brief This structure define the listen before talk configuration and state
+ */
+struct lbt_s {
+	uint16_t u16BackoffMin;   /*!< Minimum backoff (ms) */
+	uint16_t u16BackoffMax;   /*!< Maximum backoff (ms) */
+	uint8_t  u8Threshold;     /*!< Noise threshold (as PHY_CTL_GET_NOISE, that is
+	                               the opposite of the dBm value), 0 : no CCA */
+	uint8_t  u8MaxAttempts;   /*!< Maximum number of CCA attempts for one frame */
+	uint8_t  u8Attempt;       /*!< Current attempt */
+	uint8_t  u8Noise;         /*!< Last measured noise */
+	uint32_t u32Rand;         /*!< Backoff random generator state */
+	struct lbt_stats_s sStats; /*!< Statistics */
+};
+
+/*!
+ * @brief This structure define the open (PHY init or resume) statistics
+ */
+struct open_stats_s {
+	uint32_t u32Cold;      /*!< Number of cold opens (full PHY initialization) */
+	uint32_t u32Warm;      /*!< Number of warm opens (PHY resumed from sleep) */
+	uint32_t u32WarmFail;  /*!< Number of failed resume */
+	uint32_t u32LastUs;    /*!< Duration of the last open (us) */
+	uint32_t u32ColdMaxUs; /*!< Maximum cold open duration (us) */
+	uint32_t u32WarmMaxUs; /*!< Maximum warm open duration (us) */
+};
+
+/*!
+ * @brief This structure define the per PHY statistics
+ */
+struct phy_link_stats_s {
+	uint32_t u32TxFrm;  /*!< Number of transmitted frames */
+	uint32_t u32TxMs;   /*!< Total TX time (ms) */
+	uint32_t u32RxFrm;  /*!< Number of received frames (without error) */
+	uint32_t u32RxErr;  /*!< Number of received frames with error */
+	uint32_t u32RxMs;   /*!< Total RX-on time (ms) */
+	uint32_t u32PhyErr; /*!< Number of PHY errors */
+};
+
+/*!
+ * @brief This structure define the prepared (already built) frame
+ */
+struct send_prep_s {
+	net_msg_t *pNetMsg;    /*!< Message the frame has been built from (NULL if none) */
+	uint8_t   *pBuff;      /*!< Buffer that hold the prepared frame */
+	uint8_t   *pData;      /*!< Message data pointer, when the frame has been built */
+	uint32_t  u32Used;     /*!< Number of prepared frames that have been sent */
+	uint32_t  u32Dropped;  /*!< Number of prepared frames that have been discarded */
+	uint16_t  u16Id;       /*!< Message counter, when the frame has been built */
+	uint8_t   u8MsgSize;   /*!< Message size, when the frame has been built */
+	uint8_t   u8Type;      /*!< Message type, when the frame has been built */
+	uint8_t   u8KeyId;     /*!< Message key id, when the frame has been built */
+	uint8_t   u8Size;      /*!< Prepared frame size */
+};
+
+/*!
+ * @brief This structure define the extended statistics block returned by
+ * NETDEV_CTL_GET_STATS_EX
+ */
+typedef struct netdev_stats_s {
+	net_stats_t         sStats;     /*!< Basic statistics (as NETDEV_CTL_GET_STATS) */
+	net_stats_ex_t      sStatsEx;   /*!< Extended statistics (EWMA, histograms, return codes...) */
+	struct link_stats_s sLinkStats; /*!< Per channel and modulation statistics */
+	struct recv_ring_stats_s sRecvStats; /*!< Reception ring statistics */
+	struct phy_shadow_stats_s sPhyStats; /*!< PHY configuration shadow statistics */
+	struct lbt_stats_s sLbtStats;        /*!< Listen before talk statistics */
+	struct open_stats_s sOpenStats;      /*!< Open statistics */
+	struct phy_link_stats_s aPhyLink[NETDEV_PHY_NB]; /*!< Per PHY statistics */
+} netdev_stats_t;
+
 /*!
  * @brief This structure define the Wize network context
  */
@@ -188,24 +463,63 @@ typedef struct wize_net_s {
 	struct medium_cfg_s sMediumCfg; /*!< Hold the medium configuration (see
 	                                     @link medium_cfg_s @endlink)*/
 
+	struct link_stats_s sLinkStats; /*!< Hold the per channel/modulation
+	                                     statistics */
+	struct recv_ring_s  sRecvRing;  /*!< Hold the reception ring (see
+	                                     @link recv_ring_s @endlink)*/
+
+	struct phy_shadow_s sPhyShadow; /*!< Hold the PHY configuration shadow
+	                                     (see @link phy_shadow_s @endlink)*/
+
+	struct send_prep_s  sSendPrep;  /*!< Hold the prepared frame (see
+	                                     @link send_prep_s @endlink)*/
+	struct airtime_s    sAirTime;   /*!< Hold the airtime accounting (see
+	                                     @link airtime_s @endlink)*/
+	struct lbt_s        sLbt;       /*!< Hold the listen before talk (see
+	                                     @link lbt_s @endlink)*/
+	struct open_stats_s sOpenStats; /*!< Hold the open statistics (see
+	                                     @link open_stats_s @endlink)*/
+	struct phy_link_stats_s aPhyLink[NETDEV_PHY_NB]; /*!< Hold the per PHY
+	                                     statistics */
+	uint8_t u8TxPhy;                /*!< PHY of the current (or last)
+	                                     transmission */
+	uint8_t u8RxPhy;                /*!< PHY of the current (or last)
+	                                     listen window */
+	uint8_t *pSendBuff;             /*!< Buffer of the current (or last)
+	                                     transmission */
+	uint32_t u32SyncTick;           /*!< Tick (ms) of the last RX started
+	                                     event, used if the PHY can't give
+	                                     its own time stamp */
+	uint8_t bSyncTick;              /*!< u32SyncTick is valid */
+
 	uint8_t u8ProtoErr;             /*!< Hold the last error code (see
 	                                     @link ret_code_e @endlink).*/
     uint8_t aSendBuff[SEND_BUF_SZ]; /*!< Transmission buffer */
+    uint8_t aSendBuffAlt[SEND_BUF_SZ]; /*!< Alternate transmission buffer, the
+                                        next frame is built in while the
+                                        current one is transmitted */
     uint8_t aRecvBuff[RECV_BUF_SZ]; /*!< Reception buffer */
 } wize_net_t;
 
 // Public WizeNet API
 int32_t WizeNet_Setup(netdev_t* pNetdev, wize_net_t* pWizeCtx, phydev_t *pPhydev);
+int32_t WizeNet_AddPhy(netdev_t* pNetdev, phydev_t *pPhydev);
 
 int32_t WizeNet_Init(netdev_t* pNetdev, netdev_evt_cb_t pfcbEvent);
 int32_t WizeNet_Uninit(netdev_t* pNetdev);
+int32_t WizeNet_Suspend(netdev_t* pNetdev);
+int32_t WizeNet_Resume(netdev_t* pNetdev);
 
 int32_t WizeNet_Send(netdev_t* pNetdev, net_msg_t *pNetMsg);
+int32_t WizeNet_Prepare(netdev_t* pNetdev, net_msg_t *pNetMsg);
 int32_t WizeNet_Recv(netdev_t* pNetdev, net_msg_t *pNetMsg);
+int32_t WizeNet_Capture(netdev_t* pNetdev);
 int32_t WizeNet_Listen(netdev_t* pNetdev);
 
 int32_t WizeNet_Ioctl(netdev_t* pNetdev, uint32_t eCtl, uint32_t args);
 
+uint32_t WizeNet_AirTime(phy_mod_e eModulation, uint8_t u8Len, uint8_t bCrcOn);
+
 #ifdef __cplusplus
 }
 #endif
@@ -76,6 +76,14 @@ extern "C" {
 #define PHY_FREQUENCY_BASE (169406250UL) // CH100
 #define PHY_CHANNEL_WIDTH (12500) // in hertz
 #define PHY_FREQUENCY_CH(i) (PHY_FREQUENCY_BASE + i*PHY_CHANNEL_WIDTH)
+//------------------------------------------------------------------------------
+// Level units given by the PHY :
+// - PHY_CTL_GET_RSSI : as the L7 RSSI, 0.5 dB per unit, 0 is -147.5 dBm
+//   (higher value is a stronger signal)
+// - PHY_CTL_GET_NOISE : opposite of the dBm value, e.g. 110 for -110 dBm
+//   (higher value is a lower noise)
+#define PHY_RSSI_PER_DB 2    // Number of RSSI unit per dB
+#define PHY_RSSI_OFFSET 295  // RSSI of 0 dBm (-147.5 dBm is 0)
 
 /******************************************************************************/
 #ifndef DEFAULT_MOD
@@ -123,10 +131,13 @@ typedef enum {
 	PHY_CTL_GET_TX_POWER      , /*!< Get the TX Power */
 	PHY_CTL_GET_PA            , /*!< Get the PA state */
 	PHY_CTL_GET_FREQ_ERR      , /*!< Get the frequency error */
-	PHY_CTL_GET_RSSI          , /*!< Get the RX RSSI */
-	PHY_CTL_GET_NOISE         , /*!< Get the TX Noise */
+	PHY_CTL_GET_RSSI          , /*!< Get the RX RSSI (see PHY_RSSI_PER_DB) */
+	PHY_CTL_GET_NOISE         , /*!< Get the TX Noise (opposite of the dBm value) */
 	PHY_CTL_GET_ERR           , /*!< Get the Last error id */
 	PHY_CTL_GET_STR_ERR       , /*!< Get the Last error string */
+	PHY_CTL_GET_SYNC_TIME     , /*!< Get the sync word detection time of the last received frame (see phy_tstamp_s) */
+	// ---- Appended, to keep the values above unchanged
+	PHY_CTL_SET_MULTI         , /*!< Set several parameters at once (see phy_cfg_set_s) */
 
 	PHY_CTL_SPE         = 0x40,
 	PHY_CTL_SPE_TEST_MODE     , /*!< Test mode (if any) */
@@ -142,6 +153,46 @@ typedef enum {
 	PHY_CTL_CMD_LAST,
 } phy_ctl_e;
 
+/*!
+ * @brief Convert a noise level (as PHY_CTL_GET_NOISE) into the RSSI unit (as
+ * PHY_CTL_GET_RSSI)
+ *
+ * @param [in] u8Noise Noise level (opposite of the dBm value)
+ *
+ * @return The noise level in RSSI unit (may be out of the 0..255 range)
+ */
+static inline int16_t Phy_NoiseToRssi(uint8_t u8Noise)
+{
+	return (int16_t)(PHY_RSSI_OFFSET - PHY_RSSI_PER_DB * (int16_t)u8Noise);
+}
+
+/*!
+ * @brief This define the fields that can be set with PHY_CTL_SET_MULTI
+ */
+typedef enum {
+	PHY_CFG_TX_FREQ_OFF = 0x01, /*!< phy_cfg_set_s::i16TxFreqOffset is valid */
+	PHY_CFG_TX_POWER    = 0x02, /*!< phy_cfg_set_s::eTxPower is valid */
+} phy_cfg_field_e;
+
+/*!
+ * @brief This structure hold the parameters to set in one PHY transaction
+ * (see PHY_CTL_SET_MULTI). The PHY clear the bits of u8Mask that it has
+ * applied, so the caller can detect a PHY that doesn't support it.
+ */
+typedef struct phy_cfg_set_s {
+	uint8_t     u8Mask;          /*!< Fields to set (see phy_cfg_field_e) */
+	phy_power_e eTxPower;        /*!< TX power */
+	int16_t     i16TxFreqOffset; /*!< TX frequency offset */
+} phy_cfg_set_t;
+
+/*!
+ * @brief This structure hold a PHY time stamp (RTC time, sub-second
+ * resolution). A zero time stamp means "not available".
+ */
+typedef struct phy_tstamp_s {
+	uint32_t u32Sec;  /*!< Epoch (second) */
+	uint32_t u32USec; /*!< Micro-second part */
+} phy_tstamp_t;
 
 /*!
  * @brief This define the available test mode
@@ -218,6 +269,7 @@ struct phydev_s {
 	uint16_t    u16_Noise;         /*!< Last noise measured */
 	uint16_t    u16_Rssi;          /*!< Last RSSI measured */
 	int16_t     u16_Ferr;          /*!< Last frequency error measured */
+	phy_tstamp_t sSyncTime;        /*!< Sync word detection time of the last received frame */
 
 	uint8_t     bCrcOn;            /*!< Enable/Disable PHY crc computation */
 	uint8_t     bPreSyncOn;        /*!< Enable/Disable interrupt on PREMABLE and SYNCHRO */
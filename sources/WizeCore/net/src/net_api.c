@@ -38,13 +38,72 @@ extern "C" {
 #endif
 
 #include <string.h>
+#include <time.h>
+#include <sys/time.h>
 #include "net_api_private.h"
+#include "wize_utils.h"
+
+#if defined ( __OS__ ) && ( OS_FreeRTOS == 1 )
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+// Preamble plus synchro length (in bits)
+static const uint16_t _aSyncBits_[PHY_NB_MOD] = {
+	[PHY_WM2400] = PHY_WM2400_PREAMBLE_SIZE + PHY_WM2400_SYNC_WORD_SIZE,
+	[PHY_WM4800] = PHY_WM4800_PREAMBLE_SIZE + PHY_WM4800_SYNC_WORD_SIZE,
+	[PHY_WM6400] = PHY_WM6400_PREAMBLE_SIZE + PHY_WM6400_SYNC_WORD_SIZE,
+};
+// Bit rate (in bits per second)
+static const uint16_t _aBitRate_[PHY_NB_MOD] = {
+	[PHY_WM2400] = PHY_WM2400_BIT_RATE,
+	[PHY_WM4800] = PHY_WM4800_BIT_RATE,
+	[PHY_WM6400] = PHY_WM6400_BIT_RATE,
+};
+// Airtime window slot duration (in seconds)
+static const uint32_t _aSlotDuration_[AIRTIME_WIN_NB] = {
+	[AIRTIME_WIN_1H]  = 3600 / AIRTIME_SLOT_NB,
+	[AIRTIME_WIN_24H] = 86400 / AIRTIME_SLOT_NB,
+};
+#define AIRTIME_WIN_MS(w) (_aSlotDuration_[w] * AIRTIME_SLOT_NB * 1000)
+/*!
+ * @}
+ * @endcond
+ */
 
 // Internal
-static int32_t _check_idle_state(netdev_t* pNetdev);
+static inline phydev_t* _phy_dev_(netdev_t* pNetdev, uint8_t u8Phy);
+static inline netdev_state_e* _phy_state_(netdev_t* pNetdev, uint8_t u8Phy);
+static void _phy_ex_open_(netdev_t* pNetdev, uint8_t bWarm);
+static int32_t _check_idle_state(netdev_t* pNetdev, uint8_t u8Phy);
+static int32_t _recv_from_ring_(netdev_t* pNetdev, net_msg_t *pNetMsg);
+static void _recv_ring_flush_(struct recv_ring_s *pRing);
+static inline uint8_t* _free_send_buff_(wize_net_t* pCtx);
+static inline void _send_prep_drop_(wize_net_t* pCtx);
+static inline uint8_t _send_prep_match_(wize_net_t* pCtx, net_msg_t *pNetMsg);
+static void _phy_cfg_apply_(netdev_t* pNetdev, wize_net_t* pCtx);
+static uint32_t _airtime_now_ms_(void);
+static void _airtime_roll_(struct airtime_s *pAir, uint32_t u32Now);
+static void _airtime_add_(struct airtime_s *pAir, phy_chan_e eChannel, uint8_t bRx, uint32_t u32Ms);
+static uint32_t _airtime_sum_(const uint32_t *pSlot);
+static uint32_t _airtime_tx_used_(struct airtime_win_s *pWin);
+static int32_t _airtime_check_(struct airtime_s *pAir, uint32_t u32Ms);
+static void _airtime_rx_stop_(wize_net_t* pCtx);
+static int32_t _lbt_cca_(netdev_t* pNetdev, wize_net_t* pCtx);
+static uint32_t _lbt_backoff_(wize_net_t* pCtx);
+static void _rx_tstamp_(netdev_t* pNetdev, wize_net_t* pCtx, phy_tstamp_t *pTstamp);
+static inline uint32_t _tick_ms_(uint8_t bFromIsr);
+static uint32_t _open_now_us_(void);
+static void _open_stats_upd_(struct open_stats_s *pStats, uint8_t bWarm, uint32_t u32Start);
 
 // event callback from phy
+static void _evt_treat_(netdev_t* pNetdev, uint8_t u8Phy, uint32_t evt);
 static void _evt_cb(void *p_CbParam, uint32_t evt);
+static void _evt_cb_ex(void *p_CbParam, uint32_t evt);
 
 /*!
  * @brief  This function setup the netdev_t device
@@ -66,14 +125,71 @@ int32_t WizeNet_Setup(netdev_t* pNetdev, wize_net_t* pWizeCtx, phydev_t *pPhydev
     	pNetdev->pCtx = pWizeCtx;
     	pNetdev->pPhydev = pPhydev;
     	pNetdev->eState = NETDEV_STATE_UNKWON;
+    	pNetdev->u8PhyNb = 1;
+    	memset(pNetdev->aPhyEx, 0, sizeof(pNetdev->aPhyEx));
+    	memset(pNetdev->aRoute, 0, sizeof(pNetdev->aRoute));
+    	memset(pWizeCtx->aPhyLink, 0, sizeof(pWizeCtx->aPhyLink));
+    	pWizeCtx->u8TxPhy = 0;
+    	pWizeCtx->u8RxPhy = 0;
+    	memset(&(pWizeCtx->sRecvRing), 0, sizeof(struct recv_ring_s));
+    	pWizeCtx->sRecvRing.sStats.u8Depth = RECV_RING_DEPTH;
+    	memset(&(pWizeCtx->sSendPrep), 0, sizeof(struct send_prep_s));
+    	pWizeCtx->pSendBuff = pWizeCtx->aSendBuff;
+    	memset(&(pWizeCtx->sPhyShadow), 0, sizeof(struct phy_shadow_s));
+    	memset(&(pWizeCtx->sAirTime), 0, sizeof(struct airtime_s));
+    	memset(&(pWizeCtx->sLbt), 0, sizeof(struct lbt_s));
+    	memset(&(pWizeCtx->sOpenStats), 0, sizeof(struct open_stats_s));
+    	pWizeCtx->sLbt.u8MaxAttempts = LBT_MAX_ATTEMPTS;
+    	pWizeCtx->sLbt.u16BackoffMin = LBT_BACKOFF_MIN;
+    	pWizeCtx->sLbt.u16BackoffMax = LBT_BACKOFF_MAX;
     	i32Ret = 0;
     }
 	return i32Ret;
 }
 
+/*!
+ * @brief  This function attach an additional PHY device to the netdev_t
+ *
+ * @details The PHY index is the attach order (the one given to WizeNet_Setup
+ * is 0). By default, both routes use the PHY 0 (see NETDEV_CTL_SET_ROUTE).
+ * It must be called after WizeNet_Setup, before WizeNet_Init.
+ *
+ * @param [in] pNetdev  Pointer on netdev_t device
+ * @param [in] pPhydev  Pointer on the PHY device context
+ *
+ * @retval NETDEV_STATUS_OK (see @link netdev_status_e::NETDEV_STATUS_OK @endlink)
+ * @retval NETDEV_STATUS_ERROR (see @link netdev_status_e::NETDEV_STATUS_ERROR @endlink)
+ * @retval NETDEV_STATUS_BUSY (see @link netdev_status_e::NETDEV_STATUS_BUSY @endlink)
+ *         The device is already initialized
+ *
+ */
+int32_t WizeNet_AddPhy(netdev_t* pNetdev, phydev_t *pPhydev)
+{
+	int32_t i32Ret = NETDEV_STATUS_ERROR;
+	struct netdev_phy_s *pPhy;
+	if (pNetdev && pNetdev->u8PhyNb && pPhydev && (pNetdev->u8PhyNb < NETDEV_PHY_NB) )
+	{
+		if (pNetdev->eState != NETDEV_STATE_UNKWON)
+		{
+			return NETDEV_STATUS_BUSY;
+		}
+		pPhy = &(pNetdev->aPhyEx[pNetdev->u8PhyNb - 1]);
+		pPhy->pPhydev = pPhydev;
+		pPhy->pNetdev = pNetdev;
+		pPhy->eState = NETDEV_STATE_UNKWON;
+		pPhy->u8Id = pNetdev->u8PhyNb;
+		pNetdev->u8PhyNb++;
+		i32Ret = NETDEV_STATUS_OK;
+	}
+	return i32Ret;
+}
+
 /*!
  * @brief  This function initialize the netdev_t and phy devices
  *
+ * @details An additional PHY that fail to initialize is left in the unknown
+ * state and the routes that use it fall back to the primary PHY.
+ *
  * @param [in] pNetdev   Pointer on netdev_t device
  * @param [in] pfcbEvent Event call-back to upper layer (still in interrupt)
  *
@@ -88,6 +204,7 @@ int32_t WizeNet_Init(netdev_t* pNetdev, netdev_evt_cb_t pfcbEvent)
     if (pNetdev && pfcbEvent && pNetdev->pPhydev)
     {
         const phy_if_t *pIf = pNetdev->pPhydev->pIf;
+        uint32_t u32Start = _open_now_us_();
         if ( pIf->pfInit(pNetdev->pPhydev) != PHY_STATUS_OK)
         {
             pNetdev->eState = NETDEV_STATE_UNKWON;
@@ -100,6 +217,9 @@ int32_t WizeNet_Init(netdev_t* pNetdev, netdev_evt_cb_t pfcbEvent)
 			pNetdev->pPhydev->bPreSyncOn = 1;
 			pNetdev->pPhydev->pfEvtCb = &_evt_cb;
 			pNetdev->pPhydev->pCbParam = (void*)pNetdev;
+			((wize_net_t*)pNetdev->pCtx)->sPhyShadow.u8Valid = 0;
+			_phy_ex_open_(pNetdev, 0);
+			_open_stats_upd_(&(((wize_net_t*)pNetdev->pCtx)->sOpenStats), 0, u32Start);
 			i32Ret = NETDEV_STATUS_OK;
         }
     }
@@ -122,24 +242,139 @@ int32_t WizeNet_Uninit(netdev_t* pNetdev)
     if (pNetdev && pNetdev->pPhydev)
     {
         const phy_if_t *pIf = pNetdev->pPhydev->pIf;
+        struct netdev_phy_s *pPhy;
+        uint8_t u8Phy;
         if ( pIf->pfUnInit(pNetdev->pPhydev) == PHY_STATUS_OK )
         {
         	i32Ret = NETDEV_STATUS_OK;
         }
+        for (u8Phy = 1; u8Phy < pNetdev->u8PhyNb; u8Phy++)
+        {
+        	pPhy = &(pNetdev->aPhyEx[u8Phy - 1]);
+        	if (pPhy->eState != NETDEV_STATE_UNKWON)
+        	{
+        		pPhy->pPhydev->pIf->pfUnInit(pPhy->pPhydev);
+        		pPhy->eState = NETDEV_STATE_UNKWON;
+        	}
+        }
+        _send_prep_drop_((wize_net_t*)pNetdev->pCtx);
+        _airtime_rx_stop_((wize_net_t*)pNetdev->pCtx);
+        ((wize_net_t*)pNetdev->pCtx)->sPhyShadow.u8Valid = 0;
         pNetdev->eState = NETDEV_STATE_UNKWON;
     }
 	return i32Ret;
 }
 
+/*!
+ * @brief  This function suspend the netdev_t and put the PHY devices in sleep
+ *         (see PHY_CTL_CMD_SLEEP).
+ *
+ * @details The PHY configuration (and its shadow) and the call-backs are kept,
+ * so the device can be resumed quickly with WizeNet_Resume. A pending
+ * prepared frame is dropped and the current listen window is closed.
+ *
+ * @param [in] pNetdev Pointer on netdev_t device
+ *
+ * @retval NETDEV_STATUS_OK (see @link netdev_status_e::NETDEV_STATUS_OK @endlink)
+ * @retval NETDEV_STATUS_ERROR (see @link netdev_status_e::NETDEV_STATUS_ERROR @endlink)
+ *         The device is not initialized or the PHY can't sleep. The caller
+ *         should then un-initialize it (see WizeNet_Uninit).
+ *
+ */
+int32_t WizeNet_Suspend(netdev_t* pNetdev)
+{
+	int32_t i32Ret = NETDEV_STATUS_ERROR;
+    if (pNetdev && pNetdev->pPhydev)
+    {
+    	if ( pNetdev->eState & (NETDEV_STATE_IDLE | NETDEV_STATE_BUSY) )
+    	{
+            const phy_if_t *pIf = pNetdev->pPhydev->pIf;
+            struct netdev_phy_s *pPhy;
+            uint8_t u8Phy;
+            _send_prep_drop_((wize_net_t*)pNetdev->pCtx);
+            _airtime_rx_stop_((wize_net_t*)pNetdev->pCtx);
+            if ( pIf->pfIoctl(pNetdev->pPhydev, PHY_CTL_CMD_SLEEP, 0) == PHY_STATUS_OK )
+            {
+            	pNetdev->eState = NETDEV_STATE_SUSPEND;
+            	i32Ret = NETDEV_STATUS_OK;
+            }
+            for (u8Phy = 1; u8Phy < pNetdev->u8PhyNb; u8Phy++)
+            {
+            	pPhy = &(pNetdev->aPhyEx[u8Phy - 1]);
+            	if ( pPhy->eState & (NETDEV_STATE_IDLE | NETDEV_STATE_BUSY) )
+            	{
+            		// on failure, it will be initialized again on resume
+            		pPhy->eState = ( pPhy->pPhydev->pIf->pfIoctl(pPhy->pPhydev, PHY_CTL_CMD_SLEEP, 0) == PHY_STATUS_OK )?
+            				(NETDEV_STATE_SUSPEND):(NETDEV_STATE_UNKWON);
+            	}
+            }
+    	}
+    }
+	return i32Ret;
+}
+
+/*!
+ * @brief  This function resume a suspended netdev_t (see WizeNet_Suspend). The
+ *         PHY devices are waked-up (see PHY_CTL_CMD_READY), without being
+ *         re-initialized.
+ *
+ * @param [in] pNetdev Pointer on netdev_t device
+ *
+ * @retval NETDEV_STATUS_OK (see @link netdev_status_e::NETDEV_STATUS_OK @endlink)
+ * @retval NETDEV_STATUS_ERROR (see @link netdev_status_e::NETDEV_STATUS_ERROR @endlink)
+ *         The device is not suspended or the PHY can't wake-up. The caller
+ *         should then initialize it (see WizeNet_Init).
+ *
+ */
+int32_t WizeNet_Resume(netdev_t* pNetdev)
+{
+	int32_t i32Ret = NETDEV_STATUS_ERROR;
+    if (pNetdev && pNetdev->pPhydev && (pNetdev->eState == NETDEV_STATE_SUSPEND) )
+    {
+        const phy_if_t *pIf = pNetdev->pPhydev->pIf;
+        wize_net_t *pCtx = (wize_net_t*)pNetdev->pCtx;
+        uint32_t u32Start = _open_now_us_();
+        if ( pIf->pfIoctl(pNetdev->pPhydev, PHY_CTL_CMD_READY, 0) != PHY_STATUS_OK )
+        {
+            _sat_add_u32_(&(pCtx->sOpenStats.u32WarmFail), 1);
+            pCtx->sPhyShadow.u8Valid = 0;
+            pNetdev->eState = NETDEV_STATE_UNKWON;
+            pNetdev->eErrType = NETDEV_ERROR_PHY;
+        }
+        else {
+			pNetdev->eState = NETDEV_STATE_IDLE;
+			pNetdev->eErrType = NETDEV_ERROR_NONE;
+			pNetdev->pPhydev->bPreSyncOn = 1;
+			_phy_ex_open_(pNetdev, 1);
+			_open_stats_upd_(&(pCtx->sOpenStats), 1, u32Start);
+			i32Ret = NETDEV_STATUS_OK;
+        }
+    }
+	return i32Ret;
+}
+
 /*!
  * @brief  This function send the given message.
  *
+ * @details If the given message has been prepared (see WizeNet_Prepare), the
+ * already built frame is sent as is. Otherwise, the frame is built.
+ *
+ * The frame is refused if its airtime would exceed one of the duty-cycle limits
+ * (see NETDEV_CTL_SET_DUTY_1H and NETDEV_CTL_SET_DUTY_24H), or if the CCA find
+ * the channel busy (see NETDEV_CTL_SET_CCA_THRES). The device stay idle and a
+ * prepared frame is kept, so it can be sent later (e.g. after the backoff given
+ * by NETDEV_CTL_GET_BACKOFF).
+ *
+ * The frame is sent on the PHY of the TX route (see NETDEV_CTL_SET_ROUTE).
+ *
  * @param [in] pNetdev Pointer on netdev_t device
  * @param [in] pNetMsg Pointer on structure that hold the message
  *
  * @retval NETDEV_STATUS_OK (see @link netdev_status_e::NETDEV_STATUS_OK @endlink)
  * @retval NETDEV_STATUS_ERROR (see @link netdev_status_e::NETDEV_STATUS_ERROR @endlink)
  * @retval NETDEV_STATUS_BUSY (see @link netdev_status_e::NETDEV_STATUS_BUSY @endlink)
+ * @retval NETDEV_STATUS_DUTY (see @link netdev_status_e::NETDEV_STATUS_DUTY @endlink)
+ * @retval NETDEV_STATUS_CCA (see @link netdev_status_e::NETDEV_STATUS_CCA @endlink)
  *
  */
 int32_t WizeNet_Send(netdev_t* pNetdev, net_msg_t *pNetMsg)
@@ -148,53 +383,104 @@ int32_t WizeNet_Send(netdev_t* pNetdev, net_msg_t *pNetMsg)
 	wize_net_t* pCtx;
 	struct medium_cfg_s* pConfig;
 	const phy_if_t* pIf;
-	if (pNetMsg && pNetMsg->pData)
+	phydev_t *pPhydev;
+	netdev_state_e *pState;
+	uint32_t u32AirTime;
+	uint8_t u8Phy;
+	uint8_t bPrep;
+	if (pNetdev && pNetMsg && pNetMsg->pData)
 	{
-		i32Ret = _check_idle_state(pNetdev);
+		u8Phy = pNetdev->aRoute[NETDEV_ROUTE_TX];
+		i32Ret = _check_idle_state(pNetdev, u8Phy);
 		if ( i32Ret == NETDEV_STATUS_OK )
 		{
 			i32Ret = NETDEV_STATUS_ERROR;
-			pIf = pNetdev->pPhydev->pIf;
+			pPhydev = _phy_dev_(pNetdev, u8Phy);
+			pState = _phy_state_(pNetdev, u8Phy);
+			pIf = pPhydev->pIf;
 			pCtx = (wize_net_t*)pNetdev->pCtx;
 			pConfig = &(pCtx->sMediumCfg);
 
-			pNetdev->eState = NETDEV_STATE_BUSY;
+			*pState = NETDEV_STATE_BUSY;
+			pCtx->u8TxPhy = u8Phy;
+			if (u8Phy == pCtx->u8RxPhy)
+			{
+				_airtime_rx_stop_(pCtx);
+			}
 
-			pCtx->sProtoCtx.pBuffer = pCtx->aSendBuff;
-			pCtx->u8ProtoErr = Wize_ProtoBuild(&(pCtx->sProtoCtx), pNetMsg);
+			bPrep = _send_prep_match_(pCtx, pNetMsg);
+			if (bPrep)
+			{
+				// Frame already built, only refresh its time stamp
+				pCtx->pSendBuff = pCtx->sSendPrep.pBuff;
+				pCtx->sProtoCtx.pBuffer = pCtx->pSendBuff;
+				pCtx->sProtoCtx.u8Size = pCtx->sSendPrep.u8Size;
+				pCtx->u8ProtoErr = Wize_ProtoStamp(&(pCtx->sProtoCtx), pNetMsg);
+			}
+			else
+			{
+				_send_prep_drop_(pCtx);
+				pCtx->pSendBuff = _free_send_buff_(pCtx);
+				pCtx->sProtoCtx.pBuffer = pCtx->pSendBuff;
+				pCtx->u8ProtoErr = Wize_ProtoBuild(&(pCtx->sProtoCtx), pNetMsg);
+			}
 			if ( !(pCtx->u8ProtoErr) )
 			{
 				uint8_t u8FrmSize = pCtx->sProtoCtx.u8Size;
-				if(pNetdev->pPhydev->bCrcOn == 1) {
+				if(pPhydev->bCrcOn == 1) {
 					u8FrmSize -= 2; // remove CRC
 				}
-				
-				pIf->pfIoctl(pNetdev->pPhydev, PHY_CTL_SET_TX_POWER, (uint32_t)pConfig->eTxPower);
-				pIf->pfIoctl(pNetdev->pPhydev, PHY_CTL_SET_TX_FREQ_OFF, (uint32_t)pConfig->i16TxFreqOffset);
+
+				// in ms, rounded up
+				u32AirTime = ( WizeNet_AirTime(pConfig->eTxModulation, u8FrmSize, pPhydev->bCrcOn) + 999 ) / 1000;
+				if ( _airtime_check_(&(pCtx->sAirTime), u32AirTime) != NETDEV_STATUS_OK )
+				{
+					_sat_add_u32_(&(pCtx->sAirTime.u32Rejected), 1);
+					*pState = NETDEV_STATE_IDLE;
+					return NETDEV_STATUS_DUTY;
+				}
+				if ( _lbt_cca_(pNetdev, pCtx) != NETDEV_STATUS_OK )
+				{
+					*pState = NETDEV_STATE_IDLE;
+					return NETDEV_STATUS_CCA;
+				}
+				if (bPrep)
+				{
+					pCtx->sSendPrep.pNetMsg = NULL;
+					_sat_add_u32_(&(pCtx->sSendPrep.u32Used), 1);
+				}
+
+				_phy_cfg_apply_(pNetdev, pCtx);
 
 				if (pIf->pfSetSend(
-						pNetdev->pPhydev,
-						&(pCtx->aSendBuff[1]), // to remove LEN field
+						pPhydev,
+						&(pCtx->pSendBuff[1]), // to remove LEN field
 						(u8FrmSize)
 						))
 				{
+					_sat_add_u32_(&(pCtx->aPhyLink[u8Phy].u32PhyErr), 1);
 					pNetdev->eErrType = NETDEV_ERROR_PHY;
-					pNetdev->eState = NETDEV_STATE_ERROR;
+					*pState = NETDEV_STATE_ERROR;
 					return i32Ret;
 				}
-				// FIXME : Noise measurement rise an interrupt
-				uint8_t u8Noise = 0; //pIf->pfGetNoise(pNetdev->pPhydev);
-				if ( pIf->pfTx(pNetdev->pPhydev, pConfig->eTxChannel, pConfig->eTxModulation) )
+				if ( pIf->pfTx(pPhydev, pConfig->eTxChannel, pConfig->eTxModulation) )
 				{
+					_sat_add_u32_(&(pCtx->aPhyLink[u8Phy].u32PhyErr), 1);
 					pNetdev->eErrType = NETDEV_ERROR_PHY;
-					pNetdev->eState = NETDEV_STATE_ERROR;
+					*pState = NETDEV_STATE_ERROR;
 					return i32Ret;
 				}
-				Wize_ProtoStats_TxUpdate(&(pCtx->sProtoCtx), pCtx->u8ProtoErr, u8Noise);
+				pCtx->sLbt.u8Attempt = 0;
+				Wize_ProtoStats_TxUpdate(&(pCtx->sProtoCtx), pCtx->u8ProtoErr, pCtx->sLbt.u8Noise);
+				_airtime_add_(&(pCtx->sAirTime), pConfig->eTxChannel, 0, u32AirTime);
+				_sat_add_u32_(&(pCtx->sLinkStats.aTxFrmPerCh[pConfig->eTxChannel]), 1);
+				_sat_add_u32_(&(pCtx->sLinkStats.aTxFrmPerMod[pConfig->eTxModulation]), 1);
+				_sat_add_u32_(&(pCtx->aPhyLink[u8Phy].u32TxFrm), 1);
+				_sat_add_u32_(&(pCtx->aPhyLink[u8Phy].u32TxMs), u32AirTime);
 				i32Ret = NETDEV_STATUS_OK;
 			}
 			else {
-				pNetdev->eState = NETDEV_STATE_ERROR;
+				*pState = NETDEV_STATE_ERROR;
 				pNetdev->eErrType = NETDEV_ERROR_PROTO;
 			}
 		}
@@ -203,9 +489,67 @@ int32_t WizeNet_Send(netdev_t* pNetdev, net_msg_t *pNetMsg)
 	return i32Ret;
 }
 
+/*!
+ * @brief  This function build the given message in advance.
+ *
+ * @details The frame is built into the buffer that is not currently given to
+ * the PHY, so it can be called while the previous frame is being transmitted.
+ * The next call to WizeNet_Send with the same message will send this frame
+ * without building it again, only its time stamp (and so the HKmac and CRC) is
+ * refreshed (see Wize_ProtoStamp). The message is recognized by its address,
+ * data pointer, counter, size, type and key id: if one of them has changed,
+ * the prepared frame is discarded and the frame is built again. The data
+ * content must not change between both calls. Only one frame can be prepared,
+ * a new call replace the previous one.
+ *
+ * @param [in] pNetdev Pointer on netdev_t device
+ * @param [in] pNetMsg Pointer on structure that hold the message
+ *
+ * @retval NETDEV_STATUS_OK (see @link netdev_status_e::NETDEV_STATUS_OK @endlink)
+ * @retval NETDEV_STATUS_ERROR (see @link netdev_status_e::NETDEV_STATUS_ERROR @endlink)
+ *
+ */
+int32_t WizeNet_Prepare(netdev_t* pNetdev, net_msg_t *pNetMsg)
+{
+	int32_t i32Ret = NETDEV_STATUS_ERROR;
+	wize_net_t* pCtx;
+	uint8_t *pBuff;
+
+	if (pNetdev && pNetMsg && pNetMsg->pData)
+	{
+		// Idle or busy (transmitting) are both fine
+		if ( *_phy_state_(pNetdev, pNetdev->aRoute[NETDEV_ROUTE_TX]) & (NETDEV_STATE_IDLE | NETDEV_STATE_BUSY) )
+		{
+			pCtx = (wize_net_t*)pNetdev->pCtx;
+			_send_prep_drop_(pCtx);
+
+			pBuff = _free_send_buff_(pCtx);
+			pCtx->sProtoCtx.pBuffer = pBuff;
+			// On failure, WizeNet_Send will build it again and report the error
+			if ( Wize_ProtoBuild(&(pCtx->sProtoCtx), pNetMsg) == PROTO_SUCCESS )
+			{
+				pCtx->sSendPrep.pBuff = pBuff;
+				pCtx->sSendPrep.u8Size = pCtx->sProtoCtx.u8Size;
+				pCtx->sSendPrep.pNetMsg = pNetMsg;
+				pCtx->sSendPrep.pData = pNetMsg->pData;
+				pCtx->sSendPrep.u16Id = pNetMsg->u16Id;
+				pCtx->sSendPrep.u8MsgSize = pNetMsg->u8Size;
+				pCtx->sSendPrep.u8Type = pNetMsg->u8Type;
+				pCtx->sSendPrep.u8KeyId = pNetMsg->u8KeyId;
+				i32Ret = NETDEV_STATUS_OK;
+			}
+		}
+	}
+	return i32Ret;
+}
+
 /*!
  * @brief  This function get the received message
  *
+ * @details If the reception ring is not empty, the oldest captured frame is
+ * extracted (whatever the PHY state). Otherwise, the frame is read from the PHY
+ * of the last listen window.
+ *
  * @param [in] pNetdev Pointer on netdev_t device
  * @param [in] pNetMsg Pointer on structure that will hold the message
  *
@@ -219,35 +563,56 @@ int32_t WizeNet_Recv(netdev_t* pNetdev, net_msg_t *pNetMsg)
 	int32_t i32Ret = NETDEV_STATUS_ERROR;
 	wize_net_t* pCtx;
 	const phy_if_t* pIf;
+	phydev_t *pPhydev;
+	phy_tstamp_t sSyncTime;
+	uint8_t u8Phy;
 
-	if (pNetMsg && pNetMsg->pData)
+	if (pNetdev && pNetMsg && pNetMsg->pData)
 	{
-		i32Ret = _check_idle_state(pNetdev);
+		pCtx = (wize_net_t*)pNetdev->pCtx;
+		if ( pCtx->sRecvRing.u8Count )
+		{
+			return _recv_from_ring_(pNetdev, pNetMsg);
+		}
+
+		u8Phy = pCtx->u8RxPhy;
+		i32Ret = _check_idle_state(pNetdev, u8Phy);
 		if ( i32Ret == NETDEV_STATUS_OK )
 		{
-			pIf = pNetdev->pPhydev->pIf;
-			pCtx = (wize_net_t*)pNetdev->pCtx;
+			pPhydev = _phy_dev_(pNetdev, u8Phy);
+			pIf = pPhydev->pIf;
 
+			_airtime_rx_stop_(pCtx);
 			// _aRecvBuff must be protected
-			if ( pIf->pfGetRecv(pNetdev->pPhydev, &(pCtx->aRecvBuff[1]), &(pCtx->sProtoCtx.u8Size) ) )
+			if ( pIf->pfGetRecv(pPhydev, &(pCtx->aRecvBuff[1]), &(pCtx->sProtoCtx.u8Size) ) )
 			{
+				_sat_add_u32_(&(pCtx->aPhyLink[u8Phy].u32PhyErr), 1);
 				pNetdev->eErrType = NETDEV_ERROR_PHY;
-				pNetdev->eState = NETDEV_STATE_ERROR;
+				*_phy_state_(pNetdev, u8Phy) = NETDEV_STATE_ERROR;
 				i32Ret = NETDEV_STATUS_ERROR;
 				return i32Ret;
 			}
-			pIf->pfIoctl(pNetdev->pPhydev, PHY_CTL_GET_RSSI, (uint32_t)(&pNetMsg->u8Rssi));
+			pIf->pfIoctl(pPhydev, PHY_CTL_GET_RSSI, (uint32_t)(&pNetMsg->u8Rssi));
+			_rx_tstamp_(pNetdev, pCtx, &sSyncTime);
 
 			// now the PHY can be IDLE or READY
 			pCtx->sProtoCtx.pBuffer = pCtx->aRecvBuff;
 			pCtx->u8ProtoErr = Wize_ProtoExtract(&(pCtx->sProtoCtx), pNetMsg);
 			if ( !(pCtx->u8ProtoErr) )
 			{
+				pNetMsg->u32RxEpoch = sSyncTime.u32Sec;
+				pNetMsg->u32RxUSec = sSyncTime.u32USec;
+				_sat_add_u32_(&(pCtx->sLinkStats.aRxFrmPerCh[pCtx->sMediumCfg.eRxChannel]), 1);
+				_sat_add_u32_(&(pCtx->sLinkStats.aRxFrmPerMod[pCtx->sMediumCfg.eRxModulation]), 1);
+				_sat_add_u32_(&(pCtx->aPhyLink[u8Phy].u32RxFrm), 1);
 				i32Ret = NETDEV_STATUS_OK;
 			}
 			else {
 				// Wize stack error
-				pNetdev->eState = NETDEV_STATE_ERROR;
+				_sat_add_u32_(&(pCtx->sLinkStats.aRxErrPerCh[pCtx->sMediumCfg.eRxChannel]), 1);
+				_sat_add_u32_(&(pCtx->sLinkStats.aRxErrPerMod[pCtx->sMediumCfg.eRxModulation]), 1);
+				_sat_add_u32_(&(pCtx->aPhyLink[u8Phy].u32RxErr), 1);
+				*_phy_state_(pNetdev, u8Phy) = NETDEV_STATE_ERROR;
 				pNetdev->eErrType = NETDEV_ERROR_PROTO;
 				i32Ret = NETDEV_STATUS_ERROR;
 			}
@@ -258,9 +623,88 @@ int32_t WizeNet_Recv(netdev_t* pNetdev, net_msg_t *pNetMsg)
 	return i32Ret;
 }
 
+/*!
+ * @brief  This function capture the received raw frame into the reception ring.
+ *
+ * @details The frame is only read from the PHY (with its RSSI, reception
+ * and sync word detection time), the protocol extraction is delayed to WizeNet_Recv. So, the PHY can
+ * listen again while previous frames are still waiting to be consumed.
+ *
+ * @param [in] pNetdev Pointer on netdev_t device
+ *
+ * @retval NETDEV_STATUS_OK (see @link netdev_status_e::NETDEV_STATUS_OK @endlink)
+ * @retval NETDEV_STATUS_ERROR (see @link netdev_status_e::NETDEV_STATUS_ERROR @endlink)
+ * @retval NETDEV_STATUS_BUSY (see @link netdev_status_e::NETDEV_STATUS_BUSY @endlink)
+ *         Device is busy or the ring is full (the frame is dropped)
+ *
+ */
+int32_t WizeNet_Capture(netdev_t* pNetdev)
+{
+	int32_t i32Ret;
+	wize_net_t* pCtx;
+	const phy_if_t* pIf;
+	struct recv_ring_s *pRing;
+	struct recv_frm_s *pFrm;
+	phydev_t *pPhydev;
+	uint8_t u8Phy;
+	time_t t;
+
+	if (pNetdev == NULL)
+	{
+		return NETDEV_STATUS_ERROR;
+	}
+	pCtx = (wize_net_t*)pNetdev->pCtx;
+	u8Phy = pCtx->u8RxPhy;
+	i32Ret = _check_idle_state(pNetdev, u8Phy);
+	if ( i32Ret == NETDEV_STATUS_OK )
+	{
+		pPhydev = _phy_dev_(pNetdev, u8Phy);
+		pIf = pPhydev->pIf;
+		pRing = &(pCtx->sRecvRing);
+		_airtime_rx_stop_(pCtx);
+
+		if (pRing->u8Count >= pRing->sStats.u8Depth)
+		{
+			// Ring is full, drop the frame
+			_sat_add_u32_(&(pRing->sStats.u32Overflow), 1);
+			return NETDEV_STATUS_BUSY;
+		}
+
+		pFrm = &(pRing->aFrm[pRing->u8Head]);
+		if ( pIf->pfGetRecv(pPhydev, &(pFrm->aBuff[1]), &(pFrm->u8Size) ) )
+		{
+			_sat_add_u32_(&(pCtx->aPhyLink[u8Phy].u32PhyErr), 1);
+			pNetdev->eErrType = NETDEV_ERROR_PHY;
+			*_phy_state_(pNetdev, u8Phy) = NETDEV_STATE_ERROR;
+			return NETDEV_STATUS_ERROR;
+		}
+		pIf->pfIoctl(pPhydev, PHY_CTL_GET_RSSI, (uint32_t)(&pFrm->u8Rssi));
+		_rx_tstamp_(pNetdev, pCtx, &(pFrm->sSyncTime));
+		pFrm->u8Phy = u8Phy;
+		// The RX configuration may change before the frame is extracted
+		pFrm->eChannel = pCtx->sMediumCfg.eRxChannel;
+		pFrm->eModulation = pCtx->sMediumCfg.eRxModulation;
+		time(&t);
+		pFrm->u32Epoch = (uint32_t)t;
+
+		pRing->u8Head = (pRing->u8Head + 1) % pRing->sStats.u8Depth;
+		pRing->u8Count++;
+		_sat_add_u32_(&(pRing->sStats.u32Queued), 1);
+		if (pRing->u8Count > pRing->sStats.u8HighWater)
+		{
+			pRing->sStats.u8HighWater = pRing->u8Count;
+		}
+	}
+	return i32Ret;
+}
+
 /*!
  * @brief  This function open a listen window
  *
+ * @details The window is opened on the PHY of the RX route (see
+ * NETDEV_CTL_SET_ROUTE). If it is not the TX one, the window can be opened
+ * while a frame is being transmitted.
+ *
  * @param [in] pNetdev Pointer on netdev_t device
  *
  * @retval NETDEV_STATUS_OK (see @link netdev_status_e::NETDEV_STATUS_OK @endlink)
@@ -273,23 +717,38 @@ int32_t WizeNet_Listen(netdev_t* pNetdev)
 	int32_t i32Ret = NETDEV_STATUS_ERROR;
 	wize_net_t* pCtx;
 	const phy_if_t* pIf;
+	phydev_t *pPhydev;
 	struct medium_cfg_s* pConfig;
+	uint8_t u8Phy;
 
-	i32Ret = _check_idle_state(pNetdev);
+	if (pNetdev == NULL)
+	{
+		return i32Ret;
+	}
+	u8Phy = pNetdev->aRoute[NETDEV_ROUTE_RX];
+	i32Ret = _check_idle_state(pNetdev, u8Phy);
 	if ( i32Ret == NETDEV_STATUS_OK )
 	{
-		pIf = pNetdev->pPhydev->pIf;
+		pPhydev = _phy_dev_(pNetdev, u8Phy);
+		pIf = pPhydev->pIf;
 		pCtx = (wize_net_t*)pNetdev->pCtx;
 		pConfig = &(pCtx->sMediumCfg);
-		if ( pIf->pfRx(pNetdev->pPhydev, pConfig->eRxChannel, pConfig->eRxModulation) )
+		_airtime_rx_stop_(pCtx);
+		pCtx->u8RxPhy = u8Phy;
+		pCtx->bSyncTick = 0;
+		if ( pIf->pfRx(pPhydev, pConfig->eRxChannel, pConfig->eRxModulation) )
 		{
+			_sat_add_u32_(&(pCtx->aPhyLink[u8Phy].u32PhyErr), 1);
 			pNetdev->eErrType = NETDEV_ERROR_PHY;
-			pNetdev->eState = NETDEV_STATE_ERROR;
+			*_phy_state_(pNetdev, u8Phy) = NETDEV_STATE_ERROR;
 			i32Ret = NETDEV_STATUS_ERROR;
 		}
 		else {
-			pNetdev->eState = NETDEV_STATE_BUSY;
-			pNetdev->pPhydev->bPreSyncOn = 1;
+			*_phy_state_(pNetdev, u8Phy) = NETDEV_STATE_BUSY;
+			pPhydev->bPreSyncOn = 1;
+			pCtx->sAirTime.eRxChannel = pConfig->eRxChannel;
+			pCtx->sAirTime.u32RxStart = _airtime_now_ms_();
+			pCtx->sAirTime.bRxOn = 1;
 		    i32Ret = NETDEV_STATUS_OK;
 		}
 	}
@@ -300,6 +759,10 @@ int32_t WizeNet_Listen(netdev_t* pNetdev)
 /*!
  * @brief  This function Get/Set internal configuration variable
  *
+ * @details A PHY command (NETDEV_CTL_PHY_CMD) is given to all the initialized
+ * PHYs, or only to the PHY of the TX and/or RX route if NETDEV_CTL_PHY_TX
+ * and/or NETDEV_CTL_PHY_RX are set. A PHY getter should select one route.
+ *
  * @param [in]     pNetdev Pointer on netdev_t device
  * @param [in]     eCtl    Id of configuration variable to get/set (see netdev_ctl_e)
  * @param [in,out] args    scalar or pointer that hold the value to set/get
@@ -313,7 +776,9 @@ int32_t WizeNet_Ioctl(netdev_t* pNetdev, uint32_t eCtl, uint32_t args)
 	int32_t i32Ret = NETDEV_STATUS_ERROR;
 	const phy_if_t* pIf;
 	wize_net_t *pCtx;
+	netdev_state_e *pState;
 	int32_t ret;
+	uint8_t u8Phy;
 	if (pNetdev )
 	{
 		pIf = pNetdev->pPhydev->pIf;
@@ -324,25 +789,60 @@ int32_t WizeNet_Ioctl(netdev_t* pNetdev, uint32_t eCtl, uint32_t args)
 		{
 			// FIXME : how to pass argument
 
-			uint32_t phy_ctl = eCtl & ~(NETDEV_CTL_PHY_CMD);
+			uint32_t phy_ctl = eCtl & ~(NETDEV_CTL_PHY_CMD | NETDEV_CTL_PHY_TX | NETDEV_CTL_PHY_RX);
 			if(eCtl > PHY_CTL_CMD)
 			{
 				phy_ctl = (phy_ctl_e)args;
 			}
 
-			ret = pIf->pfIoctl(pNetdev->pPhydev, (phy_ctl_e)(phy_ctl), args);
-			if ( ret )
+			i32Ret = NETDEV_STATUS_OK;
+			for (u8Phy = 0; u8Phy < pNetdev->u8PhyNb; u8Phy++)
 			{
-				pNetdev->eErrType = NETDEV_ERROR_PHY;
-				pNetdev->eState = NETDEV_STATE_ERROR;
+				pState = _phy_state_(pNetdev, u8Phy);
+				// Not attached to the requested route(s)
+				if ( (eCtl & (NETDEV_CTL_PHY_TX | NETDEV_CTL_PHY_RX)) &&
+					 !( (eCtl & NETDEV_CTL_PHY_TX) && (u8Phy == pNetdev->aRoute[NETDEV_ROUTE_TX]) ) &&
+					 !( (eCtl & NETDEV_CTL_PHY_RX) && (u8Phy == pNetdev->aRoute[NETDEV_ROUTE_RX]) ) )
+				{
+					continue;
+				}
+				// Additional PHY not initialized
+				if ( u8Phy && (*pState == NETDEV_STATE_UNKWON) )
+				{
+					continue;
+				}
+
+				// PHY configuration may be changed behind the shadow
+				if ( (u8Phy == pNetdev->aRoute[NETDEV_ROUTE_TX]) &&
+					 ( (phy_ctl < PHY_CTL_GET_TX_FREQ_OFF) || (phy_ctl == PHY_CTL_SET_MULTI) ||
+					   ( (phy_ctl > PHY_CTL_CMD) && (phy_ctl < PHY_CTL_CMD_READY) ) ) )
+				{
+					pCtx->sPhyShadow.u8Valid = 0;
+				}
+				// Any command stop the current RX
+				if ( (u8Phy == pCtx->u8RxPhy) && (phy_ctl > PHY_CTL_CMD) )
+				{
+					_airtime_rx_stop_(pCtx);
+				}
+
+				ret = _phy_dev_(pNetdev, u8Phy)->pIf->pfIoctl(_phy_dev_(pNetdev, u8Phy), (phy_ctl_e)(phy_ctl), args);
+				if ( ret )
+				{
+					_sat_add_u32_(&(pCtx->aPhyLink[u8Phy].u32PhyErr), 1);
+					pNetdev->eErrType = NETDEV_ERROR_PHY;
+					*pState = NETDEV_STATE_ERROR;
+					i32Ret = NETDEV_STATUS_ERROR;
+				}
+				else {
+					*pState = NETDEV_STATE_IDLE;
+				}
 			}
-			else {
+			if (i32Ret == NETDEV_STATUS_OK)
+			{
 				pNetdev->eErrType = NETDEV_ERROR_NONE;
-				pNetdev->eState = NETDEV_STATE_IDLE;
-				i32Ret = NETDEV_STATUS_OK;
 			}
 		}
-		else if (eCtl > _NETDEV_CTL_ERR_)
+		else if ( (eCtl > _NETDEV_CTL_ERR_) && (eCtl < _NETDEV_CTL_CFG_EX_) )
 		{
 			i32Ret = NETDEV_STATUS_OK;
 
@@ -356,9 +856,121 @@ int32_t WizeNet_Ioctl(netdev_t* pNetdev, uint32_t eCtl, uint32_t args)
 					}
 					memcpy((void*)args, &(pCtx->sProtoCtx.sProtoStats), sizeof(net_stats_t));
 					break;
+				case NETDEV_CTL_GET_STATS_EX:
+					if( (void*)args == NULL)
+					{
+						i32Ret = NETDEV_STATUS_ERROR;
+						break;
+					}
+					memcpy(&(((netdev_stats_t*)args)->sStats), &(pCtx->sProtoCtx.sProtoStats), sizeof(net_stats_t));
+					memcpy(&(((netdev_stats_t*)args)->sStatsEx), &(pCtx->sProtoCtx.sProtoStatsEx), sizeof(net_stats_ex_t));
+					memcpy(&(((netdev_stats_t*)args)->sLinkStats), &(pCtx->sLinkStats), sizeof(struct link_stats_s));
+					memcpy(&(((netdev_stats_t*)args)->sRecvStats), &(pCtx->sRecvRing.sStats), sizeof(struct recv_ring_stats_s));
+					memcpy(&(((netdev_stats_t*)args)->sPhyStats), &(pCtx->sPhyShadow.sStats), sizeof(struct phy_shadow_stats_s));
+					memcpy(&(((netdev_stats_t*)args)->sLbtStats), &(pCtx->sLbt.sStats), sizeof(struct lbt_stats_s));
+					memcpy(&(((netdev_stats_t*)args)->sOpenStats), &(pCtx->sOpenStats), sizeof(struct open_stats_s));
+					memcpy(((netdev_stats_t*)args)->aPhyLink, pCtx->aPhyLink, sizeof(pCtx->aPhyLink));
+					break;
+				case NETDEV_CTL_GET_AIRTIME:
+				{
+					netdev_airtime_t *pAirTime = (netdev_airtime_t*)args;
+					struct airtime_s *pAir = &(pCtx->sAirTime);
+					uint32_t u32Max;
+					uint8_t w, c;
+					if( pAirTime == NULL)
+					{
+						i32Ret = NETDEV_STATUS_ERROR;
+						break;
+					}
+					_airtime_roll_(pAir, (uint32_t)time(NULL));
+					memcpy(pAirTime->aTxTotal, pAir->aTxTotal, sizeof(pAir->aTxTotal));
+					memcpy(pAirTime->aRxTotal, pAir->aRxTotal, sizeof(pAir->aRxTotal));
+					for (w = 0; w < AIRTIME_WIN_NB; w++)
+					{
+						for (c = 0; c < PHY_NB_CH; c++)
+						{
+							pAirTime->aTxWin[w][c] = _airtime_sum_(pAir->aWin[w].aTx[c]);
+							pAirTime->aRxWin[w][c] = _airtime_sum_(pAir->aWin[w].aRx[c]);
+						}
+						u32Max = _airtime_tx_used_(&(pAir->aWin[w]));
+						pAirTime->aDutyUsed[w] = (uint16_t)( ((uint64_t)u32Max * 10000) / AIRTIME_WIN_MS(w) );
+						pAirTime->aDutyLimit[w] = pAir->aDutyLimit[w];
+						if (pAir->aDutyLimit[w])
+						{
+							u32Max = (uint32_t)( ((uint64_t)AIRTIME_WIN_MS(w) * pAir->aDutyLimit[w]) / 10000 ) - u32Max;
+							// may be "negative" if the limit has been lowered
+							pAirTime->aTxBudget[w] = (u32Max > AIRTIME_WIN_MS(w))?(0):(u32Max);
+						}
+						else
+						{
+							pAirTime->aTxBudget[w] = UINT32_MAX;
+						}
+					}
+					pAirTime->u32Rejected = pAir->u32Rejected;
+					break;
+				}
 				case NETDEV_CTL_CLR_STATS:
 					Wize_ProtoStats_RxClear(&(pCtx->sProtoCtx));
 					Wize_ProtoStats_TxClear(&(pCtx->sProtoCtx));
+					memset(&(pCtx->sLinkStats), 0, sizeof(struct link_stats_s));
+					pCtx->sRecvRing.sStats.u32Queued = 0;
+					pCtx->sRecvRing.sStats.u32Overflow = 0;
+					pCtx->sRecvRing.sStats.u32Flushed = 0;
+					pCtx->sRecvRing.sStats.u8HighWater = pCtx->sRecvRing.u8Count;
+					memset(&(pCtx->sPhyShadow.sStats), 0, sizeof(struct phy_shadow_stats_s));
+					// windows are kept, they are used by the duty-cycle limit
+					memset(pCtx->sAirTime.aTxTotal, 0, sizeof(pCtx->sAirTime.aTxTotal));
+					memset(pCtx->sAirTime.aRxTotal, 0, sizeof(pCtx->sAirTime.aRxTotal));
+					pCtx->sAirTime.u32Rejected = 0;
+					memset(&(pCtx->sLbt.sStats), 0, sizeof(struct lbt_stats_s));
+					memset(&(pCtx->sOpenStats), 0, sizeof(struct open_stats_s));
+					memset(pCtx->aPhyLink, 0, sizeof(pCtx->aPhyLink));
+					break;
+				case NETDEV_CTL_GET_RECV_NB:
+					i32Ret = pCtx->sRecvRing.u8Count;
+					break;
+				case NETDEV_CTL_FLUSH_RECV:
+					_recv_ring_flush_(&(pCtx->sRecvRing));
+					break;
+				case NETDEV_CTL_SET_ROUTE:
+					u8Phy = (uint8_t)(args & 0xFF);
+					if ( ((args >> 8) >= NETDEV_ROUTE_NB) || (u8Phy >= pNetdev->u8PhyNb) )
+					{
+						i32Ret = NETDEV_STATUS_ERROR;
+						break;
+					}
+					// Neither the current nor the new PHY may be in use
+					if ( (*_phy_state_(pNetdev, pNetdev->aRoute[args >> 8]) == NETDEV_STATE_BUSY) ||
+						 (*_phy_state_(pNetdev, u8Phy) == NETDEV_STATE_BUSY) )
+					{
+						i32Ret = NETDEV_STATUS_BUSY;
+						break;
+					}
+					if ( ((args >> 8) == NETDEV_ROUTE_TX) && (pNetdev->aRoute[NETDEV_ROUTE_TX] != u8Phy) )
+					{
+						// The shadow is the one of the previous TX PHY
+						pCtx->sPhyShadow.u8Valid = 0;
+					}
+					pNetdev->aRoute[args >> 8] = u8Phy;
+					break;
+				case NETDEV_CTL_GET_ROUTE:
+					if (args >= NETDEV_ROUTE_NB)
+					{
+						i32Ret = NETDEV_STATUS_ERROR;
+						break;
+					}
+					i32Ret = pNetdev->aRoute[args];
+					break;
+				case NETDEV_CTL_GET_PHY_NB:
+					i32Ret = pNetdev->u8PhyNb;
+					break;
+				case NETDEV_CTL_GET_PHY_STATE:
+					if (args >= pNetdev->u8PhyNb)
+					{
+						i32Ret = NETDEV_STATUS_ERROR;
+						break;
+					}
+					i32Ret = *_phy_state_(pNetdev, (uint8_t)args);
 					break;
 				case NETDEV_CTL_CLR_ERR:
 					switch (pNetdev->eErrType)
@@ -380,7 +992,18 @@ int32_t WizeNet_Ioctl(netdev_t* pNetdev, uint32_t eCtl, uint32_t args)
 							break;
 					}
 					pNetdev->eErrType = NETDEV_ERROR_NONE;
-					pNetdev->eState = NETDEV_STATE_IDLE;
+					// Error on a ring frame can occur while the PHY is listening
+					if (pNetdev->eState != NETDEV_STATE_BUSY)
+					{
+						pNetdev->eState = NETDEV_STATE_IDLE;
+					}
+					for (u8Phy = 1; u8Phy < pNetdev->u8PhyNb; u8Phy++)
+					{
+						if (pNetdev->aPhyEx[u8Phy - 1].eState == NETDEV_STATE_ERROR)
+						{
+							pNetdev->aPhyEx[u8Phy - 1].eState = NETDEV_STATE_IDLE;
+						}
+					}
 					break;
 				case NETDEV_CTL_GET_ERR:
 					switch (pNetdev->eErrType)
@@ -430,9 +1053,20 @@ int32_t WizeNet_Ioctl(netdev_t* pNetdev, uint32_t eCtl, uint32_t args)
 					break;
 			}
 		}
+		else if (eCtl == NETDEV_CTL_GET_BACKOFF)
+		{
+			// Only the LBT state, so it doesn't wait for the routed PHYs to be
+			// idle (the RX one may be listening)
+			i32Ret = (int32_t)_lbt_backoff_(pCtx);
+		}
 		else
 		{
-			i32Ret = _check_idle_state(pNetdev);
+			// The configuration is shared by the routed PHYs
+			i32Ret = _check_idle_state(pNetdev, pNetdev->aRoute[NETDEV_ROUTE_TX]);
+			if ( i32Ret == NETDEV_STATUS_OK)
+			{
+				i32Ret = _check_idle_state(pNetdev, pNetdev->aRoute[NETDEV_ROUTE_RX]);
+			}
 			if ( i32Ret == NETDEV_STATUS_OK)
 			{
 				switch (eCtl)
@@ -499,6 +1133,7 @@ int32_t WizeNet_Ioctl(netdev_t* pNetdev, uint32_t eCtl, uint32_t args)
 							break;
 						}
 						memcpy(&(pCtx->sProtoCtx.sProtoConfig), (struct proto_config_s*)args, sizeof(struct proto_config_s));
+						_send_prep_drop_(pCtx);
 						break;
 
 					case NETDEV_CTL_SET_TRANSLEN:
@@ -509,6 +1144,7 @@ int32_t WizeNet_Ioctl(netdev_t* pNetdev, uint32_t eCtl, uint32_t args)
 						break;
 					case NETDEV_CTL_SET_NETWID:
 						pCtx->sProtoCtx.sProtoConfig.u8NetId = (uint8_t)args;
+						_send_prep_drop_(pCtx);
 						break;
 					case NETDEV_CTL_SET_DWNID:
 						pCtx->sProtoCtx.sProtoConfig.DwnId[0] = (uint8_t)(args >> 16);
@@ -525,6 +1161,7 @@ int32_t WizeNet_Ioctl(netdev_t* pNetdev, uint32_t eCtl, uint32_t args)
 						}
 						memcpy(pCtx->sProtoCtx.aDeviceManufID, (uint8_t*)args, MFIELD_SZ);
 						memcpy(pCtx->sProtoCtx.aDeviceAddr, &(((uint8_t*)args)[MFIELD_SZ]), AFIELD_SZ);
+						_send_prep_drop_(pCtx);
 						break;
 					case NETDEV_CTL_GET_DEVID:
 						if( (void*)args == NULL)
@@ -535,44 +1172,196 @@ int32_t WizeNet_Ioctl(netdev_t* pNetdev, uint32_t eCtl, uint32_t args)
 						memcpy((uint8_t*)args, pCtx->sProtoCtx.aDeviceManufID, MFIELD_SZ);
 						memcpy(&(((uint8_t*)args)[MFIELD_SZ]), pCtx->sProtoCtx.aDeviceAddr, AFIELD_SZ);
 						break;
-					/*--------------------------------------------------------*/
-					default:
+					case NETDEV_CTL_SET_RECV_DEPTH:
+						if( (args == 0) || (args > RECV_RING_DEPTH) )
+						{
+							i32Ret = NETDEV_STATUS_ERROR;
+							break;
+						}
+						_recv_ring_flush_(&(pCtx->sRecvRing));
+						pCtx->sRecvRing.sStats.u8Depth = (uint8_t)args;
 						break;
-				}
-			}
-		}
-	}
-	return i32Ret;
-}
-
-/*==============================================================================
- * Private internal function
- *============================================================================*/
-
-/*!
+					case NETDEV_CTL_SET_DUTY_1H:
+					case NETDEV_CTL_SET_DUTY_24H:
+						if(args > 10000)
+						{
+							i32Ret = NETDEV_STATUS_ERROR;
+							break;
+						}
+						pCtx->sAirTime.aDutyLimit[
+							(eCtl == NETDEV_CTL_SET_DUTY_1H)?(AIRTIME_WIN_1H):(AIRTIME_WIN_24H)
+							] = (uint16_t)args;
+						break;
+					case NETDEV_CTL_SET_CCA_THRES:
+						pCtx->sLbt.u8Threshold = (uint8_t)args;
+						break;
+					case NETDEV_CTL_SET_CCA_ATTEMPTS:
+						if( (args == 0) || (args > UINT8_MAX) )
+						{
+							i32Ret = NETDEV_STATUS_ERROR;
+							break;
+						}
+						pCtx->sLbt.u8MaxAttempts = (uint8_t)args;
+						pCtx->sLbt.u8Attempt = 0;
+						break;
+					case NETDEV_CTL_SET_BACKOFF:
+						if( ((args & 0xFFFF) == 0) || ((args & 0xFFFF) > (args >> 16)) )
+						{
+							i32Ret = NETDEV_STATUS_ERROR;
+							break;
+						}
+						pCtx->sLbt.u16BackoffMin = (uint16_t)(args & 0xFFFF);
+						pCtx->sLbt.u16BackoffMax = (uint16_t)(args >> 16);
+						break;
+					/*--------------------------------------------------------*/
+					default:
+						break;
+				}
+			}
+		}
+	}
+	return i32Ret;
+}
+
+/*!
+ * @brief  This function compute the time on air of a frame
+ *
+ * @param [in] eModulation Modulation
+ * @param [in] u8Len       Frame length as given to the PHY (without L-field
+ *                         and CRC)
+ * @param [in] bCrcOn      The PHY add the CRC
+ *
+ * @return The time on air (in us)
+ */
+uint32_t WizeNet_AirTime(phy_mod_e eModulation, uint8_t u8Len, uint8_t bCrcOn)
+{
+	uint32_t u32Bits;
+	if (eModulation >= PHY_NB_MOD)
+	{
+		eModulation = PHY_WM2400;
+	}
+	// preamble, synchro, L-field, frame and CRC
+	u32Bits = _aSyncBits_[eModulation] + ( (uint32_t)u8Len + 1 + ((bCrcOn)?(2):(0)) ) * 8;
+	return (uint32_t)( ((uint64_t)u32Bits * 1000000 + _aBitRate_[eModulation] - 1) / _aBitRate_[eModulation] );
+}
+
+/*==============================================================================
+ * Private internal function
+ *============================================================================*/
+
+/*!
  * @static
- * @brief  This function check if the device is in IDLE state
+ * @brief  This function get the given PHY device
  *
  * @param [in]  pNetdev Pointer on netdev_t device
+ * @param [in]  u8Phy   PHY index
+ *
+ * @return Pointer on the PHY device
+ *
+ */
+static inline phydev_t* _phy_dev_(netdev_t* pNetdev, uint8_t u8Phy)
+{
+	return (u8Phy)?(pNetdev->aPhyEx[u8Phy - 1].pPhydev):(pNetdev->pPhydev);
+}
+
+/*!
+ * @static
+ * @brief  This function get the state of the given PHY
+ *
+ * @param [in]  pNetdev Pointer on netdev_t device
+ * @param [in]  u8Phy   PHY index
+ *
+ * @return Pointer on the PHY state
+ *
+ */
+static inline netdev_state_e* _phy_state_(netdev_t* pNetdev, uint8_t u8Phy)
+{
+	return (u8Phy)?(&(pNetdev->aPhyEx[u8Phy - 1].eState)):(&(pNetdev->eState));
+}
+
+/*!
+ * @static
+ * @brief  This function open the additional PHYs, once the primary one is
+ * opened.
+ *
+ * @details On failure, the PHY is left in the unknown state and the routes
+ * that use it fall back to the primary PHY.
+ *
+ * @param [in]  pNetdev Pointer on netdev_t device
+ * @param [in]  bWarm   0 : initialize the PHY, 1 : resume it if suspended
+ *
+ * @return None
+ *
+ */
+static void _phy_ex_open_(netdev_t* pNetdev, uint8_t bWarm)
+{
+	struct netdev_phy_s *pPhy;
+	int32_t i32Ret;
+	uint8_t u8Phy, r;
+
+	for (u8Phy = 1; u8Phy < pNetdev->u8PhyNb; u8Phy++)
+	{
+		pPhy = &(pNetdev->aPhyEx[u8Phy - 1]);
+		if ( bWarm && (pPhy->eState == NETDEV_STATE_SUSPEND) )
+		{
+			i32Ret = pPhy->pPhydev->pIf->pfIoctl(pPhy->pPhydev, PHY_CTL_CMD_READY, 0);
+		}
+		else
+		{
+			i32Ret = pPhy->pPhydev->pIf->pfInit(pPhy->pPhydev);
+		}
+
+		if ( i32Ret != PHY_STATUS_OK )
+		{
+			_sat_add_u32_(&(((wize_net_t*)pNetdev->pCtx)->aPhyLink[u8Phy].u32PhyErr), 1);
+			pPhy->eState = NETDEV_STATE_UNKWON;
+			for (r = 0; r < NETDEV_ROUTE_NB; r++)
+			{
+				if (pNetdev->aRoute[r] == u8Phy)
+				{
+					pNetdev->aRoute[r] = 0;
+				}
+			}
+			// The shadow may be the one of the failed PHY
+			((wize_net_t*)pNetdev->pCtx)->sPhyShadow.u8Valid = 0;
+		}
+		else
+		{
+			pPhy->eState = NETDEV_STATE_IDLE;
+			pPhy->pPhydev->bPreSyncOn = 1;
+			pPhy->pPhydev->pfEvtCb = &_evt_cb_ex;
+			pPhy->pPhydev->pCbParam = (void*)pPhy;
+		}
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function check if the given PHY is in IDLE state
+ *
+ * @param [in]  pNetdev Pointer on netdev_t device
+ * @param [in]  u8Phy   PHY index
  *
  * @retval NETDEV_STATUS_OK (see @link netdev_status_e::NETDEV_STATUS_OK @endlink))
  * @retval NETDEV_STATUS_ERROR (see @link netdev_status_e::NETDEV_STATUS_ERROR @endlink)
  * @retval NETDEV_STATUS_BUSY (see @link netdev_status_e::NETDEV_STATUS_BUSY @endlink)
  *
  */
-static int32_t _check_idle_state(netdev_t* pNetdev)
+static int32_t _check_idle_state(netdev_t* pNetdev, uint8_t u8Phy)
 {
+	netdev_state_e eState;
 	if (pNetdev == NULL)
 	{
 		return NETDEV_STATUS_ERROR;
 	}
+	eState = *_phy_state_(pNetdev, u8Phy);
 	// Idle
-	if ( pNetdev->eState & NETDEV_STATE_IDLE )
+	if ( eState & NETDEV_STATE_IDLE )
 	{
 		return NETDEV_STATUS_OK;
 	}
 	// Busy
-	else if (pNetdev->eState & NETDEV_STATE_BUSY)
+	else if (eState & NETDEV_STATE_BUSY)
 	{
 		return NETDEV_STATUS_BUSY;
 	}
@@ -583,6 +1372,687 @@ static int32_t _check_idle_state(netdev_t* pNetdev)
 	}
 }
 
+/*!
+ * @static
+ * @brief  This function extract the oldest frame from the reception ring
+ *
+ * @param [in] pNetdev Pointer on netdev_t device
+ * @param [in] pNetMsg Pointer on structure that will hold the message
+ *
+ * @retval NETDEV_STATUS_OK (see @link netdev_status_e::NETDEV_STATUS_OK @endlink)
+ * @retval NETDEV_STATUS_ERROR (see @link netdev_status_e::NETDEV_STATUS_ERROR @endlink)
+ *
+ */
+static int32_t _recv_from_ring_(netdev_t* pNetdev, net_msg_t *pNetMsg)
+{
+	int32_t i32Ret;
+	wize_net_t* pCtx = (wize_net_t*)pNetdev->pCtx;
+	struct recv_ring_s *pRing = &(pCtx->sRecvRing);
+	struct recv_frm_s *pFrm = &(pRing->aFrm[pRing->u8Tail]);
+
+	pRing->u8Tail = (pRing->u8Tail + 1) % pRing->sStats.u8Depth;
+	pRing->u8Count--;
+
+	pNetMsg->u8Rssi = pFrm->u8Rssi;
+	pCtx->sProtoCtx.u8Size = pFrm->u8Size;
+	pCtx->sProtoCtx.pBuffer = pFrm->aBuff;
+	pCtx->u8ProtoErr = Wize_ProtoExtract(&(pCtx->sProtoCtx), pNetMsg);
+	if ( !(pCtx->u8ProtoErr) )
+	{
+		// Keep the capture time, not the extraction one
+		pNetMsg->u32Epoch = pFrm->u32Epoch;
+		pNetMsg->u32RxEpoch = pFrm->sSyncTime.u32Sec;
+		pNetMsg->u32RxUSec = pFrm->sSyncTime.u32USec;
+		_sat_add_u32_(&(pCtx->sLinkStats.aRxFrmPerCh[pFrm->eChannel]), 1);
+		_sat_add_u32_(&(pCtx->sLinkStats.aRxFrmPerMod[pFrm->eModulation]), 1);
+		_sat_add_u32_(&(pCtx->aPhyLink[pFrm->u8Phy].u32RxFrm), 1);
+		i32Ret = NETDEV_STATUS_OK;
+	}
+	else {
+		// Wize stack error. The PHY may be listening again, so keep its state.
+		_sat_add_u32_(&(pCtx->sLinkStats.aRxErrPerCh[pFrm->eChannel]), 1);
+		_sat_add_u32_(&(pCtx->sLinkStats.aRxErrPerMod[pFrm->eModulation]), 1);
+		_sat_add_u32_(&(pCtx->aPhyLink[pFrm->u8Phy].u32RxErr), 1);
+		if (*_phy_state_(pNetdev, pFrm->u8Phy) != NETDEV_STATE_BUSY)
+		{
+			*_phy_state_(pNetdev, pFrm->u8Phy) = NETDEV_STATE_ERROR;
+		}
+		pNetdev->eErrType = NETDEV_ERROR_PROTO;
+		i32Ret = NETDEV_STATUS_ERROR;
+	}
+	Wize_ProtoStats_RxUpdate(&(pCtx->sProtoCtx), pCtx->u8ProtoErr, pNetMsg->u8Rssi);
+	return i32Ret;
+}
+
+/*!
+ * @static
+ * @brief  This function flush the reception ring
+ *
+ * @param [in] pRing Pointer on the reception ring
+ *
+ * @return None
+ *
+ */
+static void _recv_ring_flush_(struct recv_ring_s *pRing)
+{
+	_sat_add_u32_(&(pRing->sStats.u32Flushed), pRing->u8Count);
+	pRing->u8Head = 0;
+	pRing->u8Tail = 0;
+	pRing->u8Count = 0;
+}
+
+/*!
+ * @static
+ * @brief  This function return the transmission buffer that is not used by the
+ * current (or last) transmission
+ *
+ * @param [in] pCtx Pointer on the network context
+ *
+ * @return Pointer on the free transmission buffer
+ *
+ */
+static inline uint8_t* _free_send_buff_(wize_net_t* pCtx)
+{
+	return (pCtx->pSendBuff == pCtx->aSendBuff)?(pCtx->aSendBuffAlt):(pCtx->aSendBuff);
+}
+
+/*!
+ * @static
+ * @brief  This function check if the given message is the prepared one
+ *
+ * @param [in] pCtx    Pointer on the network context
+ * @param [in] pNetMsg Pointer on the message to send
+ *
+ * @retval 1 the prepared frame has been built from this message
+ * @retval 0 otherwise
+ *
+ */
+static inline uint8_t _send_prep_match_(wize_net_t* pCtx, net_msg_t *pNetMsg)
+{
+	struct send_prep_s *pPrep = &(pCtx->sSendPrep);
+	return ( (pPrep->pNetMsg == pNetMsg) &&
+			 (pPrep->pData == pNetMsg->pData) &&
+			 (pPrep->u16Id == pNetMsg->u16Id) &&
+			 (pPrep->u8MsgSize == pNetMsg->u8Size) &&
+			 (pPrep->u8Type == pNetMsg->u8Type) &&
+			 (pPrep->u8KeyId == pNetMsg->u8KeyId) );
+}
+
+/*!
+ * @static
+ * @brief  This function discard the prepared frame (if any)
+ *
+ * @param [in] pCtx Pointer on the network context
+ *
+ * @return None
+ *
+ */
+static inline void _send_prep_drop_(wize_net_t* pCtx)
+{
+	if (pCtx->sSendPrep.pNetMsg)
+	{
+		pCtx->sSendPrep.pNetMsg = NULL;
+		_sat_add_u32_(&(pCtx->sSendPrep.u32Dropped), 1);
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function push the TX configuration to the PHY
+ *
+ * @details Only the fields that differ from the shadow (or are unknown) are
+ * written. When several fields have changed, they are first tried in one
+ * transaction (PHY_CTL_SET_MULTI), then one by one for the fields the PHY
+ * didn't apply. As before, a PHY error doesn't prevent the transmission, but
+ * the field is kept unknown so it will be written again next time.
+ *
+ * @param [in] pNetdev Pointer on netdev_t device
+ * @param [in] pCtx    Pointer on the network context
+ *
+ * @return None
+ *
+ */
+static void _phy_cfg_apply_(netdev_t* pNetdev, wize_net_t* pCtx)
+{
+	phydev_t *pPhydev = _phy_dev_(pNetdev, pCtx->u8TxPhy);
+	const phy_if_t* pIf = pPhydev->pIf;
+	struct phy_shadow_s *pShadow = &(pCtx->sPhyShadow);
+	struct medium_cfg_s *pConfig = &(pCtx->sMediumCfg);
+	phy_cfg_set_t sSet;
+
+	sSet.u8Mask = 0;
+	sSet.eTxPower = pConfig->eTxPower;
+	sSet.i16TxFreqOffset = pConfig->i16TxFreqOffset;
+
+	if ( !(pShadow->u8Valid & PHY_CFG_TX_POWER) || (pShadow->eTxPower != sSet.eTxPower) )
+	{
+		sSet.u8Mask |= PHY_CFG_TX_POWER;
+	}
+	else
+	{
+		_sat_add_u32_(&(pShadow->sStats.u32Avoided), 1);
+	}
+	if ( !(pShadow->u8Valid & PHY_CFG_TX_FREQ_OFF) || (pShadow->i16TxFreqOffset != sSet.i16TxFreqOffset) )
+	{
+		sSet.u8Mask |= PHY_CFG_TX_FREQ_OFF;
+	}
+	else
+	{
+		_sat_add_u32_(&(pShadow->sStats.u32Avoided), 1);
+	}
+
+	// Applied fields are no more valid until the PHY acknowledge them
+	pShadow->u8Valid &= ~sSet.u8Mask;
+	pShadow->eTxPower = sSet.eTxPower;
+	pShadow->i16TxFreqOffset = sSet.i16TxFreqOffset;
+
+	if (sSet.u8Mask == (PHY_CFG_TX_POWER | PHY_CFG_TX_FREQ_OFF))
+	{
+		_sat_add_u32_(&(pShadow->sStats.u32Writes), 1);
+		if ( pIf->pfIoctl(pPhydev, PHY_CTL_SET_MULTI, (uint32_t)(&sSet)) == PHY_STATUS_OK )
+		{
+			if (sSet.u8Mask != (PHY_CFG_TX_POWER | PHY_CFG_TX_FREQ_OFF))
+			{
+				_sat_add_u32_(&(pShadow->sStats.u32Batched), 1);
+				pShadow->u8Valid |= (PHY_CFG_TX_POWER | PHY_CFG_TX_FREQ_OFF) & ~sSet.u8Mask;
+			}
+		}
+	}
+	if (sSet.u8Mask & PHY_CFG_TX_POWER)
+	{
+		_sat_add_u32_(&(pShadow->sStats.u32Writes), 1);
+		if ( pIf->pfIoctl(pPhydev, PHY_CTL_SET_TX_POWER, (uint32_t)sSet.eTxPower) == PHY_STATUS_OK )
+		{
+			pShadow->u8Valid |= PHY_CFG_TX_POWER;
+		}
+	}
+	if (sSet.u8Mask & PHY_CFG_TX_FREQ_OFF)
+	{
+		_sat_add_u32_(&(pShadow->sStats.u32Writes), 1);
+		if ( pIf->pfIoctl(pPhydev, PHY_CTL_SET_TX_FREQ_OFF, (uint32_t)sSet.i16TxFreqOffset) == PHY_STATUS_OK )
+		{
+			pShadow->u8Valid |= PHY_CFG_TX_FREQ_OFF;
+		}
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function get the current time in ms (free running, wrap around)
+ *
+ * @return The current time (in ms)
+ *
+ */
+static uint32_t _airtime_now_ms_(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (uint32_t)tv.tv_sec * 1000 + (uint32_t)tv.tv_usec / 1000;
+}
+
+/*!
+ * @static
+ * @brief  This function move the sliding windows to the current time
+ *
+ * @details Slots that are out of the windows are cleared. If the time goes
+ * backward (e.g. time synchronization), windows are restarted.
+ *
+ * @param [in] pAir   Pointer on the airtime context
+ * @param [in] u32Now Current time (in seconds)
+ *
+ * @return None
+ *
+ */
+static void _airtime_roll_(struct airtime_s *pAir, uint32_t u32Now)
+{
+	struct airtime_win_s *pWin;
+	uint32_t u32Id, u32Nb, u32Slot;
+	uint8_t w, c;
+
+	for (w = 0; w < AIRTIME_WIN_NB; w++)
+	{
+		pWin = &(pAir->aWin[w]);
+		u32Id = u32Now / _aSlotDuration_[w];
+		if (u32Id < pWin->u32SlotId)
+		{
+			memset(pWin->aTx, 0, sizeof(pWin->aTx));
+			memset(pWin->aRx, 0, sizeof(pWin->aRx));
+		}
+		else
+		{
+			u32Nb = u32Id - pWin->u32SlotId;
+			if (u32Nb > AIRTIME_SLOT_NB)
+			{
+				u32Nb = AIRTIME_SLOT_NB;
+			}
+			while (u32Nb)
+			{
+				u32Slot = (pWin->u32SlotId + u32Nb) % AIRTIME_SLOT_NB;
+				for (c = 0; c < PHY_NB_CH; c++)
+				{
+					pWin->aTx[c][u32Slot] = 0;
+					pWin->aRx[c][u32Slot] = 0;
+				}
+				u32Nb--;
+			}
+		}
+		pWin->u32SlotId = u32Id;
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function account a TX or RX time
+ *
+ * @param [in] pAir     Pointer on the airtime context
+ * @param [in] eChannel Channel
+ * @param [in] bRx      0 : TX time, 1 : RX time
+ * @param [in] u32Ms    Time to add (in ms)
+ *
+ * @return None
+ *
+ */
+static void _airtime_add_(struct airtime_s *pAir, phy_chan_e eChannel, uint8_t bRx, uint32_t u32Ms)
+{
+	uint32_t u32Slot;
+	uint8_t w;
+
+	if (eChannel >= PHY_NB_CH)
+	{
+		return;
+	}
+	_airtime_roll_(pAir, (uint32_t)time(NULL));
+	for (w = 0; w < AIRTIME_WIN_NB; w++)
+	{
+		u32Slot = pAir->aWin[w].u32SlotId % AIRTIME_SLOT_NB;
+		if (bRx)
+		{
+			_sat_add_u32_(&(pAir->aWin[w].aRx[eChannel][u32Slot]), u32Ms);
+		}
+		else
+		{
+			_sat_add_u32_(&(pAir->aWin[w].aTx[eChannel][u32Slot]), u32Ms);
+		}
+	}
+	if (bRx)
+	{
+		_sat_add_u32_(&(pAir->aRxTotal[eChannel]), u32Ms);
+	}
+	else
+	{
+		_sat_add_u32_(&(pAir->aTxTotal[eChannel]), u32Ms);
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function sum the slots of one window channel
+ *
+ * @param [in] pSlot Pointer on the first slot
+ *
+ * @return The sum (in ms)
+ *
+ */
+static uint32_t _airtime_sum_(const uint32_t *pSlot)
+{
+	uint32_t u32Sum = 0;
+	uint8_t i;
+	for (i = 0; i < AIRTIME_SLOT_NB; i++)
+	{
+		_sat_add_u32_(&u32Sum, pSlot[i]);
+	}
+	return u32Sum;
+}
+
+/*!
+ * @static
+ * @brief  This function give the TX time of one window, all channels included
+ *
+ * @param [in] pWin Pointer on the window
+ *
+ * @return The TX time (in ms)
+ *
+ */
+static uint32_t _airtime_tx_used_(struct airtime_win_s *pWin)
+{
+	uint32_t u32Sum = 0;
+	uint8_t c;
+	for (c = 0; c < PHY_NB_CH; c++)
+	{
+		_sat_add_u32_(&u32Sum, _airtime_sum_(pWin->aTx[c]));
+	}
+	return u32Sum;
+}
+
+/*!
+ * @static
+ * @brief  This function check that a transmission is allowed by the duty-cycle
+ * limits
+ *
+ * @details All channels are in the same regulated sub-band, so the limit apply
+ * on the TX time of all channels.
+ *
+ * @param [in] pAir  Pointer on the airtime context
+ * @param [in] u32Ms Time on air of the transmission (in ms)
+ *
+ * @retval NETDEV_STATUS_OK (see @link netdev_status_e::NETDEV_STATUS_OK @endlink)
+ * @retval NETDEV_STATUS_DUTY (see @link netdev_status_e::NETDEV_STATUS_DUTY @endlink)
+ *
+ */
+static int32_t _airtime_check_(struct airtime_s *pAir, uint32_t u32Ms)
+{
+	uint8_t w;
+	_airtime_roll_(pAir, (uint32_t)time(NULL));
+	for (w = 0; w < AIRTIME_WIN_NB; w++)
+	{
+		if (pAir->aDutyLimit[w])
+		{
+			if ( ((uint64_t)_airtime_tx_used_(&(pAir->aWin[w])) + u32Ms) * 10000 >
+			     (uint64_t)AIRTIME_WIN_MS(w) * pAir->aDutyLimit[w] )
+			{
+				return NETDEV_STATUS_DUTY;
+			}
+		}
+	}
+	return NETDEV_STATUS_OK;
+}
+
+/*!
+ * @static
+ * @brief  This function account the RX-on time of the current RX, if any
+ *
+ * @param [in] pCtx Pointer on the network context
+ *
+ * @return None
+ *
+ */
+static void _airtime_rx_stop_(wize_net_t* pCtx)
+{
+	uint32_t u32Ms;
+	if (pCtx->sAirTime.bRxOn)
+	{
+		pCtx->sAirTime.bRxOn = 0;
+		u32Ms = _airtime_now_ms_() - pCtx->sAirTime.u32RxStart;
+		// ignore it if the time has been changed meanwhile
+		if (u32Ms <= AIRTIME_WIN_MS(AIRTIME_WIN_1H))
+		{
+			_airtime_add_(&(pCtx->sAirTime), pCtx->sAirTime.eRxChannel, 1, u32Ms);
+			_sat_add_u32_(&(pCtx->aPhyLink[pCtx->u8RxPhy].u32RxMs), u32Ms);
+		}
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function execute the CCA (Clear Channel Assessment) on the TX
+ * channel
+ *
+ * @details The CCA is done only if a threshold is configured. A failed noise
+ * measurement doesn't prevent the transmission.
+ *
+ * @param [in] pNetdev Pointer on netdev_t device
+ * @param [in] pCtx    Pointer on the network context
+ *
+ * @retval NETDEV_STATUS_OK (see @link netdev_status_e::NETDEV_STATUS_OK @endlink)
+ * @retval NETDEV_STATUS_CCA (see @link netdev_status_e::NETDEV_STATUS_CCA @endlink)
+ *
+ */
+static int32_t _lbt_cca_(netdev_t* pNetdev, wize_net_t* pCtx)
+{
+	phydev_t *pPhydev = _phy_dev_(pNetdev, pCtx->u8TxPhy);
+	const phy_if_t* pIf = pPhydev->pIf;
+	struct lbt_s *pLbt = &(pCtx->sLbt);
+	struct medium_cfg_s *pConfig = &(pCtx->sMediumCfg);
+
+	pLbt->u8Noise = 0;
+	if ( !(pLbt->u8Threshold) )
+	{
+		return NETDEV_STATUS_OK;
+	}
+	if ( pIf->pfNoise(pPhydev, pConfig->eTxChannel, pConfig->eTxModulation) ||
+	     pIf->pfIoctl(pPhydev, PHY_CTL_GET_NOISE, (uint32_t)(&(pLbt->u8Noise))) )
+	{
+		pLbt->u8Noise = 0;
+		return NETDEV_STATUS_OK;
+	}
+	_sat_add_u32_(&(pLbt->sStats.u32Cca), 1);
+	// the lower the value, the stronger the noise
+	if (pLbt->u8Noise < pLbt->u8Threshold)
+	{
+		_sat_add_u32_(&(pLbt->sStats.u32Busy), 1);
+		return NETDEV_STATUS_CCA;
+	}
+	return NETDEV_STATUS_OK;
+}
+
+/*!
+ * @static
+ * @brief  This function give the backoff to apply before the next CCA attempt
+ *
+ * @details The backoff is randomly taken in [min, min * 2^attempt], the upper
+ * bound being limited to the maximum backoff. When the maximum number of
+ * attempts is reached, the frame is given up and the attempts are restarted.
+ *
+ * @param [in] pCtx Pointer on the network context
+ *
+ * @return The backoff (in ms), 0 to give up
+ *
+ */
+static uint32_t _lbt_backoff_(wize_net_t* pCtx)
+{
+	struct lbt_s *pLbt = &(pCtx->sLbt);
+	uint32_t u32Win;
+	uint32_t x;
+
+	pLbt->u8Attempt++;
+	if (pLbt->u8Attempt >= pLbt->u8MaxAttempts)
+	{
+		pLbt->u8Attempt = 0;
+		_sat_add_u32_(&(pLbt->sStats.u32GiveUp), 1);
+		return 0;
+	}
+
+	if (pLbt->u8Attempt < 16)
+	{
+		u32Win = (uint32_t)pLbt->u16BackoffMin << pLbt->u8Attempt;
+	}
+	else
+	{
+		u32Win = pLbt->u16BackoffMax;
+	}
+	if (u32Win > pLbt->u16BackoffMax)
+	{
+		u32Win = pLbt->u16BackoffMax;
+	}
+
+	// xorshift32, seeded with the device address so devices don't synchronize
+	if (!pLbt->u32Rand)
+	{
+		memcpy(&x, pCtx->sProtoCtx.aDeviceAddr, sizeof(x));
+		x ^= _airtime_now_ms_();
+		pLbt->u32Rand = (x)?(x):(0x2545F491);
+	}
+
+	u32Win = pLbt->u16BackoffMin + _xorshift32_(&(pLbt->u32Rand)) % (u32Win - pLbt->u16BackoffMin + 1);
+	_sat_add_u32_(&(pLbt->sStats.u32Backoff), 1);
+	_sat_add_u32_(&(pLbt->sStats.u32BackoffMs), u32Win);
+	return u32Win;
+}
+
+/*!
+ * @static
+ * @brief  This function get the sync word detection time of the last received
+ *         frame.
+ *
+ * @details The PHY time stamp is used first (see PHY_CTL_GET_SYNC_TIME). If the
+ * PHY doesn't give it, the time of the RX started event is used : the event
+ * only record a tick (no RTC access in the interrupt handler), which is turned
+ * into a time here, relative to the current time. At last, the current time is
+ * used.
+ *
+ * @param [in]  pNetdev Pointer on netdev_t device
+ * @param [in]  pCtx    Pointer on the Wize network context
+ * @param [out] pTstamp Pointer on the time stamp to fill
+ *
+ * @return None
+ *
+ */
+static void _rx_tstamp_(netdev_t* pNetdev, wize_net_t* pCtx, phy_tstamp_t *pTstamp)
+{
+	struct timeval tv;
+	uint32_t u32Ago;
+	phydev_t *pPhydev = _phy_dev_(pNetdev, pCtx->u8RxPhy);
+
+	pTstamp->u32Sec = 0;
+	pTstamp->u32USec = 0;
+	if ( pPhydev->pIf->pfIoctl(pPhydev, PHY_CTL_GET_SYNC_TIME, (uint32_t)pTstamp)
+		|| !(pTstamp->u32Sec) )
+	{
+		gettimeofday(&tv, NULL);
+		pTstamp->u32Sec = (uint32_t)tv.tv_sec;
+		pTstamp->u32USec = (uint32_t)tv.tv_usec;
+		if (pCtx->bSyncTick)
+		{
+			u32Ago = _tick_ms_(0) - pCtx->u32SyncTick;
+			pTstamp->u32Sec -= u32Ago / 1000;
+			u32Ago = (u32Ago % 1000) * 1000;
+			if (pTstamp->u32USec < u32Ago)
+			{
+				pTstamp->u32Sec--;
+				pTstamp->u32USec += 1000000;
+			}
+			pTstamp->u32USec -= u32Ago;
+		}
+	}
+	pCtx->bSyncTick = 0;
+}
+
+/*!
+ * @static
+ * @brief  This function get a free running tick, in ms (wrap around). It is
+ *         cheap enough to be called from the PHY interrupt handler.
+ *
+ * @param [in] bFromIsr 1 : called from an interrupt handler, 0 otherwise
+ *
+ * @return The current tick (ms)
+ *
+ */
+static inline uint32_t _tick_ms_(uint8_t bFromIsr)
+{
+#if defined ( __OS__ ) && ( OS_FreeRTOS == 1 )
+	TickType_t xTick = (bFromIsr)?(xTaskGetTickCountFromISR()):(xTaskGetTickCount());
+	return (uint32_t)(xTick * portTICK_PERIOD_MS);
+#else
+	(void)bFromIsr;
+	return (uint32_t)( ((uint64_t)clock() * 1000) / CLOCKS_PER_SEC );
+#endif
+}
+
+/*!
+ * @static
+ * @brief  This function get the current time in micro-second (wrap around
+ *         every ~71 minutes, only suitable for short durations)
+ *
+ * @return The current time (us)
+ *
+ */
+static uint32_t _open_now_us_(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (uint32_t)tv.tv_sec * 1000000 + (uint32_t)tv.tv_usec;
+}
+
+/*!
+ * @static
+ * @brief  This function update the open statistics
+ *
+ * @param [in] pStats   Pointer on the open statistics
+ * @param [in] bWarm    0 : cold open (PHY init), 1 : warm open (PHY resume)
+ * @param [in] u32Start Time of the open start (us, see _open_now_us_)
+ *
+ * @return None
+ *
+ */
+static void _open_stats_upd_(struct open_stats_s *pStats, uint8_t bWarm, uint32_t u32Start)
+{
+	uint32_t u32Us = _open_now_us_() - u32Start;
+
+	pStats->u32LastUs = u32Us;
+	if (bWarm)
+	{
+		_sat_add_u32_(&(pStats->u32Warm), 1);
+		if (u32Us > pStats->u32WarmMaxUs)
+		{
+			pStats->u32WarmMaxUs = u32Us;
+		}
+	}
+	else
+	{
+		_sat_add_u32_(&(pStats->u32Cold), 1);
+		if (u32Us > pStats->u32ColdMaxUs)
+		{
+			pStats->u32ColdMaxUs = u32Us;
+		}
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function treat an event from one PHY (still in interrupt handler)
+ *
+ * @param [in] pNetdev Pointer on netdev_t device structure
+ * @param [in] u8Phy   Index of the PHY that give the event
+ * @param [in] evt     Event from lower PHY layer
+ *
+ * @return None
+ *
+ */
+static void _evt_treat_(netdev_t* pNetdev, uint8_t u8Phy, uint32_t evt)
+{
+	wize_net_t* pCtx = (wize_net_t*)pNetdev->pCtx;
+	netdev_evt_e eNetEvt;
+	switch(evt) {
+		case PHYDEV_EVT_RX_COMPLETE:
+			eNetEvt = NETDEV_EVT_RX_COMPLETE;
+			*_phy_state_(pNetdev, u8Phy) = NETDEV_STATE_IDLE;
+			break;
+		case PHYDEV_EVT_TX_COMPLETE:
+			eNetEvt = NETDEV_EVT_TX_COMPLETE;
+			*_phy_state_(pNetdev, u8Phy) = NETDEV_STATE_IDLE;
+			break;
+		case PHYDEV_EVT_RX_STARTED:
+			eNetEvt = NETDEV_EVT_RX_STARTED;
+			// Close enough to the sync word detection, if PHY doesn't time
+			// stamp. Only a tick here, the RTC is read out of the interrupt
+			// (see _rx_tstamp_).
+			if (pCtx && (u8Phy == pCtx->u8RxPhy) )
+			{
+				pCtx->u32SyncTick = _tick_ms_(1);
+				pCtx->bSyncTick = 1;
+			}
+			break;
+		case PHYDEV_EVT_ERROR:
+			eNetEvt = NETDEV_EVT_ERROR;
+			*_phy_state_(pNetdev, u8Phy) = NETDEV_STATE_ERROR;
+			if (pCtx)
+			{
+				_sat_add_u32_(&(pCtx->aPhyLink[u8Phy].u32PhyErr), 1);
+			}
+			break;
+		case PHYDEV_EVT_CCA_STARTED:
+		case PHYDEV_EVT_CCA_COMPLETE:
+			// CCA is done synchronously in WizeNet_Send
+			return;
+		default:
+			eNetEvt = NETDEV_EVT_NONE;
+			break;
+	}
+	if(pNetdev->cbEvent){
+		pNetdev->cbEvent(eNetEvt);
+	}
+}
+
 /*!
  * @static
  * @brief  Callback function, from Phy to Higher level (still in interrupt handler)
@@ -596,32 +2066,29 @@ static int32_t _check_idle_state(netdev_t* pNetdev)
 static void _evt_cb(void *p_CbParam, uint32_t evt)
 {
 	netdev_t* pNetdev = (netdev_t*)p_CbParam;
-	netdev_evt_e eNetEvt;
 	if (pNetdev)
 	{
-		switch(evt) {
-			case PHYDEV_EVT_RX_COMPLETE:
-				eNetEvt = NETDEV_EVT_RX_COMPLETE;
-				pNetdev->eState = NETDEV_STATE_IDLE;
-				break;
-			case PHYDEV_EVT_TX_COMPLETE:
-				eNetEvt = NETDEV_EVT_TX_COMPLETE;
-				pNetdev->eState = NETDEV_STATE_IDLE;
-				break;
-			case PHYDEV_EVT_RX_STARTED:
-				eNetEvt = NETDEV_EVT_RX_STARTED;
-				break;
-			case PHYDEV_EVT_ERROR:
-				eNetEvt = NETDEV_EVT_ERROR;
-				pNetdev->eState = NETDEV_STATE_ERROR;
-				break;
-			default:
-				eNetEvt = NETDEV_EVT_NONE;
-				break;
-		}
-		if(pNetdev->cbEvent){
-			pNetdev->cbEvent(eNetEvt);
-		}
+		_evt_treat_(pNetdev, 0, evt);
+	}
+}
+
+/*!
+ * @static
+ * @brief  Callback function, from an additional Phy to Higher level (still in
+ * interrupt handler)
+ *
+ * @param [in] p_CbParam Pointer on netdev_phy_s structure
+ * @param [in] evt       Event from lower PHY layer
+ *
+ * @return      Status
+ *
+ */
+static void _evt_cb_ex(void *p_CbParam, uint32_t evt)
+{
+	struct netdev_phy_s* pPhy = (struct netdev_phy_s*)p_CbParam;
+	if (pPhy && pPhy->pNetdev)
+	{
+		_evt_treat_(pPhy->pNetdev, pPhy->u8Id, evt);
 	}
 }
 
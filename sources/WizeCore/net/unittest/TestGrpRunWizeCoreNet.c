@@ -10,4 +10,12 @@ TEST_GROUP_RUNNER(WizeCore_net)
     RUN_TEST_CASE(WizeCore_net, test_NetApi_Recv);
     RUN_TEST_CASE(WizeCore_net, test_NetApi_Listen);
     RUN_TEST_CASE(WizeCore_net, test_NetApi_CallBack);
+    RUN_TEST_CASE(WizeCore_net, test_NetApi_Capture);
+    RUN_TEST_CASE(WizeCore_net, test_NetApi_Prepare);
+    RUN_TEST_CASE(WizeCore_net, test_NetApi_PhyShadow);
+    RUN_TEST_CASE(WizeCore_net, test_NetApi_DutyCycle);
+    RUN_TEST_CASE(WizeCore_net, test_NetApi_Lbt);
+    RUN_TEST_CASE(WizeCore_net, test_NetApi_RxTstamp);
+    RUN_TEST_CASE(WizeCore_net, test_NetApi_SuspendResume);
+    RUN_TEST_CASE(WizeCore_net, test_NetApi_MultiPhy);
 }
@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdint.h>
+#include <time.h>
 
 TEST_GROUP(WizeCore_net);
 #include "net_api_private.h"
@@ -27,6 +28,10 @@ uint8_t frm[255];
 /******************************************************************************/
 int32_t i32PhyRetCode = PHY_STATUS_OK;
 uint8_t u8PhyExpectSize = 0;
+uint8_t bPhyMulti = 0;
+uint32_t u32PhyIoctlNb = 0;
+uint8_t u8PhyNoise = 0;
+phy_tstamp_t sPhySyncTime;
 
 uint8_t aData[256];
 net_msg_t sNetMsg;
@@ -106,6 +111,19 @@ static int32_t GetRecv(phydev_t *pPhydev, uint8_t *pBuf, uint8_t *u8Len)
 
 static int32_t Ioctl(phydev_t *pPhydev, uint32_t eCtl, uint32_t args)
 {
+	u32PhyIoctlNb++;
+	if ( bPhyMulti && (eCtl == PHY_CTL_SET_MULTI) && (i32PhyRetCode == PHY_STATUS_OK) )
+	{
+		((phy_cfg_set_t*)args)->u8Mask = 0;
+	}
+	if (eCtl == PHY_CTL_GET_NOISE)
+	{
+		*(uint8_t*)args = u8PhyNoise;
+	}
+	if (eCtl == PHY_CTL_GET_SYNC_TIME)
+	{
+		*(phy_tstamp_t*)args = sPhySyncTime;
+	}
 	return i32PhyRetCode;
 }
 
@@ -174,6 +192,7 @@ TEST_SETUP(WizeCore_net)
 
 	Wize_ProtoBuild_IgnoreAndReturn(PROTO_SUCCESS);
 	Wize_ProtoExtract_IgnoreAndReturn(PROTO_SUCCESS);
+	Wize_ProtoStamp_IgnoreAndReturn(PROTO_SUCCESS);
 	Wize_ProtoStats_RxUpdate_Ignore();
 	Wize_ProtoStats_TxUpdate_Ignore();
 	Wize_ProtoStats_RxClear_Ignore();
@@ -309,11 +328,20 @@ TEST(WizeCore_net, test_NetApi_Ioctl)
 	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
 	TEST_ASSERT_EQUAL_MEMORY((void*)(&WizeNet_Uninit), aData, sz);
 
+	netdev_stats_t sStatsEx;
+	sWizeCtx.sLinkStats.aRxFrmPerCh[PHY_CH120] = 0x1234;
+	eCtl = NETDEV_CTL_GET_STATS_EX;
+	i32Ret = WizeNet_Ioctl(&sNetDev, eCtl, (uint32_t)(&sStatsEx));
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL_MEMORY((void*)(&WizeNet_Uninit), &(sStatsEx.sStats), sz);
+	TEST_ASSERT_EQUAL(0x1234, sStatsEx.sLinkStats.aRxFrmPerCh[PHY_CH120]);
+
 	eCtl = NETDEV_CTL_CLR_STATS;
 	memset(aData, 0, sz);
 	i32Ret = WizeNet_Ioctl(&sNetDev, eCtl, 0);
 	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
 	//TEST_ASSERT_EQUAL_MEMORY(aData, (void*)(&(sWizeCtx.sProtoCtx.sProtoStats)), sz);
+	TEST_ASSERT_EQUAL(0, sWizeCtx.sLinkStats.aRxFrmPerCh[PHY_CH120]);
 
 	// Check err
 	eCtl = NETDEV_CTL_GET_ERR;
@@ -478,3 +506,504 @@ TEST(WizeCore_net, test_NetApi_CallBack)
 	_TxDone();
 	TEST_ASSERT_EQUAL(NETDEV_STATE_IDLE, sNetDev.eState);
 }
+
+TEST(WizeCore_net, test_NetApi_Capture)
+{
+	int32_t i32Ret;
+	sNetMsg.pData = &aData;
+
+	// Ring depth
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_RECV_DEPTH, 0);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_RECV_DEPTH, RECV_RING_DEPTH + 1);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_RECV_DEPTH, 2);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+
+	// Fill the ring, then overflow
+	sWizeCtx.sMediumCfg.eRxChannel = PHY_CH100;
+	sWizeCtx.sMediumCfg.eRxModulation = PHY_WM2400;
+	memset(&(sWizeCtx.sLinkStats), 0, sizeof(sWizeCtx.sLinkStats));
+	i32Ret = WizeNet_Capture(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	sWizeCtx.sMediumCfg.eRxChannel = PHY_CH110;
+	sWizeCtx.sMediumCfg.eRxModulation = PHY_WM4800;
+	i32Ret = WizeNet_Capture(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	i32Ret = WizeNet_Capture(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_BUSY, i32Ret);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sRecvRing.sStats.u32Overflow);
+	TEST_ASSERT_EQUAL(2, sWizeCtx.sRecvRing.sStats.u8HighWater);
+	TEST_ASSERT_EQUAL(2, WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_RECV_NB, 0));
+
+	// Drain while the PHY is listening again
+	sNetDev.eState = NETDEV_STATE_BUSY;
+	i32Ret = WizeNet_Recv(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(1, WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_RECV_NB, 0));
+	// Accounted on the channel and modulation of the capture, not the current ones
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sLinkStats.aRxFrmPerCh[PHY_CH100]);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sLinkStats.aRxFrmPerMod[PHY_WM2400]);
+	TEST_ASSERT_EQUAL(0, sWizeCtx.sLinkStats.aRxFrmPerCh[PHY_CH110]);
+
+	// Proto error doesn't change the PHY state
+	Wize_ProtoExtract_StopIgnore();
+	Wize_ProtoExtract_ExpectAnyArgsAndReturn(PROTO_FAILED);
+	i32Ret = WizeNet_Recv(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+	TEST_ASSERT_EQUAL(NETDEV_ERROR_PROTO, sNetDev.eErrType);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_BUSY, sNetDev.eState);
+	TEST_ASSERT_EQUAL(0, WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_RECV_NB, 0));
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sLinkStats.aRxErrPerCh[PHY_CH110]);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sLinkStats.aRxErrPerMod[PHY_WM4800]);
+	_clean_state_();
+
+	// Flush
+	i32Ret = WizeNet_Capture(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_FLUSH_RECV, 0);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(0, WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_RECV_NB, 0));
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sRecvRing.sStats.u32Flushed);
+
+	// Phy error
+	i32PhyRetCode = PHY_STATUS_ERROR;
+	i32Ret = WizeNet_Capture(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+	TEST_ASSERT_EQUAL(NETDEV_ERROR_PHY, sNetDev.eErrType);
+	_clean_state_();
+}
+
+TEST(WizeCore_net, test_NetApi_Prepare)
+{
+	int32_t i32Ret;
+	uint8_t *pPrepBuff;
+	sNetMsg.u8Type = APP_DATA;
+	sNetMsg.u16Id = 1;
+	sNetMsg.pData = &aData;
+	strcpy(aData, "Nothing to say");
+	sNetMsg.u8Size = strlen(aData);
+
+	// Prepare while idle, then send without building again
+	i32Ret = WizeNet_Prepare(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	pPrepBuff = sWizeCtx.sSendPrep.pBuff;
+	TEST_ASSERT_NOT_EQUAL(sWizeCtx.pSendBuff, pPrepBuff);
+
+	Wize_ProtoBuild_StopIgnore();
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL_PTR(pPrepBuff, sWizeCtx.pSendBuff);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sSendPrep.u32Used);
+
+	// Prepare while transmitting, in the other buffer
+	Wize_ProtoBuild_ExpectAnyArgsAndReturn(PROTO_SUCCESS);
+	i32Ret = WizeNet_Prepare(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_NOT_EQUAL(pPrepBuff, sWizeCtx.sSendPrep.pBuff);
+	_clean_state_();
+
+	// Config change discard the prepared frame
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_NETWID, L6KmacIndex);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_NULL(sWizeCtx.sSendPrep.pNetMsg);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sSendPrep.u32Dropped);
+
+	// Same message structure, but its content changed : build it again
+	Wize_ProtoBuild_ExpectAnyArgsAndReturn(PROTO_SUCCESS);
+	i32Ret = WizeNet_Prepare(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	sNetMsg.u16Id++;
+	Wize_ProtoBuild_ExpectAnyArgsAndReturn(PROTO_SUCCESS);
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sSendPrep.u32Used);
+	TEST_ASSERT_EQUAL(2, sWizeCtx.sSendPrep.u32Dropped);
+	TEST_ASSERT_NULL(sWizeCtx.sSendPrep.pNetMsg);
+	_TxDone();
+	_clean_state_();
+
+	// Proto error doesn't change the device state
+	Wize_ProtoBuild_ExpectAnyArgsAndReturn(PROTO_FAILED);
+	i32Ret = WizeNet_Prepare(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+	TEST_ASSERT_EQUAL(NETDEV_ERROR_NONE, sNetDev.eErrType);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_IDLE, sNetDev.eState);
+	TEST_ASSERT_NULL(sWizeCtx.sSendPrep.pNetMsg);
+
+	// Not ready
+	sNetDev.eState = NETDEV_STATE_ERROR;
+	i32Ret = WizeNet_Prepare(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+	_clean_state_();
+}
+
+TEST(WizeCore_net, test_NetApi_PhyShadow)
+{
+	int32_t i32Ret;
+	sNetMsg.u8Type = APP_DATA;
+	sNetMsg.u16Id = 1;
+	sNetMsg.pData = &aData;
+	strcpy(aData, "Nothing to say");
+	sNetMsg.u8Size = strlen(aData);
+	sWizeCtx.sMediumCfg.eTxPower = PHY_PMAX_minus_0db;
+	sWizeCtx.sMediumCfg.i16TxFreqOffset = 0;
+
+	// PHY without multi-set : tried once, then one by one
+	bPhyMulti = 0;
+	u32PhyIoctlNb = 0;
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(3, u32PhyIoctlNb);
+	TEST_ASSERT_EQUAL(0, sWizeCtx.sPhyShadow.sStats.u32Batched);
+	_clean_state_();
+
+	// Nothing changed
+	u32PhyIoctlNb = 0;
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(0, u32PhyIoctlNb);
+	TEST_ASSERT_EQUAL(2, sWizeCtx.sPhyShadow.sStats.u32Avoided);
+	_clean_state_();
+
+	// Only the power changed
+	sWizeCtx.sMediumCfg.eTxPower = PHY_PMAX_minus_6db;
+	u32PhyIoctlNb = 0;
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(1, u32PhyIoctlNb);
+	TEST_ASSERT_EQUAL(3, sWizeCtx.sPhyShadow.sStats.u32Avoided);
+	_clean_state_();
+
+	// PHY with multi-set : both in one transaction
+	bPhyMulti = 1;
+	sWizeCtx.sMediumCfg.eTxPower = PHY_PMAX_minus_12db;
+	sWizeCtx.sMediumCfg.i16TxFreqOffset = 100;
+	u32PhyIoctlNb = 0;
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(1, u32PhyIoctlNb);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sPhyShadow.sStats.u32Batched);
+	TEST_ASSERT_EQUAL(PHY_CFG_TX_POWER | PHY_CFG_TX_FREQ_OFF, sWizeCtx.sPhyShadow.u8Valid);
+	_clean_state_();
+
+	// PHY reset invalidate the shadow
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_PHY_CMD, PHY_CTL_CMD_RESET);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(0, sWizeCtx.sPhyShadow.u8Valid);
+	bPhyMulti = 0;
+	_clean_state_();
+}
+
+TEST(WizeCore_net, test_NetApi_DutyCycle)
+{
+	int32_t i32Ret;
+	uint8_t i;
+	netdev_airtime_t sAirTime;
+	sNetMsg.u8Type = APP_DATA;
+	sNetMsg.u16Id = 1;
+	sNetMsg.pData = &aData;
+	strcpy(aData, "Nothing to say");
+	sNetMsg.u8Size = strlen(aData);
+	memset(&(sWizeCtx.sAirTime), 0, sizeof(struct airtime_s));
+	sWizeCtx.sMediumCfg.eTxChannel = PHY_CH120;
+	sWizeCtx.sMediumCfg.eTxModulation = PHY_WM2400;
+	sPhydev.bCrcOn = 0;
+
+	// 32 + (20 + 1) * 8 bits at 2400 bps
+	TEST_ASSERT_EQUAL(83334, WizeNet_AirTime(PHY_WM2400, 20, 0));
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_DUTY_1H, 10001));
+
+	// 0.01% on 1 hour : 360 ms, that is 4 frames of 84 ms
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_DUTY_1H, 1);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	for (i = 0; i < 4; i++)
+	{
+		sWizeCtx.sProtoCtx.u8Size = 20;
+		i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+		TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+		_clean_state_();
+	}
+	sWizeCtx.sProtoCtx.u8Size = 20;
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_DUTY, i32Ret);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_IDLE, sNetDev.eState);
+	TEST_ASSERT_EQUAL(NETDEV_ERROR_NONE, sNetDev.eErrType);
+
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_AIRTIME, (uint32_t)&sAirTime);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(4*84, sAirTime.aTxWin[AIRTIME_WIN_1H][PHY_CH120]);
+	TEST_ASSERT_EQUAL(4*84, sAirTime.aTxWin[AIRTIME_WIN_24H][PHY_CH120]);
+	TEST_ASSERT_EQUAL(4*84, sAirTime.aTxTotal[PHY_CH120]);
+	TEST_ASSERT_EQUAL(360 - 4*84, sAirTime.aTxBudget[AIRTIME_WIN_1H]);
+	TEST_ASSERT_EQUAL(UINT32_MAX, sAirTime.aTxBudget[AIRTIME_WIN_24H]);
+	TEST_ASSERT_EQUAL(1, sAirTime.u32Rejected);
+
+	// No limit
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_DUTY_1H, 0);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	sWizeCtx.sProtoCtx.u8Size = 20;
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	_clean_state_();
+}
+
+TEST(WizeCore_net, test_NetApi_Lbt)
+{
+	int32_t i32Ret;
+	uint8_t i;
+	sNetMsg.u8Type = APP_DATA;
+	sNetMsg.u16Id = 1;
+	sNetMsg.pData = &aData;
+	strcpy(aData, "Nothing to say");
+	sNetMsg.u8Size = strlen(aData);
+	memset(&(sWizeCtx.sLbt.sStats), 0, sizeof(struct lbt_stats_s));
+
+	// No CCA
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_CCA_THRES, 0);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	u8PhyNoise = 10;
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(0, sWizeCtx.sLbt.sStats.u32Cca);
+	_clean_state_();
+
+	// Channel is free (-110 dBm, threshold -100 dBm)
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_CCA_THRES, 100);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_BACKOFF, (40 << 16) | 10);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_BACKOFF, (10 << 16) | 40));
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_CCA_ATTEMPTS, 0));
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_CCA_ATTEMPTS, 4);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	u8PhyNoise = 110;
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sLbt.sStats.u32Cca);
+	TEST_ASSERT_EQUAL(0, sWizeCtx.sLbt.sStats.u32Busy);
+	_clean_state_();
+
+	// Channel is busy (-90 dBm)
+	u8PhyNoise = 90;
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_CCA, i32Ret);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_IDLE, sNetDev.eState);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sLbt.sStats.u32Busy);
+
+	// 3 backoff, growing up to the maximum, then give up. The backoff is given
+	// even if a routed PHY is busy
+	sNetDev.eState = NETDEV_STATE_BUSY;
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_BACKOFF, 0);
+	TEST_ASSERT_INT32_WITHIN(5, 15, i32Ret);
+	sNetDev.eState = NETDEV_STATE_IDLE;
+	for (i = 0; i < 2; i++)
+	{
+		i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_BACKOFF, 0);
+		TEST_ASSERT_INT32_WITHIN(15, 25, i32Ret);
+	}
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_BACKOFF, 0);
+	TEST_ASSERT_EQUAL(0, i32Ret);
+	TEST_ASSERT_EQUAL(3, sWizeCtx.sLbt.sStats.u32Backoff);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sLbt.sStats.u32GiveUp);
+
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_CCA_THRES, 0);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	u8PhyNoise = 0;
+	_clean_state_();
+}
+
+TEST(WizeCore_net, test_NetApi_RxTstamp)
+{
+	int32_t i32Ret;
+	uint32_t u32Sec, u32USec;
+	sNetMsg.pData = &aData;
+
+	// PHY time stamp
+	sPhySyncTime.u32Sec = 1000;
+	sPhySyncTime.u32USec = 250;
+	i32Ret = WizeNet_Recv(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(1000, sNetMsg.u32RxEpoch);
+	TEST_ASSERT_EQUAL(250, sNetMsg.u32RxUSec);
+
+	// Captured frame keep its own time stamp
+	i32Ret = WizeNet_Capture(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	sPhySyncTime.u32Sec = 2000;
+	i32Ret = WizeNet_Recv(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(1000, sNetMsg.u32RxEpoch);
+
+	// PHY doesn't time stamp, the RX started event tick is used
+	sPhySyncTime.u32Sec = 0;
+	sPhySyncTime.u32USec = 0;
+	i32Ret = WizeNet_Listen(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(0, sWizeCtx.bSyncTick);
+	sPhydev.pfEvtCb(sPhydev.pCbParam, PHYDEV_EVT_RX_STARTED);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.bSyncTick);
+	// As if the event was 1.5 s ago
+	sWizeCtx.u32SyncTick -= 1500;
+	_RxDone();
+	u32Sec = (uint32_t)time(NULL);
+	i32Ret = WizeNet_Recv(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	u32USec = (u32Sec - sNetMsg.u32RxEpoch) * 1000000 - sNetMsg.u32RxUSec;
+	// Current time (in second) minus the time stamp : between 0.5 and 1.5 s
+	TEST_ASSERT_UINT32_WITHIN(510000, 1000000, u32USec);
+	TEST_ASSERT_LESS_THAN(1000000, sNetMsg.u32RxUSec);
+	TEST_ASSERT_EQUAL(0, sWizeCtx.bSyncTick);
+
+	// No time stamp at all, the current time is used
+	sNetMsg.u32RxEpoch = 0;
+	i32Ret = WizeNet_Recv(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_NOT_EQUAL(0, sNetMsg.u32RxEpoch);
+	_clean_state_();
+}
+
+TEST(WizeCore_net, test_NetApi_SuspendResume)
+{
+	int32_t i32Ret;
+	netdev_stats_t sStats;
+
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_CLR_STATS, 0);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+
+	// Not suspended, can't resume
+	i32Ret = WizeNet_Resume(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+
+	// Suspend keep the PHY shadow
+	sWizeCtx.sPhyShadow.u8Valid = 1;
+	i32Ret = WizeNet_Suspend(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_SUSPEND, sNetDev.eState);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sPhyShadow.u8Valid);
+
+	// Device can't be used while suspended
+	i32Ret = WizeNet_Listen(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+
+	// Warm open
+	i32Ret = WizeNet_Resume(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_IDLE, sNetDev.eState);
+	TEST_ASSERT_EQUAL(1, sWizeCtx.sPhyShadow.u8Valid);
+
+	// PHY can't wake-up
+	i32Ret = WizeNet_Suspend(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	i32PhyRetCode = PHY_STATUS_ERROR;
+	i32Ret = WizeNet_Resume(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_UNKWON, sNetDev.eState);
+	TEST_ASSERT_EQUAL(0, sWizeCtx.sPhyShadow.u8Valid);
+
+	// PHY can't sleep
+	i32PhyRetCode = PHY_STATUS_OK;
+	i32Ret = WizeNet_Init(&sNetDev, pfcbEvent);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	i32PhyRetCode = PHY_STATUS_ERROR;
+	i32Ret = WizeNet_Suspend(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_IDLE, sNetDev.eState);
+
+	// Statistics
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_STATS_EX, (uint32_t)&sStats);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(1, sStats.sOpenStats.u32Cold);
+	TEST_ASSERT_EQUAL(1, sStats.sOpenStats.u32Warm);
+	TEST_ASSERT_EQUAL(1, sStats.sOpenStats.u32WarmFail);
+	_clean_state_();
+}
+
+TEST(WizeCore_net, test_NetApi_MultiPhy)
+{
+	static struct phydev_s sPhydevB;
+	int32_t i32Ret;
+	netdev_stats_t sStats;
+
+	sPhydevB.pIf = &sPhyIf;
+	sNetMsg.pData = aData;
+
+	i32Ret = WizeNet_Setup(&sNetDev, &sWizeCtx, &sPhydev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	i32Ret = WizeNet_AddPhy(&sNetDev, &sPhydevB);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	i32Ret = WizeNet_Init(&sNetDev, pfcbEvent);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_PHY_NB, 0);
+	TEST_ASSERT_EQUAL(2, i32Ret);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_PHY_STATE, 1);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_IDLE, i32Ret);
+
+	// Unknown route or PHY
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_ROUTE, (NETDEV_ROUTE_NB << 8) | 1);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_ROUTE, (NETDEV_ROUTE_RX << 8) | 2);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+
+	// Listen on PHY 1
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_ROUTE, (NETDEV_ROUTE_RX << 8) | 1);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_ROUTE, NETDEV_ROUTE_RX);
+	TEST_ASSERT_EQUAL(1, i32Ret);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_CLR_STATS, 0);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	i32Ret = WizeNet_Listen(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_IDLE, sNetDev.eState);
+
+	// Send on PHY 0 while PHY 1 is listening
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_BUSY, sNetDev.eState);
+
+	// Routes can't be changed while in use
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_SET_ROUTE, (NETDEV_ROUTE_RX << 8) | 0);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_BUSY, i32Ret);
+
+	// TX done, only the TX PHY goes to sleep
+	_TxDone();
+	TEST_ASSERT_EQUAL(NETDEV_STATE_IDLE, sNetDev.eState);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_PHY_CMD | NETDEV_CTL_PHY_TX, PHY_CTL_CMD_SLEEP);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_PHY_STATE, 1);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_BUSY, i32Ret);
+
+	// RX done on PHY 1
+	sPhydevB.pfEvtCb(sPhydevB.pCbParam, PHYDEV_EVT_RX_COMPLETE);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_PHY_STATE, 1);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_IDLE, i32Ret);
+	i32Ret = WizeNet_Recv(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+
+	// Per PHY statistics
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_STATS_EX, (uint32_t)&sStats);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	TEST_ASSERT_EQUAL(1, sStats.aPhyLink[0].u32TxFrm);
+	TEST_ASSERT_EQUAL(0, sStats.aPhyLink[0].u32RxFrm);
+	TEST_ASSERT_EQUAL(0, sStats.aPhyLink[1].u32TxFrm);
+	TEST_ASSERT_EQUAL(1, sStats.aPhyLink[1].u32RxFrm);
+
+	// Error on PHY 1 doesn't prevent PHY 0 to send
+	sPhydevB.pfEvtCb(sPhydevB.pCbParam, PHYDEV_EVT_ERROR);
+	i32Ret = WizeNet_Listen(&sNetDev);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_ERROR, i32Ret);
+	i32Ret = WizeNet_Send(&sNetDev, &sNetMsg);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	_TxDone();
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_CLR_ERR, 0);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	i32Ret = WizeNet_Ioctl(&sNetDev, NETDEV_CTL_GET_PHY_STATE, 1);
+	TEST_ASSERT_EQUAL(NETDEV_STATE_IDLE, i32Ret);
+
+	// Back to one PHY
+	WizeNet_Uninit(&sNetDev);
+	i32Ret = WizeNet_Setup(&sNetDev, &sWizeCtx, &sPhydev);
+	i32Ret = WizeNet_Init(&sNetDev, pfcbEvent);
+	TEST_ASSERT_EQUAL(NETDEV_STATUS_OK, i32Ret);
+	_clean_state_();
+}
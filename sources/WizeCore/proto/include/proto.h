@@ -159,6 +159,44 @@ typedef struct proto_stats_s
 	uint8_t u8RxReserved;         /*!< Reserved */
 } net_stats_t;
 
+/*!
+ * @cond INTERNAL
+ * @{
+ */
+#ifndef PROTO_STATS_HIST_NB
+#define PROTO_STATS_HIST_NB 8 // Number of histogram bins (on 0-255 range)
+#endif
+#ifndef PROTO_STATS_EWMA_SHIFT
+#define PROTO_STATS_EWMA_SHIFT 3 // EWMA weight is 1/(2^PROTO_STATS_EWMA_SHIFT)
+#endif
+/*!
+ * @}
+ * @endcond
+ */
+
+/*!
+ * @brief This structure hold the net device extended statistics
+ *
+ * @details Averages are EWMA in Q8.8 fixed point. Histograms are halved when
+ * one of their bins saturates, so the distribution shape is kept. Return code
+ * counters saturate at 0xFFFF.
+ */
+typedef struct proto_stats_ex_s
+{
+	// TX
+	uint16_t u16TxNoiseEwma;                       /*!< Noise EWMA (Q8.8) */
+	uint16_t aTxNoiseHist[PROTO_STATS_HIST_NB];    /*!< Noise histogram */
+	uint16_t aTxRetCode[PROTO_RET_CODE_NB];        /*!< Number of TX per return code (see @link ret_code_e @endlink) */
+	uint32_t u32TxLastErrEpoch;                    /*!< Epoch of the last TX error */
+	uint8_t  u8TxLastErr;                          /*!< Last TX error code */
+	// RX
+	uint8_t  u8RxLastErr;                          /*!< Last RX error code */
+	uint16_t u16RxRssiEwma;                        /*!< RSSI EWMA (Q8.8) */
+	uint16_t aRxRssiHist[PROTO_STATS_HIST_NB];     /*!< RSSI histogram */
+	uint16_t aRxRetCode[PROTO_RET_CODE_NB];        /*!< Number of RX per return code (see @link ret_code_e @endlink) */
+	uint32_t u32RxLastErrEpoch;                    /*!< Epoch of the last RX error */
+} net_stats_ex_t;
+
 /*!
  * @brief This structure is used to hold net device message
  */
@@ -166,6 +204,8 @@ typedef struct net_msg_s
 {
 	uint8_t *pData;              /*!< Pointer on data (transmit or received) */
 	uint32_t u32Epoch;           /*!< Epoch of the last frame */
+	uint32_t u32RxEpoch;         /*!< Sync word detection time of the last received frame (epoch) */
+	uint32_t u32RxUSec;          /*!< Sync word detection time of the last received frame (micro-second part) */
 	uint16_t u16Id;              /*!< Counter of the last frame */
 	uint8_t u8Size;              /*!< Size of the last frame */
 	uint8_t u8Type;              /*!< Type of the last frame*/
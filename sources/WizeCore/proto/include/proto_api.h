@@ -41,6 +41,7 @@ extern "C" {
 #include "proto_private.h"
 
 uint8_t Wize_ProtoBuild(struct proto_ctx_s *pCtx, net_msg_t *pNetMsg);
+uint8_t Wize_ProtoStamp(struct proto_ctx_s *pCtx, net_msg_t *pNetMsg);
 uint8_t Wize_ProtoExtract(struct proto_ctx_s *pCtx, net_msg_t *pNetMsg);
 void Wize_ProtoStats_RxUpdate(struct proto_ctx_s *pCtx, uint8_t u8ErrCode, uint8_t u8Rssi);
 void Wize_ProtoStats_TxUpdate(struct proto_ctx_s *pCtx, uint8_t u8ErrCode, uint8_t u8Noise);
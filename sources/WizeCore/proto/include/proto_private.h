@@ -375,6 +375,7 @@ struct proto_ctx_s
 {
 	struct proto_config_s sProtoConfig; /*!< Protocol filter configuration*/
 	struct proto_stats_s  sProtoStats;  /*!< Protocol TX/RX statistics */
+	struct proto_stats_ex_s sProtoStatsEx; /*!< Protocol TX/RX extended statistics */
 	uint8_t *pBuffer;                   /*!< Pointer on input/output buffer*/
 	uint8_t u8Size;                     /*!< Frame Size to send or received */
 
@@ -38,6 +38,7 @@ extern "C" {
 #include "proto.h"
 #include "proto_private.h"
 #include "proto_api.h"
+#include "wize_utils.h"
 #include "crypto.h"
 #include "crc_sw.h"
 #include "rs.h"
@@ -88,6 +89,10 @@ static uint8_t _download_extract(struct proto_ctx_s *pCtx, net_msg_t *pNetMsg);
 static uint8_t _exchange_extract(struct proto_ctx_s *pCtx, net_msg_t *pNetMsg);
 static uint8_t _exchange_build(struct proto_ctx_s *pCtx, net_msg_t *pNetMsg);
 
+static inline uint8_t _ewma_to_u8_(uint16_t u16Ewma);
+static uint16_t _ewma_update_(uint16_t u16Ewma, uint8_t u8Val, uint8_t bFirst);
+static void _hist_update_(uint16_t aHist[PROTO_STATS_HIST_NB], uint8_t u8Val);
+
 /******************************************************************************/
 
 /*!
@@ -228,6 +233,83 @@ uint8_t Wize_ProtoBuild(
     return u8Ret;
 }
 
+/*!
+  * @brief This function refresh the time stamp of an already built frame (see
+  * Wize_ProtoBuild). The Application and Presentation Layer are not built
+  * again : only the L6TStamp, the HKmac and the CRC are updated, and only if
+  * the time stamp has changed since the frame has been built.
+  *
+  * @param [in,out] *pCtx Pointer on structure that hold the protocol context.
+  * @param [in,out] *pNetMsg Pointer on structure that hold the Application message.
+  *
+  * @retval PROTO_SUCCESS (see @link ret_code_e::PROTO_SUCCESS @endlink)
+  * @retval PROTO_FRAME_SZ_ERR (see @link ret_code_e::PROTO_FRAME_SZ_ERR @endlink)
+  * @retval PROTO_INTERNAL_HASH_ERR (see @link ret_code_e::PROTO_INTERNAL_HASH_ERR @endlink)
+  * @retval PROTO_INTERNAL_CRC_ERR (see @link ret_code_e::PROTO_INTERNAL_CRC_ERR @endlink)
+  *
+  */
+uint8_t Wize_ProtoStamp(
+		struct proto_ctx_s *pCtx,
+		net_msg_t          *pNetMsg
+		)
+{
+    l2_exch_header_t *pL2h;
+    uint8_t pCtr[CTR_SIZE];
+    uint8_t aHash[CTR_SIZE];
+    uint8_t l6_start, l_size, u8TStampPos;
+    uint16_t u16Crc;
+    time_t t;
+
+    if ( !pCtx || !pNetMsg || !pCtx->pBuffer )
+    {
+    	return PROTO_INTERNAL_NULL_ERR;
+    }
+
+    l6_start = sizeof(l2_exch_header_t) + 1;
+    if ( pCtx->pBuffer[0] < ( sizeof(l2_exch_header_t) + sizeof(l6_exch_header_t) + sizeof(l6_exch_footer_t) + CRC_SZ ) )
+    {
+    	return PROTO_FRAME_SZ_ERR;
+    }
+    l_size = pCtx->pBuffer[0] - CRC_SZ;
+    u8TStampPos = l_size + 1 - L6_HASH_KMAC_SZ - L6_TSTAMP_SZ;
+
+    time(&t);
+    pNetMsg->u32Epoch = (uint32_t)t;
+    if ( *(uint16_t*)(&(pCtx->pBuffer[u8TStampPos])) == __htons((uint16_t)t) )
+    {
+    	// still the same time stamp, nothing to do
+    	return PROTO_SUCCESS;
+    }
+
+    // Set L6TStamp
+    *(uint16_t*)(&(pCtx->pBuffer[u8TStampPos])) = __htons((uint16_t)t);
+    pNetMsg->u16Tstamp = (uint16_t)t;
+
+    // compute HKmac
+    pL2h = (l2_exch_header_t*)(&(pCtx->pBuffer[1]));
+#if L6VERS == L6VER_WIZE_REV_1_0 || L6VERS == L6VER_WIZE_REV_1_1 || L6VERS == L6VER_WIZE_REV_1_2
+    memcpy(&(pCtr[0]), pL2h->Mfield, MFIELD_SZ);
+    memcpy(&(pCtr[MFIELD_SZ]), pL2h->Afield, AFIELD_SZ);
+    memset(&(pCtr[MFIELD_SZ + AFIELD_SZ]), 0x00, CTR_SIZE - (MFIELD_SZ + AFIELD_SZ));
+#else
+#error "L6VERS == L6VER_WIZE_REV_0_0"
+#endif
+    if ( Crypto_AES128_CMAC( aHash, &(pCtx->pBuffer[l6_start]), l_size - L6_HASH_KMAC_SZ - sizeof(l2_exch_header_t), pCtr, (uint8_t)(KEY_MAC_ID) ) != CRYPTO_OK)
+    {
+        return PROTO_INTERNAL_HASH_ERR;
+    }
+    // set Kmac
+    memcpy( &(pCtx->pBuffer[l_size + 1 - L6_HASH_KMAC_SZ]), aHash, L6_HASH_KMAC_SZ );
+
+    // compute and set the CRC
+    if ( ! CRC_Compute(pCtx->pBuffer, l_size + 1, &u16Crc) )
+    {
+        return PROTO_INTERNAL_CRC_ERR;
+    }
+    *(uint16_t*)(&(pCtx->pBuffer[l_size + 1])) = __htons(u16Crc);
+    return PROTO_SUCCESS;
+}
+
 /*!
   * @brief This function update the reception statistics.
   *
@@ -247,54 +329,72 @@ void Wize_ProtoStats_RxUpdate(
 	if (pCtx)
 	{
 		struct proto_stats_s *pStats = &(pCtx->sProtoStats);
-		pStats->u32RxNbBytes += pCtx->u8Size;
+		struct proto_stats_ex_s *pStatsEx = &(pCtx->sProtoStatsEx);
+		_sat_add_u32_(&(pStats->u32RxNbBytes), pCtx->u8Size);
+		if (u8ErrCode < PROTO_RET_CODE_NB)
+		{
+			_sat_inc_u16_(&(pStatsEx->aRxRetCode[u8ErrCode]));
+		}
 		// Update Frame stats
 		if (u8ErrCode == PROTO_SUCCESS)
 		{
-			uint32_t u32_temp;
 			// Stats on Rssi
+			if (pStats->u32RxNbFrmOK == 0) {
+				pStats->u8RxRssiMax = u8Rssi;
+				pStats->u8RxRssiMin = u8Rssi;
+			}
 			if(u8Rssi > pStats->u8RxRssiMax) {
 				pStats->u8RxRssiMax = u8Rssi;
 			}
 			if(u8Rssi < pStats->u8RxRssiMin) {
 				pStats->u8RxRssiMin = u8Rssi;
 			}
-			u32_temp = (pStats->u8RxRssiAvg*pStats->u32RxNbFrmOK) + u8Rssi;
-			pStats->u32RxNbFrmOK++;
-			pStats->u8RxRssiAvg = u32_temp/pStats->u32RxNbFrmOK;
+			pStatsEx->u16RxRssiEwma = _ewma_update_(
+					pStatsEx->u16RxRssiEwma, u8Rssi, (pStats->u32RxNbFrmOK == 0) );
+			pStats->u8RxRssiAvg = _ewma_to_u8_(pStatsEx->u16RxRssiEwma);
+			_hist_update_(pStatsEx->aRxRssiHist, u8Rssi);
+			_sat_add_u32_(&(pStats->u32RxNbFrmOK), 1);
 		}
 		// Update Frame error stats
 		else {
 			// Increase the number of received erronous frame
-			pStats->u32RxNbFrmErr++;
+			_sat_add_u32_(&(pStats->u32RxNbFrmErr), 1);
 			// set the stats
 			switch (u8ErrCode)
 			{
 				case PROTO_HEAD_END_AUTH_ERR:
-					pStats->sFrmErrStats.u32HeadAuthErr++;
+					_sat_add_u32_(&(pStats->sFrmErrStats.u32HeadAuthErr), 1);
 					break;
 				case PROTO_GATEWAY_AUTH_ERR:
-					pStats->sFrmErrStats.u32GatewayAuthErr++;
+					_sat_add_u32_(&(pStats->sFrmErrStats.u32GatewayAuthErr), 1);
 					break;
 				case PROTO_FRAME_UNK_ERR:
-					pStats->sFrmErrStats.u32UnkErr++;
+					_sat_add_u32_(&(pStats->sFrmErrStats.u32UnkErr), 1);
 					break;
 				case PROTO_FRAME_CRC_ERR:
-					pStats->sFrmErrStats.u32CrcErr++;
+					_sat_add_u32_(&(pStats->sFrmErrStats.u32CrcErr), 1);
 					break;
 				case PROTO_FRAME_RS_ERR:
-					pStats->sFrmErrStats.u32RsErr++;
+					_sat_add_u32_(&(pStats->sFrmErrStats.u32RsErr), 1);
 					break;
 				case PROTO_FRAME_SZ_ERR:
-					pStats->sFrmErrStats.u32LenErr++;
+					_sat_add_u32_(&(pStats->sFrmErrStats.u32LenErr), 1);
 					break;
 				case PROTO_APP_MSG_SZ_ERR:
-					pStats->sFrmErrStats.u32AppSzErr++;
+					_sat_add_u32_(&(pStats->sFrmErrStats.u32AppSzErr), 1);
 					break;
 				default:
-					pStats->sFrmErrStats.u32PassedErr++;
+					_sat_add_u32_(&(pStats->sFrmErrStats.u32PassedErr), 1);
 					break;
 			}
+			// Warning and info (e.g. frame passed) are not kept as last error
+			if (u8ErrCode < PROTO_FRM_WRN)
+			{
+				time_t t;
+				time(&t);
+				pStatsEx->u8RxLastErr = u8ErrCode;
+				pStatsEx->u32RxLastErrEpoch = (uint32_t)t;
+			}
 			// Wize stack error, so drop the frame
 		}
 	}
@@ -320,21 +420,37 @@ void Wize_ProtoStats_TxUpdate(
 	if (pCtx)
 	{
 		struct proto_stats_s *pStats = &(pCtx->sProtoStats);
-		pStats->u32TxNbBytes += pCtx->u8Size;
+		struct proto_stats_ex_s *pStatsEx = &(pCtx->sProtoStatsEx);
+		_sat_add_u32_(&(pStats->u32TxNbBytes), pCtx->u8Size);
+		if (u8ErrCode < PROTO_RET_CODE_NB)
+		{
+			_sat_inc_u16_(&(pStatsEx->aTxRetCode[u8ErrCode]));
+		}
 		// Update Frame stats
 		if (u8ErrCode == PROTO_SUCCESS)
 		{
-			uint32_t u32_temp;
 			// Stats on Noise
+			if (pStats->u32TxNbFrames == 0) {
+				pStats->u8TxNoiseMax = u8Noise;
+				pStats->u8TxNoiseMin = u8Noise;
+			}
 			if(u8Noise > pStats->u8TxNoiseMax) {
 				pStats->u8TxNoiseMax = u8Noise;
 			}
 			if(u8Noise < pStats->u8TxNoiseMin) {
 				pStats->u8TxNoiseMin = u8Noise;
 			}
-			u32_temp = (pStats->u8TxNoiseAvg*pStats->u32TxNbFrames) + u8Noise;
-			pStats->u32TxNbFrames++;
-			pStats->u8TxNoiseAvg = u32_temp/pStats->u32TxNbFrames;
+			pStatsEx->u16TxNoiseEwma = _ewma_update_(
+					pStatsEx->u16TxNoiseEwma, u8Noise, (pStats->u32TxNbFrames == 0) );
+			pStats->u8TxNoiseAvg = _ewma_to_u8_(pStatsEx->u16TxNoiseEwma);
+			_hist_update_(pStatsEx->aTxNoiseHist, u8Noise);
+			_sat_add_u32_(&(pStats->u32TxNbFrames), 1);
+		}
+		else {
+			time_t t;
+			time(&t);
+			pStatsEx->u8TxLastErr = u8ErrCode;
+			pStatsEx->u32TxLastErrEpoch = (uint32_t)t;
 		}
 	}
 }
@@ -354,6 +470,7 @@ void Wize_ProtoStats_RxClear(
 	if (pCtx)
 	{
 		struct proto_stats_s *pStats = &(pCtx->sProtoStats);
+		struct proto_stats_ex_s *pStatsEx = &(pCtx->sProtoStatsEx);
 		pStats->u8RxRssiMax = 0;
 		pStats->u8RxRssiMin = 0;
 		pStats->u8RxRssiAvg = 0;
@@ -362,6 +479,12 @@ void Wize_ProtoStats_RxClear(
 		pStats->u32RxNbFrmOK = 0;
 		pStats->u32RxNbFrmErr = 0;
 		memset(&(pStats->sFrmErrStats), 0, sizeof(frm_err_stats_t));
+
+		pStatsEx->u8RxLastErr = 0;
+		pStatsEx->u16RxRssiEwma = 0;
+		pStatsEx->u32RxLastErrEpoch = 0;
+		memset(pStatsEx->aRxRssiHist, 0, sizeof(pStatsEx->aRxRssiHist));
+		memset(pStatsEx->aRxRetCode, 0, sizeof(pStatsEx->aRxRetCode));
 	}
 }
 
@@ -380,14 +503,22 @@ void Wize_ProtoStats_TxClear(
 	if (pCtx)
 	{
 		struct proto_stats_s *pStats = &(pCtx->sProtoStats);
+		struct proto_stats_ex_s *pStatsEx = &(pCtx->sProtoStatsEx);
 		pStats->u8TxNoiseMax = 0;
 		pStats->u8TxNoiseAvg = 0;
 		pStats->u8TxNoiseMin = 0;
 		pStats->u8TxReserved = 0;
 		pStats->u32TxNbFrames = 0;
 		pStats->u32TxNbBytes = 0;
+
+		pStatsEx->u8TxLastErr = 0;
+		pStatsEx->u16TxNoiseEwma = 0;
+		pStatsEx->u32TxLastErrEpoch = 0;
+		memset(pStatsEx->aTxNoiseHist, 0, sizeof(pStatsEx->aTxNoiseHist));
+		memset(pStatsEx->aTxRetCode, 0, sizeof(pStatsEx->aTxRetCode));
 	}
 }
+
 /*!
   * @brief This function return a pointer on string error.
   *
@@ -1026,6 +1157,69 @@ static uint8_t _decrypt_(
     return ret;
 }
 
+/*!
+  * @static
+  * @brief Convert a Q8.8 EWMA into its rounded 8 bits value.
+  *
+  * @param [in] u16Ewma The Q8.8 EWMA.
+  *
+  * @return The rounded integer part
+  */
+static inline uint8_t _ewma_to_u8_(uint16_t u16Ewma)
+{
+	return (u16Ewma >= 0xFF80)?(0xFF):( (uint8_t)( (u16Ewma + 0x80) >> 8) );
+}
+
+/*!
+  * @static
+  * @brief Update an exponential weighted moving average (Q8.8 fixed point).
+  *
+  * @details avg += (val - avg) / 2^PROTO_STATS_EWMA_SHIFT. The first sample
+  * initialize the average.
+  *
+  * @param [in] u16Ewma The current Q8.8 EWMA.
+  * @param [in] u8Val   The new sample.
+  * @param [in] bFirst  Non zero if this is the first sample.
+  *
+  * @return The updated Q8.8 EWMA
+  */
+static uint16_t _ewma_update_(uint16_t u16Ewma, uint8_t u8Val, uint8_t bFirst)
+{
+	int32_t i32Diff;
+	if (bFirst)
+	{
+		return (uint16_t)(u8Val << 8);
+	}
+	i32Diff = ( (int32_t)(u8Val << 8) ) - (int32_t)u16Ewma;
+	return (uint16_t)( (int32_t)u16Ewma + (i32Diff / (1 << PROTO_STATS_EWMA_SHIFT)) );
+}
+
+/*!
+  * @static
+  * @brief Add a sample into a fixed bins histogram.
+  *
+  * @details When a bin is about to saturate, all bins are halved so that the
+  * distribution shape is kept.
+  *
+  * @param [in,out] aHist  The histogram.
+  * @param [in]     u8Val  The sample.
+  *
+  * @retval None
+  */
+static void _hist_update_(uint16_t aHist[PROTO_STATS_HIST_NB], uint8_t u8Val)
+{
+	uint8_t i;
+	uint8_t u8Bin = (uint8_t)( ((uint16_t)u8Val * PROTO_STATS_HIST_NB) >> 8 );
+	if (aHist[u8Bin] == UINT16_MAX)
+	{
+		for (i = 0; i < PROTO_STATS_HIST_NB; i++)
+		{
+			aHist[i] >>= 1;
+		}
+	}
+	aHist[u8Bin]++;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,6 +17,11 @@ TEST_GROUP_RUNNER(WizeCore_proto)
     RUN_TEST_CASE(WizeCore_proto, test_Proto_Build_CheckLField);
     RUN_TEST_CASE(WizeCore_proto, test_Proto_Build_CheckOtherContent);
 
+	// Test on call to Wize_ProtoStamp
+    RUN_TEST_CASE(WizeCore_proto, test_Proto_Stamp_NullPtr);
+    RUN_TEST_CASE(WizeCore_proto, test_Proto_Stamp_SameAsBuild);
+    RUN_TEST_CASE(WizeCore_proto, test_Proto_Stamp_SameTime);
+
     // Test on call to Wize_ProtoExtract
     RUN_TEST_CASE(WizeCore_proto, test_Proto_Extract_NullPtr);
     RUN_TEST_CASE(WizeCore_proto, test_Proto_Extract_BadSize);
@@ -52,6 +57,7 @@ TEST_GROUP_RUNNER(WizeCore_proto)
     // Test on call to Wize_ProtoStatsxx
     RUN_TEST_CASE(WizeCore_proto, test_Proto_StatRxUpdate_Success);
     RUN_TEST_CASE(WizeCore_proto, test_Proto_StatsTxUpdate_Success);
+    RUN_TEST_CASE(WizeCore_proto, test_Proto_StatsRxUpdate_Extended);
     RUN_TEST_CASE(WizeCore_proto, test_Proto_StatsRxClear_Success);
     RUN_TEST_CASE(WizeCore_proto, test_Proto_StatsTxClear_Success);
 }
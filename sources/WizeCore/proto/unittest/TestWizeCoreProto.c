@@ -3,6 +3,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdint.h>
+#include <time.h>
+#include <sys/time.h>
 
 TEST_GROUP(WizeCore_proto);
 
@@ -43,6 +45,25 @@ static net_msg_t sNetMsg =
 };
 
 uint8_t aHash[L6_HASH_KENC_SZ] = {0xC0, 0xCA, 0xBA, 0xD0};
+
+/*
+ * Time source of the DUT : the real one, unless a test set u32FakeTime
+ */
+static uint32_t u32FakeTime;
+
+time_t time(time_t *tloc)
+{
+	struct timeval tv;
+	time_t t;
+
+	gettimeofday(&tv, NULL);
+	t = (u32FakeTime)?((time_t)u32FakeTime):(tv.tv_sec);
+	if (tloc)
+	{
+		*tloc = t;
+	}
+	return t;
+}
 uint8_t aCrc[CRC_SZ] = {0xCA, 0xD0};
 /******************************************************************************/
 //
@@ -272,6 +293,83 @@ uint8_t _crc_compute_cb_(
 	return 1;
 }
 
+/*
+ * The following cipher, hash and CRC depend on the input (as the real ones
+ * do), so that a frame can be compared byte per byte with another one.
+ */
+uint8_t _crypto_encrypt_xor_cb_(
+		uint8_t* p_Out,
+		uint8_t* p_In,
+		uint8_t u8_Sz,
+		uint8_t* p_Ctr,
+		uint8_t u8_KeyId,
+		int cmock_num_calls
+		)
+{
+	uint8_t i;
+	TEST_ASSERT_NOT_NULL(p_Out);
+	TEST_ASSERT_NOT_NULL(p_In);
+	TEST_ASSERT_NOT_NULL(p_Ctr);
+	for (i = 0; i < u8_Sz; i++)
+	{
+		p_Out[i] = p_In[i] ^ p_Ctr[i % CTR_SIZE];
+	}
+	return CRYPTO_OK;
+}
+
+uint8_t _crypto_aes128_cmac_sum_cb_(
+		uint8_t* p_Hash,
+		uint8_t* p_Msg,
+		uint8_t u8_Sz,
+		uint8_t* p_Ctr,
+		uint8_t u8_KeyId,
+		int cmock_num_calls
+		)
+{
+	uint8_t i;
+	TEST_ASSERT_NOT_NULL(p_Hash);
+	TEST_ASSERT_NOT_NULL(p_Msg);
+	TEST_ASSERT_NOT_NULL(p_Ctr);
+	memset(p_Hash, u8_KeyId, L6_HASH_KENC_SZ);
+	for (i = 0; i < u8_Sz; i++)
+	{
+		p_Hash[i % L6_HASH_KENC_SZ] = (uint8_t)(p_Hash[i % L6_HASH_KENC_SZ] * 31 + p_Msg[i]);
+	}
+	for (i = 0; i < CTR_SIZE; i++)
+	{
+		p_Hash[i % L6_HASH_KENC_SZ] ^= p_Ctr[i];
+	}
+	return CRYPTO_OK;
+}
+
+uint8_t _crc_compute_sum_cb_(
+		uint8_t* p_Buf,
+		uint8_t u8_Sz,
+		uint16_t* p_Crc,
+		int cmock_num_calls
+		)
+{
+	uint8_t i;
+	TEST_ASSERT_NOT_NULL(p_Buf);
+	TEST_ASSERT_NOT_NULL(p_Crc);
+	*p_Crc = 0xFFFF;
+	for (i = 0; i < u8_Sz; i++)
+	{
+		*p_Crc = (uint16_t)( (*p_Crc << 5) + (*p_Crc >> 11) + p_Buf[i] );
+	}
+	return 1;
+}
+
+uint8_t _crc_compute_fail_cb_(
+		uint8_t* p_Buf,
+		uint8_t u8_Sz,
+		uint16_t* p_Crc,
+		int cmock_num_calls
+		)
+{
+	return 0;
+}
+
 uint8_t _crc_check_cb_(
 		uint16_t u16_CrcA,
 		uint16_t u16_CrcB,
@@ -330,6 +428,8 @@ TEST_SETUP(WizeCore_proto)
 	eTestHMACStatusIndex = 0;
 	eTestHMACStatus[0] = TEST_AES_HMAC_STATUS_Match;
 	eTestHMACStatus[1] = TEST_AES_HMAC_STATUS_Match;
+
+	u32FakeTime = 0;
 }
 
 TEST_TEAR_DOWN(WizeCore_proto)
@@ -567,6 +667,81 @@ TEST(WizeCore_proto, test_Proto_Build_CheckOtherContent)
 	_check_exch_other_content_(sNetMsg.u8Size);
 }
 
+/******************************************************************************/
+TEST(WizeCore_proto, test_Proto_Stamp_NullPtr)
+{
+	uint8_t eRet;
+
+	eRet = Wize_ProtoStamp(NULL, &sNetMsg);
+	TEST_ASSERT_EQUAL(PROTO_INTERNAL_NULL_ERR, eRet);
+
+	eRet = Wize_ProtoStamp(&sCtx, NULL);
+	TEST_ASSERT_EQUAL(PROTO_INTERNAL_NULL_ERR, eRet);
+
+	// not built
+	aBuff[0] = 0;
+	eRet = Wize_ProtoStamp(&sCtx, &sNetMsg);
+	TEST_ASSERT_EQUAL(PROTO_FRAME_SZ_ERR, eRet);
+}
+
+TEST(WizeCore_proto, test_Proto_Stamp_SameAsBuild)
+{
+	uint8_t eRet;
+	uint8_t aFresh[sizeof(aBuff)];
+
+	Crypto_Encrypt_Stub(_crypto_encrypt_xor_cb_);
+	Crypto_AES128_CMAC_Stub(_crypto_aes128_cmac_sum_cb_);
+	CRC_Compute_Stub(_crc_compute_sum_cb_);
+
+	// reference : frame built at T + 1
+	u32FakeTime = 0x5F5E1000 + 1;
+	eRet = Wize_ProtoBuild(&sCtx, &sNetMsg);
+	TEST_ASSERT_EQUAL(PROTO_SUCCESS, eRet);
+	memcpy(aFresh, aBuff, sizeof(aBuff));
+
+	// built at T, so L6TStamp, HKmac and CRC differ
+	u32FakeTime = 0x5F5E1000;
+	eRet = Wize_ProtoBuild(&sCtx, &sNetMsg);
+	TEST_ASSERT_EQUAL(PROTO_SUCCESS, eRet);
+	TEST_ASSERT_EQUAL(aFresh[0], aBuff[0]);
+	TEST_ASSERT_NOT_EQUAL(0, memcmp(aFresh, aBuff, aBuff[0] + 1));
+
+	// then stamped at T + 1 : same bytes as the reference
+	u32FakeTime = 0x5F5E1000 + 1;
+	eRet = Wize_ProtoStamp(&sCtx, &sNetMsg);
+	TEST_ASSERT_EQUAL(PROTO_SUCCESS, eRet);
+	TEST_ASSERT_EQUAL_MEMORY(aFresh, aBuff, aFresh[0] + 1);
+	TEST_ASSERT_EQUAL(0x5F5E1000 + 1, sNetMsg.u32Epoch);
+	TEST_ASSERT_EQUAL((uint16_t)(0x5F5E1000 + 1), sNetMsg.u16Tstamp);
+	TEST_ASSERT_EQUAL(aFresh[0], sCtx.u8Size);
+}
+
+TEST(WizeCore_proto, test_Proto_Stamp_SameTime)
+{
+	uint8_t eRet;
+	uint8_t aBuilt[sizeof(aBuff)];
+
+	Crypto_Encrypt_Stub(_crypto_encrypt_xor_cb_);
+	Crypto_AES128_CMAC_Stub(_crypto_aes128_cmac_sum_cb_);
+	CRC_Compute_Stub(_crc_compute_sum_cb_);
+
+	u32FakeTime = 0x5F5E1000;
+	eRet = Wize_ProtoBuild(&sCtx, &sNetMsg);
+	TEST_ASSERT_EQUAL(PROTO_SUCCESS, eRet);
+	memcpy(aBuilt, aBuff, sizeof(aBuff));
+
+	// same time stamp : nothing is computed again
+	CRC_Compute_Stub(_crc_compute_fail_cb_);
+	eRet = Wize_ProtoStamp(&sCtx, &sNetMsg);
+	TEST_ASSERT_EQUAL(PROTO_SUCCESS, eRet);
+	TEST_ASSERT_EQUAL_MEMORY(aBuilt, aBuff, aBuilt[0] + 1);
+
+	// new time stamp, CRC failed
+	u32FakeTime++;
+	eRet = Wize_ProtoStamp(&sCtx, &sNetMsg);
+	TEST_ASSERT_EQUAL(PROTO_INTERNAL_CRC_ERR, eRet);
+}
+
 /******************************************************************************/
 TEST(WizeCore_proto, test_Proto_Extract_NullPtr)
 {
@@ -969,6 +1144,51 @@ TEST(WizeCore_proto, test_Proto_StatsTxUpdate_Success)
 	TEST_ASSERT_EQUAL(15, sCtx.sProtoStats.u32TxNbBytes);
 }
 
+TEST(WizeCore_proto, test_Proto_StatsRxUpdate_Extended)
+{
+	memset(&(sCtx.sProtoStats), 0, sizeof(struct proto_stats_s));
+	memset(&(sCtx.sProtoStatsEx), 0, sizeof(struct proto_stats_ex_s));
+	sCtx.u8Size = 10;
+
+	// First frame initialize min, max and average
+	Wize_ProtoStats_RxUpdate(&sCtx, PROTO_SUCCESS, 100);
+	TEST_ASSERT_EQUAL(100, sCtx.sProtoStats.u8RxRssiMin);
+	TEST_ASSERT_EQUAL(100, sCtx.sProtoStats.u8RxRssiMax);
+	TEST_ASSERT_EQUAL(100, sCtx.sProtoStats.u8RxRssiAvg);
+	TEST_ASSERT_EQUAL(100 << 8, sCtx.sProtoStatsEx.u16RxRssiEwma);
+
+	// EWMA move toward the new sample
+	Wize_ProtoStats_RxUpdate(&sCtx, PROTO_SUCCESS, 180);
+	TEST_ASSERT_EQUAL(100, sCtx.sProtoStats.u8RxRssiMin);
+	TEST_ASSERT_EQUAL(180, sCtx.sProtoStats.u8RxRssiMax);
+	TEST_ASSERT_EQUAL(110, sCtx.sProtoStats.u8RxRssiAvg);
+	TEST_ASSERT_EQUAL(1, sCtx.sProtoStatsEx.aRxRssiHist[(100*PROTO_STATS_HIST_NB) >> 8]);
+	TEST_ASSERT_EQUAL(1, sCtx.sProtoStatsEx.aRxRssiHist[(180*PROTO_STATS_HIST_NB) >> 8]);
+	TEST_ASSERT_EQUAL(2, sCtx.sProtoStatsEx.aRxRetCode[PROTO_SUCCESS]);
+
+	// Error is counted and time stamped, passed frame is not kept as last error
+	Wize_ProtoStats_RxUpdate(&sCtx, PROTO_FRAME_CRC_ERR, 0);
+	Wize_ProtoStats_RxUpdate(&sCtx, PROTO_FRAME_PASS_INF, 0);
+	TEST_ASSERT_EQUAL(1, sCtx.sProtoStatsEx.aRxRetCode[PROTO_FRAME_CRC_ERR]);
+	TEST_ASSERT_EQUAL(1, sCtx.sProtoStatsEx.aRxRetCode[PROTO_FRAME_PASS_INF]);
+	TEST_ASSERT_EQUAL(PROTO_FRAME_CRC_ERR, sCtx.sProtoStatsEx.u8RxLastErr);
+	TEST_ASSERT_EQUAL(2, sCtx.sProtoStats.u32RxNbFrmErr);
+
+	// Counters saturate
+	sCtx.sProtoStats.u32RxNbBytes = 0xFFFFFFFA;
+	sCtx.sProtoStatsEx.aRxRetCode[PROTO_SUCCESS] = 0xFFFF;
+	Wize_ProtoStats_RxUpdate(&sCtx, PROTO_SUCCESS, 100);
+	TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFF, sCtx.sProtoStats.u32RxNbBytes);
+	TEST_ASSERT_EQUAL_HEX16(0xFFFF, sCtx.sProtoStatsEx.aRxRetCode[PROTO_SUCCESS]);
+
+	// Histogram is halved on saturation
+	sCtx.sProtoStatsEx.aRxRssiHist[(100*PROTO_STATS_HIST_NB) >> 8] = 0xFFFF;
+	sCtx.sProtoStatsEx.aRxRssiHist[(180*PROTO_STATS_HIST_NB) >> 8] = 10;
+	Wize_ProtoStats_RxUpdate(&sCtx, PROTO_SUCCESS, 100);
+	TEST_ASSERT_EQUAL_HEX16(0x8000, sCtx.sProtoStatsEx.aRxRssiHist[(100*PROTO_STATS_HIST_NB) >> 8]);
+	TEST_ASSERT_EQUAL(5, sCtx.sProtoStatsEx.aRxRssiHist[(180*PROTO_STATS_HIST_NB) >> 8]);
+}
+
 TEST(WizeCore_proto, test_Proto_StatsRxClear_Success)
 {
 	uint8_t *p = (uint8_t*)( &(sCtx.sProtoStats) );
@@ -0,0 +1,98 @@
+/**
+  * @file wize_utils.h
+  * @brief This file contains small internal helpers shared by the WizeCore
+  * modules (not part of the public API).
+  *
+  * @details
+  *
+  * @copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *
+  * @par Revision history
+  *
+  * @par 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  */
+
+/*!
+ * @addtogroup wize_utils
+ * @{
+ *
+ */
+#ifndef _WIZE_UTILS_H_
+#define _WIZE_UTILS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*!
+  * @brief Add a value to a 32 bits counter, saturating at 0xFFFFFFFF.
+  *
+  * @param [in,out] pCnt    Pointer on the counter.
+  * @param [in]     u32Val  Value to add.
+  *
+  * @retval None
+  */
+static inline void _sat_add_u32_(uint32_t *pCnt, uint32_t u32Val)
+{
+	if ( *pCnt > (UINT32_MAX - u32Val) ) {
+		*pCnt = UINT32_MAX;
+	}
+	else {
+		*pCnt += u32Val;
+	}
+}
+
+/*!
+  * @brief Increment a 16 bits counter, saturating at 0xFFFF.
+  *
+  * @param [in,out] pCnt Pointer on the counter.
+  *
+  * @retval None
+  */
+static inline void _sat_inc_u16_(uint16_t *pCnt)
+{
+	if ( *pCnt < UINT16_MAX ) {
+		(*pCnt)++;
+	}
+}
+
+/*!
+  * @brief Get the next value of a xorshift32 random generator.
+  *
+  * @param [in,out] pState Pointer on the generator state (must not be 0).
+  *
+  * @return The next random value (never 0).
+  */
+static inline uint32_t _xorshift32_(uint32_t *pState)
+{
+	uint32_t x = *pState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*pState = x;
+	return x;
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _WIZE_UTILS_H_ */
+
+/*! @} */
@@ -30,6 +30,7 @@ option(USE_FREERTOS "" OFF)
 
 
 option(BUILD_DEMO "" OFF)
+option(BUILD_PHYVIRTUAL "Build the host virtual medium (native environment only)" OFF)
 
 option(BUILD_TEST "" OFF)
 option(BUILD_UNITTEST "" OFF)
@@ -110,6 +111,10 @@ if(ENABLE_NATIVE_UNITTEST)
         add_to_native(TARGET openwize PATH sources)
     endif(BUILD_OPENWIZE)
 
+    if(BUILD_PHYVIRTUAL)
+        add_to_native(TARGET phyvirtual PATH demo/Native/device/PhyVirtual)
+    endif(BUILD_PHYVIRTUAL)
+
     setup_to_native()
 endif(ENABLE_NATIVE_UNITTEST)
 
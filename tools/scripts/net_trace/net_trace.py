@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+################################################################################
+# Decode a NetMgr trace snapshot (see NetMgr_TraceGet in net_mgr.h).
+#
+# The input is the records array, as a raw binary file (e.g. dumped from the
+# debugger) or as an hexadecimal text (--hex, white spaces are ignored). Each
+# record is 8 bytes, little endian :
+#   uint32_t u32Us; uint8_t u8Evt; uint8_t u8State; uint16_t u16Arg;
+#
+# It print the timeline, then the latency distribution of each phase.
+################################################################################
+import argparse
+import struct
+import sys
+
+# Must match net_trace_evt_e (net_mgr.h)
+EVT = {
+    0x00: "NONE",
+    0x01: "OPEN",
+    0x02: "CLOSE",
+    0x03: "SEND_START",
+    0x04: "SEND_RETRY",
+    0x05: "CCA_BACKOFF",
+    0x06: "TX_COMPLETE",
+    0x07: "LISTEN_START",
+    0x08: "LISTEN_RETRY",
+    0x09: "RX_STARTED",
+    0x0A: "RX_COMPLETE",
+    0x0B: "RECV_DONE",
+    0x0C: "FRM_PASSED",
+    0x0D: "FRM_DROPPED",
+    0x0E: "TIMEOUT",
+    0x0F: "TMO_EXPAND",
+    0x10: "RX_WAKE",
+    0x11: "RX_ARM",
+    0x12: "ERROR",
+    0x13: "ABORT",
+    0x14: "REQ_START",
+    0x15: "REQ_END",
+    0x16: "PREEMPT",
+    0x17: "REQ_DROP",
+}
+
+# Must match netdev_state_e (net_api_private.h)
+STATE = {0x0: "UNKWON", 0x1: "IDLE", 0x2: "BUSY", 0x4: "SUSPEND", 0x8: "ERROR"}
+
+# Phase : (name, start events, end events)
+PHASES = [
+    ("tx",         ("SEND_START",),   ("TX_COMPLETE",)),
+    ("rx_wait",    ("LISTEN_START",), ("RX_STARTED", "TIMEOUT")),
+    ("rx_frame",   ("RX_STARTED",),   ("RX_COMPLETE",)),
+    ("rx_process", ("RX_COMPLETE",),  ("RECV_DONE", "FRM_PASSED", "FRM_DROPPED")),
+    ("rx_arm",     ("RX_WAKE",),      ("RX_ARM",)),
+    ("request",    ("REQ_START",),    ("REQ_END",)),
+    ("session",    ("OPEN",),         ("CLOSE",)),
+]
+
+REC = struct.Struct("<IBBH")
+
+
+def load(path, is_hex):
+    with open(path, "rb") as f:
+        data = f.read()
+    if is_hex:
+        data = bytes.fromhex("".join(data.decode("ascii").split()))
+    if len(data) % REC.size:
+        sys.exit("error: size is not a multiple of %d bytes" % REC.size)
+    recs = [REC.unpack_from(data, i) for i in range(0, len(data), REC.size)]
+    return [r for r in recs if r[1] != 0]
+
+
+def unwrap(recs):
+    # time stamps wrap around on 32 bits
+    out, base, prev = [], 0, None
+    for us, evt, state, arg in recs:
+        if prev is not None and us < prev:
+            base += 1 << 32
+        prev = us
+        out.append((base + us, EVT.get(evt, "0x%02X" % evt), STATE.get(state, "0x%X" % state), arg))
+    return out
+
+
+def timeline(recs):
+    t0 = recs[0][0]
+    prev = t0
+    print("%12s %10s  %-13s %-8s %s" % ("t (us)", "dt (us)", "event", "state", "arg"))
+    for t, evt, state, arg in recs:
+        print("%12d %10d  %-13s %-8s %d" % (t - t0, t - prev, evt, state, arg))
+        prev = t
+
+
+def percentile(values, p):
+    k = (len(values) - 1) * p / 100.0
+    lo = int(k)
+    hi = min(lo + 1, len(values) - 1)
+    return values[lo] + (values[hi] - values[lo]) * (k - lo)
+
+
+def phases(recs):
+    print()
+    print("%-11s %6s %10s %10s %10s %10s %10s" % ("phase", "nb", "min", "p50", "p90", "p99", "max"))
+    for name, starts, ends in PHASES:
+        values, start = [], None
+        for t, evt, _, _ in recs:
+            if evt in starts:
+                start = t
+            elif evt in ends and start is not None:
+                values.append(t - start)
+                start = None
+        if not values:
+            continue
+        values.sort()
+        print("%-11s %6d %10d %10d %10d %10d %10d" % (
+            name, len(values), values[0], percentile(values, 50),
+            percentile(values, 90), percentile(values, 99), values[-1]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a NetMgr trace snapshot")
+    parser.add_argument("file", help="records file (binary, or hexadecimal text with --hex)")
+    parser.add_argument("--hex", action="store_true", help="the file is an hexadecimal text")
+    parser.add_argument("--no-timeline", action="store_true", help="only print the phase latencies")
+    args = parser.parse_args()
+
+    recs = load(args.file, args.hex)
+    if not recs:
+        sys.exit("no record")
+    recs = unwrap(recs)
+    if not args.no_timeline:
+        timeline(recs)
+    phases(recs)
+
+
+if __name__ == "__main__":
+    main()